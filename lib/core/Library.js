@@ -39,6 +39,35 @@
  * ```
  */
 
+import { resolveErrcheckPolicy } from "../platform/errors.js";
+
+/**
+ * View lazy per un return type struct/union (opzione `lazy_struct`): riceve
+ * il Buffer con la copia dei byte ritornati e costruisce lo stesso wrapper di
+ * `new T(buf)` / `def.create()`, senza decodificare nessun campo.
+ *
+ * @param {Function|Object} returnType - Structure/Union subclass o struct()/union() def
+ * @returns {Function} `(buf) => view`
+ * @private
+ */
+function structReturnView(returnType) {
+  if (typeof returnType === "function" && (typeof returnType._buildStruct === "function" || typeof returnType._buildUnion === "function")) {
+    return (buf) => new returnType(buf);
+  }
+  if (returnType && typeof returnType === "object" && returnType._isStructType && typeof returnType.wrap === "function") {
+    return (buf) => returnType.wrap(buf);
+  }
+  throw new TypeError("lazy_struct requires a Structure/Union (or struct()/union()) return type");
+}
+
+/**
+ * Chiave della cache dei callable di CDLL.func() / bindAll().
+ * @private
+ */
+function functionCacheKey(name, returnType, argTypes, options) {
+  return `${name}:${returnType}:${argTypes.join(",")}${options.abi ? `:${options.abi}` : ""}${options.lazy_struct ? ":lazy" : ""}${options.pointerMode ? `:${options.pointerMode}` : ""}${options.serial === undefined ? "" : options.serial ? ":serial" : ":noserial"}${options.outParams ? `:out=${options.outParams.map((o) => `${o.index}/${o.type}`).join(";")}` : ""}`;
+}
+
 /**
  * Creates the Library-related classes with required dependencies injected.
  *
@@ -50,7 +79,7 @@
  * @returns {Object} Object containing FunctionWrapper, CDLL, WinDLL classes
  * @private
  */
-export function createLibraryClasses(Library, LRUCache, _toNativeType, _toNativeTypes, native) {
+export function createLibraryClasses(Library, LRUCache, _toNativeType, _toNativeTypes, native, winError) {
   class FunctionWrapper {
     constructor(cdll, name) {
       const argtypes = [];
@@ -74,14 +103,14 @@ export function createLibraryClasses(Library, LRUCache, _toNativeType, _toNative
           if (prop === "argtypes") return argtypes;
           if (prop === "restype") return restype;
           if (prop === "errcheck") return cachedFunc ? cachedFunc.errcheck : undefined;
-          if (prop === "callAsync") {
+          if (prop === "callAsync" || prop === "submit") {
             if (restype === undefined) {
               throw new Error(`Function ${name}: restype not set`);
             }
             if (!cachedFunc) {
               cachedFunc = cdll.func(name, restype, argtypes);
             }
-            return cachedFunc.callAsync;
+            return cachedFunc[prop];
           }
           return target[prop];
         },
@@ -130,6 +159,16 @@ export function createLibraryClasses(Library, LRUCache, _toNativeType, _toNative
       // intervening JS/Node code clobbering the value.
       this._use_last_error = !!options.use_last_error;
       this._use_errno = !!options.use_errno;
+      // stats: true → strumentazione per tutte le funzioni della library
+      // (fn.getStats(), ctypes.statsSnapshot())
+      this._stats = !!options.stats;
+      // pointerMode: "number" → puntatori e interi a 64 bit ritornati come
+      // Number quando esatti (niente BigInt per chiamata), vedi FunctionOptions
+      this._pointerMode = options.pointerMode;
+      // serial: true → tutte le callAsync della library passano da un'unica
+      // coda seriale del pool nativo (librerie non thread-safe). Default:
+      // fan-out sui worker del pool.
+      this._serialQueue = options.serial ? native.createSerialQueue() : null;
 
       // Return a proxy to enable Python-like syntax: libc.abs.argtypes = [...]; libc.abs.restype = ...; libc.abs(...)
       return new Proxy(this, {
@@ -155,24 +194,133 @@ export function createLibraryClasses(Library, LRUCache, _toNativeType, _toNative
      * @param {string} name - Nome della funzione
      * @param {Function|number|CType} returnType - Tipo di ritorno (SimpleCData class, CType value, o CType)
      * @param {Array<Function|number|CType>} argTypes - Tipi degli argomenti
-     * @param {Object} [options] - Opzioni aggiuntive (es. { abi: 'stdcall' })
+     * @param {Object} [options] - Opzioni aggiuntive (es. { abi: 'stdcall' }).
+     *   `lazy_struct: true` con un return type struct/union: il risultato è
+     *   una view sul Buffer copiato (campi decodificati solo quando letti)
+     *   invece di un oggetto con tutti i campi già convertiti.
      * @returns {Function} Funzione callable
      */
     func(name, returnType, argTypes = [], options = {}) {
-      const cacheKey = `${name}:${returnType}:${argTypes.join(",")}`;
+      options = this._defaultOptions(options);
+      const cacheKey = functionCacheKey(name, returnType, argTypes, options);
 
       if (this._cache.has(cacheKey)) {
         return this._cache.get(cacheKey);
       }
 
+      const ffiFunc = this._lib.func(name, _toNativeType(returnType, native), _toNativeTypes(argTypes, native), this._nativeOptions(returnType, options));
+      const callMethod = this._finishFunction(name, returnType, this._wrapFunction(name, argTypes, ffiFunc));
+      this._cache.set(cacheKey, callMethod);
+      return callMethod;
+    }
+
+    /**
+     * Risolve e prepara un intero manifest di funzioni in un solo crossing
+     * verso il native (dlsym + FFIFunction per ogni voce non già in cache).
+     *
+     * @param {Array<{name: string, restype: Function|number|CType, argtypes?: Array, options?: Object}>} manifest
+     * @returns {Object<string, Function>} Funzioni callable indicizzate per nome
+     *
+     * @example
+     * ```javascript
+     * const { strlen, abs } = libc.bindAll([
+     *   { name: "strlen", restype: c_size_t, argtypes: [c_char_p] },
+     *   { name: "abs", restype: c_int, argtypes: [c_int] },
+     * ]);
+     * ```
+     */
+    bindAll(manifest) {
+      if (!Array.isArray(manifest)) {
+        throw new TypeError("bindAll requires an array of { name, restype, argtypes, options }");
+      }
+
+      const bound = {};
+      const pending = [];
+      const specs = [];
+      for (const entry of manifest) {
+        const { name, restype, argtypes = [] } = entry;
+        if (typeof name !== "string") {
+          throw new TypeError("bindAll: every entry requires a string name");
+        }
+        if (restype === undefined) {
+          throw new TypeError(`bindAll: '${name}' requires a restype`);
+        }
+        const options = this._defaultOptions(entry.options ?? {});
+        const cacheKey = functionCacheKey(name, restype, argtypes, options);
+        if (this._cache.has(cacheKey)) {
+          bound[name] = this._cache.get(cacheKey);
+          continue;
+        }
+        pending.push({ name, restype, argtypes, cacheKey });
+        specs.push({
+          name,
+          restype: _toNativeType(restype, native),
+          argtypes: _toNativeTypes(argtypes, native),
+          options: this._nativeOptions(restype, options),
+        });
+      }
+
+      if (specs.length > 0) {
+        const ffiFuncs = this._lib.bindAll(specs);
+        for (let i = 0; i < pending.length; i++) {
+          const { name, restype, argtypes, cacheKey } = pending[i];
+          const callMethod = this._finishFunction(name, restype, this._wrapFunction(name, argtypes, ffiFuncs[i]));
+          this._cache.set(cacheKey, callMethod);
+          bound[name] = callMethod;
+        }
+      }
+      return bound;
+    }
+
+    /**
+     * Opzioni di default della library, applicate prima del lookup in cache
+     * (WinDLL: abi stdcall).
+     * @private
+     */
+    _defaultOptions(options) {
+      return options;
+    }
+
+    /**
+     * Post-processing del callable appena creato, prima di metterlo in cache
+     * (OleDLL: errcheck HRESULT).
+     * @private
+     */
+    _finishFunction(name, returnType, fn) {
+      return fn;
+    }
+
+    /**
+     * Opzioni passate alla FFIFunction nativa: coda seriale, struct_view per
+     * lazy_struct, outParams con i tipi nativi, use_last_error / use_errno /
+     * stats / pointerMode della library.
+     * @private
+     */
+    _nativeOptions(returnType, options) {
+      // Coda seriale per callAsync: quella della library, oppure una dedicata
+      // se la singola funzione è dichiarata { serial: true }.
+      const queue = options.serial === false ? null : (this._serialQueue ?? (options.serial ? native.createSerialQueue() : null));
+
+      // lazy_struct è solo JS: al native arriva come callback struct_view
+      const { lazy_struct, outParams, ...nativeOptions } = options;
       // Propagate library-level use_last_error / use_errno to the FFIFunction
-      const mergedOptions = {
-        ...options,
+      return {
+        ...nativeOptions,
+        ...(lazy_struct ? { struct_view: structReturnView(returnType) } : {}),
         ...(this._use_last_error ? { use_last_error: true } : {}),
         ...(this._use_errno ? { use_errno: true } : {}),
+        ...(this._stats ? { stats: true } : {}),
+        ...(this._pointerMode && nativeOptions.pointerMode === undefined ? { pointerMode: this._pointerMode } : {}),
+        ...(queue ? { queue } : {}),
+        ...(outParams ? { outParams: outParams.map(({ index, type }) => ({ index, type: _toNativeType(type, native) })) } : {}),
       };
-      const ffiFunc = this._lib.func(name, _toNativeType(returnType, native), _toNativeTypes(argTypes, native), mergedOptions);
+    }
 
+    /**
+     * Costruisce il callable JS attorno a una FFIFunction nativa.
+     * @private
+     */
+    _wrapFunction(name, argTypes, ffiFunc) {
       // =========================================================================
       // OPTIMIZATION: Create specialized wrapper based on argument types
       // For primitive-only args, bypass the processing loop entirely
@@ -206,6 +354,11 @@ export function createLibraryClasses(Library, LRUCache, _toNativeType, _toNative
 
       let callMethod;
 
+      // Entry point nativo standalone (vedi FFIFunction::GetFastCall): stessa
+      // semantica di ffiFunc.call ma senza lookup del metodo né unwrap del
+      // receiver a ogni chiamata.
+      const nativeCall = ffiFunc.getFastCall();
+
       // COERCE: unified inline coercion for any arg type.
       // - primitives (number, string, bigint, null, undefined): pass through
       // - object with ._buffer: unwrap to the raw Buffer (struct/array wrapper)
@@ -224,9 +377,9 @@ export function createLibraryClasses(Library, LRUCache, _toNativeType, _toNative
         // FAST PATH: No declared arguments — still support variadic
         callMethod = function (...args) {
           if (args.length === 0) {
-            return ffiFunc.call();
+            return nativeCall();
           }
-          return ffiFunc.call(...args);
+          return nativeCall(...args);
         };
       } else if (!anyFromParam) {
         // FAST PATH: No from_param — arity-specialized wrappers with inline COERCE.
@@ -236,40 +389,40 @@ export function createLibraryClasses(Library, LRUCache, _toNativeType, _toNative
         switch (argCount) {
           case 1:
             callMethod = function (a0) {
-              if (arguments.length === 1) return ffiFunc.call(COERCE(a0));
+              if (arguments.length === 1) return nativeCall(COERCE(a0));
               const n = arguments.length,
                 arr = new Array(n);
               arr[0] = COERCE(a0);
               for (let i = 1; i < n; i++) arr[i] = arguments[i];
-              return ffiFunc.call(...arr);
+              return nativeCall(...arr);
             };
             break;
           case 2:
             callMethod = function (a0, a1) {
-              if (arguments.length === 2) return ffiFunc.call(COERCE(a0), COERCE(a1));
+              if (arguments.length === 2) return nativeCall(COERCE(a0), COERCE(a1));
               const n = arguments.length,
                 arr = new Array(n);
               arr[0] = COERCE(a0);
               arr[1] = COERCE(a1);
               for (let i = 2; i < n; i++) arr[i] = arguments[i];
-              return ffiFunc.call(...arr);
+              return nativeCall(...arr);
             };
             break;
           case 3:
             callMethod = function (a0, a1, a2) {
-              if (arguments.length === 3) return ffiFunc.call(COERCE(a0), COERCE(a1), COERCE(a2));
+              if (arguments.length === 3) return nativeCall(COERCE(a0), COERCE(a1), COERCE(a2));
               const n = arguments.length,
                 arr = new Array(n);
               arr[0] = COERCE(a0);
               arr[1] = COERCE(a1);
               arr[2] = COERCE(a2);
               for (let i = 3; i < n; i++) arr[i] = arguments[i];
-              return ffiFunc.call(...arr);
+              return nativeCall(...arr);
             };
             break;
           case 4:
             callMethod = function (a0, a1, a2, a3) {
-              if (arguments.length === 4) return ffiFunc.call(COERCE(a0), COERCE(a1), COERCE(a2), COERCE(a3));
+              if (arguments.length === 4) return nativeCall(COERCE(a0), COERCE(a1), COERCE(a2), COERCE(a3));
               const n = arguments.length,
                 arr = new Array(n);
               arr[0] = COERCE(a0);
@@ -277,12 +430,12 @@ export function createLibraryClasses(Library, LRUCache, _toNativeType, _toNative
               arr[2] = COERCE(a2);
               arr[3] = COERCE(a3);
               for (let i = 4; i < n; i++) arr[i] = arguments[i];
-              return ffiFunc.call(...arr);
+              return nativeCall(...arr);
             };
             break;
           case 5:
             callMethod = function (a0, a1, a2, a3, a4) {
-              if (arguments.length === 5) return ffiFunc.call(COERCE(a0), COERCE(a1), COERCE(a2), COERCE(a3), COERCE(a4));
+              if (arguments.length === 5) return nativeCall(COERCE(a0), COERCE(a1), COERCE(a2), COERCE(a3), COERCE(a4));
               const n = arguments.length,
                 arr = new Array(n);
               arr[0] = COERCE(a0);
@@ -291,12 +444,12 @@ export function createLibraryClasses(Library, LRUCache, _toNativeType, _toNative
               arr[3] = COERCE(a3);
               arr[4] = COERCE(a4);
               for (let i = 5; i < n; i++) arr[i] = arguments[i];
-              return ffiFunc.call(...arr);
+              return nativeCall(...arr);
             };
             break;
           case 6:
             callMethod = function (a0, a1, a2, a3, a4, a5) {
-              if (arguments.length === 6) return ffiFunc.call(COERCE(a0), COERCE(a1), COERCE(a2), COERCE(a3), COERCE(a4), COERCE(a5));
+              if (arguments.length === 6) return nativeCall(COERCE(a0), COERCE(a1), COERCE(a2), COERCE(a3), COERCE(a4), COERCE(a5));
               const n = arguments.length,
                 arr = new Array(n);
               arr[0] = COERCE(a0);
@@ -306,14 +459,14 @@ export function createLibraryClasses(Library, LRUCache, _toNativeType, _toNative
               arr[4] = COERCE(a4);
               arr[5] = COERCE(a5);
               for (let i = 6; i < n; i++) arr[i] = arguments[i];
-              return ffiFunc.call(...arr);
+              return nativeCall(...arr);
             };
             break;
           default:
             // > 6 args: rest params unavoidable, but still no processedArgs allocation
             callMethod = function (...args) {
               for (let i = 0; i < args.length; i++) args[i] = COERCE(args[i]);
-              return ffiFunc.call(...args);
+              return nativeCall(...args);
             };
         }
       } else {
@@ -323,7 +476,7 @@ export function createLibraryClasses(Library, LRUCache, _toNativeType, _toNative
           for (let i = 0; i < args.length; i++) {
             processedArgs[i] = applyParamProtocols(COERCE(args[i]), i);
           }
-          return ffiFunc.call(...processedArgs);
+          return nativeCall(...processedArgs);
         };
       }
 
@@ -401,21 +554,65 @@ export function createLibraryClasses(Library, LRUCache, _toNativeType, _toNative
         address: { value: ffiFunc.address },
         _ffi: { value: ffiFunc },
         callAsync: { value: asyncCallMethod, writable: false, enumerable: false, configurable: false },
+        // callBatch(argsColumns, count[, out]): una colonna TypedArray (o uno
+        // scalare ripetuto) per parametro, N chiamate in un solo crossing.
+        callBatch: {
+          value: (argsColumns, count, out) => ffiFunc.callBatch(argsColumns.map(COERCE), count, out),
+          writable: false,
+          enumerable: false,
+          configurable: false,
+        },
+        // mapAsync(argsColumns, count[, { concurrency, out }]): callBatch a
+        // chunk su più thread del pool, una sola Promise per tutto il batch
+        mapAsync: {
+          value: (argsColumns, count, options) => ffiFunc.mapAsync(argsColumns.map(COERCE), count, options),
+          writable: false,
+          enumerable: false,
+          configurable: false,
+        },
+        // submit(ring, tag, ...args): come callAsync, ma il risultato va nel
+        // completion ring (ctypes.completionRing) invece che in una Promise
+        submit: {
+          value: (ring, tag, ...args) => {
+            for (let i = 0; i < args.length; i++) args[i] = COERCE(args[i]);
+            return ffiFunc.submit(ring, tag, ...args);
+          },
+          writable: false,
+          enumerable: false,
+          configurable: false,
+        },
+        // Statistiche per-funzione (opzione `stats` o ctypes.setStatsEnabled)
+        getStats: { value: () => ffiFunc.getStats(), writable: false, enumerable: false, configurable: false },
+        resetStats: { value: () => ffiFunc.resetStats(), writable: false, enumerable: false, configurable: false },
+        // Opzione outParams: valori degli out param dell'ultima call (array riusato)
+        outValues: { value: ffiFunc.outValues, writable: false, enumerable: false, configurable: false },
         // Esponi errcheck come setter/getter
         errcheck: {
           get() {
             return ffiFunc._errcheck;
           },
+          // Un oggetto { fail, code, error } è una policy dichiarativa,
+          // valutata in nativo: la funzione JS è chiamata solo sul fallimento.
+          // Il nativo passa come `func` la FFIFunction: errcheck e factory
+          // ricevono invece callMethod, uguale per call sync e callAsync.
           set(callback) {
+            if (callback !== null && typeof callback === "object") {
+              const policy = resolveErrcheckPolicy(callback, name, winError);
+              const error = policy.error;
+              policy.error = (code, result, _ffi, args) => error(code, result, callMethod, args);
+              ffiFunc.setErrcheckPolicy(policy);
+              ffiFunc.setErrcheck(null);
+            } else {
+              ffiFunc.setErrcheck(typeof callback === "function" ? (result, _ffi, args) => callback(result, callMethod, args) : callback);
+              ffiFunc.setErrcheckPolicy(null);
+            }
             ffiFunc._errcheck = callback;
-            ffiFunc.setErrcheck(callback);
           },
           enumerable: false,
           configurable: true,
         },
       });
 
-      this._cache.set(cacheKey, callMethod);
       return callMethod;
     }
 
@@ -483,11 +680,8 @@ export function createLibraryClasses(Library, LRUCache, _toNativeType, _toNative
    * WinDLL - come CDLL ma con stdcall di default (per Windows)
    */
   class WinDLL extends CDLL {
-    func(name, returnType, argTypes = [], options = {}) {
-      return super.func(name, returnType, argTypes, {
-        abi: "stdcall",
-        ...options,
-      });
+    _defaultOptions(options) {
+      return { abi: "stdcall", ...options };
     }
   }
 
@@ -498,22 +692,28 @@ export function createLibraryClasses(Library, LRUCache, _toNativeType, _toNative
    * Python ctypes parity: `ctypes.OleDLL`.
    */
   class OleDLL extends WinDLL {
-    func(name, returnType, argTypes = [], options = {}) {
-      const fn = super.func(name, returnType, argTypes, options);
-
+    _finishFunction(name, returnType, fn) {
       // If the return type is tagged as HRESULT, install an errcheck that
       // throws on negative values (Python's OleDLL behavior).
       if (returnType && returnType._isHResult) {
         const prevErrcheck = fn.errcheck;
+        const hresultError = (n) => {
+          const hex = (n >>> 0).toString(16).padStart(8, "0").toUpperCase();
+          const err = new Error(`OleDLL '${name}' failed with HRESULT 0x${hex}`);
+          err.hresult = n;
+          err.winerror = n >>> 0;
+          return err;
+        };
+        if (!prevErrcheck) {
+          // Caso comune: policy nativa, nessuna call JS sui successi
+          fn.errcheck = { fail: "negative", error: hresultError };
+          return fn;
+        }
         fn.errcheck = (result, func, args) => {
           const r = prevErrcheck ? prevErrcheck(result, func, args) : result;
           const n = typeof r === "bigint" ? Number(r) : r;
           if (typeof n === "number" && n < 0) {
-            const hex = (n >>> 0).toString(16).padStart(8, "0").toUpperCase();
-            const err = new Error(`OleDLL '${name}' failed with HRESULT 0x${hex}`);
-            err.hresult = n;
-            err.winerror = n >>> 0;
-            throw err;
+            throw hresultError(n);
           }
           return r;
         };
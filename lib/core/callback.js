@@ -207,11 +207,37 @@ export function callback(fn, returnType, argTypes = [], native, abi = undefined)
  * @param {Function|Object|number} returnType - Return type (SimpleCData class, CType, or CType value)
  * @param {Array<Function|Object|number>} argTypes - Argument types array
  * @param {Object} native - Native module reference (internal use)
+ * @param {string|Object} [abi] - Calling convention, or an options object:
+ *   - `abi` (string): Calling convention
+ *   - `nonBlocking` (boolean): Fire-and-forget mode for `void` callbacks.
+ *     Calls from external threads copy their arguments into a lock-free ring
+ *     and return immediately; the main thread drains many records per wakeup.
+ *     String arguments are not allowed (the caller's memory may be gone by then).
+ *   - `batch` (boolean): With `nonBlocking`, call `fn` once per drained batch
+ *     with an array of argument arrays instead of once per record
+ *   - `capacity` (number): Ring size in records (default 4096). When full,
+ *     new events are dropped and counted in `dropped`: producers never wait
+ *     for the main thread, which may itself be blocked on them.
  * @returns {Object} Callback wrapper with properties:
  *   - `pointer` (BigInt): Function pointer to pass to C
+ *   - `dropped` (number): Events dropped because the ring was full (nonBlocking)
  *   - `release()`: Release native resources (MUST be called)
  *   - `_callback`: Internal callback object
  *
+ * @example Non-blocking event sink
+ * ```javascript
+ * import { threadSafeCallback, c_void, c_int32, c_double } from 'node-ctypes';
+ *
+ * const onEvent = threadSafeCallback(
+ *   (events) => {
+ *     for (const [id, value] of events) handle(id, value);
+ *   },
+ *   c_void,
+ *   [c_int32, c_double],
+ *   { nonBlocking: true, batch: true }
+ * );
+ * ```
+ *
  * @example Windows thread callback
  * ```javascript
  * import { WinDLL, threadSafeCallback, c_int, c_void_p } from 'node-ctypes';
@@ -268,14 +294,25 @@ export function callback(fn, returnType, argTypes = [], native, abi = undefined)
  * @see {@link callback} for main-thread-only callbacks
  */
 export function threadSafeCallback(fn, returnType, argTypes = [], native, abi = undefined) {
+  let options;
+  if (abi && typeof abi === "object") {
+    options = abi;
+    abi = options.abi;
+  }
   const args = [fn, _toNativeType(returnType, native), _toNativeTypes(argTypes, native)];
-  if (abi) args.push(abi);
+  if (abi || options) args.push(abi);
+  if (options) {
+    args.push({ nonBlocking: !!options.nonBlocking, batch: !!options.batch, capacity: options.capacity });
+  }
   const cb = new native.ThreadSafeCallback(...args);
 
   const wrapper = {
     get pointer() {
       return cb.pointer;
     },
+    get dropped() {
+      return cb.getDroppedCount();
+    },
     release() {
       cb.release();
     },
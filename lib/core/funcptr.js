@@ -64,6 +64,10 @@ import { callback as createCallback } from "./callback.js";
  * @private
  */
 function applyParamflags(rawFn, restype, argtypes, paramflags) {
+  // Out param nativi (opzione outParams): il native scrive i valori in un
+  // array riusato, niente Buffer per call e niente read-back da JS
+  const nativeOuts = rawFn.outValues;
+
   if (paramflags.length !== argtypes.length) {
     throw new TypeError(`paramflags length (${paramflags.length}) must match argtypes length (${argtypes.length})`);
   }
@@ -115,6 +119,12 @@ function applyParamflags(rawFn, restype, argtypes, paramflags) {
       rawArgs[input.idx] = value;
     }
 
+    if (nativeOuts) {
+      // Gli slot out restano undefined: li riempie il native
+      rawFn(...rawArgs);
+      return outputs.length === 1 ? nativeOuts[0] : Array.from(nativeOuts);
+    }
+
     // Allocate out-slots. `outType` può essere:
     //   - SimpleCData class: usa _size + _reader
     //   - Structure/Union class: usa .size (dalla structDef) + new T(buf)
@@ -165,12 +175,53 @@ function applyParamflags(rawFn, restype, argtypes, paramflags) {
   };
 }
 
+/**
+ * Opzione `outParams` per i paramflags "out": solo se ogni out punta a un
+ * SimpleCData che il native legge come il `_reader` JS (c_wchar torna un
+ * Number nativo, size_t un Number dal reader JS sui 32 bit). Altrimenti
+ * null e gli out restano sul path Buffer di applyParamflags.
+ * @private
+ */
+function nativeOutParams(paramflags, argtypes, native) {
+  const { CType } = native;
+  const eligible = new Set([
+    CType.INT8,
+    CType.UINT8,
+    CType.INT16,
+    CType.UINT16,
+    CType.INT32,
+    CType.UINT32,
+    CType.INT64,
+    CType.UINT64,
+    CType.FLOAT,
+    CType.DOUBLE,
+    CType.BOOL,
+    CType.POINTER,
+    CType.STRING,
+    CType.WSTRING,
+    CType.LONG,
+    CType.ULONG,
+  ]);
+  if (native.POINTER_SIZE === 8) {
+    eligible.add(CType.SIZE_T);
+    eligible.add(CType.SSIZE_T);
+  }
+  const outParams = [];
+  for (let i = 0; i < paramflags.length; i++) {
+    if (paramflags[i].dir !== "out") continue;
+    const t = argtypes[i]._pointerTo;
+    if (!t || !t._isSimpleCData || !eligible.has(t._type)) return null;
+    outParams.push({ index: i, type: t });
+  }
+  return outParams.length > 0 ? outParams : null;
+}
+
 /**
  * Attach a `.bind(library, name, paramflags)` method to a CFUNCTYPE/WINFUNCTYPE
  * factory, enabling Python-style typed binding with in/out params.
  * @private
  */
-function attachBind(factory, restype, argtypes, abi) {
+function attachBind(factory, restype, argtypes, abi, native) {
   factory.bind = function bindWithFlags(library, symbolName, paramflags) {
     // Validate paramflags up-front so shape errors surface before the symbol
     // lookup (which may fail for unrelated reasons like missing export).
@@ -186,7 +237,11 @@ function attachBind(factory, restype, argtypes, abi) {
         throw new TypeError(`paramflags[${i}] is "out" but argtype ${i} is not a POINTER(T)`);
       }
     }
-    const rawFn = library.func(symbolName, restype, argtypes, abi ? { abi } : {});
+    const outParams = nativeOutParams(paramflags, argtypes, native);
+    const rawFn = library.func(symbolName, restype, argtypes, {
+      ...(abi ? { abi } : {}),
+      ...(outParams ? { outParams } : {}),
+    });
     return applyParamflags(rawFn, restype, argtypes, paramflags);
   };
   return factory;
@@ -254,7 +309,7 @@ export function createCFUNCTYPE(native) {
     factory.restype = restype;
     factory.argtypes = argtypes;
     factory._isFuncPtr = true;
-    attachBind(factory, restype, argtypes, undefined);
+    attachBind(factory, restype, argtypes, undefined, native);
 
     return factory;
   };
@@ -322,7 +377,7 @@ export function createWINFUNCTYPE(native) {
     factory.restype = restype;
     factory.argtypes = argtypes;
     factory._isFuncPtr = true;
-    attachBind(factory, restype, argtypes, "stdcall");
+    attachBind(factory, restype, argtypes, "stdcall", native);
 
     return factory;
   };
@@ -0,0 +1,350 @@
+/**
+ * @file manifest.js
+ * @module core/manifest
+ * @description Binding manifest serializzabili: layout di struct / union /
+ * array e signature di funzioni, generati una volta (es. a build time) e
+ * ricaricati all'avvio senza rieseguire `addField` né ricalcolare i layout.
+ *
+ * Il manifest è un plain object JSON-serializzabile, quindi può essere
+ * scritto su file, incluso in un bundle o in un blob SEA / snapshot.
+ * È legato alla piattaforma che lo ha generato (dimensione di puntatori,
+ * `wchar_t` e `long`): il caricamento altrove viene rifiutato.
+ *
+ * Tra Worker thread dello stesso processo `shareBindings` / `attachBindings`
+ * evitano anche la ricostruzione: gli environment condividono gli stessi
+ * layout nativi (e quindi i CIF) tramite un token clonabile.
+ *
+ * @example Generazione (build time)
+ * ```javascript
+ * import { createManifest, c_int, c_double } from 'node-ctypes';
+ * import { writeFileSync } from 'node:fs';
+ *
+ * const manifest = createManifest({
+ *   types: { Point, Rect },
+ *   functions: [{ name: 'area', restype: c_double, argtypes: [Rect] }],
+ * });
+ * writeFileSync('bindings.json', JSON.stringify(manifest));
+ * ```
+ *
+ * @example Caricamento (startup)
+ * ```javascript
+ * const loaded = loadManifest(JSON.parse(readFileSync('bindings.json', 'utf8')), { Point, Rect });
+ * const { area } = loaded.bind(lib);
+ * ```
+ */
+
+/**
+ * Def JS (structDef / unionDef) di un tipo struct, o null.
+ * @private
+ */
+function structDefOf(type) {
+  if (typeof type === "function" && typeof type._buildStruct === "function") {
+    return type._structDef || type._buildStruct();
+  }
+  if (typeof type === "function" && typeof type._buildUnion === "function") {
+    return type._unionDef || type._buildUnion();
+  }
+  if (type && typeof type === "object" && type._isStructType && Array.isArray(type.fields)) {
+    return type;
+  }
+  return null;
+}
+
+/**
+ * Campi della def JS così come li vede il tipo nativo: stesso ordine e
+ * stessi nomi sintetici di _buildNativeStructType (una cella
+ * `__bitfield@offset` per gruppo di bitfield).
+ * @private
+ */
+function nativeFieldsOf(def, native) {
+  const fields = [];
+  const bitfieldCells = new Set();
+  for (const f of def.fields) {
+    if (f.isBitField) {
+      const cellKey = `${f.offset}:${f.baseSize}`;
+      if (bitfieldCells.has(cellKey)) continue;
+      bitfieldCells.add(cellKey);
+      fields.push({ name: `__bitfield@${f.offset}`, offset: f.offset, type: f.type, anonymous: false });
+      continue;
+    }
+    const type = f.isPointer ? native.CType.POINTER : f.type;
+    fields.push({ name: f.name, offset: f.offset, type, anonymous: !!f.isAnonymous });
+  }
+  return fields;
+}
+
+/**
+ * Confronta un tipo JS (CType, SimpleCData, struct / union, array) con
+ * il riferimento `ref` di un campo descritto da describeTypes.
+ * @private
+ */
+function typeMatches(type, ref, described, native) {
+  if (typeof type === "number") return ref === type;
+  if (typeof type === "function" && type._isSimpleCData) return ref === type._type;
+  if (type && typeof type === "object" && type._pointerTo !== undefined) return ref === native.CType.POINTER;
+  if (typeof ref !== "object" || ref === null) return false;
+
+  const entry = described[ref.ref];
+  const def = structDefOf(type);
+  if (def) return layoutMatches(def, entry, described, native);
+  if (type && type._isArrayType) {
+    return entry?.kind === "array" && entry.length === type.length && typeMatches(type.elementType, entry.element, described, native);
+  }
+  // Tipo nativo (StructType / ArrayType) usato direttamente nella def
+  if (type && typeof type.getSize === "function") {
+    const own = native.describeTypes([type]);
+    return JSON.stringify(expandRef(own.types, { ref: own.roots[0] })) === JSON.stringify(expandRef(described, ref));
+  }
+  return false;
+}
+
+/**
+ * Riferimento di describeTypes con i `{ ref }` sostituiti dai tipi
+ * descritti, per confrontare due descrizioni indipendenti.
+ * @private
+ */
+function expandRef(described, ref) {
+  if (typeof ref !== "object" || ref === null) return ref;
+  const { fields, element, ...entry } = described[ref.ref] ?? {};
+  if (fields) entry.fields = fields.map((f) => ({ ...f, type: expandRef(described, f.type) }));
+  if (element !== undefined) entry.element = expandRef(described, element);
+  return entry;
+}
+
+/**
+ * Layout della def JS == entry di describeTypes: kind, size, e per ogni
+ * campo nome, offset e tipo (ricorsivamente per nested e array).
+ * @private
+ */
+function layoutMatches(def, entry, described, native) {
+  if (!entry || entry.kind !== (def.isUnion ? "union" : "struct") || entry.size !== def.size) {
+    return false;
+  }
+  const expected = nativeFieldsOf(def, native);
+  if (expected.length !== entry.fields.length) {
+    return false;
+  }
+  return expected.every((f, i) => {
+    const actual = entry.fields[i];
+    return (
+      actual.name === f.name &&
+      actual.offset === f.offset &&
+      !!actual.anonymous === f.anonymous &&
+      typeMatches(f.type, actual.type, described, native)
+    );
+  });
+}
+
+/**
+ * Raccoglie i tipi nativi di una spec di createManifest / shareBindings:
+ * ogni struct / union / array compare una volta sola in `nativeTypes`.
+ * @private
+ */
+function collectTypes(spec, _toNativeType, native, caller) {
+  const { types = {}, functions = [] } = spec ?? {};
+  const nativeTypes = [];
+  const slotOf = new Map();
+
+  // Tipo → valore nel manifest: CType numerico, o slot in nativeTypes
+  const collect = (type, what) => {
+    const nt = _toNativeType(type, native);
+    if (typeof nt === "number") return nt;
+    if (!nt || typeof nt !== "object" || (typeof nt.addField !== "function" && typeof nt.getLength !== "function")) {
+      throw new TypeError(`${caller}: ${what} is not a C type`);
+    }
+    if (!slotOf.has(nt)) {
+      slotOf.set(nt, nativeTypes.length);
+      nativeTypes.push(nt);
+    }
+    return { slot: slotOf.get(nt) };
+  };
+
+  const namedSlots = {};
+  for (const [name, type] of Object.entries(types)) {
+    const ref = collect(type, `type '${name}'`);
+    if (typeof ref === "number") {
+      throw new TypeError(`${caller}: type '${name}' must be a struct, union or array`);
+    }
+    namedSlots[name] = ref.slot;
+  }
+
+  const fnSlots = functions.map((f) => {
+    if (!f || typeof f.name !== "string") {
+      throw new TypeError(`${caller}: every function requires a string name`);
+    }
+    return {
+      restype: collect(f.restype, `restype of '${f.name}'`),
+      argtypes: (f.argtypes ?? []).map((t, i) => collect(t, `argtypes[${i}] of '${f.name}'`)),
+    };
+  });
+
+  return { nativeTypes, namedSlots, fnSlots, functions };
+}
+
+/**
+ * Genera un binding manifest.
+ *
+ * @param {Object} spec
+ * @param {Object<string, Function|Object>} [spec.types] - Tipi con nome
+ *   (Structure / Union class, struct() / union() def, array())
+ * @param {Array<{name: string, restype: *, argtypes?: Array, options?: Object}>} [spec.functions]
+ *   Signature da legare con `loadManifest(...).bind(lib)`; `options` deve
+ *   essere JSON-serializzabile
+ * @param {Function} _toNativeType - Conversione tipo → native
+ * @param {Object} native - Modulo native
+ * @returns {Object} Manifest JSON-serializzabile
+ */
+export function createManifest(spec, _toNativeType, native) {
+  const { nativeTypes, namedSlots, fnSlots, functions } = collectTypes(spec, _toNativeType, native, "createManifest");
+
+  const { roots, ...manifest } = native.describeTypes(nativeTypes);
+  const toRef = (v) => (typeof v === "number" ? v : { ref: roots[v.slot] });
+
+  manifest.names = {};
+  for (const [name, slot] of Object.entries(namedSlots)) {
+    manifest.names[name] = roots[slot];
+  }
+  manifest.functions = functions.map((f, i) => ({
+    name: f.name,
+    restype: toRef(fnSlots[i].restype),
+    argtypes: fnSlots[i].argtypes.map(toRef),
+    ...(f.options ? { options: f.options } : {}),
+  }));
+  return manifest;
+}
+
+/**
+ * Carica un binding manifest: ricostruisce i tipi nativi in una sola
+ * chiamata e li associa alle def JS passate in `bindings`, così che
+ * `func()` / `bindAll()` / struct-by-value li trovino già pronti.
+ *
+ * @param {Object} manifest - Output di createManifest (anche dopo JSON round-trip)
+ * @param {Object<string, Function|Object>} [bindings] - Structure / Union
+ *   class o def per nome, come in `createManifest({ types })`
+ * @param {Object} native - Modulo native
+ * @returns {{types: Object<string, Object>, bind: Function}} Tipi nativi
+ *   per nome e `bind(lib)` che lega le funzioni del manifest
+ */
+export function loadManifest(manifest, bindings, native) {
+  return bindLoaded(native.loadTypes(manifest), manifest, bindings, "loadManifest", native);
+}
+
+/**
+ * Associa i tipi nativi caricati (loadTypes / importBindings) alle def JS
+ * e prepara `bind(lib)`.
+ * @private
+ */
+function bindLoaded(loaded, manifest, bindings, caller, native) {
+  const names = manifest.names ?? {};
+  const boundByIndex = new Map();
+  let described = null;
+
+  const types = {};
+  for (const [name, index] of Object.entries(names)) {
+    types[name] = loaded[index];
+  }
+
+  for (const [name, type] of Object.entries(bindings ?? {})) {
+    if (!(name in names)) {
+      throw new Error(`${caller}: type '${name}' is not in the manifest`);
+    }
+    const def = structDefOf(type);
+    if (!def) {
+      throw new TypeError(`${caller}: binding '${name}' must be a Structure / Union class or a struct() / union() def`);
+    }
+    const nt = loaded[names[name]];
+    if (typeof nt.addField !== "function") {
+      throw new Error(`${caller}: layout of '${name}' does not match the manifest`);
+    }
+    // Descrizione nativa di tutti i tipi caricati, calcolata una volta sola
+    described ??= native.describeTypes(loaded);
+    if (!layoutMatches(def, described.types[described.roots[names[name]]], described.types, native)) {
+      throw new Error(`${caller}: layout of '${name}' does not match the manifest`);
+    }
+    // Stessa cache di _buildNativeStructType: niente addField per questa def
+    if (!def._nativeStructType) {
+      def._nativeStructType = nt;
+    }
+    boundByIndex.set(names[name], type);
+  }
+
+  // Un tipo legato a una def JS resta quello (wrapper, lazy_struct, ...);
+  // gli altri passano come StructType / ArrayType nativi
+  const resolve = (ref) => (typeof ref === "number" ? ref : (boundByIndex.get(ref.ref) ?? loaded[ref.ref]));
+  const functions = manifest.functions ?? [];
+
+  return {
+    types,
+    bind(lib) {
+      return lib.bindAll(
+        functions.map((f) => ({
+          name: f.name,
+          restype: resolve(f.restype),
+          argtypes: (f.argtypes ?? []).map(resolve),
+          ...(f.options ? { options: f.options } : {}),
+        })),
+      );
+    },
+  };
+}
+
+/**
+ * Pubblica tipi e signature per gli altri Worker thread del processo.
+ *
+ * I layout nativi diventano immutabili e condivisi: un Worker che chiama
+ * `attachBindings(token)` ottiene wrapper sugli stessi StructInfo /
+ * ArrayInfo (nessun addField, nessun ricalcolo) e, legando le funzioni,
+ * riusa i CIF già preparati. Le librerie aperte con lo stesso path sono
+ * comunque condivise a livello di processo.
+ *
+ * Il token è un plain object clonabile (postMessage / workerData). Resta
+ * valido finché non viene passato a `releaseBindings` o finché vive
+ * l'environment che lo ha creato.
+ *
+ * @param {Object} spec - Come createManifest: `{ types, functions }`
+ * @param {Function} _toNativeType - Conversione tipo → native
+ * @param {Object} native - Modulo native
+ * @returns {{id: number, names: Object<string, number>, functions: Array}} Token
+ */
+export function shareBindings(spec, _toNativeType, native) {
+  const { nativeTypes, namedSlots, fnSlots, functions } = collectTypes(spec, _toNativeType, native, "shareBindings");
+  const id = native.exportBindings(nativeTypes);
+  const toRef = (v) => (typeof v === "number" ? v : { ref: v.slot });
+
+  return {
+    id,
+    names: namedSlots,
+    functions: functions.map((f, i) => ({
+      name: f.name,
+      restype: toRef(fnSlots[i].restype),
+      argtypes: fnSlots[i].argtypes.map(toRef),
+      ...(f.options ? { options: f.options } : {}),
+    })),
+  };
+}
+
+/**
+ * Adotta in questo environment i tipi di un token di shareBindings.
+ * Stessa interfaccia di loadManifest: `bindings` associa le def JS del
+ * Worker ai layout condivisi.
+ *
+ * @param {Object} token - Output di shareBindings
+ * @param {Object<string, Function|Object>} [bindings]
+ * @param {Object} native - Modulo native
+ * @returns {{types: Object<string, Object>, bind: Function}}
+ */
+export function attachBindings(token, bindings, native) {
+  if (!token || typeof token.id !== "number") {
+    throw new TypeError("attachBindings: invalid binding token");
+  }
+  return bindLoaded(native.importBindings(token.id), token, bindings, "attachBindings", native);
+}
+
+/**
+ * Revoca un token: nuovi attachBindings falliscono, chi lo ha già
+ * adottato continua a funzionare.
+ * @returns {boolean} false se il token era già stato revocato
+ */
+export function releaseBindings(token, native) {
+  return native.releaseBindings(typeof token === "number" ? token : token?.id);
+}
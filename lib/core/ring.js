@@ -0,0 +1,235 @@
+/**
+ * @file ring.js
+ * @module core/ring
+ * @description Completion ring for Promise-free asynchronous calls.
+ *
+ * `fn.callAsync()` allocates a Promise per call and settles it with a
+ * microtask on the main thread; at high call rates that bookkeeping, not the
+ * worker pool, is the bottleneck. `fn.submit(ring, tag, ...args)` runs the
+ * same call on the pool, but the worker writes `tag`, status and return value
+ * straight into a SharedArrayBuffer-backed ring. JS consumes the records in
+ * batches with `ring.drain(fn)`, woken either by `await ring.wait()`
+ * (Atomics.waitAsync) or by a single `onBatch` callback per pool drain.
+ *
+ * Record values are decoded from the function's return type: numbers,
+ * BigInts (64-bit types), booleans, and addresses for pointer and string
+ * returns (`c_char_p` / `c_wchar_p` results are delivered as addresses: read
+ * them with `string_at` / `wstring_at`). Struct, union and array returns are
+ * not supported, and `errcheck` is not applied.
+ *
+ * The ring never overflows: `submit()` throws a RangeError when calls in
+ * flight plus unread records would exceed `capacity`.
+ *
+ * @example Awaiting batches
+ * ```javascript
+ * import { completionRing } from 'node-ctypes';
+ *
+ * const ring = completionRing({ capacity: 256 });
+ * for (let i = 0; i < 100; i++) lib.hash_block.submit(ring, i, blocks[i]);
+ *
+ * let done = 0;
+ * while (done < 100) {
+ *   await ring.wait();
+ *   done += ring.drain((tag, value, error) => { results[tag] = value; });
+ * }
+ * ```
+ *
+ * @example One callback per batch
+ * ```javascript
+ * const ring = completionRing({
+ *   onBatch: (r) => r.drain((tag, value) => handle(tag, value)),
+ * });
+ * ```
+ */
+
+// Layout: vedi src/ring.h
+const HEADER_SIZE = 64;
+const RECORD_SIZE = 32;
+const WRITE = 0;
+const READ = 1;
+
+const FORMAT_VOID = 0;
+const FORMAT_DOUBLE = 1;
+const FORMAT_INT = 2;
+const FORMAT_UINT = 3;
+const FORMAT_BIGINT = 4;
+const FORMAT_BIGUINT = 5;
+const FORMAT_INT_NUMBER = 6;
+const FORMAT_UINT_NUMBER = 7;
+const FORMAT_BOOL = 8;
+const FORMAT_POINTER = 9;
+const FORMAT_POINTER_NUMBER = 10;
+
+const MAX_SAFE = BigInt(Number.MAX_SAFE_INTEGER);
+const MIN_SAFE = BigInt(Number.MIN_SAFE_INTEGER);
+
+/**
+ * Decodes the value field of the record at byte offset `offset`.
+ * @private
+ */
+function decodeValue(data, offset, format) {
+  const at = offset + 16;
+  switch (format) {
+    case FORMAT_VOID:
+      return undefined;
+    case FORMAT_DOUBLE:
+      return data.getFloat64(at, true);
+    case FORMAT_INT:
+      return data.getInt32(at, true);
+    case FORMAT_UINT:
+      return data.getUint32(at, true);
+    case FORMAT_BIGINT:
+      return data.getBigInt64(at, true);
+    case FORMAT_BIGUINT:
+      return data.getBigUint64(at, true);
+    case FORMAT_INT_NUMBER: {
+      const v = data.getBigInt64(at, true);
+      return v >= MIN_SAFE && v <= MAX_SAFE ? Number(v) : v;
+    }
+    case FORMAT_UINT_NUMBER: {
+      const v = data.getBigUint64(at, true);
+      return v <= MAX_SAFE ? Number(v) : v;
+    }
+    case FORMAT_BOOL:
+      return data.getUint8(at) !== 0;
+    case FORMAT_POINTER: {
+      const v = data.getBigUint64(at, true);
+      return v === 0n ? null : v;
+    }
+    case FORMAT_POINTER_NUMBER: {
+      const v = data.getBigUint64(at, true);
+      if (v === 0n) {
+        return null;
+      }
+      return v <= MAX_SAFE ? Number(v) : v;
+    }
+    default:
+      throw new Error(`completion ring: unknown value format ${format}`);
+  }
+}
+
+/**
+ * Adds the JS-only helpers to the native CompletionRing prototype (once).
+ * @private
+ */
+function installRingHelpers(CompletionRing) {
+  const proto = CompletionRing.prototype;
+  if (proto._ctypesHelpers) {
+    return;
+  }
+
+  Object.defineProperties(proto, {
+    _ctypesHelpers: { value: true },
+
+    /**
+     * Calls `fn(tag, value, error)` for every published record, oldest
+     * first, and marks them as read. `error` is an Error when the native
+     * call threw, otherwise undefined. Returns the number of records
+     * consumed. If `fn` throws, the records before the failing one stay
+     * consumed.
+     */
+    drain: {
+      value: function drain(fn) {
+        if (typeof fn !== "function") {
+          throw new TypeError("ring.drain: callback must be a function");
+        }
+        const view = this._view;
+        const data = this._data;
+        const capacity = view[2];
+        const write = Atomics.load(view, WRITE);
+        let read = view[READ];
+        const count = (write - read) >>> 0;
+        try {
+          while (read !== write) {
+            const offset = HEADER_SIZE + (read >>> 0) % capacity * RECORD_SIZE;
+            const tag = data.getFloat64(offset, true);
+            const status = data.getInt32(offset + 8, true);
+            read = (read + 1) | 0;
+            if (status !== 0) {
+              fn(tag, undefined, new Error("Native function threw an exception"));
+            } else {
+              fn(tag, decodeValue(data, offset, data.getInt32(offset + 12, true)), undefined);
+            }
+          }
+        } finally {
+          Atomics.store(view, READ, read);
+        }
+        return count;
+      },
+    },
+
+    /**
+     * Resolves with the number of unread records once there is at least
+     * one (immediately if some are already unread). With `timeout` (ms)
+     * the Promise can also resolve with 0.
+     */
+    wait: {
+      value: function wait(timeout) {
+        const view = this._view;
+        const write = Atomics.load(view, WRITE);
+        const unread = (write - view[READ]) >>> 0;
+        if (unread > 0) {
+          return Promise.resolve(unread);
+        }
+        const result = Atomics.waitAsync(view, WRITE, write, timeout);
+        const settle = () => (Atomics.load(view, WRITE) - view[READ]) >>> 0;
+        if (!result.async) {
+          return Promise.resolve(settle());
+        }
+        if (timeout === undefined || timeout === Infinity) {
+          // Le call in volo tengono vivo il loop (il pool è referenziato)
+          return result.value.then(settle);
+        }
+        // Il timeout di waitAsync non tiene vivo il loop: lo fa un timer
+        const keepAlive = setTimeout(() => {}, timeout);
+        return result.value.then(() => {
+          clearTimeout(keepAlive);
+          return settle();
+        });
+      },
+    },
+
+    /** Records published but not drained yet. */
+    pending: {
+      get() {
+        return (Atomics.load(this._view, WRITE) - this._view[READ]) >>> 0;
+      },
+    },
+
+    /** The SharedArrayBuffer backing the ring (layout in src/ring.h). */
+    buffer: {
+      get() {
+        return this._view.buffer;
+      },
+    },
+  });
+}
+
+/**
+ * Creates a completion ring for `fn.submit(ring, tag, ...args)`.
+ *
+ * @param {Object} [options]
+ * @param {number} [options.capacity=1024] - Records in the ring: the
+ *   maximum of calls in flight plus completions not drained yet
+ * @param {Function} [options.onBatch] - Called with the ring once per pool
+ *   drain that completed at least one of its calls
+ * @param {Object} native - Native module reference
+ * @returns {Object} CompletionRing with `drain`, `wait`, `pending`,
+ *   `inflight`, `capacity` and `buffer`
+ */
+export function completionRing(options, native) {
+  const { capacity = 1024, onBatch } = options ?? {};
+  if (!Number.isInteger(capacity) || capacity < 1 || capacity > 0x3fffffff / RECORD_SIZE) {
+    throw new RangeError("completionRing: capacity must be a positive integer");
+  }
+  installRingHelpers(native.CompletionRing);
+
+  const sab = new SharedArrayBuffer(HEADER_SIZE + capacity * RECORD_SIZE);
+  const view = new Int32Array(sab);
+  const ring = new native.CompletionRing(view, onBatch);
+  Object.defineProperties(ring, {
+    _view: { value: view },
+    _data: { value: new DataView(sab) },
+  });
+  return ring;
+}
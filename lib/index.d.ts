@@ -141,6 +141,13 @@ export class Library {
   func<TRet extends AnyType, const TArgs extends readonly AnyType[]>(name: string, returnType: TRet, argTypes: TArgs, options?: FunctionOptions): TypedFFIFunction<TArgs, TRet>;
   func(name: string, returnType: AnyType, argTypes?: AnyType[], options?: FunctionOptions): FFIFunction;
 
+  /**
+   * Resolve and prepare a batch of functions in a single native call.
+   * `restype` / `argtypes` must already be native types (see {@link CDLL.bindAll}).
+   * @returns One FFIFunction per entry, in order
+   */
+  bindAll(manifest: Array<{ name: string; restype: AnyType; argtypes?: AnyType[]; options?: FunctionOptions }>): FFIFunction[];
+
   /**
    * Get the address of a symbol in the library.
    * @param name - Symbol name
@@ -165,6 +172,123 @@ export class Library {
 export interface FunctionOptions {
   /** Calling convention. Defaults to `"cdecl"` for CDLL, `"stdcall"` for WinDLL. */
   abi?: "cdecl" | "stdcall" | "fastcall" | "thiscall" | "default";
+  /**
+   * Run `callAsync` of this function on its own serial queue of the call
+   * pool (one call at a time, in call order). Ignored when the library was
+   * opened with `serial: true`; `false` opts out of the library queue.
+   */
+  serial?: boolean;
+  /** Explicit serial queue, shared with other functions. See {@link createSerialQueue}. */
+  queue?: SerialQueue;
+  /**
+   * Struct/union return types only: return a lazy view over a Buffer copy of
+   * the returned bytes (same wrapper as `new T(buf)` / `def.create()`), so
+   * fields are decoded only when read. `errcheck` receives the view.
+   */
+  lazy_struct?: boolean;
+  /** Record per-call statistics for this function. See {@link FunctionStats}. */
+  stats?: boolean;
+  /**
+   * How pointer, `size_t`, 64-bit and `long` return values reach JS.
+   * `"bigint"` (default) always returns a BigInt. `"number"` returns a Number
+   * when the value is exact in a double (up to 2^53, which covers every
+   * user-space address on current 64-bit platforms). A pointer beyond that
+   * becomes an opaque {@link PointerHandle}, and an integer beyond that stays
+   * a BigInt.
+   */
+  pointerMode?: PointerMode;
+  /**
+   * Native out parameters. Every entry names a pointer argument (`index`)
+   * and the primitive type it points to. The call ignores the JS value of
+   * that argument (pass `undefined`) and gives the function a pointer to a
+   * zeroed per-function cell instead. After the call, the pointed-to values
+   * are available in `fn.outValues`, so the call allocates no Buffer.
+   * Sync calls only: `callAsync` and `callBatch` reject such functions.
+   * `CFUNCTYPE(...).bind(lib, name, paramflags)` uses this automatically
+   * for primitive `"out"` params.
+   */
+  outParams?: Array<{ index: number; type: AnyType }>;
+}
+
+/**
+ * Representation of pointer and 64-bit return values. See {@link FunctionOptions.pointerMode}.
+ * @category Library Loading
+ */
+export type PointerMode = "bigint" | "number";
+
+/**
+ * Opaque pointer returned in `pointerMode: "number"` when the address does
+ * not fit in a Number. Every pointer argument accepts it as is (function
+ * arguments, readValue / writeValue, ptrToBuffer), and {@link addressOf}
+ * converts it to a BigInt.
+ * @category Library Loading
+ */
+export type PointerHandle = object & { readonly __pointerHandle: unique symbol };
+
+/**
+ * Time spent in one phase of a call.
+ * @category Library Loading
+ */
+export interface PhaseStats {
+  /** Total nanoseconds */
+  totalNs: number;
+  /** Log2 histogram: bucket `i` counts calls in `[2^i, 2^(i+1))` ns, the last bucket is open-ended */
+  histogram: number[];
+}
+
+/**
+ * Per-function call statistics, recorded when enabled with the `stats`
+ * option (function or library) or {@link setStatsEnabled}.
+ * While stats are recorded, calls bypass the specialized trampoline so every
+ * phase is timed; `callAsync` calls are counted but not timed.
+ * @category Library Loading
+ */
+export interface FunctionStats {
+  name: string;
+  address: bigint;
+  /** Whether statistics are currently being recorded */
+  enabled: boolean;
+  calls: number;
+  /** Calls that use the specialized trampoline when stats are off */
+  trampolineCalls: number;
+  asyncCalls: number;
+  /** Number of `callBatch` invocations (not elements) */
+  batchCalls: number;
+  /** Calls that had to grow the long-string buffer */
+  stringBufferGrowths: number;
+  /** By-value structs/arrays that did not fit the preallocated aggregate arena (heap fallback) */
+  largeArgOverflows: number;
+  /** Argument marshalling, including variadic CIF setup */
+  marshal: PhaseStats;
+  /** `ffi_call` plus errno / last-error capture */
+  ffiCall: PhaseStats;
+  /** Return conversion plus `errcheck` */
+  finalize: PhaseStats;
+  total: PhaseStats;
+  /** Variadic CIF cache counters (not cleared by `resetStats`) */
+  variadicCacheHits: number;
+  variadicCacheMisses: number;
+}
+
+/**
+ * Opaque handle of a call-pool serial queue.
+ * @category Library Loading
+ */
+export type SerialQueue = { readonly __brand: "SerialQueue" };
+
+/**
+ * Snapshot of the native worker pool used by `callAsync`.
+ * @category Library Loading
+ */
+export interface CallPoolStats {
+  /** Worker threads (configured size if the pool has not started yet) */
+  threads: number;
+  /** Calls submitted since startup */
+  submitted: number;
+  /** Calls whose native part has finished */
+  completed: number;
+  /** Calls whose Promise has not been settled yet */
+  pending: number;
 }
 
 /**
@@ -181,6 +305,61 @@ export interface FunctionOptions {
  */
 export type ErrcheckCallback = (result: any, func: CallableFunction, args: any[]) => any;
 
+/**
+ * Declarative errcheck, evaluated natively after every call: JS runs only
+ * when the call fails, to build the error that is thrown (or rejected by
+ * `callAsync`). Not applied by `callBatch` and `submit`.
+ *
+ * @example
+ * ```javascript
+ * const libc = new CDLL(LIBC, { use_errno: true });
+ * const close = libc.func("close", c_int, [c_int]);
+ * close.errcheck = { fail: "minusOne", code: "errno" }; // throws OSError-like errors
+ * ```
+ *
+ * @category Library Loading
+ */
+export interface ErrcheckPolicy {
+  /**
+   * When the call failed: `"nonzero"` (status codes), `"zero"` (BOOL,
+   * handles, NULL pointers), `"negative"` (HRESULT, `-errno` returns) or
+   * `"minusOne"` (POSIX calls that set errno).
+   */
+  fail: "nonzero" | "zero" | "negative" | "minusOne";
+  /**
+   * Code passed to `error`: the return value (default), the errno captured
+   * with `use_errno`, or the last error captured with `use_last_error`.
+   */
+  code?: "result" | "errno" | "lastError";
+  /**
+   * Builds the error to throw. Defaults to an Error with `.errno` / `.code`
+   * for `"errno"`, {@link WinError} for `"lastError"` on Windows, and an
+   * Error with `.result` otherwise.
+   */
+  error?: (code: any, result: any, func: CallableFunction, args: any[]) => Error;
+}
+
+/**
+ * Options for {@link FFIFunction.mapAsync}.
+ *
+ * @category Library Loading
+ */
+export interface MapAsyncOptions {
+  /** Number of chunks run in parallel (default: the call pool size). */
+  concurrency?: number;
+  /** TypedArray receiving the return values (at least `count` elements). */
+  out?: ArrayBufferView;
+}
+
+/**
+ * One argument column for {@link FFIFunction.callBatch}: a TypedArray whose
+ * element type matches the parameter (same element size, integer vs float),
+ * or a scalar repeated for every call.
+ *
+ * @category Library Loading
+ */
+export type BatchColumn = ArrayBufferView | number | bigint | Buffer | null;
+
 /**
  * A callable FFI function returned by {@link Library.func} or {@link CDLL.func}.
  * @category Library Loading
@@ -192,6 +371,54 @@ export interface FFIFunction {
   /** Call the native function asynchronously on a worker thread. */
   callAsync(...args: any[]): Promise<any>;
 
+  /**
+   * Call the function `count` times in a single native crossing.
+   * Only primitive argument/return types are supported; `errcheck` is not
+   * applied per element.
+   *
+   * @param argsColumns - One {@link BatchColumn} per declared argument
+   * @param count - Number of calls
+   * @param out - Optional TypedArray receiving the return values
+   * @returns `out` (or a new TypedArray), `undefined` for void functions
+   */
+  callBatch(argsColumns: BatchColumn[], count: number, out?: ArrayBufferView): ArrayBufferView | undefined;
+
+  /**
+   * Parallel {@link FFIFunction.callBatch}: the batch is split into
+   * `concurrency` chunks (default: the call pool size) that run on several
+   * pool threads. Functions on a serial queue run as a single chunk.
+   * `errcheck` is not applied and errno / last error are not captured.
+   *
+   * @param argsColumns - One {@link BatchColumn} per declared argument;
+   *   columns must not be modified until the Promise settles
+   * @param count - Number of calls
+   * @returns Promise of `options.out` (or a new TypedArray), `undefined`
+   *   for void functions
+   */
+  mapAsync(argsColumns: BatchColumn[], count: number, options?: MapAsyncOptions): Promise<ArrayBufferView | undefined>;
+
+  /**
+   * Run the call on the worker pool like `callAsync`, but publish `tag` and
+   * the result to `ring` instead of settling a Promise. Only primitive,
+   * pointer and string return types; `errcheck` is not applied.
+   *
+   * @throws RangeError if the ring has no free record (drain it first)
+   */
+  submit(ring: CompletionRing, tag: number, ...args: any[]): void;
+
+  /** Call statistics of this function (all zero unless stats are enabled). */
+  getStats(): FunctionStats;
+
+  /** Clear the call statistics of this function. */
+  resetStats(): void;
+
+  /**
+   * With {@link FunctionOptions.outParams}: the values of the out parameters
+   * written by the last call, in `outParams` order. The same array is reused
+   * by every call. `undefined` otherwise.
+   */
+  readonly outValues: any[] | undefined;
+
   /** The function name in the native library. */
   readonly funcName: string;
 
@@ -199,10 +426,11 @@ export interface FFIFunction {
   readonly address: bigint;
 
   /**
-   * Error checking callback, called after every invocation.
+   * Error checking callback, called after every invocation, or a
+   * declarative {@link ErrcheckPolicy} checked natively.
    * @see {@link ErrcheckCallback}
    */
-  errcheck: ErrcheckCallback | null;
+  errcheck: ErrcheckCallback | ErrcheckPolicy | null;
 }
 
 /**
@@ -217,9 +445,15 @@ export interface FFIFunction {
 export interface TypedFFIFunction<TArgs extends readonly AnyType[], TRet extends AnyType> {
   (...args: ArgsFromCTypes<TArgs>): JsFromCType<TRet>;
   callAsync(...args: ArgsFromCTypes<TArgs>): Promise<JsFromCType<TRet>>;
+  callBatch(argsColumns: BatchColumn[], count: number, out?: ArrayBufferView): ArrayBufferView | undefined;
+  mapAsync(argsColumns: BatchColumn[], count: number, options?: MapAsyncOptions): Promise<ArrayBufferView | undefined>;
+  submit(ring: CompletionRing, tag: number, ...args: ArgsFromCTypes<TArgs>): void;
+  getStats(): FunctionStats;
+  resetStats(): void;
+  readonly outValues: any[] | undefined;
   readonly funcName: string;
   readonly address: bigint;
-  errcheck: ErrcheckCallback | null;
+  errcheck: ErrcheckCallback | ErrcheckPolicy | null;
 }
 
 /**
@@ -277,6 +511,33 @@ export interface LibraryOptions {
    * Python ctypes parity: `use_errno=True` on CDLL.
    */
   use_errno?: boolean;
+
+  /** Record call statistics for every function of this library. See {@link FunctionStats}. */
+  stats?: boolean;
+
+  /** Default {@link FunctionOptions.pointerMode} for every function of this library. */
+  pointerMode?: PointerMode;
+
+  /**
+   * If true, every `callAsync` of this library runs on a single serial
+   * queue of the call pool. Use it for libraries that are not thread-safe.
+   */
+  serial?: boolean;
+}
+
+/**
+ * One entry of a {@link CDLL.bindAll} manifest.
+ * @category Library Loading
+ */
+export interface BindManifestEntry {
+  /** Exported symbol name */
+  name: string;
+  /** Return type */
+  restype: AnyType;
+  /** Argument types (default: none) */
+  argtypes?: AnyType[];
+  /** Same options as {@link CDLL.func} */
+  options?: FunctionOptions;
 }
 
 export class CDLL {
@@ -297,7 +558,25 @@ export class CDLL {
    */
   /** Typed overload: narrows args/return when argTypes is a literal tuple. */
   func<TRet extends AnyType, const TArgs extends readonly AnyType[]>(name: string, returnType: TRet, argTypes: TArgs, options?: FunctionOptions): TypedFFIFunction<TArgs, TRet>;
-  func(name: string, returnType: AnyType, argTypes?: AnyType[], options?: FunctionOptions): CallableFunction & { callAsync(...args: any[]): Promise<any>; errcheck: ErrcheckCallback | null };
+  func(name: string, returnType: AnyType, argTypes?: AnyType[], options?: FunctionOptions): CallableFunction & { callAsync(...args: any[]): Promise<any>; callBatch: FFIFunction["callBatch"]; mapAsync: FFIFunction["mapAsync"]; submit: FFIFunction["submit"]; errcheck: ErrcheckCallback | ErrcheckPolicy | null };
+
+  /**
+   * Bind a whole manifest of functions at once: symbols are resolved and the
+   * FFI functions prepared in a single native call. Entries already in the
+   * function cache are reused.
+   *
+   * @param manifest - `{ name, restype, argtypes, options }` entries
+   * @returns The callable functions keyed by name
+   *
+   * @example
+   * ```javascript
+   * const { strlen, abs } = libc.bindAll([
+   *   { name: 'strlen', restype: c_size_t, argtypes: [c_char_p] },
+   *   { name: 'abs', restype: c_int, argtypes: [c_int] },
+   * ]);
+   * ```
+   */
+  bindAll(manifest: BindManifestEntry[]): Record<string, ReturnType<CDLL["func"]>>;
 
   /**
    * Get the address of a symbol.
@@ -368,7 +647,7 @@ export interface FunctionWrapper {
   restype: AnyType;
 
   /** Optional error checking callback. */
-  errcheck: ErrcheckCallback | null;
+  errcheck: ErrcheckCallback | ErrcheckPolicy | null;
 }
 
 /**
@@ -481,6 +760,15 @@ export interface CallbackWrapper {
   release(): void;
 }
 
+/**
+ * Wrapper returned by {@link threadSafeCallback}.
+ * @category Callbacks
+ */
+export interface ThreadSafeCallbackWrapper extends CallbackWrapper {
+  /** Events dropped because the non-blocking ring was full (always 0 in blocking mode). */
+  readonly dropped: number;
+}
+
 /**
  * Native callback class for main-thread callbacks.
  * @category Callbacks
@@ -545,6 +833,8 @@ export interface StructDef {
 
   /** Allocate a buffer and optionally initialize field values. */
   create(values?: Record<string, any>): Buffer;
+  /** Wrap an existing buffer (no copy) with the same accessors as `create()`. */
+  wrap(buf: Buffer): Buffer;
   /** Read a field value from a buffer. */
   get(buf: Buffer, fieldName: string): any;
   /** Write a field value to a buffer. */
@@ -661,9 +951,53 @@ export interface ArrayTypeDef {
   /** Element alignment. */
   getAlignment(): number;
   /** Create a new array, optionally initialized with values. Returns a Proxy with index access. */
-  create(values?: any[]): Buffer & ArrayProxy;
+  create(values?: any[] | ArrayBufferView | string): Buffer & ArrayProxy;
   /** Wrap an existing buffer as an array with index access. */
   wrap(buffer: Buffer): Buffer & ArrayProxy;
+  /** `true` for arrays created with `{ typed: true }`. */
+  readonly typed: boolean;
+}
+
+/**
+ * TypedArray types used for `typed` arrays (see {@link ArrayOptions}).
+ * @category Structures
+ */
+export type NumericTypedArray =
+  | Int8Array
+  | Uint8Array
+  | Int16Array
+  | Uint16Array
+  | Int32Array
+  | Uint32Array
+  | BigInt64Array
+  | BigUint64Array
+  | Float32Array
+  | Float64Array;
+
+/**
+ * Options for {@link array}.
+ * @category Structures
+ */
+export interface ArrayOptions {
+  /**
+   * Expose elements as a TypedArray (numeric element types only).
+   * `create()` / `wrap()` and struct field reads return a TypedArray view
+   * over the memory (a copy if it is not element-aligned); native array
+   * returns come back as a TypedArray copy.
+   */
+  typed?: boolean;
+}
+
+/**
+ * An array type created with `{ typed: true }`.
+ * @category Structures
+ */
+export interface TypedArrayTypeDef extends Omit<ArrayTypeDef, "create" | "wrap"> {
+  readonly typed: true;
+  /** Create a new zero-filled array, optionally initialized from an Array, TypedArray or Buffer. */
+  create(values?: ArrayLike<number | bigint> | Buffer): NumericTypedArray;
+  /** View an existing buffer as a TypedArray (copy if not element-aligned). */
+  wrap(buffer: Buffer): NumericTypedArray;
 }
 
 /**
@@ -899,6 +1233,8 @@ export class StructType {
   getAlignment(): number;
   create(values?: Record<string, any>): Buffer;
   read(buffer: Buffer): Record<string, any>;
+  /** Strided gather of numeric fields of `count` consecutive structs, one TypedArray per field. */
+  readColumns(ptr: Buffer | bigint | number, count: number, fieldNames: string[], stride?: number): Record<string, NumericTypedArray>;
 }
 
 /**
@@ -913,6 +1249,135 @@ export class ArrayType {
   create(values?: any[]): Buffer;
 }
 
+// =============================================================================
+// Binding Manifests
+// =============================================================================
+
+/** Type reference inside a {@link BindingManifest}: a CType value or an index into `types`. */
+export type ManifestTypeRef = number | { ref: number };
+
+/**
+ * Serializable description of struct / union / array layouts and function
+ * signatures, produced by {@link createManifest}. Plain JSON: it can be
+ * written to a file or embedded in a bundle. It is tied to the platform that
+ * generated it (pointer, `wchar_t` and `long` sizes).
+ * @category Structures
+ */
+export interface BindingManifest {
+  version: number;
+  pointerSize: number;
+  wcharSize: number;
+  longSize: number;
+  types: Array<
+    | { kind: "struct" | "union"; size: number; alignment: number; fields: Array<{ name: string; type: ManifestTypeRef; offset: number; anonymous?: boolean }> }
+    | { kind: "array"; element: ManifestTypeRef; length: number; typed?: boolean }
+  >;
+  /** Named types: index into `types` */
+  names: Record<string, number>;
+  functions: Array<{ name: string; restype: ManifestTypeRef; argtypes: ManifestTypeRef[]; options?: FunctionOptions }>;
+}
+
+/**
+ * Generate a binding manifest, typically once at build time.
+ *
+ * @param spec.types - Named struct / union / array types
+ * @param spec.functions - Function signatures bound later with `loadManifest(...).bind(lib)`
+ *
+ * @example
+ * ```javascript
+ * const manifest = createManifest({
+ *   types: { Point },
+ *   functions: [{ name: 'norm', restype: c_double, argtypes: [Point] }],
+ * });
+ * writeFileSync('bindings.json', JSON.stringify(manifest));
+ * ```
+ *
+ * @category Structures
+ */
+export function createManifest(spec: {
+  types?: Record<string, StructDef | UnionDef | ArrayTypeDef | typeof Structure | typeof Union>;
+  functions?: BindManifestEntry[];
+}): BindingManifest;
+
+/**
+ * Rebuild the native types of a manifest in a single call, using the stored
+ * offsets instead of recomputing layouts. Structure / Union classes or defs
+ * passed in `bindings` reuse the rebuilt types.
+ *
+ * @param manifest - Output of {@link createManifest} (also after a JSON round trip)
+ * @param bindings - JS types by name, as given to `createManifest({ types })`
+ * @returns Native types by name and `bind(lib)` to bind the manifest functions
+ *
+ * @category Structures
+ */
+export function loadManifest(
+  manifest: BindingManifest,
+  bindings?: Record<string, StructDef | UnionDef | typeof Structure | typeof Union>,
+): { types: Record<string, StructType | ArrayType>; bind(lib: CDLL): Record<string, ReturnType<CDLL["func"]>> };
+
+/**
+ * Structured-clone-able token returned by {@link shareBindings}.
+ * @category Structures
+ */
+export interface BindingToken {
+  /** Process-wide binding set id */
+  id: number;
+  names: Record<string, number>;
+  functions: BindingManifest["functions"];
+}
+
+/**
+ * Publish native layouts and signatures to the other Worker threads of the
+ * process. The shared types become immutable; a Worker that attaches the
+ * token gets wrappers over the same layouts and reuses the prepared CIFs.
+ *
+ * @example
+ * ```javascript
+ * const token = shareBindings({ types: { Point }, functions: [{ name: 'norm', restype: c_double, argtypes: [Point] }] });
+ * new Worker('./worker.js', { workerData: token });
+ * // worker.js
+ * const { norm } = attachBindings(workerData, { Point }).bind(new CDLL('./libgeo.so'));
+ * ```
+ *
+ * @category Structures
+ */
+export function shareBindings(spec: {
+  types?: Record<string, StructDef | UnionDef | ArrayTypeDef | typeof Structure | typeof Union>;
+  functions?: BindManifestEntry[];
+}): BindingToken;
+
+/**
+ * Adopt the layouts of a {@link shareBindings} token in this environment.
+ * Same result as {@link loadManifest}.
+ *
+ * @category Structures
+ */
+export function attachBindings(
+  token: BindingToken,
+  bindings?: Record<string, StructDef | UnionDef | typeof Structure | typeof Union>,
+): { types: Record<string, StructType | ArrayType>; bind(lib: CDLL): Record<string, ReturnType<CDLL["func"]>> };
+
+/**
+ * Revoke a token. Environments that already attached it keep working.
+ * @returns false if the token was already released
+ * @category Structures
+ */
+export function releaseBindings(token: BindingToken | number): boolean;
+
+/**
+ * Process-wide registry counters, shared by all Worker threads.
+ * @category Library Loading
+ */
+export function sharedRegistryStats(): {
+  /** Distinct library paths currently open */
+  libraries: number;
+  /** Live Library instances across all environments */
+  libraryRefs: number;
+  bindingSets: number;
+  /** Distinct prepared CIFs still in use */
+  signatures: number;
+};
+
 /**
  * Base class for Python-like struct definitions.
  *
@@ -1112,6 +1577,19 @@ export class LittleEndianUnion<F extends Record<string, FieldSpec> = Record<stri
 // Functions
 // =============================================================================
 
+/**
+ * Enable or disable call statistics for every FFI function.
+ * @returns The new state
+ * @category Library Loading
+ */
+export function setStatsEnabled(enabled?: boolean): boolean;
+
+/**
+ * Statistics of every function that recorded at least one call.
+ * @category Library Loading
+ */
+export function statsSnapshot(): { enabled: boolean; functions: FunctionStats[] };
+
 /**
  * Load a shared library at the lowest level.
  *
@@ -1160,13 +1638,35 @@ export function callback(fn: Function, returnType: AnyType, argTypes?: AnyType[]
  *
  * **Important:** Call `.release()` when the callback is no longer needed.
  *
+ * With `{ nonBlocking: true }` (void callbacks only) calls from external
+ * threads enqueue their arguments into a lock-free ring and return
+ * immediately; the main thread drains many records per wakeup. With
+ * `batch: true` as well, `fn` receives one array of argument arrays per batch.
+ * When the ring is full, events are dropped and counted in `dropped`.
+ *
  * @param fn - JavaScript function to wrap
  * @param returnType - Return type of the callback
  * @param argTypes - Argument types
+ * @param abi - Calling convention or {@link ThreadSafeCallbackOptions}
  *
  * @category Callbacks
  */
-export function threadSafeCallback(fn: Function, returnType: AnyType, argTypes?: AnyType[]): CallbackWrapper;
+export function threadSafeCallback(fn: Function, returnType: AnyType, argTypes?: AnyType[], abi?: string | ThreadSafeCallbackOptions): ThreadSafeCallbackWrapper;
+
+/**
+ * Options for {@link threadSafeCallback}.
+ * @category Callbacks
+ */
+export interface ThreadSafeCallbackOptions {
+  /** Calling convention */
+  abi?: string;
+  /** Fire-and-forget mode for void callbacks invoked from external threads */
+  nonBlocking?: boolean;
+  /** With `nonBlocking`, call `fn` once per drained batch with an array of argument arrays */
+  batch?: boolean;
+  /** Ring size in records (default 4096); events are dropped (and counted) when it is full */
+  capacity?: number;
+}
 
 /**
  * Create a function pointer type with cdecl calling convention.
@@ -1297,13 +1797,35 @@ export function create_string_buffer(init: number | string | Buffer): Buffer;
  */
 export function create_unicode_buffer(init: number | string): Buffer;
 
+/**
+ * Return a shared, pre-encoded null-terminated C string (UTF-8).
+ *
+ * Encoded once per distinct string (bounded cache); passing the result to a
+ * `c_char_p` argument skips the per-call transcoding. The Buffer is shared:
+ * treat it as read-only.
+ *
+ * @param str - String to intern
+ *
+ * @category Memory
+ */
+export function intern_string(str: string): Buffer;
+
+/**
+ * Wide-string (`wchar_t*`) counterpart of {@link intern_string}.
+ *
+ * @param str - String to intern
+ *
+ * @category Memory
+ */
+export function intern_wstring(str: string): Buffer;
+
 /**
  * Read a C string from an address or buffer.
  *
  * Python equivalent: `ctypes.string_at`
  *
  * @param address - Buffer, BigInt address, or numeric address
- * @param size - Maximum bytes to read (optional, reads until null terminator)
+ * @param size - Exact number of bytes to read, embedded nulls included (optional, reads until null terminator)
  *
  * @category Memory
  */
@@ -1315,7 +1837,7 @@ export function string_at(address: Buffer | bigint | number, size?: number): str
  * Python equivalent: `ctypes.wstring_at`
  *
  * @param address - Buffer, BigInt address, or numeric address
- * @param size - Maximum characters to read
+ * @param size - Exact number of wide characters to read, embedded nulls included (optional, reads until null terminator)
  *
  * @category Memory
  */
@@ -1328,7 +1850,7 @@ export function wstring_at(address: Buffer | bigint | number, size?: number): st
  *
  * @category Memory
  */
-export function addressof(ptr: Buffer | bigint | number): bigint;
+export function addressof(ptr: Buffer | bigint | number | PointerHandle): bigint;
 
 /**
  * Copy memory from source to destination.
@@ -1348,6 +1870,138 @@ export function memmove(dst: Buffer, src: Buffer | bigint, count: number): void;
  */
 export function memset(dst: Buffer, value: number, count: number): void;
 
+/**
+ * Options for {@link pool}.
+ * @category Memory
+ */
+export interface SlabPoolOptions {
+  /** Bytes per slab: power of two, 4 KiB – 16 MiB (default 65536) */
+  slabSize?: number;
+  /** Largest pooled request: power of two, 8 – 4096 (default 256) */
+  maxBlockSize?: number;
+}
+
+/**
+ * Per-size-class counters of a {@link SlabPool}.
+ * @category Memory
+ */
+export interface SlabPoolClassStats {
+  blockSize: number;
+  slabs: number;
+  live: number;
+  free: number;
+}
+
+/**
+ * Snapshot returned by {@link SlabPool.stats}.
+ * @category Memory
+ */
+export interface SlabPoolStats {
+  slabSize: number;
+  maxBlockSize: number;
+  /** Slabs currently reserved (one ArrayBuffer each) */
+  slabs: number;
+  reservedBytes: number;
+  liveBlocks: number;
+  /** Bytes of the live blocks (block size, not requested size) */
+  inUseBytes: number;
+  allocations: number;
+  releases: number;
+  /** Requests above maxBlockSize served by ordinary Buffers */
+  fallbacks: number;
+  /** Open scopes */
+  scopes: number;
+  classes: SlabPoolClassStats[];
+}
+
+/**
+ * Slab allocator for small, short-lived buffers.
+ *
+ * Buffers are views over shared slabs. A released Buffer stays a valid view
+ * but its block may be handed out again.
+ * @category Memory
+ */
+export interface SlabPool {
+  /** Zero-filled Buffer of `size` bytes */
+  alloc(size: number): Buffer;
+  /** Returns the block to the pool; false for Buffers not backed by a slab */
+  release(buffer: Buffer): boolean;
+  /** Releases every block (slabs stay reserved) */
+  reset(): void;
+  /** Drops slabs without live blocks; returns how many */
+  trim(): number;
+  /** Runs a synchronous `fn` and releases the blocks it allocated */
+  scope<T>(fn: (pool: SlabPool) => T): T;
+  /** Opens a scope closed by `close()` or `using` */
+  scope(): { close(): void; [Symbol.dispose](): void };
+  beginScope(): number;
+  endScope(): number;
+  cstring(str: string): Buffer;
+  create_string_buffer(init: number | string | Buffer): Buffer;
+  stats(): SlabPoolStats;
+  /** reset() + trim() */
+  [Symbol.dispose](): void;
+}
+
+/**
+ * Create a slab pool for small native buffers (structs, scalars, strings).
+ *
+ * @example
+ * ```typescript
+ * const p = pool();
+ * const total = p.scope(() => lib.sum(p.cstring('a,b,c')));
+ * ```
+ *
+ * @category Memory
+ */
+export function pool(options?: SlabPoolOptions): SlabPool;
+
+/**
+ * Access hint for {@link mmap} / {@link madvise}.
+ * @category Memory
+ */
+export type MapAdvice = "normal" | "sequential" | "random" | "willneed" | "dontneed";
+
+/**
+ * Options for {@link mmap}.
+ * @category Memory
+ */
+export interface MmapOptions {
+  /** First byte of the file to map (default 0, any alignment) */
+  offset?: number;
+  /** Bytes to map (default: up to the end of the file) */
+  length?: number;
+  /** Read-only mapping (default true); false maps the file shared and writable */
+  readonly?: boolean;
+  /** Initial access hint */
+  advise?: MapAdvice;
+}
+
+/**
+ * Map a file into memory and return an external Buffer over the mapping.
+ *
+ * Zero-copy: the Buffer can be passed straight to native functions. The
+ * mapping is released when the Buffer is garbage collected. Writing into a
+ * read-only mapping terminates the process.
+ *
+ * @example
+ * ```typescript
+ * const data = mmap('/data/trace.bin', { advise: 'sequential' });
+ * lib.parse_trace(data, BigInt(data.length));
+ * ```
+ *
+ * @category Memory
+ */
+export function mmap(path: string | URL, options?: MmapOptions): Buffer;
+
+/**
+ * Give the kernel an access hint for a Buffer returned by {@link mmap} (or
+ * a view of it). Returns false when the platform has no equivalent hint.
+ *
+ * @category Memory
+ */
+export function madvise(buffer: Buffer, advice: MapAdvice, offset?: number, length?: number): boolean;
+
 /**
  * Read a typed value from a buffer at a given offset.
  *
@@ -1365,7 +2019,7 @@ export function memset(dst: Buffer, value: number, count: number): void;
  * @category Memory
  */
 export function readValue<T extends AnyType>(ptr: Buffer | bigint | number, type: T, offset?: number): JsFromCType<T>;
-export function readValue(ptr: Buffer | bigint | number, type: AnyType, offset?: number): any;
+export function readValue(ptr: Buffer | bigint | number | PointerHandle, type: AnyType, offset?: number): any;
 
 /**
  * Write a typed value to a buffer at a given offset.
@@ -1380,6 +2034,55 @@ export function readValue(ptr: Buffer | bigint | number, type: AnyType, offset?:
 export function writeValue<T extends AnyType>(ptr: Buffer | bigint | number, type: T, value: JsArgFromCType<T>, offset?: number): number | void;
 export function writeValue(ptr: Buffer | bigint | number, type: AnyType, value: any, offset?: number): number | void;
 
+/**
+ * Read `count` numeric elements into a TypedArray in one native call.
+ *
+ * With `stride` larger than the element size the read is a strided gather
+ * (e.g. one field out of an array of structs).
+ *
+ * @param ptr - Buffer or address to read from
+ * @param type - Numeric element type (e.g. `c_int32`, `c_double`)
+ * @param count - Number of elements
+ * @param stride - Distance in bytes between elements (default `sizeof(type)`)
+ * @param out - TypedArray of the matching kind to fill instead of allocating
+ *
+ * @example
+ * ```javascript
+ * const values = readArray(ptr, c_double, 1024); // Float64Array
+ * ```
+ *
+ * @category Memory
+ */
+export function readArray(ptr: Buffer | bigint | number, type: AnyType | number, count: number, stride?: number, out?: NumericTypedArray): NumericTypedArray;
+
+/**
+ * Write numeric elements from a TypedArray (memcpy / strided scatter) or an Array.
+ *
+ * @returns Number of elements written
+ *
+ * @category Memory
+ */
+export function writeArray(ptr: Buffer | bigint | number, type: AnyType | number, values: NumericTypedArray | ArrayLike<number | bigint>, stride?: number): number;
+
+/**
+ * Read numeric fields of `count` consecutive structs as columns (one TypedArray per field).
+ *
+ * @example
+ * ```javascript
+ * const Point = struct({ x: c_double, y: c_double });
+ * const { x, y } = readColumns(Point, ptr, n, ["x", "y"]);
+ * ```
+ *
+ * @category Memory
+ */
+export function readColumns(
+  structType: StructDef | UnionDef | typeof Structure,
+  ptr: Buffer | bigint | number,
+  count: number,
+  fieldNames: string[],
+  stride?: number,
+): Record<string, NumericTypedArray>;
+
 /**
  * Get the size of a type in bytes.
  *
@@ -1422,7 +2125,7 @@ export function alignment(type: AnyType | StructDef | ArrayTypeDef | typeof Stru
  *
  * @category Memory
  */
-export function ptrToBuffer(address: bigint | number, size: number): Buffer;
+export function ptrToBuffer(address: bigint | number | PointerHandle, size: number): Buffer;
 
 /**
  * Define a struct using the functional API.
@@ -1480,17 +2183,22 @@ export function defineUnion<F extends Record<string, FieldSpec>>(fields: F): new
  *
  * @param elementType - Type of each element
  * @param count - Number of elements
+ * @param options - `{ typed: true }` to expose elements as a TypedArray
  *
  * @example
  * ```javascript
  * const IntArray5 = array(c_int32, 5);
  * const arr = IntArray5.create([1, 2, 3, 4, 5]);
  * console.log(arr[0]);  // 1
+ *
+ * const Samples = array(c_double, 512, { typed: true });
+ * const samples = Samples.create(); // Float64Array
  * ```
  *
  * @category Structures
  */
-export function array(elementType: AnyType | typeof Structure | typeof Union, count: number): ArrayTypeDef;
+export function array(elementType: AnyType, count: number, options: ArrayOptions & { typed: true }): TypedArrayTypeDef;
+export function array(elementType: AnyType | typeof Structure | typeof Union, count: number, options?: ArrayOptions): ArrayTypeDef;
 
 /**
  * Define a bit field for use in struct `_fields_`.
@@ -1611,6 +2319,77 @@ export function POINTER(baseType: AnyType | StructDef): PointerTypeDef;
  */
 export function pointer(obj: SimpleCDataInstance | { _buffer: Buffer }): PointerInstance;
 
+/**
+ * Configure the native worker pool used by `callAsync`. The size can be set
+ * freely before the first async call; afterwards it can only grow.
+ *
+ * @category Library Loading
+ */
+export function configureCallPool(options: { threads?: number }): CallPoolStats;
+
+/**
+ * Statistics of the native worker pool used by `callAsync`.
+ *
+ * @category Library Loading
+ */
+export function callPoolStats(): CallPoolStats;
+
+/**
+ * Create a serial queue: async calls of functions created with
+ * `{ queue }` run one at a time, in call order.
+ *
+ * @category Library Loading
+ */
+export function createSerialQueue(): SerialQueue;
+
+/**
+ * Options for {@link completionRing}.
+ *
+ * @category Library Loading
+ */
+export interface CompletionRingOptions {
+  /** Records in the ring: calls in flight plus completions not drained yet (default 1024). */
+  capacity?: number;
+  /** Called with the ring once per pool drain that completed some of its calls. */
+  onBatch?: (ring: CompletionRing) => void;
+}
+
+/**
+ * SharedArrayBuffer-backed ring receiving the results of
+ * {@link FFIFunction.submit}.
+ *
+ * @category Library Loading
+ */
+export interface CompletionRing {
+  /** Number of records. */
+  readonly capacity: number;
+  /** Submitted calls that have not completed yet. */
+  readonly inflight: number;
+  /** Completed calls not drained yet. */
+  readonly pending: number;
+  /** The backing SharedArrayBuffer. */
+  readonly buffer: SharedArrayBuffer;
+  /**
+   * Call `fn` for each completed call, oldest first, and mark the records as
+   * read. Pointer and string returns arrive as addresses.
+   * @returns The number of records consumed
+   */
+  drain(fn: (tag: number, value: any, error: Error | undefined) => void): number;
+  /**
+   * Resolve with the number of unread records once there is at least one
+   * (0 if `timeout` ms elapse first).
+   */
+  wait(timeout?: number): Promise<number>;
+}
+
+/**
+ * Create a completion ring for {@link FFIFunction.submit}: Promise-free
+ * async calls whose results are drained in batches.
+ *
+ * @category Library Loading
+ */
+export function completionRing(options?: CompletionRingOptions): CompletionRing;
+
 /**
  * Get the C library errno value.
  *
@@ -25,18 +25,33 @@ import { _toNativeType, _toNativeTypes } from "./core/types.js";
 import { callback as createCallback, threadSafeCallback as createThreadSafeCallback } from "./core/callback.js";
 import { createCFUNCTYPE, createWINFUNCTYPE } from "./core/funcptr.js";
 import { createLibraryClasses } from "./core/Library.js";
+import {
+  createManifest as _createManifest,
+  loadManifest as _loadManifest,
+  shareBindings as _shareBindings,
+  attachBindings as _attachBindings,
+  releaseBindings as _releaseBindings,
+} from "./core/manifest.js";
 import {
   alloc as _alloc,
   cstring as _cstring,
   wstring as _wstring,
+  intern_string as _intern_string,
+  intern_wstring as _intern_wstring,
   create_string_buffer as _create_string_buffer,
   create_unicode_buffer as _create_unicode_buffer,
   string_at as _string_at,
   wstring_at as _wstring_at,
   memmove as _memmove,
   memset as _memset,
+  readArray as _readArray,
+  writeArray as _writeArray,
+  readColumns as _readColumns,
 } from "./memory/buffer.js";
 import { createMemoryOps } from "./memory/operations.js";
+import { mmap as _mmap, madvise as _madvise } from "./memory/mmap.js";
+import { pool as _pool } from "./memory/pool.js";
+import { completionRing as _completionRing } from "./core/ring.js";
 import { addressOf as _addressOf, byref as _byref, cast as _cast, ptrToBuffer as _ptrToBuffer, POINTER as _POINTER, pointer as _pointer } from "./memory/pointer.js";
 import { FormatError as _FormatError, WinError as _WinError } from "./platform/errors.js";
 import { bitfield as _bitfield, _isStruct, _isArrayType, _isBitField } from "./structures/helpers/common.js";
@@ -138,7 +153,7 @@ function load(libPath) {
  * Wrapper per funzioni con sintassi Python-like ctypes (argtypes/restype)
  */
 // Create Library classes (FunctionWrapper, CDLL, WinDLL, OleDLL)
-const { FunctionWrapper, CDLL, WinDLL, OleDLL } = createLibraryClasses(Library, LRUCache, _toNativeType, _toNativeTypes, native);
+const { FunctionWrapper, CDLL, WinDLL, OleDLL } = createLibraryClasses(Library, LRUCache, _toNativeType, _toNativeTypes, native, WinError);
 
 // Function pointer type factories (Python ctypes CFUNCTYPE/WINFUNCTYPE)
 const CFUNCTYPE = createCFUNCTYPE(native);
@@ -165,6 +180,82 @@ function threadSafeCallback(fn, returnType, argTypes = [], abi = undefined) {
   return createThreadSafeCallback(fn, returnType, argTypes, native, abi);
 }
 
+// ============================================================================
+// Call Statistics
+// ============================================================================
+
+/**
+ * Accende / spegne la strumentazione per tutte le FFIFunction
+ * (equivalente all'opzione `stats: true` su ogni funzione)
+ * @param {boolean} [enabled=true]
+ * @returns {boolean} Stato attuale
+ */
+function setStatsEnabled(enabled = true) {
+  return native.setStatsEnabled(!!enabled);
+}
+
+/**
+ * Snapshot delle statistiche di tutte le funzioni misurate finora
+ * @returns {{enabled: boolean, functions: Array<Object>}}
+ */
+function statsSnapshot() {
+  return native.statsSnapshot();
+}
+
+// ============================================================================
+// Binding Manifests
+// Now imported from ./core/manifest.js - see that file for implementation details
+// ============================================================================
+
+/**
+ * Genera un binding manifest JSON-serializzabile (tipi e signature)
+ * @see ./core/manifest.js for full documentation
+ */
+function createManifest(spec) {
+  return _createManifest(spec, _toNativeType, native);
+}
+
+/**
+ * Ricostruisce i tipi di un binding manifest in una sola chiamata native
+ * @see ./core/manifest.js for full documentation
+ */
+function loadManifest(manifest, bindings = {}) {
+  return _loadManifest(manifest, bindings, native);
+}
+
+/**
+ * Pubblica tipi e signature per gli altri Worker thread (token clonabile)
+ * @see ./core/manifest.js for full documentation
+ */
+function shareBindings(spec) {
+  return _shareBindings(spec, _toNativeType, native);
+}
+
+/**
+ * Adotta i layout nativi di un token di shareBindings in questo environment
+ * @see ./core/manifest.js for full documentation
+ */
+function attachBindings(token, bindings = {}) {
+  return _attachBindings(token, bindings, native);
+}
+
+/**
+ * Revoca un token di shareBindings
+ * @see ./core/manifest.js for full documentation
+ */
+function releaseBindings(token) {
+  return _releaseBindings(token, native);
+}
+
+/**
+ * Stato del registry di processo: librerie aperte, binding set e CIF
+ * condivisi tra tutti gli environment
+ * @returns {{libraries: number, libraryRefs: number, bindingSets: number, signatures: number}}
+ */
+function sharedRegistryStats() {
+  return native.sharedRegistryStats();
+}
+
 // ============================================================================
 // Buffer Operations
 // Now imported from ./memory/buffer.js - see that file for implementation details
@@ -182,6 +273,26 @@ function wstring(str) {
   return _wstring(str, native);
 }
 
+function intern_string(str) {
+  return _intern_string(str, native);
+}
+
+function intern_wstring(str) {
+  return _intern_wstring(str, native);
+}
+
+function readArray(ptr, type, count, stride, out) {
+  return _readArray(ptr, type, count, stride, out, native);
+}
+
+function writeArray(ptr, type, values, stride) {
+  return _writeArray(ptr, type, values, stride, native);
+}
+
+function readColumns(structType, ptr, count, fieldNames, stride) {
+  return _readColumns(structType, ptr, count, fieldNames, stride, _toNativeType, native);
+}
+
 // Internal wrappers for backward compatibility (used by SimpleCData _reader/_writer)
 function readCString(ptr, maxLen) {
   return _string_at(ptr, maxLen, native);
@@ -335,6 +446,7 @@ memoryDeps.Union = Union;
  *
  * @param {string} elementType - Tipo degli elementi ('int32', 'float', etc.)
  * @param {number} count - Numero di elementi
+ * @param {Object} [options] - `{ typed: true }` espone gli elementi come TypedArray
  * @returns {Object} ArrayType con metodi getSize(), getLength(), create(), wrap()
  *
  * @example
@@ -344,8 +456,8 @@ memoryDeps.Union = Union;
  * arr[2] = 42;
  * console.log(arr[2]);  // 42
  */
-function array(elementType, count) {
-  return _array(elementType, count, sizeof, alloc, readValue, writeValue, Structure, Union, ArrayType);
+function array(elementType, count, options) {
+  return _array(elementType, count, options, sizeof, alloc, readValue, writeValue, Structure, Union, ArrayType, CType);
 }
 
 // ============================================================================
@@ -397,6 +509,51 @@ function WinError(code) {
   return _WinError(code, WinDLL, alloc, c_uint32, c_void, c_void_p);
 }
 
+// ============================================================================
+// Call pool (callAsync)
+// Le callAsync non usano il threadpool di libuv ma un pool nativo dedicato,
+// così le call C bloccanti non rubano thread a fs / dns / crypto.
+// ============================================================================
+
+/**
+ * Configura il worker pool di callAsync.
+ * Prima della prima callAsync imposta il numero di thread; dopo può solo
+ * aumentarlo.
+ * @param {{ threads?: number }} options
+ * @returns {{ threads: number, submitted: number, completed: number, pending: number }}
+ */
+function configureCallPool(options) {
+  return native.configureCallPool(options);
+}
+
+/**
+ * Statistiche del worker pool di callAsync.
+ * @returns {{ threads: number, submitted: number, completed: number, pending: number }}
+ */
+function callPoolStats() {
+  return native.callPoolStats();
+}
+
+/**
+ * Crea una coda seriale del pool: le callAsync delle funzioni create con
+ * `{ queue }` eseguono una alla volta, in ordine di chiamata.
+ * Equivalente per-funzione di `new CDLL(path, { serial: true })`.
+ * @returns {Object} Handle opaco
+ */
+function createSerialQueue() {
+  return native.createSerialQueue();
+}
+
+/**
+ * Crea un completion ring per fn.submit(ring, tag, ...args): le call girano
+ * sul pool come callAsync, ma i risultati finiscono in un SharedArrayBuffer
+ * invece che in una Promise per call.
+ * @see ./core/ring.js for full documentation
+ */
+function completionRing(options) {
+  return _completionRing(options, native);
+}
+
 /**
  * Helper per definire un bit field
  * @param {string} baseType - Tipo base (uint8, uint16, uint32, uint64)
@@ -529,6 +686,26 @@ function memset(dst, value, count) {
   return _memset(dst, value, count);
 }
 
+/**
+ * Crea uno slab pool per buffer piccoli e di breve durata
+ * @see ./memory/pool.js for full documentation
+ */
+function pool(options) {
+  return _pool(options, native);
+}
+
+/**
+ * Mappa un file in memoria come Buffer esterno (zero-copy)
+ * @see ./memory/mmap.js for full documentation
+ */
+function mmap(path, options) {
+  return _mmap(path, options, native);
+}
+
+function madvise(buffer, advice, offset, length) {
+  return _madvise(buffer, advice, offset, length, native);
+}
+
 // Export come ES module
 export {
   // Classi
@@ -549,6 +726,14 @@ export {
   threadSafeCallback,
   CFUNCTYPE,
   WINFUNCTYPE,
+  createManifest,
+  loadManifest,
+  shareBindings,
+  attachBindings,
+  releaseBindings,
+  sharedRegistryStats,
+  setStatsEnabled,
+  statsSnapshot,
 
   // Memory Management - Python-compatibili
   create_string_buffer,
@@ -560,11 +745,19 @@ export {
   memset,
 
   // Memory - utility senza equivalente Python diretto
+  intern_string,
+  intern_wstring,
   readValue,
   writeValue,
+  readArray,
+  writeArray,
+  readColumns,
   sizeof,
   alignment,
   ptrToBuffer,
+  pool,
+  mmap,
+  madvise,
 
   // Strutture
   struct,
@@ -599,6 +792,12 @@ export {
   FormatError,
   WinError,
 
+  // Call pool (callAsync)
+  configureCallPool,
+  callPoolStats,
+  createSerialQueue,
+  completionRing,
+
   // SimpleCData base class
   SimpleCData,
 
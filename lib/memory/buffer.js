@@ -135,6 +135,63 @@ export function wstring(str, native) {
   return buf;
 }
 
+// Bounded: a hot loop reuses a handful of strings, but a caller interning
+// unbounded input (ids, user data) must not grow the cache forever. A plain
+// Map keeps hits to one lookup; on overflow the oldest entry is dropped.
+const INTERNED_STRINGS_MAX = 4096;
+const internedStrings = new Map();
+const internedWStrings = new Map();
+
+function internInto(cache, str, encode) {
+  let buf = cache.get(str);
+  if (buf === undefined) {
+    if (cache.size >= INTERNED_STRINGS_MAX) {
+      cache.delete(cache.keys().next().value);
+    }
+    buf = encode(str);
+    cache.set(str, buf);
+  }
+  return buf;
+}
+
+/**
+ * Returns a shared, pre-encoded null-terminated C string for `str`.
+ *
+ * The string is encoded to UTF-8 only the first time; later calls with the
+ * same content return the same Buffer. Buffers are passed to `c_char_p`
+ * arguments as-is (no per-call transcoding), so interning pays off for
+ * strings that repeat across many calls: keys, table names, format strings.
+ *
+ * The returned Buffer is shared: treat it as read-only and never pass it to
+ * a function that writes through the pointer.
+ *
+ * @param {string} str - JavaScript string to intern
+ * @param {Object} native - Native module reference
+ * @returns {Buffer} Shared buffer containing the null-terminated C string
+ *
+ * @example
+ * ```javascript
+ * import { intern_string } from 'node-ctypes';
+ *
+ * const key = intern_string("user.name");
+ * for (const row of rows) lookup(table, key, row); // no UTF-8 encode per call
+ * ```
+ */
+export function intern_string(str, native) {
+  return internInto(internedStrings, str, (s) => cstring(s, native));
+}
+
+/**
+ * Wide-string (`wchar_t*`) counterpart of {@link intern_string}.
+ *
+ * @param {string} str - JavaScript string to intern
+ * @param {Object} native - Native module reference (provides WCHAR_SIZE)
+ * @returns {Buffer} Shared buffer containing the null-terminated wide string
+ */
+export function intern_wstring(str, native) {
+  return internInto(internedWStrings, str, (s) => wstring(s, native));
+}
+
 /**
  * Creates a C string buffer (Python ctypes compatible).
  *
@@ -249,7 +306,9 @@ export function create_unicode_buffer(init, native) {
  * Direct equivalent to Python's `ctypes.string_at()`.
  *
  * @param {Buffer|bigint|number} address - Memory address or buffer
- * @param {number} [size] - Number of bytes to read (default: until null terminator)
+ * @param {number} [size] - Number of bytes to read (default: until null
+ *   terminator). With a size the read is exact, embedded nulls included, and
+ *   the memory is not scanned; on a Buffer it stops at the Buffer end.
  * @param {Object} native - Native module reference
  * @returns {string|null} String read from memory
  *
@@ -270,7 +329,7 @@ export function create_unicode_buffer(init, native) {
  * ```
  */
 export function string_at(address, size, native) {
-  return native.readCString(address, size);
+  return size === undefined ? native.readCString(address) : native.readCString(address, size, true);
 }
 
 /**
@@ -284,7 +343,9 @@ export function string_at(address, size, native) {
  * Direct equivalent to Python's `ctypes.wstring_at()`.
  *
  * @param {Buffer|bigint|number} address - Memory address or buffer
- * @param {number} [size] - Number of wide characters to read (not bytes)
+ * @param {number} [size] - Number of wide characters to read (not bytes).
+ *   Without it the read stops at the null terminator; with it the read is
+ *   exact (embedded nulls included) and stops only at a Buffer's end.
  * @param {Object} native - Native module reference
  * @returns {string|null} Wide string read from memory
  *
@@ -298,45 +359,7 @@ export function string_at(address, size, native) {
  * ```
  */
 export function wstring_at(address, size, native) {
-  if (address === null || address === undefined) {
-    return null;
-  }
-
-  const wcharSize = native.WCHAR_SIZE;
-  let buf;
-
-  if (Buffer.isBuffer(address)) {
-    buf = address;
-  } else {
-    // Convert BigInt/number to buffer
-    const maxBytes = size ? size * wcharSize : 1024;
-    buf = native.ptrToBuffer(address, maxBytes);
-  }
-
-  // Windows: UTF-16LE
-  if (wcharSize === 2) {
-    if (size !== undefined) {
-      return buf.toString("utf16le", 0, size * 2);
-    }
-    // Read until null terminator
-    let end = 0;
-    while (end < buf.length - 1 && (buf[end] !== 0 || buf[end + 1] !== 0)) {
-      end += 2;
-    }
-    return buf.toString("utf16le", 0, end);
-  }
-
-  // Unix: UTF-32LE
-  const chars = [];
-  const limit = size !== undefined ? size : Math.floor(buf.length / 4);
-
-  for (let i = 0; i < limit; i++) {
-    const codePoint = buf.readUInt32LE(i * 4);
-    if (codePoint === 0) break;
-    chars.push(String.fromCodePoint(codePoint));
-  }
-
-  return chars.join("");
+  return size === undefined ? native.readWString(address) : native.readWString(address, size, true);
 }
 
 /**
@@ -402,3 +425,89 @@ export function memset(dst, value, count) {
   }
   dst.fill(value, 0, count);
 }
+
+/**
+ * Resolves a bulk element type (SimpleCData class or CType number) to its CType.
+ * @private
+ */
+function _bulkType(type) {
+  if (typeof type === "function" && type._isSimpleCData) {
+    return type._type;
+  }
+  if (typeof type === "number") {
+    return type;
+  }
+  throw new TypeError("Bulk access requires a numeric SimpleCData type (e.g. c_int32, c_double)");
+}
+
+/**
+ * Reads `count` numeric elements from memory into a TypedArray in one native call.
+ *
+ * With a `stride` larger than the element size the read becomes a strided
+ * gather: useful to extract one scalar field out of an array of structs
+ * without materializing a JS object per element.
+ *
+ * @param {Buffer|bigint|number} ptr - Source buffer or address
+ * @param {Function|number} type - Element type (e.g. `c_int32`, `c_double`)
+ * @param {number} count - Number of elements
+ * @param {number} [stride] - Distance in bytes between elements (default: sizeof(type))
+ * @param {TypedArray} [out] - Destination TypedArray to reuse (length >= count)
+ * @param {Object} native - Native module reference
+ * @returns {TypedArray} `out` or a new TypedArray of the matching kind
+ *
+ * @example
+ * ```javascript
+ * import { readArray, c_double } from 'node-ctypes';
+ *
+ * const values = readArray(ptr, c_double, 1024); // Float64Array(1024)
+ * ```
+ */
+export function readArray(ptr, type, count, stride, out, native) {
+  return native.readArray(ptr, _bulkType(type), count, stride, out);
+}
+
+/**
+ * Writes numeric elements to memory in one native call.
+ *
+ * `values` may be a TypedArray of the matching kind (copied directly,
+ * scattered with `stride` if given) or a plain Array of numbers/bigints.
+ *
+ * @param {Buffer|bigint|number} ptr - Destination buffer or address
+ * @param {Function|number} type - Element type (e.g. `c_int32`, `c_double`)
+ * @param {TypedArray|Array} values - Values to write
+ * @param {number} [stride] - Distance in bytes between elements (default: sizeof(type))
+ * @param {Object} native - Native module reference
+ * @returns {number} Number of elements written
+ */
+export function writeArray(ptr, type, values, stride, native) {
+  return native.writeArray(ptr, _bulkType(type), values, stride);
+}
+
+/**
+ * Reads selected scalar fields of `count` consecutive structs as columns
+ * (one TypedArray per field), with a single native strided gather per field.
+ *
+ * @param {Function|Object} structType - Structure/Union class or struct()/union() definition
+ * @param {Buffer|bigint|number} ptr - Address of the first struct
+ * @param {number} count - Number of structs
+ * @param {string[]} fieldNames - Numeric primitive fields to extract
+ * @param {number} [stride] - Distance in bytes between structs (default: sizeof(structType))
+ * @param {Function} toNativeType - Type normalizer (`_toNativeType`)
+ * @param {Object} native - Native module reference
+ * @returns {Object<string, TypedArray>} Columns keyed by field name
+ *
+ * @example
+ * ```javascript
+ * import { struct, readColumns, c_int32, c_double } from 'node-ctypes';
+ *
+ * const Point = struct({ id: c_int32, x: c_double, y: c_double });
+ * const { x, y } = readColumns(Point, ptr, n, ["x", "y"]); // Float64Array each
+ * ```
+ */
+export function readColumns(structType, ptr, count, fieldNames, stride, toNativeType, native) {
+  const nativeType = toNativeType(structType, native);
+  if (!nativeType || typeof nativeType.readColumns !== "function") {
+    throw new TypeError("readColumns requires a Structure/Union (or struct()/union()) type");
+  }
+  return nativeType.readColumns(ptr, count, fieldNames, stride);
+}
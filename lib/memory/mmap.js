@@ -0,0 +1,75 @@
+/**
+ * @file mmap.js
+ * @module memory/mmap
+ * @description Memory-mapped file Buffers.
+ *
+ * `mmap()` maps a file (or a range of it) and returns an external Buffer
+ * over the mapping: no copy into the JS heap, resident pages shared with
+ * the page cache and every other process mapping the same file. The Buffer
+ * is accepted anywhere a Buffer is (pointer and string arguments,
+ * `readValue`, `readArray`, ...) and the mapping is released when the
+ * Buffer is garbage collected.
+ *
+ * Mappings are read-only by default. Writing into a read-only mapping is a
+ * protection fault that terminates the process, exactly like writing
+ * through a `const` pointer in C would.
+ *
+ * @example Hand a data file to a C parser
+ * ```javascript
+ * import { mmap, madvise } from 'node-ctypes';
+ *
+ * const data = mmap('/data/trace.bin', { advise: 'sequential' });
+ * lib.parse_trace(data, BigInt(data.length));
+ * ```
+ *
+ * @example Map a window and prefetch it
+ * ```javascript
+ * const page = mmap('/data/index.db', { offset: 1 << 20, length: 65536 });
+ * madvise(page, 'willneed');
+ * ```
+ */
+
+import { fileURLToPath } from "node:url";
+
+/**
+ * Maps a file into memory.
+ *
+ * @param {string|URL} path - File to map
+ * @param {Object} [options]
+ * @param {number} [options.offset=0] - First byte of the file to map (any
+ *   value: alignment to pages is handled natively)
+ * @param {number} [options.length] - Bytes to map (default: up to the end
+ *   of the file)
+ * @param {boolean} [options.readonly=true] - Map read-only; `false` maps
+ *   the file shared and writable, so writes reach the file
+ * @param {string} [options.advise] - Initial access hint, see {@link madvise}
+ * @param {Object} native - Native module reference
+ * @returns {Buffer} External Buffer backed by the mapping
+ */
+export function mmap(path, options, native) {
+  if (path instanceof URL) {
+    path = fileURLToPath(path);
+  }
+  return native.mmap(path, options);
+}
+
+/**
+ * Gives the kernel an access hint for a mapped Buffer (or a range of it).
+ *
+ * `'willneed'` prefetches the pages into the page cache, `'dontneed'` lets
+ * the kernel drop them (they are read back from the file on next access),
+ * `'sequential'` / `'random'` tune read-ahead and `'normal'` restores the
+ * default.
+ *
+ * @param {Buffer} buffer - Buffer returned by `mmap()` (or a view of one)
+ * @param {string} advice - `'normal'`, `'sequential'`, `'random'`,
+ *   `'willneed'` or `'dontneed'`
+ * @param {number} [offset=0] - Start of the range within `buffer`
+ * @param {number} [length] - Range length (default: to the end of `buffer`)
+ * @param {Object} native - Native module reference
+ * @returns {boolean} false when the platform has no equivalent hint
+ * @throws {TypeError} If `buffer` is not backed by `mmap()`
+ */
+export function madvise(buffer, advice, offset, length, native) {
+  return native.madvise(buffer, advice, offset, length);
+}
@@ -102,7 +102,8 @@ export function createMemoryOps(deps) {
         }
         return type._reader(ptr, offset);
       }
-      if (typeof ptr === "bigint" || typeof ptr === "number") {
+      // Indirizzo raw (BigInt / Number) o handle di puntatore (pointerMode "number")
+      if (typeof ptr === "bigint" || typeof ptr === "number" || (ptr !== null && typeof ptr === "object")) {
         const size = type._size || sizeof(type);
         const buf = ptrToBuffer(ptr, size + offset);
         return type._reader(buf, offset);
@@ -32,7 +32,7 @@
  * **Python ctypes Compatibility**:
  * Direct equivalent to Python's `ctypes.addressof()`.
  *
- * @param {Buffer|bigint|number} ptr - Buffer or address to get address of
+ * @param {Buffer|bigint|number|object} ptr - Buffer, address or pointer handle to get address of
  * @param {Function} alloc - alloc function reference
  * @param {Object} native - Native module reference
  * @returns {bigint} Memory address as BigInt
@@ -69,6 +69,8 @@ export function addressOf(ptr, alloc, native) {
     return BigInt(tempBuf.readUInt32LE(0));
   }
   if (typeof ptr === "bigint") return ptr;
+  // Handle di puntatore (pointerMode: "number", indirizzo oltre 2^53)
+  if (ptr !== null && typeof ptr === "object" && native.addressOf) return native.addressOf(ptr);
   return BigInt(ptr);
 }
 
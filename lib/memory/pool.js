@@ -0,0 +1,146 @@
+/**
+ * @file pool.js
+ * @module memory/pool
+ * @description Slab pool for small, short-lived native buffers.
+ *
+ * `alloc()` and `create_string_buffer()` create a separate Buffer (and a
+ * separate ArrayBuffer with its own external-memory accounting) for every
+ * object. A pool reserves larger slabs once and hands out Buffer views over
+ * fixed-size blocks, so thousands of 4–64-byte structs and scalars cost a
+ * handful of ArrayBuffers instead of one each.
+ *
+ * Blocks go back to the pool explicitly (`release`, `reset`) or at the end
+ * of a scope (`scope(fn)`, or `using` on `scope()`). A released Buffer is
+ * still a valid view, but its block can be handed out again: treat it like
+ * freed memory. Requests larger than `maxBlockSize` fall back to ordinary
+ * Buffers, which the GC owns.
+ *
+ * @example Explicit release
+ * ```javascript
+ * import { pool } from 'node-ctypes';
+ *
+ * const p = pool();
+ * const pt = p.alloc(Point.size);
+ * lib.move_point(pt, 1, 2);
+ * p.release(pt);
+ * ```
+ *
+ * @example Scope-based release
+ * ```javascript
+ * p.scope(() => {
+ *   const name = p.cstring("eth0");
+ *   const out = p.alloc(16);
+ *   lib.if_query(name, out);
+ *   return out.readInt32LE(0); // read before the scope releases `out`
+ * });
+ * ```
+ */
+
+/**
+ * Adds the JS-only helpers to the native SlabPool prototype (once).
+ * @private
+ */
+function installPoolHelpers(SlabPool) {
+  const proto = SlabPool.prototype;
+  if (proto._ctypesHelpers) {
+    return;
+  }
+
+  Object.defineProperties(proto, {
+    _ctypesHelpers: { value: true },
+
+    /**
+     * Runs `fn(pool)` inside a scope: every block allocated meanwhile (and
+     * not released yet) goes back to the pool when `fn` returns or throws.
+     * Without `fn`, opens a scope and returns a disposable that closes it.
+     * `fn` must be synchronous: blocks used after an `await` would already
+     * be released.
+     */
+    scope: {
+      value: function scope(fn) {
+        if (fn === undefined) {
+          this.beginScope();
+          const pool = this;
+          let open = true;
+          const close = () => {
+            if (open) {
+              open = false;
+              pool.endScope();
+            }
+          };
+          return { close, [Symbol.dispose]: close };
+        }
+        if (typeof fn !== "function") {
+          throw new TypeError("pool.scope: callback must be a function");
+        }
+        this.beginScope();
+        let result;
+        try {
+          result = fn(this);
+        } finally {
+          this.endScope();
+        }
+        if (result && typeof result.then === "function") {
+          throw new TypeError("pool.scope: callback must be synchronous");
+        }
+        return result;
+      },
+    },
+
+    /**
+     * Null-terminated UTF-8 copy of `str` in a pool block.
+     */
+    cstring: {
+      value: function cstring(str) {
+        const len = Buffer.byteLength(str, "utf8");
+        const buf = this.alloc(len + 1);
+        buf.write(str, 0, len, "utf8");
+        return buf;
+      },
+    },
+
+    /**
+     * Pool counterpart of `create_string_buffer(size | string | Buffer)`.
+     */
+    create_string_buffer: {
+      value: function create_string_buffer(init) {
+        if (typeof init === "number") {
+          return this.alloc(init);
+        }
+        if (typeof init === "string") {
+          return this.cstring(init);
+        }
+        if (Buffer.isBuffer(init)) {
+          const buf = this.alloc(init.length + 1);
+          init.copy(buf);
+          return buf;
+        }
+        throw new TypeError("create_string_buffer requires number, string, or Buffer");
+      },
+    },
+
+    [Symbol.dispose]: {
+      value: function dispose() {
+        this.reset();
+        this.trim();
+      },
+    },
+  });
+}
+
+/**
+ * Creates a slab pool.
+ *
+ * @param {Object} [options]
+ * @param {number} [options.slabSize=65536] - Bytes per slab (power of two,
+ *   4 KiB – 16 MiB)
+ * @param {number} [options.maxBlockSize=256] - Largest pooled request
+ *   (power of two, 8 – 4096); size classes are the powers of two up to it
+ * @param {Object} native - Native module reference
+ * @returns {Object} SlabPool with `alloc`, `release`, `reset`, `trim`,
+ *   `scope`, `cstring`, `create_string_buffer` and `stats`
+ */
+export function pool(options, native) {
+  installPoolHelpers(native.SlabPool);
+  return new native.SlabPool(options);
+}
@@ -14,8 +14,13 @@
  * read/write a private ctypes slot, not the system errno/GetLastError — if
  * you want to capture the system value after an FFI call, open the library
  * with `{ use_last_error: true }` / `{ use_errno: true }`.
+ *
+ * Also provides `OSError` and `resolveErrcheckPolicy`, the error factories
+ * behind declarative errcheck policies (`fn.errcheck = { fail, code }`).
  */
 
+import os from "node:os";
+
 // Lazy-loaded Windows error functions
 let _win_error_funcs = null;
 
@@ -120,3 +125,74 @@ export function WinError(code, WinDLL, alloc, c_uint32, c_void, c_void_p) {
   err.winerror = code;
   return err;
 }
+
+// errno → nome simbolico (ENOENT...), costruita al primo uso
+let _errno_names = null;
+
+/**
+ * Creates an Error object from an errno value, like Python's
+ * `OSError(errno, strerror)`.
+ *
+ * @param {number} code - errno value (e.g. captured with `use_errno`)
+ * @returns {Error} Error with `.errno = code` and, when known, `.code`
+ *   set to the symbolic name (`"ENOENT"`)
+ */
+export function OSError(code) {
+  if (!_errno_names) {
+    _errno_names = new Map();
+    for (const [name, value] of Object.entries(os.constants.errno)) {
+      if (!_errno_names.has(value)) _errno_names.set(value, name);
+    }
+  }
+  const name = _errno_names.get(code);
+  const err = new Error(`[Errno ${code}] ${name ?? "Unknown error"}`);
+  err.errno = code;
+  if (name) err.code = name;
+  return err;
+}
+
+const ERRCHECK_FAILS = new Set(["nonzero", "zero", "negative", "minusOne"]);
+const ERRCHECK_CODES = new Set(["result", "errno", "lastError"]);
+
+/**
+ * Normalizes a declarative errcheck policy for `FFIFunction.setErrcheckPolicy`.
+ * Without `error`, the factory follows `code`: `OSError` for `"errno"`,
+ * `winError` for `"lastError"` on Windows (`OSError` elsewhere, where the
+ * last error is errno), and an Error carrying `.result` for `"result"`.
+ *
+ * @param {{ fail: string, code?: string, error?: Function }} policy
+ * @param {string} funcName - Function name, used in default messages
+ * @param {Function} winError - `WinError(code)` of the public API
+ * @returns {{ fail: string, code: string, error: Function }}
+ * @private
+ */
+export function resolveErrcheckPolicy(policy, funcName, winError) {
+  const { fail, code = "result", error } = policy;
+  if (!ERRCHECK_FAILS.has(fail)) {
+    throw new TypeError("errcheck policy: fail must be 'nonzero', 'zero', 'negative' or 'minusOne'");
+  }
+  if (!ERRCHECK_CODES.has(code)) {
+    throw new TypeError("errcheck policy: code must be 'result', 'errno' or 'lastError'");
+  }
+  if (error !== undefined && typeof error !== "function") {
+    throw new TypeError("errcheck policy: error must be a function");
+  }
+  if (error) {
+    return { fail, code, error };
+  }
+  if (code === "errno" || (code === "lastError" && process.platform !== "win32")) {
+    return { fail, code, error: (errno) => OSError(errno) };
+  }
+  if (code === "lastError") {
+    return { fail, code, error: (winerror) => winError(winerror) };
+  }
+  return {
+    fail,
+    code,
+    error: (result) => {
+      const err = new Error(`${funcName} failed with result ${result}`);
+      err.result = result;
+      return err;
+    },
+  };
+}
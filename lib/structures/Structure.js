@@ -140,9 +140,20 @@ export function createStructureClass(alloc, struct, bitfield, ptrToBuffer) {
     constructor(...args) {
       const Ctor = this.constructor;
       const def = Ctor._structDef || Ctor._buildStruct();
-      // Allocate buffer for instance
-      let buf = alloc(def.size);
-      buf.fill(0);
+      let buf;
+      if (args.length === 1 && Buffer.isBuffer(args[0])) {
+        // new Point(buffer) - wrap existing buffer (nessuna allocazione: è
+        // anche il path delle view lazy dei return by-value)
+        buf = args[0];
+        // Validate buffer size matches struct size
+        if (buf.length < def.size) {
+          throw new RangeError(`Buffer size (${buf.length}) is smaller than struct size (${def.size})`);
+        }
+      } else {
+        // Allocate buffer for instance
+        buf = alloc(def.size);
+        buf.fill(0);
+      }
 
       // Support positional args: new Point(10,20)
       if (args.length === 1 && typeof args[0] === "object" && !Array.isArray(args[0]) && !Buffer.isBuffer(args[0])) {
@@ -150,14 +161,7 @@ export function createStructureClass(alloc, struct, bitfield, ptrToBuffer) {
         for (const [k, v] of Object.entries(initial)) {
           def.set(buf, k, v);
         }
-      } else if (args.length === 1 && Buffer.isBuffer(args[0])) {
-        // new Point(buffer) - wrap existing buffer
-        buf = args[0];
-        // Validate buffer size matches struct size
-        if (buf.length < def.size) {
-          throw new RangeError(`Buffer size (${buf.length}) is smaller than struct size (${def.size})`);
-        }
-      } else if (args.length > 0) {
+      } else if (args.length > 1 || (args.length === 1 && !Buffer.isBuffer(args[0]))) {
         // Positional mapping to non-anonymous declared fields order
         const ordered = def.fields.filter((f) => !f.isAnonymous);
         for (let i = 0; i < Math.min(args.length, ordered.length); i++) {
@@ -57,6 +57,11 @@
  *
  * @param {Function|Object} elementType - Element type (SimpleCData class, Structure/Union class, or type object)
  * @param {number} count - Number of elements in the array
+ * @param {Object} [options] - Array options
+ * @param {boolean} [options.typed=false] - Expose elements as a TypedArray
+ *   (numeric SimpleCData elements only): `create()`/`wrap()` return a
+ *   TypedArray view, and native array returns / struct-by-value fields
+ *   come back as a TypedArray copy instead of a JS array
  * @param {Function} sizeof - sizeof function reference
  * @param {Function} alloc - alloc function reference
  * @param {Function} readValue - readValue function reference
@@ -64,6 +69,7 @@
  * @param {Function} Structure - Structure class reference
  * @param {Function} Union - Union class reference
  * @param {Function} ArrayType - Native ArrayType class reference (if available)
+ * @param {Object} CType - Native CType enum (for `typed` arrays)
  * @returns {Object} Array type definition with create and wrap methods
  * @throws {TypeError} If elementType is not a valid type
  *
@@ -103,8 +109,14 @@
  * points[0].x = 10;
  * points[0].y = 20;
  * ```
+ *
+ * @example TypedArray elements
+ * ```javascript
+ * const Samples = array(c_double, 512, { typed: true });
+ * const s = Samples.create(new Float64Array(512)); // Float64Array view
+ * ```
  */
-export function array(elementType, count, sizeof, alloc, readValue, writeValue, Structure, Union, ArrayType) {
+export function array(elementType, count, options, sizeof, alloc, readValue, writeValue, Structure, Union, ArrayType, CType) {
   // Validate elementType: accept SimpleCData classes, Structure/Union classes,
   // or native CType-like objects.
   const isSimple = typeof elementType === "function" && elementType._isSimpleCData;
@@ -114,6 +126,12 @@ export function array(elementType, count, sizeof, alloc, readValue, writeValue,
     throw new TypeError("array elementType must be a SimpleCData class or a Structure/Union class");
   }
 
+  const typed = options?.typed === true;
+  const TypedArrayCtor = typed ? typedArrayConstructorFor(elementType, isSimple, CType) : null;
+  if (typed && !TypedArrayCtor) {
+    throw new TypeError("typed arrays require a numeric SimpleCData element type");
+  }
+
   const elementSize = sizeof(elementType);
   // Array alignment == element alignment (C standard), NOT element size.
   // For Structure/Union: ask the class. For SimpleCData: alignment == size
@@ -128,7 +146,7 @@ export function array(elementType, count, sizeof, alloc, readValue, writeValue,
     // campo di struct-by-value (il native StructType.addField duck-typing
     // su `getLength` funziona con lo shim JS ma `ObjectWrap::Unwrap` no —
     // serve un'istanza reale).
-    nativeArray = new ArrayType(elementType._type, count);
+    nativeArray = typed ? new ArrayType(elementType._type, count, { typed: true }) : new ArrayType(elementType._type, count);
   } else {
     // Fallback shim (caso Structure/Union come element, o ArrayType
     // non disponibile): il native StructType.addField non può unwrappare
@@ -148,7 +166,7 @@ export function array(elementType, count, sizeof, alloc, readValue, writeValue,
   }
 
   // Wrap function that returns a Proxy for array-like indexing
-  const wrap = function (buffer) {
+  const wrapProxy = function (buffer) {
     return new Proxy(buffer, {
       get(target, prop, receiver) {
         // Special case for _buffer to return the underlying buffer
@@ -244,6 +262,45 @@ export function array(elementType, count, sizeof, alloc, readValue, writeValue,
     });
   };
 
+  // typed: vista TypedArray sullo stesso buffer (scritture visibili a C).
+  // Se il buffer non è allineato all'elemento (struct packed) la vista non
+  // è costruibile: si ritorna una copia.
+  const wrapTyped = function (buffer) {
+    if (buffer.byteOffset % TypedArrayCtor.BYTES_PER_ELEMENT === 0) {
+      return new TypedArrayCtor(buffer.buffer, buffer.byteOffset, count);
+    }
+    const copy = new TypedArrayCtor(count);
+    new Uint8Array(copy.buffer).set(buffer.subarray(0, count * elementSize));
+    return copy;
+  };
+
+  const wrap = typed ? wrapTyped : wrapProxy;
+
+  // Scrive `values` (Buffer, TypedArray o Array JS) nell'array che inizia a
+  // `offset` dentro `target`. Usato da create() e dai setter dei campi struct.
+  const assign = function (target, offset, values) {
+    if (Buffer.isBuffer(values)) {
+      // Byte grezzi
+      values.copy(target, offset, 0, Math.min(values.length, count * elementSize));
+      return;
+    }
+    if (TypedArrayCtor && values instanceof TypedArrayCtor) {
+      // Stessa rappresentazione: copia dei byte
+      const n = Math.min(values.length, count) * elementSize;
+      Buffer.from(values.buffer, values.byteOffset, n).copy(target, offset);
+      return;
+    }
+    if (Array.isArray(values) || ArrayBuffer.isView(values)) {
+      for (let i = 0; i < Math.min(values.length, count); i++) {
+        writeValue(target, elementType, values[i], offset + i * elementSize);
+      }
+    } else if (typeof values === "string") {
+      for (let i = 0; i < Math.min(values.length, count); i++) {
+        writeValue(target, elementType, values.charCodeAt(i), offset + i * elementSize);
+      }
+    }
+  };
+
   // Return a wrapper object that delegates to nativeArray but overrides create()
   return {
     // Type information
@@ -255,19 +312,13 @@ export function array(elementType, count, sizeof, alloc, readValue, writeValue,
     getLength: () => nativeArray.getLength(),
     getAlignment: () => nativeArray.getAlignment(),
 
-    // create automatically returns the proxy
+    // create automatically returns the proxy (or the TypedArray view)
     create: (values) => {
-      const size = count * sizeof(elementType);
+      const size = count * elementSize;
       const buffer = alloc(size);
       buffer.fill(0);
-      if (Array.isArray(values)) {
-        for (let i = 0; i < Math.min(values.length, count); i++) {
-          writeValue(buffer, elementType, values[i], i * sizeof(elementType));
-        }
-      } else if (typeof values === "string") {
-        for (let i = 0; i < Math.min(values.length, count); i++) {
-          writeValue(buffer, elementType, values.charCodeAt(i), i * sizeof(elementType));
-        }
+      if (values !== undefined) {
+        assign(buffer, 0, values);
       }
       return wrap(buffer);
     },
@@ -278,7 +329,52 @@ export function array(elementType, count, sizeof, alloc, readValue, writeValue,
     // For compatibility, expose the native array (needed for StructType.addField)
     _native: nativeArray,
 
+    // @internal: write values at an offset (struct field setters)
+    _assign: assign,
+
+    // true if elements are exposed as a TypedArray
+    typed,
+
     // Helper to check if this is an ArrayType wrapper
     _isArrayType: true,
   };
 }
+
+/**
+ * TypedArray constructor matching a numeric SimpleCData element type.
+ * Mirrors the native CTypeToTypedArrayType mapping (types.cc).
+ *
+ * @param {Function} elementType - Element type
+ * @param {boolean} isSimple - Whether elementType is a SimpleCData class
+ * @param {Object} CType - Native CType enum
+ * @returns {Function|null} TypedArray constructor, or null if not numeric
+ * @private
+ */
+function typedArrayConstructorFor(elementType, isSimple, CType) {
+  if (!isSimple || !CType) {
+    return null;
+  }
+  switch (elementType._type) {
+    case CType.FLOAT:
+      return Float32Array;
+    case CType.DOUBLE:
+      return Float64Array;
+    case CType.STRING:
+    case CType.WSTRING:
+    case CType.VOID:
+      return null;
+  }
+  const signed = [CType.INT8, CType.INT16, CType.INT32, CType.INT64, CType.SSIZE_T, CType.LONG].includes(elementType._type);
+  switch (elementType._size) {
+    case 1:
+      return signed ? Int8Array : Uint8Array;
+    case 2:
+      return signed ? Int16Array : Uint16Array;
+    case 4:
+      return signed ? Int32Array : Uint32Array;
+    case 8:
+      return signed ? BigInt64Array : BigUint64Array;
+    default:
+      return null;
+  }
+}
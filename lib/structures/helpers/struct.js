@@ -34,7 +34,7 @@
  */
 
 import { _readBitField, _writeBitField } from "./bitfield.js";
-import { buildWrapper } from "./wrap.js";
+import { buildViewClass } from "./wrap.js";
 
 /**
  * Creates a struct type definition with proper alignment and padding.
@@ -578,11 +578,12 @@ export function struct(fields, options = {}, sizeof, alloc, readValue, writeValu
     /**
      * Alloca e inizializza una nuova istanza
      * @param {Object} [values] - Valori iniziali
-     * @returns {Proxy} Proxy-based struct instance
+     * @returns {Buffer} struct instance (view generata, vedi buildViewClass)
      */
     create(values = {}) {
-      const buf = alloc(totalSize);
-      buf.fill(0); // Inizializza a zero
+      const raw = alloc(totalSize);
+      raw.fill(0); // Inizializza a zero
+      const buf = new StructView(raw.buffer, raw.byteOffset, raw.length);
 
       // Prima imposta i campi diretti
       for (const field of fieldDefs) {
@@ -602,10 +603,17 @@ export function struct(fields, options = {}, sizeof, alloc, readValue, writeValu
         }
       }
 
-      return new Proxy(buf, buildWrapper(structDef, {
-        instanceTag: "StructInstance",
-        exposeAnonymous: true,
-      }));
+      return buf;
+    },
+
+    /**
+     * Wrapper lazy su un buffer esistente (nessuna copia): i campi vengono
+     * decodificati solo quando letti. Stesso wrapper di create().
+     * @param {Buffer} buf - Buffer della struttura (almeno `size` byte)
+     * @returns {Buffer} struct instance che condivide la memoria di `buf`
+     */
+    wrap(buf) {
+      return new StructView(buf.buffer, buf.byteOffset, buf.length);
     },
 
     /**
@@ -662,12 +670,7 @@ export function struct(fields, options = {}, sizeof, alloc, readValue, writeValu
         // Nested struct (senza dot = ritorna intero oggetto)
         if (field.isNested) {
           const nestedBuf = buf.subarray(field.offset, field.offset + field.size);
-          return field.type.create
-            ? new Proxy(nestedBuf, buildWrapper(field.type, {
-                instanceTag: "NestedStructInstance",
-                exposeAnonymous: true,
-              }))
-            : field.type.toObject(nestedBuf);
+          return field.type.wrap ? field.type.wrap(nestedBuf) : field.type.toObject(nestedBuf);
         }
 
         // POINTER() field — return PointerInstance
@@ -682,8 +685,10 @@ export function struct(fields, options = {}, sizeof, alloc, readValue, writeValu
           return field.type.wrap(arrayBuf);
         }
 
-        // Tipo base - fast path!
-        return readValue(buf, field.type, field.offset);
+        // Tipo base - fast path! Reader precompilato (JS puro, rispetta
+        // `swapped`); readValue nativo solo se manca
+        const reader = fieldReaders[fieldName];
+        return reader !== undefined ? reader(buf) : readValue(buf, field.type, field.offset);
       }
 
       // supporto per accesso nested 'outer.inner' o anonymous fields
@@ -786,18 +791,19 @@ export function struct(fields, options = {}, sizeof, alloc, readValue, writeValu
         if (field.isArray) {
           if (Buffer.isBuffer(value)) {
             value.copy(buf, field.offset, 0, field.size);
-          } else if (Array.isArray(value)) {
-            const arrayBuf = buf.subarray(field.offset, field.offset + field.size);
-            const wrapped = field.type.wrap(arrayBuf);
-            for (let i = 0; i < Math.min(value.length, field.type.length); i++) {
-              wrapped[i] = value[i];
-            }
+          } else if (Array.isArray(value) || ArrayBuffer.isView(value)) {
+            field.type._assign(buf, field.offset, value);
           }
           return;
         }
 
         // Tipo base - fast path!
-        writeValue(buf, field.type, value, field.offset);
+        const writer = fieldWriters[fieldName];
+        if (writer !== undefined) {
+          writer(buf, value);
+        } else {
+          writeValue(buf, field.type, value, field.offset);
+        }
         return;
       }
 
@@ -854,13 +860,9 @@ export function struct(fields, options = {}, sizeof, alloc, readValue, writeValu
         if (Buffer.isBuffer(value)) {
           // Copia buffer array
           value.copy(buf, field.offset, 0, field.size);
-        } else if (Array.isArray(value)) {
-          // Inizializza da array JavaScript
-          const arrayBuf = buf.subarray(field.offset, field.offset + field.size);
-          const wrapped = field.type.wrap(arrayBuf);
-          for (let i = 0; i < Math.min(value.length, field.type.length); i++) {
-            wrapped[i] = value[i];
-          }
+        } else if (Array.isArray(value) || ArrayBuffer.isView(value)) {
+          // Inizializza da array JavaScript o TypedArray
+          field.type._assign(buf, field.offset, value);
         }
         return;
       }
@@ -917,7 +919,8 @@ export function struct(fields, options = {}, sizeof, alloc, readValue, writeValu
           result[field.name] = field.type.wrap(arrayBuf);
         } else {
           // Tipo base - lettura diretta
-          result[field.name] = readValue(buf, field.type, field.offset);
+          const reader = fieldReaders[field.name];
+          result[field.name] = reader !== undefined ? reader(buf) : readValue(buf, field.type, field.offset);
         }
       }
 
@@ -939,6 +942,13 @@ export function struct(fields, options = {}, sizeof, alloc, readValue, writeValu
     },
   };
 
+  // Classe view del layout: getter/setter sul prototype al posto del Proxy
+  const StructView = buildViewClass(structDef, {
+    instanceTag: "StructInstance",
+    exposeAnonymous: true,
+  });
+  structDef._viewClass = StructView;
+
   // fromObject: write plain object values into buffer
   structDef.fromObject = function (buf, obj) {
     for (const [key, value] of Object.entries(obj)) {
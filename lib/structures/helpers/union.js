@@ -338,6 +338,15 @@ export function union(fields, options, sizeof, alloc, readValue, writeValue, _is
         }
       }
 
+      return unionDef.wrap(buf);
+    },
+
+    /**
+     * Wrapper lazy su un buffer esistente (nessuna copia), come create().
+     * @param {Buffer} buf - Buffer della union (almeno `size` byte)
+     * @returns {Proxy} Proxy-based union instance
+     */
+    wrap(buf) {
       // Union: exposeAnonymous=false — i sotto-campi di _anonymous_ non
       // vengono elevati al livello dell'istanza.
       return new Proxy(buf, buildWrapper(unionDef, {
@@ -370,6 +379,10 @@ export function union(fields, options, sizeof, alloc, readValue, writeValue, _is
       // Nested struct
       if (field.isNested) {
         const nestedBuf = buf.subarray(field.offset, field.offset + field.size);
+        // Nested struct(): view generata (vedi buildViewClass), niente Proxy
+        if (field.type._viewClass !== undefined) {
+          return field.type.wrap(nestedBuf);
+        }
         // Proxy-based nested instance
         return new Proxy(nestedBuf, {
           get(target, prop, receiver) {
@@ -488,11 +501,8 @@ export function union(fields, options, sizeof, alloc, readValue, writeValue, _is
       if (field.isArray) {
         if (Buffer.isBuffer(value)) {
           value.copy(buf, field.offset, 0, field.size);
-        } else if (Array.isArray(value)) {
-          const wrapped = field.type.wrap(buf.subarray(field.offset, field.offset + field.size));
-          for (let i = 0; i < Math.min(value.length, field.type.length); i++) {
-            wrapped[i] = value[i];
-          }
+        } else if (Array.isArray(value) || ArrayBuffer.isView(value)) {
+          field.type._assign(buf, field.offset, value);
         } else if (value && value._buffer && Buffer.isBuffer(value._buffer)) {
           // Handle array proxy instances
           value._buffer.copy(buf, field.offset, 0, field.size);
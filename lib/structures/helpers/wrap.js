@@ -9,13 +9,20 @@
  * `ProxyHandler` con 6 trap (get/set/has/ownKeys/getOwnPropertyDescriptor
  * + `Symbol.toStringTag`). I due flag discriminano:
  *   - `instanceTag`     — stringa per `Symbol.toStringTag`
- *     ("StructInstance", "UnionInstance", "NestedStructInstance", ...)
+ *     ("UnionInstance", ...)
  *   - `exposeAnonymous` — `true` per Structure (campi di `_anonymous_`
  *     elevati come top-level), `false` per Union.
  *
- * È usato da 3 call site: outer struct, nested struct, outer union.
- * Il nested union ha semantiche residue (filtro per-field
- * `!f.isAnonymous`) gestite inline in `union.js`.
+ * È usato dalle union (outer union; il nested union ha semantiche residue,
+ * filtro per-field `!f.isAnonymous`, gestite inline in `union.js`).
+ *
+ * `buildViewClass(def, { instanceTag, exposeAnonymous })` è l'alternativa
+ * senza Proxy usata da `struct()`: genera una classe per layout, sottoclasse
+ * di Uint8Array con prototype Buffer (come il FastBuffer interno di Node),
+ * con getter/setter sul prototype compilati dalla tabella dei campi. Le
+ * istanze sono Buffer a tutti gli effetti (Buffer.isBuffer, readInt32LE & co.,
+ * N-API) e l'accesso ai campi resta monomorfico: niente trap, niente
+ * Proxy intermedi per i nested.
  */
 
 // Proprietà meta del Buffer che NON vanno mai interpretate come field name.
@@ -28,6 +35,22 @@ const BUFFER_META_PROPS = new Set([
   "BYTES_PER_ELEMENT",
 ]);
 
+// Proprietà che una view non ridefinisce mai: sono quelle del Buffer (usate
+// anche dai getter nested qui sotto) o i meta delle istanze. Un campo con
+// questo nome resta raggiungibile via def.get / def.set.
+const VIEW_RESERVED_PROPS = new Set([...BUFFER_META_PROPS, "constructor", "_buffer", "toObject"]);
+
+/**
+ * Base comune delle view generate da buildViewClass. `subarray()` (species)
+ * ritorna un ByteView senza accessor, non un'altra view del layout.
+ */
+class ByteView extends Uint8Array {
+  static get [Symbol.species]() {
+    return ByteView;
+  }
+}
+Object.setPrototypeOf(ByteView.prototype, Buffer.prototype);
+
 /**
  * Costruisce un Proxy handler per un'istanza Structure/Union.
  *
@@ -144,3 +167,108 @@ export function buildWrapper(def, { instanceTag, exposeAnonymous }) {
     },
   };
 }
+
+/**
+ * Genera la classe view di un layout struct (vedi header). Stessa
+ * superficie del Proxy di buildWrapper: campi (e sotto-campi `_anonymous_`
+ * se `exposeAnonymous`), `_buffer`, `toObject()`, `Symbol.toStringTag`.
+ * A differenza del Proxy, `Object.keys()` / spread vedono gli indici del
+ * Buffer: per un plain object si usa `toObject()`.
+ *
+ * @param {object} def - structDef. Oltre ai campi richiesti da buildWrapper
+ *   usa `_viewClass` dei nested struct (se presente) per costruire la view
+ *   del sotto-buffer senza passare da def.get.
+ * @param {object} opts
+ * @param {string}  opts.instanceTag
+ * @param {boolean} opts.exposeAnonymous
+ * @returns {Function} classe con costruttore `(arrayBuffer, byteOffset, length)`
+ */
+export function buildViewClass(def, { instanceTag, exposeAnonymous }) {
+  const { fieldReaders, fieldWriters } = def;
+
+  class StructView extends ByteView {}
+  const proto = StructView.prototype;
+
+  const define = (name, get, set) => {
+    if (VIEW_RESERVED_PROPS.has(name)) return;
+    Object.defineProperty(proto, name, { get, set, enumerable: true, configurable: true });
+  };
+
+  for (const f of def.fields) {
+    if (f.isAnonymous) {
+      if (exposeAnonymous && f.type?.fields) {
+        for (const sf of f.type.fields) {
+          const subName = sf.name;
+          define(
+            subName,
+            function () {
+              return def.get(this, subName);
+            },
+            function (value) {
+              def.set(this, subName, value);
+            },
+          );
+        }
+      }
+      continue;
+    }
+
+    const name = f.name;
+    // FAST PATH: reader/writer precompilati (scalari, POINTER, bitfield)
+    const reader = fieldReaders?.[name];
+    const writer = fieldWriters?.[name];
+    if (reader !== undefined && writer !== undefined) {
+      define(
+        name,
+        function () {
+          return reader(this);
+        },
+        function (value) {
+          writer(this, value);
+        },
+      );
+      continue;
+    }
+
+    // Nested struct: view del sotto-buffer, stessa memoria
+    const NestedView = f.isNested ? f.type?._viewClass : undefined;
+    const getter =
+      NestedView !== undefined
+        ? ((offset, size) =>
+            function () {
+              return new NestedView(this.buffer, this.byteOffset + offset, size);
+            })(f.offset, f.size)
+        : function () {
+            return def.get(this, name);
+          };
+    define(name, getter, function (value) {
+      def.set(this, name, value);
+    });
+  }
+
+  Object.defineProperties(proto, {
+    _buffer: {
+      get() {
+        return this;
+      },
+      configurable: true,
+    },
+    toObject: {
+      value() {
+        return def.toObject(this);
+      },
+      writable: true,
+      configurable: true,
+    },
+    [Symbol.toStringTag]: {
+      get() {
+        return instanceTag;
+      },
+      configurable: true,
+    },
+    // Come il Proxy: l'istanza non è iterabile come sequenza di byte
+    [Symbol.iterator]: { value: undefined, writable: true, configurable: true },
+  });
+
+  return StructView;
+}
@@ -4,7 +4,13 @@
 #include "callback.h"
 #include "function.h"
 #include "library.h"
+#include "manifest.h"
+#include "mmap.h"
+#include "registry.h"
+#include "ring.h"
+#include "slab.h"
 #include "struct.h"
+#include "text.h"
 #include "types.h"
 #include "version.h"
 
@@ -78,6 +84,8 @@ CTypesAddon::CTypesAddon(Napi::Env env, Napi::Object exports) {
   ThreadSafeCallbackConstructor = SafeInitializeWrapper<ThreadSafeCallback>(env, "ThreadSafeCallback");
   StructTypeConstructor = SafeInitializeWrapper<StructType>(env, "StructType");
   ArrayTypeConstructor = SafeInitializeWrapper<ArrayType>(env, "ArrayType");
+  SlabPoolConstructor = SafeInitializeWrapper<SlabPool>(env, "SlabPool");
+  CompletionRingConstructor = SafeInitializeWrapper<CompletionRing>(env, "CompletionRing");
 
   // Definisci l'addon con tutte le esportazioni
   DefineAddon(exports, {
@@ -91,22 +99,45 @@ CTypesAddon::CTypesAddon(Napi::Env env, Napi::Object exports) {
                          InstanceValue("ThreadSafeCallback", ThreadSafeCallbackConstructor->Value(), napi_enumerable),
                          InstanceValue("StructType", StructTypeConstructor->Value(), napi_enumerable),
                          InstanceValue("ArrayType", ArrayTypeConstructor->Value(), napi_enumerable),
+                         InstanceValue("SlabPool", SlabPoolConstructor->Value(), napi_enumerable),
+                         InstanceValue("CompletionRing", CompletionRingConstructor->Value(), napi_enumerable),
 
                          // Funzioni helper
                          InstanceMethod("load", &CTypesAddon::LoadLibrary),
                          InstanceMethod("alloc", &CTypesAddon::Alloc),
                          InstanceMethod("readValue", &CTypesAddon::ReadValue),
                          InstanceMethod("writeValue", &CTypesAddon::WriteValue),
+                         InstanceMethod("readArray", &CTypesAddon::ReadArray),
+                         InstanceMethod("writeArray", &CTypesAddon::WriteArray),
                          InstanceMethod("sizeof", &CTypesAddon::SizeOf),
                          InstanceMethod("cstring", &CTypesAddon::CreateCString),
                          InstanceMethod("readCString", &CTypesAddon::ReadCString),
+                         InstanceMethod("readWString", &CTypesAddon::ReadWString),
                          InstanceMethod("ptrToBuffer", &CTypesAddon::PtrToBuffer),
                          InstanceMethod("addressOf", &CTypesAddon::AddressOf),
+                         // File mappati in memoria (mmap.h)
+                         InstanceMethod("mmap", &CTypesAddon::MapFile),
+                         InstanceMethod("madvise", &CTypesAddon::Madvise),
                          // Slot module-level last-error / errno (parity Python ctypes)
                          InstanceMethod("getCapturedLastError", &CTypesAddon::GetCapturedLastError),
                          InstanceMethod("setCapturedLastError", &CTypesAddon::SetCapturedLastError),
                          InstanceMethod("getCapturedErrno", &CTypesAddon::GetCapturedErrno),
                          InstanceMethod("setCapturedErrno", &CTypesAddon::SetCapturedErrno),
+                         // Worker pool dedicato per callAsync
+                         InstanceMethod("configureCallPool", &CTypesAddon::ConfigureCallPool),
+                         InstanceMethod("callPoolStats", &CTypesAddon::GetCallPoolStats),
+                         InstanceMethod("createSerialQueue", &CTypesAddon::CreateSerialQueue),
+                         // Statistiche per-funzione (stats.h)
+                         InstanceMethod("setStatsEnabled", &CTypesAddon::SetStatsEnabled),
+                         InstanceMethod("statsSnapshot", &CTypesAddon::GetStatsSnapshot),
+                         // Binding manifest: layout serializzati (manifest.h)
+                         InstanceMethod("describeTypes", &CTypesAddon::DescribeTypes),
+                         InstanceMethod("loadTypes", &CTypesAddon::LoadTypes),
+                         // Layout condivisi tra Worker thread (registry.h)
+                         InstanceMethod("exportBindings", &CTypesAddon::ExportBindings),
+                         InstanceMethod("importBindings", &CTypesAddon::ImportBindings),
+                         InstanceMethod("releaseBindings", &CTypesAddon::ReleaseBindings),
+                         InstanceMethod("sharedRegistryStats", &CTypesAddon::GetSharedRegistryStats),
 
                          // CType enum - single source of truth per i tipi
                          InstanceValue("CType", CreateCType(env), napi_enumerable),
@@ -118,7 +149,13 @@ CTypesAddon::CTypesAddon(Napi::Env env, Napi::Object exports) {
                        });
 }
 
-CTypesAddon::~CTypesAddon() {}
+CTypesAddon::~CTypesAddon() {
+  // I binding set di un Worker che termina spariscono con lui; chi li ha
+  // già importati tiene vivi i layout
+  for (uint64_t id : exported_binding_sets) {
+    RevokeBindingSet(id);
+  }
+}
 
 // ========== Helper functions ==========
 
@@ -178,7 +215,7 @@ Napi::Value CTypesAddon::ReadValue(const Napi::CallbackInfo& info) {
     ptr = reinterpret_cast<void*>(addr);
   } else if (info[0].IsNumber()) {
     ptr = reinterpret_cast<void*>(static_cast<uintptr_t>(info[0].ToNumber().Int64Value()));
-  } else {
+  } else if (!info[0].IsExternal() || !GetPointerHandle(env, info[0], ptr)) {
     Napi::TypeError::New(env, "Invalid pointer type").ThrowAsJavaScriptException();
     return env.Undefined();
   }
@@ -249,7 +286,7 @@ Napi::Value CTypesAddon::WriteValue(const Napi::CallbackInfo& info) {
     ptr = reinterpret_cast<void*>(addr);
   } else if (info[0].IsNumber()) {
     ptr = reinterpret_cast<void*>(static_cast<uintptr_t>(info[0].ToNumber().Int64Value()));
-  } else {
+  } else if (!info[0].IsExternal() || !GetPointerHandle(env, info[0], ptr)) {
     Napi::TypeError::New(env, "Invalid pointer type").ThrowAsJavaScriptException();
     return env.Undefined();
   }
@@ -305,6 +342,171 @@ Napi::Value CTypesAddon::WriteValue(const Napi::CallbackInfo& info) {
   return Napi::Number::New(env, written);
 }
 
+// Tipo elemento per readArray / writeArray: primitivo con un TypedArray
+// canonico. false con TypeError JS pendente.
+static bool GetBulkElementType(Napi::Env env, const Napi::Value& value, const char* fn, CType& type) {
+  napi_typedarray_type ta_type;
+  if (!value.IsNumber() || !IsValidCType(value.As<Napi::Number>().Int32Value())) {
+    Napi::TypeError::New(env, std::format("{}: type must be a CType enum value (number)", fn))
+      .ThrowAsJavaScriptException();
+    return false;
+  }
+  type = static_cast<CType>(value.As<Napi::Number>().Int32Value());
+  if (!CTypeToTypedArrayType(type, ta_type)) {
+    Napi::TypeError::New(env, std::format("{}: type must be a numeric primitive (got {})", fn, CTypeToName(type)))
+      .ThrowAsJavaScriptException();
+    return false;
+  }
+  return true;
+}
+
+// readArray(ptr, type, count[, stride[, out]]) -> TypedArray
+Napi::Value CTypesAddon::ReadArray(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 3) {
+    Napi::TypeError::New(env, "Expected (ptr, type, count[, stride[, out]])").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  uint8_t* ptr = nullptr;
+  size_t limit = 0;
+  CType type;
+  size_t count = 0;
+  if (!GetPointerArg(env, info[0], ptr, limit) || !GetBulkElementType(env, info[1], "readArray", type) ||
+      !GetSizeArg(env, info[2], "count", count)) {
+    return env.Undefined();
+  }
+
+  const size_t elem_size = CTypeSize(type);
+  size_t stride = elem_size;
+  if (info.Length() > 3 && !info[3].IsUndefined()) {
+    if (!GetSizeArg(env, info[3], "stride", stride)) {
+      return env.Undefined();
+    }
+    if (stride < elem_size) {
+      Napi::RangeError::New(env, std::format("stride must be >= element size ({})", elem_size))
+        .ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+  }
+
+  if (!CheckStridedSpan(env, count, stride, elem_size, limit)) {
+    return env.Undefined();
+  }
+  if (!ptr && count > 0) {
+    Napi::Error::New(env, "Cannot read from null pointer").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  // Destinazione: `out` riusato se compatibile, altrimenti TypedArray nuovo
+  void* data = nullptr;
+  napi_value result;
+  if (info.Length() > 4 && !info[4].IsUndefined()) {
+    napi_typedarray_type out_type;
+    size_t out_length = 0;
+    bool is_typed = false;
+    napi_is_typedarray(env, info[4], &is_typed);
+    if (!is_typed ||
+        napi_get_typedarray_info(env, info[4], &out_type, &out_length, &data, nullptr, nullptr) != napi_ok ||
+        !TypedArrayMatchesCType(out_type, type)) {
+      Napi::TypeError::New(env, std::format("readArray: out must be a TypedArray of {}", CTypeToName(type)))
+        .ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    if (out_length < count) {
+      Napi::RangeError::New(env, std::format("readArray: out too small ({} < {})", out_length, count))
+        .ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    result = info[4];
+  } else {
+    napi_typedarray_type ta_type;
+    CTypeToTypedArrayType(type, ta_type);
+    napi_value arraybuffer;
+    if (napi_create_arraybuffer(env, count * elem_size, &data, &arraybuffer) != napi_ok ||
+        napi_create_typedarray(env, ta_type, count, arraybuffer, 0, &result) != napi_ok) {
+      Napi::Error::New(env, "Failed to allocate typed array").ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+  }
+
+  CopyStrided(data, elem_size, ptr, stride, count, elem_size);
+  return Napi::Value(env, result);
+}
+
+// writeArray(ptr, type, values[, stride]) -> numero di elementi scritti.
+// `values`: TypedArray compatibile (copia diretta) o Array JS (JSToC per
+// elemento, comunque in un solo crossing).
+Napi::Value CTypesAddon::WriteArray(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 3) {
+    Napi::TypeError::New(env, "Expected (ptr, type, values[, stride])").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  uint8_t* ptr = nullptr;
+  size_t limit = 0;
+  CType type;
+  if (!GetPointerArg(env, info[0], ptr, limit) || !GetBulkElementType(env, info[1], "writeArray", type)) {
+    return env.Undefined();
+  }
+
+  const size_t elem_size = CTypeSize(type);
+  size_t stride = elem_size;
+  if (info.Length() > 3 && !info[3].IsUndefined()) {
+    if (!GetSizeArg(env, info[3], "stride", stride)) {
+      return env.Undefined();
+    }
+    if (stride < elem_size) {
+      Napi::RangeError::New(env, std::format("stride must be >= element size ({})", elem_size))
+        .ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+  }
+
+  napi_typedarray_type ta_type;
+  void* ta_data = nullptr;
+  size_t count = 0;
+  bool is_typed = false;
+  napi_is_typedarray(env, info[2], &is_typed);
+  if (is_typed) {
+    if (napi_get_typedarray_info(env, info[2], &ta_type, &count, &ta_data, nullptr, nullptr) != napi_ok ||
+        !TypedArrayMatchesCType(ta_type, type)) {
+      Napi::TypeError::New(env, std::format("writeArray: values must be a TypedArray of {}", CTypeToName(type)))
+        .ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+  } else if (info[2].IsArray()) {
+    count = info[2].As<Napi::Array>().Length();
+  } else {
+    Napi::TypeError::New(env, "writeArray: values must be a TypedArray or an Array").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (!CheckStridedSpan(env, count, stride, elem_size, limit)) {
+    return env.Undefined();
+  }
+  if (!ptr && count > 0) {
+    Napi::Error::New(env, "Cannot write to null pointer").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (is_typed) {
+    CopyStrided(ptr, stride, ta_data, elem_size, count, elem_size);
+  } else {
+    Napi::Array values = info[2].As<Napi::Array>();
+    for (size_t i = 0; i < count; i++) {
+      if (JSToC(env, values.Get(static_cast<uint32_t>(i)), type, ptr + i * stride, elem_size) < 0) {
+        return env.Undefined();
+      }
+    }
+  }
+
+  return Napi::Number::New(env, static_cast<double>(count));
+}
+
 Napi::Value CTypesAddon::SizeOf(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
 
@@ -340,56 +542,112 @@ Napi::Value CTypesAddon::CreateCString(const Napi::CallbackInfo& info) {
   return buffer;
 }
 
-Napi::Value CTypesAddon::ReadCString(const Napi::CallbackInfo& info) {
+// Argomenti comuni di readCString / readWString: puntatore e limite in unità
+// (default 1M, contro scansioni senza fine su memoria senza terminatore). Su
+// Buffer il limite non supera mai la sua lunghezza. false con `ptr` nullo se
+// il risultato è null, false con eccezione pendente se gli argomenti sono
+// invalidi.
+static bool GetStringReadArgs(
+  const Napi::CallbackInfo& info, size_t unit_size, const uint8_t*& ptr, size_t& max_units) {
   Napi::Env env = info.Env();
+  ptr = nullptr;
 
   if (info.Length() < 1) {
     Napi::TypeError::New(env, "Pointer required").ThrowAsJavaScriptException();
-    return env.Undefined();
+    return false;
   }
-
-  const char* ptr = nullptr;
-
-  if (info[0].IsBuffer()) {
-    ptr = reinterpret_cast<const char*>(info[0].As<Napi::Buffer<uint8_t>>().Data());
-  } else if (info[0].IsBigInt()) {
-    bool lossless;
-    uint64_t addr = info[0].As<Napi::BigInt>().Uint64Value(&lossless);
-    ptr = reinterpret_cast<const char*>(addr);
-  } else if (info[0].IsNumber()) {
-    ptr = reinterpret_cast<const char*>(static_cast<uintptr_t>(info[0].ToNumber().Int64Value()));
+  const Napi::Value value = info[0];
+  if (!value.IsBuffer() && !value.IsBigInt() && !value.IsNumber() && !value.IsExternal()) {
+    return false;
   }
 
-  if (!ptr) {
-    return env.Null();
+  uint8_t* data = nullptr;
+  size_t limit = 0;
+  if (!GetPointerArg(env, value, data, limit)) {
+    return false;
   }
 
   // Set reasonable default limit to prevent DoS
-  size_t max_len = 1024 * 1024;  // 1MB default limit
+  max_units = 1024 * 1024;  // 1M unità
   if (info.Length() > 1 && info[1].IsNumber()) {
     int64_t len_raw = info[1].ToNumber().Int64Value();
     if (len_raw < 0 || len_raw > static_cast<int64_t>(SIZE_MAX / 2)) {
       Napi::RangeError::New(env, "Invalid max_len: must be positive and reasonable").ThrowAsJavaScriptException();
-      return env.Undefined();
+      return false;
     }
-    max_len = static_cast<size_t>(len_raw);
+    max_units = static_cast<size_t>(len_raw);
+  }
+  if (value.IsBuffer()) {
+    max_units = std::min(max_units, limit / unit_size);
   }
 
-  size_t len = 0;
-  while (len < max_len && ptr[len] != '\0') {
-    len++;
+  ptr = data;
+  return ptr != nullptr;
+}
+
+// Terzo argomento di readCString / readWString: la lunghezza data è esatta
+// (terminatori interni compresi) invece di un limite alla scansione
+static bool IsExactStringRead(const Napi::CallbackInfo& info) {
+  return info.Length() > 2 && info[1].IsNumber() && info[2].ToBoolean();
+}
+
+Napi::Value CTypesAddon::ReadCString(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  const uint8_t* ptr;
+  size_t max_len;
+  if (!GetStringReadArgs(info, sizeof(char), ptr, max_len)) {
+    return ptr == nullptr && !env.IsExceptionPending() ? env.Null() : env.Undefined();
   }
 
-  return Napi::String::New(env, ptr, len);
+  // exact (string_at con size): esattamente max_len byte, senza scansione
+  const char* str = reinterpret_cast<const char*>(ptr);
+  return CStringToJS(env, str, IsExactStringRead(info) ? max_len : FindCStringEnd(str, max_len));
+}
+
+Napi::Value CTypesAddon::ReadWString(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  const uint8_t* ptr;
+  size_t max_units;
+  if (!GetStringReadArgs(info, sizeof(wchar_t), ptr, max_units)) {
+    return ptr == nullptr && !env.IsExceptionPending() ? env.Null() : env.Undefined();
+  }
+
+  const bool exact = IsExactStringRead(info);
+
+  // Buffer con offset dispari: scansione con load scalari non allineati (mai
+  // oltre il terminatore), poi copia allineata delle sole unità lette
+  if (reinterpret_cast<uintptr_t>(ptr) % alignof(wchar_t) != 0) {
+    size_t len = max_units;
+    if (!exact) {
+      for (len = 0; len < max_units; len++) {
+        wchar_t unit;
+        memcpy(&unit, ptr + (len * sizeof(wchar_t)), sizeof(wchar_t));
+        if (unit == 0) {
+          break;
+        }
+      }
+    }
+    std::vector<wchar_t> aligned(len);
+    if (len > 0) {
+      memcpy(aligned.data(), ptr, len * sizeof(wchar_t));
+    }
+    return WStringToJS(env, aligned.data(), len);
+  }
+  const wchar_t* str = reinterpret_cast<const wchar_t*>(ptr);
+  return WStringToJS(env, str, exact ? max_units : FindWStringEnd(str, max_units));
 }
 
 Napi::Value CTypesAddon::AddressOf(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
-  if (info.Length() < 1 || !info[0].IsBuffer()) {
-    Napi::TypeError::New(env, "addressOf requires a Buffer argument").ThrowAsJavaScriptException();
+  void* ptr = nullptr;
+  if (info.Length() >= 1 && info[0].IsBuffer()) {
+    ptr = info[0].As<Napi::Buffer<uint8_t>>().Data();
+  } else if (info.Length() < 1 || !info[0].IsExternal() || !GetPointerHandle(env, info[0], ptr)) {
+    Napi::TypeError::New(env, "addressOf requires a Buffer or a pointer handle").ThrowAsJavaScriptException();
     return env.Undefined();
   }
-  void* ptr = info[0].As<Napi::Buffer<uint8_t>>().Data();
   return Napi::BigInt::New(env, reinterpret_cast<uint64_t>(ptr));
 }
 
@@ -409,8 +667,8 @@ Napi::Value CTypesAddon::PtrToBuffer(const Napi::CallbackInfo& info) {
     ptr = reinterpret_cast<void*>(addr);
   } else if (info[0].IsNumber()) {
     ptr = reinterpret_cast<void*>(static_cast<uintptr_t>(info[0].ToNumber().Int64Value()));
-  } else {
-    Napi::TypeError::New(env, "Address must be BigInt or Number").ThrowAsJavaScriptException();
+  } else if (!info[0].IsExternal() || !GetPointerHandle(env, info[0], ptr)) {
+    Napi::TypeError::New(env, "Address must be BigInt, Number or pointer handle").ThrowAsJavaScriptException();
     return env.Undefined();
   }
 
@@ -435,6 +693,92 @@ Napi::Value CTypesAddon::PtrToBuffer(const Napi::CallbackInfo& info) {
   });
 }
 
+Napi::Value CTypesAddon::MapFile(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsString()) {
+    Napi::TypeError::New(env, "mmap requires a file path").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  MapFileOptions options;
+  if (info.Length() > 1 && !info[1].IsUndefined()) {
+    if (!info[1].IsObject()) {
+      Napi::TypeError::New(env, "mmap options must be an object").ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    Napi::Object opts = info[1].As<Napi::Object>();
+    size_t value = 0;
+
+    Napi::Value offset = opts.Get("offset");
+    if (!offset.IsUndefined()) {
+      if (!GetSizeArg(env, offset, "offset", value)) {
+        return env.Undefined();
+      }
+      options.offset = value;
+    }
+    Napi::Value length = opts.Get("length");
+    if (!length.IsUndefined()) {
+      if (!GetSizeArg(env, length, "length", value)) {
+        return env.Undefined();
+      }
+      options.length = value;
+    }
+    Napi::Value readonly = opts.Get("readonly");
+    if (!readonly.IsUndefined()) {
+      options.readonly = readonly.ToBoolean().Value();
+    }
+    Napi::Value advise = opts.Get("advise");
+    if (!advise.IsUndefined() &&
+        (!advise.IsString() || !ParseMapAdvice(advise.As<Napi::String>().Utf8Value(), options.advice))) {
+      Napi::TypeError::New(env, "mmap advise must be 'normal', 'sequential', 'random', 'willneed' or 'dontneed'")
+        .ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+  }
+
+  return ctypes::MapFile(env, info[0].As<Napi::String>().Utf8Value(), options);
+}
+
+Napi::Value CTypesAddon::Madvise(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 2 || !info[0].IsBuffer() || !info[1].IsString()) {
+    Napi::TypeError::New(env, "Expected (buffer, advice[, offset[, length]])").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  MapAdvice advice;
+  if (!ParseMapAdvice(info[1].As<Napi::String>().Utf8Value(), advice)) {
+    Napi::TypeError::New(env, "madvise advice must be 'normal', 'sequential', 'random', 'willneed' or 'dontneed'")
+      .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Buffer<uint8_t> buf = info[0].As<Napi::Buffer<uint8_t>>();
+  size_t offset = 0;
+  size_t length = 0;
+  if (info.Length() > 2 && !info[2].IsUndefined() && !GetSizeArg(env, info[2], "offset", offset)) {
+    return env.Undefined();
+  }
+  if (offset > buf.Length()) {
+    Napi::RangeError::New(env, "madvise: offset exceeds the buffer").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  length = buf.Length() - offset;
+  if (info.Length() > 3 && !info[3].IsUndefined()) {
+    if (!GetSizeArg(env, info[3], "length", length)) {
+      return env.Undefined();
+    }
+    if (length > buf.Length() - offset) {
+      Napi::RangeError::New(env, "madvise: range exceeds the buffer").ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+  }
+
+  return AdviseMapping(env, buf.Data() + offset, length, advice);
+}
+
 // ========== Module-level captured last-error / errno ==========
 // Slot privati thread-local aggiornati da FFIFunction::Call quando la library
 // è aperta con use_last_error / use_errno. Parity Python ctypes: le API
@@ -466,4 +810,200 @@ Napi::Value CTypesAddon::SetCapturedErrno(const Napi::CallbackInfo& info) {
   return Napi::Number::New(info.Env(), prev);
 }
 
+// ========== Call pool ==========
+// Worker pool dedicato di callAsync (vedi pool.h). configureCallPool accetta
+// { threads } e ritorna le statistiche aggiornate.
+
+static Napi::Object CallPoolStatsToObject(Napi::Env env, const CallPoolStats& stats) {
+  Napi::Object obj = Napi::Object::New(env);
+  obj.Set("threads", Napi::Number::New(env, static_cast<double>(stats.threads)));
+  obj.Set("submitted", Napi::Number::New(env, static_cast<double>(stats.submitted)));
+  obj.Set("completed", Napi::Number::New(env, static_cast<double>(stats.completed)));
+  obj.Set("pending", Napi::Number::New(env, static_cast<double>(stats.pending)));
+  return obj;
+}
+
+Napi::Value CTypesAddon::ConfigureCallPool(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsObject()) {
+    Napi::TypeError::New(env, "Options object expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Object opts = info[0].As<Napi::Object>();
+  if (opts.Has("threads")) {
+    Napi::Value threads = opts.Get("threads");
+    if (!threads.IsNumber()) {
+      Napi::TypeError::New(env, "threads must be a number").ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    int64_t count = threads.As<Napi::Number>().Int64Value();
+    if (!call_pool.SetThreadCount(env, count < 0 ? 0 : static_cast<size_t>(count))) {
+      return env.Undefined();
+    }
+  }
+
+  return CallPoolStatsToObject(env, call_pool.GetStats());
+}
+
+Napi::Value CTypesAddon::GetCallPoolStats(const Napi::CallbackInfo& info) {
+  return CallPoolStatsToObject(info.Env(), call_pool.GetStats());
+}
+
+Napi::Value CTypesAddon::CreateSerialQueue(const Napi::CallbackInfo& info) {
+  return CreateSerialQueueHandle(info.Env());
+}
+
+Napi::Value CTypesAddon::SetStatsEnabled(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  stats_enabled = info.Length() < 1 || info[0].ToBoolean();
+  return Napi::Boolean::New(env, stats_enabled);
+}
+
+Napi::Value CTypesAddon::GetStatsSnapshot(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Napi::Object snapshot = Napi::Object::New(env);
+  snapshot.Set("enabled", Napi::Boolean::New(env, stats_enabled));
+
+  // Ordine stabile per nome: l'unordered_set non ne ha uno
+  std::vector<FFIFunction*> functions(instrumented_functions.begin(), instrumented_functions.end());
+  std::sort(functions.begin(), functions.end(),
+            [](const FFIFunction* a, const FFIFunction* b) { return a->GetFunctionName() < b->GetFunctionName(); });
+
+  Napi::Array list = Napi::Array::New(env, functions.size());
+  for (size_t i = 0; i < functions.size(); i++) {
+    list.Set(static_cast<uint32_t>(i), functions[i]->StatsSnapshot(env));
+  }
+  snapshot.Set("functions", list);
+  return snapshot;
+}
+
+Napi::Value CTypesAddon::DescribeTypes(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsArray()) {
+    Napi::TypeError::New(env, "describeTypes requires an array of StructType / ArrayType")
+      .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return ctypes::DescribeTypes(env, info[0].As<Napi::Array>());
+}
+
+Napi::Value CTypesAddon::LoadTypes(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsObject()) {
+    Napi::TypeError::New(env, "loadTypes requires a manifest object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return ctypes::LoadTypes(env, info[0].As<Napi::Object>());
+}
+
+// exportBindings([StructType | ArrayType]) -> id del binding set
+Napi::Value CTypesAddon::ExportBindings(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsArray()) {
+    Napi::TypeError::New(env, "exportBindings requires an array of StructType / ArrayType")
+      .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Array types = info[0].As<Napi::Array>();
+  std::vector<SharedTypeEntry> entries;
+  entries.reserve(types.Length());
+  for (uint32_t i = 0; i < types.Length(); i++) {
+    Napi::Value val = types.Get(i);
+    Napi::Object obj = val.IsObject() ? val.As<Napi::Object>() : Napi::Object();
+    SharedTypeEntry entry;
+    if (!obj.IsEmpty() && IsStructType(obj)) {
+      entry.struct_info = Napi::ObjectWrap<StructType>::Unwrap(obj)->GetStructInfo();
+    } else if (!obj.IsEmpty() && IsArrayType(obj)) {
+      entry.array_info = Napi::ObjectWrap<ArrayType>::Unwrap(obj)->GetArrayInfo();
+    } else {
+      Napi::TypeError::New(env, std::format("exportBindings: types[{}] must be a StructType or ArrayType", i))
+        .ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    entries.push_back(std::move(entry));
+  }
+
+  // Share() solo dopo la validazione: un errore non lascia tipi congelati
+  for (const auto& entry : entries) {
+    if (entry.struct_info) {
+      entry.struct_info->Share();
+    } else {
+      entry.array_info->Share();
+    }
+  }
+
+  uint64_t id = PublishBindingSet(std::move(entries));
+  exported_binding_sets.push_back(id);
+  return Napi::Number::New(env, static_cast<double>(id));
+}
+
+// importBindings(id) -> [StructType | ArrayType] nello stesso ordine
+// dell'export, wrapper di questo environment sui layout condivisi
+Napi::Value CTypesAddon::ImportBindings(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsNumber()) {
+    Napi::TypeError::New(env, "importBindings requires a binding set id").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  std::vector<SharedTypeEntry> entries;
+  const int64_t id = info[0].As<Napi::Number>().Int64Value();
+  if (id <= 0 || !FindBindingSet(static_cast<uint64_t>(id), entries)) {
+    Napi::Error::New(env, std::format("importBindings: binding set {} does not exist or was released", id))
+      .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Array result = Napi::Array::New(env, entries.size());
+  for (uint32_t i = 0; i < entries.size(); i++) {
+    if (entries[i].struct_info) {
+      Napi::Object obj = StructTypeConstructor->New(std::vector<napi_value>{});
+      Napi::ObjectWrap<StructType>::Unwrap(obj)->Adopt(std::move(entries[i].struct_info));
+      result.Set(i, obj);
+    } else {
+      // Argomenti placeholder: l'ArrayInfo viene subito sostituito
+      Napi::Object obj = ArrayTypeConstructor->New(
+        {Napi::Number::New(env, static_cast<int>(CType::CTYPES_UINT8)), Napi::Number::New(env, 1)});
+      Napi::ObjectWrap<ArrayType>::Unwrap(obj)->Adopt(std::move(entries[i].array_info));
+      result.Set(i, obj);
+    }
+  }
+  return result;
+}
+
+Napi::Value CTypesAddon::ReleaseBindings(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsNumber()) {
+    Napi::TypeError::New(env, "releaseBindings requires a binding set id").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  const int64_t id = info[0].As<Napi::Number>().Int64Value();
+  std::erase(exported_binding_sets, static_cast<uint64_t>(id));
+  return Napi::Boolean::New(env, id > 0 && RevokeBindingSet(static_cast<uint64_t>(id)));
+}
+
+Napi::Value CTypesAddon::GetSharedRegistryStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  SharedRegistryStats stats = ctypes::GetSharedRegistryStats();
+  Napi::Object obj = Napi::Object::New(env);
+  obj.Set("libraries", Napi::Number::New(env, static_cast<double>(stats.libraries)));
+  obj.Set("libraryRefs", Napi::Number::New(env, static_cast<double>(stats.library_refs)));
+  obj.Set("bindingSets", Napi::Number::New(env, static_cast<double>(stats.binding_sets)));
+  obj.Set("signatures", Napi::Number::New(env, static_cast<double>(SignatureRegistry::Shared().Size())));
+  return obj;
+}
+
 }  // namespace ctypes
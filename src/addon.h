@@ -1,9 +1,13 @@
 #pragma once
 
+#include "pool.h"
 #include "shared.h"
+#include "signature.h"
 
 namespace ctypes {
 
+class FFIFunction;
+
 class CTypesAddon : public Napi::Addon<CTypesAddon> {
  public:
   // Constructors per le classi wrapper
@@ -13,6 +17,8 @@ class CTypesAddon : public Napi::Addon<CTypesAddon> {
   std::unique_ptr<Napi::FunctionReference> ThreadSafeCallbackConstructor;
   std::unique_ptr<Napi::FunctionReference> StructTypeConstructor;
   std::unique_ptr<Napi::FunctionReference> ArrayTypeConstructor;
+  std::unique_ptr<Napi::FunctionReference> SlabPoolConstructor;
+  std::unique_ptr<Napi::FunctionReference> CompletionRingConstructor;
 
   // Slot catturati per GetLastError / errno — parity Python ctypes.
   // Essendo instance data di un Napi::Addon sono per-environment: ogni Worker
@@ -21,6 +27,21 @@ class CTypesAddon : public Napi::Addon<CTypesAddon> {
   uint32_t captured_last_error = 0;  // DWORD-like (unsigned) per parity Win32
   int captured_errno = 0;            // errno è int in POSIX
 
+  // Worker pool per FFIFunction::CallAsync (vedi pool.h), per-environment
+  // come gli slot sopra. Avviato al primo callAsync.
+  CallPool call_pool;
+
+  // Chiavi JS dei campi per gli StructInfo condivisi tra environment
+  // (StructInfo::Share): per id di layout, una copia per environment
+  std::unordered_map<uint64_t, std::vector<Napi::Reference<Napi::String>>> shared_struct_keys;
+  // Binding set pubblicati da questo environment, revocati al teardown
+  std::vector<uint64_t> exported_binding_sets;
+
+  // Strumentazione (stats.h): flag globale e FFIFunction che hanno già
+  // statistiche allocate, per lo snapshot di modulo
+  bool stats_enabled = false;
+  std::unordered_set<FFIFunction*> instrumented_functions;
+
   CTypesAddon(Napi::Env env, Napi::Object exports);
   ~CTypesAddon();
 
@@ -30,17 +51,44 @@ class CTypesAddon : public Napi::Addon<CTypesAddon> {
   Napi::Value Alloc(const Napi::CallbackInfo& info);
   Napi::Value ReadValue(const Napi::CallbackInfo& info);
   Napi::Value WriteValue(const Napi::CallbackInfo& info);
+  // Bulk: N elementi (eventualmente strided) ↔ TypedArray in un crossing
+  Napi::Value ReadArray(const Napi::CallbackInfo& info);
+  Napi::Value WriteArray(const Napi::CallbackInfo& info);
   Napi::Value SizeOf(const Napi::CallbackInfo& info);
   Napi::Value CreateCString(const Napi::CallbackInfo& info);
   Napi::Value ReadCString(const Napi::CallbackInfo& info);
+  Napi::Value ReadWString(const Napi::CallbackInfo& info);
   Napi::Value PtrToBuffer(const Napi::CallbackInfo& info);
   Napi::Value AddressOf(const Napi::CallbackInfo& info);
 
+  // File mappati in memoria (mmap.h)
+  Napi::Value MapFile(const Napi::CallbackInfo& info);
+  Napi::Value Madvise(const Napi::CallbackInfo& info);
+
   // Module-level captured last-error / errno accessors (parity Python ctypes)
   Napi::Value GetCapturedLastError(const Napi::CallbackInfo& info);
   Napi::Value SetCapturedLastError(const Napi::CallbackInfo& info);
   Napi::Value GetCapturedErrno(const Napi::CallbackInfo& info);
   Napi::Value SetCapturedErrno(const Napi::CallbackInfo& info);
+
+  // Call pool: dimensione, statistiche e code seriali
+  Napi::Value ConfigureCallPool(const Napi::CallbackInfo& info);
+  Napi::Value GetCallPoolStats(const Napi::CallbackInfo& info);
+  Napi::Value CreateSerialQueue(const Napi::CallbackInfo& info);
+
+  // Strumentazione delle FFIFunction: flag globale e snapshot di modulo
+  Napi::Value SetStatsEnabled(const Napi::CallbackInfo& info);
+  Napi::Value GetStatsSnapshot(const Napi::CallbackInfo& info);
+
+  // Binding manifest (manifest.h): StructType / ArrayType ↔ plain object
+  Napi::Value DescribeTypes(const Napi::CallbackInfo& info);
+  Napi::Value LoadTypes(const Napi::CallbackInfo& info);
+
+  // Binding set condivisi tra environment (registry.h)
+  Napi::Value ExportBindings(const Napi::CallbackInfo& info);
+  Napi::Value ImportBindings(const Napi::CallbackInfo& info);
+  Napi::Value ReleaseBindings(const Napi::CallbackInfo& info);
+  Napi::Value GetSharedRegistryStats(const Napi::CallbackInfo& info);
 };
 
 }  // namespace ctypes
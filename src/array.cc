@@ -8,8 +8,17 @@ namespace ctypes {
 // ArrayInfo - Core logic
 // ============================================================================
 
-ArrayInfo::ArrayInfo(CType element_type, size_t count, std::shared_ptr<StructInfo> element_struct)
-  : element_type_(element_type), count_(count), element_struct_(element_struct) {
+ArrayInfo::ArrayInfo(CType element_type, size_t count, std::shared_ptr<StructInfo> element_struct, bool typed)
+  : element_type_(element_type),
+    count_(count),
+    element_struct_(element_struct),
+    typed_(false),
+    typed_array_type_(napi_uint8_array) {
+  // typed solo per elementi primitivi con un TypedArray corrispondente
+  if (typed && !element_struct && CTypeToTypedArrayType(element_type, typed_array_type_)) {
+    typed_ = true;
+  }
+
   if (element_struct) {
     element_size_ = element_struct->GetSize();
     alignment_ = element_struct->GetAlignment();
@@ -57,6 +66,13 @@ ArrayInfo::ArrayInfo(CType element_type, size_t count, std::shared_ptr<StructInf
 
 ArrayInfo::~ArrayInfo() = default;
 
+void ArrayInfo::Share() {
+  if (element_struct_) {
+    element_struct_->Share();
+  }
+  GetFFIType();
+}
+
 ffi_type* ArrayInfo::GetFFIType() {
   if (ffi_type_) {
     return ffi_type_.get();
@@ -98,13 +114,25 @@ bool ArrayInfo::JSToArray(Napi::Env env, Napi::Value val, void* buffer, size_t b
 
   std::memset(buffer, 0, size_);
 
-  if (val.IsArray()) {
-    Napi::Array arr = val.As<Napi::Array>();
-    size_t arr_len = arr.Length();
+  napi_typedarray_type ta_type;
+  void* ta_data = nullptr;
+  size_t ta_length = 0;
+  const bool is_typed = GetElementTypedArray(env, val, ta_type, ta_data, ta_length);
+  if (is_typed && !element_struct_ && TypedArrayMatchesCType(ta_type, element_type_)) {
+    // Stessa rappresentazione in memoria: un solo memcpy
+    memcpy(buffer, ta_data, std::min(ta_length, count_) * element_size_);
+    return true;
+  }
+
+  if (val.IsArray() || is_typed) {
+    // Array JS, o TypedArray con elementi di altro tipo (es. Float32Array
+    // per double[]): conversione per elemento
+    Napi::Object arr = val.As<Napi::Object>();
+    size_t arr_len = is_typed ? ta_length : val.As<Napi::Array>().Length();
     size_t copy_len = std::min(arr_len, count_);
 
     for (size_t i = 0; i < copy_len; i++) {
-      Napi::Value elem = arr.Get(i);
+      Napi::Value elem = arr.Get(static_cast<uint32_t>(i));
       void* elem_ptr = static_cast<char*>(buffer) + (i * element_size_);
 
       if (element_struct_) {
@@ -145,7 +173,24 @@ bool ArrayInfo::JSToArray(Napi::Env env, Napi::Value val, void* buffer, size_t b
   return true;
 }
 
-Napi::Array ArrayInfo::ArrayToJS(Napi::Env env, const void* buffer) {
+Napi::Value ArrayInfo::ArrayToJS(Napi::Env env, const void* buffer) {
+  if (typed_) {
+    // Copia, non vista: `buffer` è quasi sempre storage riusato (return
+    // buffer di FFIFunction, struct temporanee)
+    void* data = nullptr;
+    napi_value arraybuffer;
+    napi_value typedarray;
+    if (napi_create_arraybuffer(env, size_, &data, &arraybuffer) != napi_ok ||
+        napi_create_typedarray(env, typed_array_type_, count_, arraybuffer, 0, &typedarray) != napi_ok) {
+      Napi::Error::New(env, "Failed to allocate typed array").ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    if (size_ > 0) {
+      memcpy(data, buffer, size_);
+    }
+    return Napi::Value(env, typedarray);
+  }
+
   Napi::Array arr = Napi::Array::New(env, count_);
 
   for (size_t i = 0; i < count_; i++) {
@@ -212,7 +257,23 @@ ArrayType::ArrayType(const Napi::CallbackInfo& info) : Napi::ObjectWrap<ArrayTyp
   // Parse count
   size_t count = static_cast<size_t>(info[1].As<Napi::Number>().Int64Value());
 
-  array_info_ = std::make_shared<ArrayInfo>(element_type, count, element_struct);
+  // Opzioni: { typed: true } → ArrayToJS ritorna un TypedArray
+  bool typed = false;
+  if (info.Length() > 2 && info[2].IsObject()) {
+    Napi::Object opts = info[2].As<Napi::Object>();
+    if (opts.Has("typed")) {
+      typed = opts.Get("typed").ToBoolean().Value();
+    }
+  }
+  napi_typedarray_type ta_type;
+  if (typed && (element_struct || !CTypeToTypedArrayType(element_type, ta_type))) {
+    Napi::TypeError::New(env, std::format("typed arrays require a numeric element type (got {})",
+                                          CTypeToName(element_type)))
+      .ThrowAsJavaScriptException();
+    return;
+  }
+
+  array_info_ = std::make_shared<ArrayInfo>(element_type, count, element_struct, typed);
 }
 
 Napi::Value ArrayType::GetSize(const Napi::CallbackInfo& info) {
@@ -11,7 +11,10 @@ class TypeInfo;
 // ArrayInfo - descrizione di array a dimensione fissa (come c_int * 5 in Python)
 class ArrayInfo {
  public:
-  ArrayInfo(CType element_type, size_t count, std::shared_ptr<StructInfo> element_struct = nullptr);
+  ArrayInfo(CType element_type,
+            size_t count,
+            std::shared_ptr<StructInfo> element_struct = nullptr,
+            bool typed = false);
   ~ArrayInfo();
 
   // Getter
@@ -20,15 +23,23 @@ class ArrayInfo {
   size_t GetSize() const { return size_; }
   size_t GetAlignment() const { return alignment_; }
   std::shared_ptr<StructInfo> GetElementStruct() const { return element_struct_; }
+  // ArrayToJS produce un TypedArray (copia) invece di un Array JS
+  bool IsTyped() const { return typed_; }
 
   // Crea ffi_type custom per questo array
   ffi_type* GetFFIType();
 
-  // Converte JS array → C array buffer
+  // Costruisce ffi_type e rende condiviso l'eventuale elemento struct: da
+  // qui ArrayInfo è di sola lettura e usabile da più environment
+  void Share();
+
+  // Converte JS array → C array buffer. Un TypedArray con elementi
+  // compatibili (vedi TypedArrayMatchesCType) viene copiato con memcpy;
+  // Buffer / Uint8Array restano byte grezzi.
   bool JSToArray(Napi::Env env, Napi::Value val, void* buffer, size_t bufsize);
 
-  // Converte C array buffer → JS array
-  Napi::Array ArrayToJS(Napi::Env env, const void* buffer);
+  // Converte C array buffer → JS array (o TypedArray se typed)
+  Napi::Value ArrayToJS(Napi::Env env, const void* buffer);
 
  private:
   CType element_type_;
@@ -37,6 +48,8 @@ class ArrayInfo {
   size_t size_;  // count * element_size
   size_t alignment_;
   std::shared_ptr<StructInfo> element_struct_;  // Se element_type == STRUCT
+  bool typed_;
+  napi_typedarray_type typed_array_type_;  // valido solo se typed_
   std::unique_ptr<ffi_type> ffi_type_;
   std::vector<ffi_type*> ffi_element_types_;  // Per ffi_type.elements
 };
@@ -55,6 +68,8 @@ class ArrayType : public Napi::ObjectWrap<ArrayType> {
   Napi::Value Create(const Napi::CallbackInfo& info);  // crea buffer array
 
   std::shared_ptr<ArrayInfo> GetArrayInfo() const { return array_info_; }
+  // Wrapper su un layout condiviso da un altro environment (importBindings)
+  void Adopt(std::shared_ptr<ArrayInfo> info) { array_info_ = std::move(info); }
 
  private:
   std::shared_ptr<ArrayInfo> array_info_;
@@ -9,6 +9,169 @@ namespace ctypes {
 // ========================================================================
 static constexpr size_t kMaxInlineCallbackArgs = 8;
 
+// ========================================================================
+// Piano di conversione (vedi callback.h)
+// ========================================================================
+
+template <typename T>
+static napi_value ReadInt32Arg(napi_env env, const void* src, const CallbackArgConv&) {
+  T val;
+  memcpy(&val, src, sizeof(val));
+  napi_value result;
+  napi_create_int32(env, static_cast<int32_t>(val), &result);
+  return result;
+}
+
+template <typename T>
+static napi_value ReadUint32Arg(napi_env env, const void* src, const CallbackArgConv&) {
+  T val;
+  memcpy(&val, src, sizeof(val));
+  napi_value result;
+  napi_create_uint32(env, static_cast<uint32_t>(val), &result);
+  return result;
+}
+
+template <typename T>
+static napi_value ReadDoubleArg(napi_env env, const void* src, const CallbackArgConv&) {
+  T val;
+  memcpy(&val, src, sizeof(val));
+  napi_value result;
+  napi_create_double(env, static_cast<double>(val), &result);
+  return result;
+}
+
+static napi_value ReadPointerArg(napi_env env, const void* src, const CallbackArgConv&) {
+  void* ptr;
+  memcpy(&ptr, src, sizeof(ptr));
+  napi_value result;
+  if (ptr == nullptr) {
+    napi_get_null(env, &result);
+  } else {
+    napi_create_bigint_uint64(env, reinterpret_cast<uint64_t>(ptr), &result);
+  }
+  return result;
+}
+
+static napi_value ReadStructArg(napi_env env, const void* src, const CallbackArgConv& conv) {
+  return conv.struct_info->StructToJS(Napi::Env(env), src);
+}
+
+static napi_value ReadArrayArg(napi_env env, const void* src, const CallbackArgConv& conv) {
+  return conv.array_info->ArrayToJS(Napi::Env(env), src);
+}
+
+static napi_value ReadGenericArg(napi_env env, const void* src, const CallbackArgConv& conv) {
+  return CToJS(Napi::Env(env), src, conv.type);
+}
+
+static CallbackArgReader SelectArgReader(CType type) {
+  switch (type) {
+    case CType::CTYPES_INT8:
+      return &ReadInt32Arg<int8_t>;
+    case CType::CTYPES_INT16:
+      return &ReadInt32Arg<int16_t>;
+    case CType::CTYPES_INT32:
+      return &ReadInt32Arg<int32_t>;
+    case CType::CTYPES_UINT8:
+      return &ReadUint32Arg<uint8_t>;
+    case CType::CTYPES_UINT16:
+      return &ReadUint32Arg<uint16_t>;
+    case CType::CTYPES_UINT32:
+      return &ReadUint32Arg<uint32_t>;
+    case CType::CTYPES_FLOAT:
+      return &ReadDoubleArg<float>;
+    case CType::CTYPES_DOUBLE:
+      return &ReadDoubleArg<double>;
+    case CType::CTYPES_POINTER:
+      return &ReadPointerArg;
+    default:
+      return &ReadGenericArg;
+  }
+}
+
+// Conversione generica del ritorno: JSToC, zero se fallisce
+static void WriteGenericReturn(napi_env env, napi_value value, CType type, void* ret, size_t size) {
+  if (JSToC(Napi::Env(env), Napi::Value(env, value), type, static_cast<uint8_t*>(ret), size) <= 0) {
+    memset(ret, 0, size);
+  }
+}
+
+// Fast path per i ritorni numerici più comuni; valori non Number (BigInt,
+// boolean, oggetti) ricadono sulla conversione generica
+static void WriteInt32Return(napi_env env, napi_value value, CType type, void* ret, size_t size) {
+  int32_t v;
+  if (napi_get_value_int32(env, value, &v) == napi_ok) {
+    memcpy(ret, &v, sizeof(v));
+    return;
+  }
+  WriteGenericReturn(env, value, type, ret, size);
+}
+
+static void WriteDoubleReturn(napi_env env, napi_value value, CType type, void* ret, size_t size) {
+  double v;
+  if (napi_get_value_double(env, value, &v) == napi_ok) {
+    memcpy(ret, &v, sizeof(v));
+    return;
+  }
+  WriteGenericReturn(env, value, type, ret, size);
+}
+
+static void WriteVoidReturn(napi_env, napi_value, CType, void*, size_t) {}
+
+static CallbackReturnWriter SelectReturnWriter(CType type) {
+  switch (type) {
+    case CType::CTYPES_VOID:
+      return &WriteVoidReturn;
+    case CType::CTYPES_INT32:
+      return &WriteInt32Return;
+    case CType::CTYPES_DOUBLE:
+      return &WriteDoubleReturn;
+    default:
+      return &WriteGenericReturn;
+  }
+}
+
+// Tipi degli argomenti di un callback: CType numerico, oppure StructType /
+// ArrayType per struct / union / array passati per valore. Riempie
+// arg_types, ffi_arg_types e il piano dei reader; false con eccezione JS
+// pendente.
+static bool ParseCallbackArgTypes(Napi::Env env,
+                                  const Napi::Array& arr,
+                                  std::vector<CType>& arg_types,
+                                  std::vector<ffi_type*>& ffi_arg_types,
+                                  std::vector<CallbackArgConv>& plan) {
+  for (uint32_t i = 0; i < arr.Length(); i++) {
+    Napi::Value elem = arr.Get(i);
+    CallbackArgConv conv;
+    try {
+      if (elem.IsNumber()) {
+        conv.type = IntToCType(elem.As<Napi::Number>().Int32Value());
+        conv.read = SelectArgReader(conv.type);
+        ffi_arg_types.push_back(CTypeToFFI(conv.type));
+      } else if (elem.IsObject() && IsStructType(elem.As<Napi::Object>())) {
+        conv.type = CType::CTYPES_STRUCT;
+        conv.struct_info = Napi::ObjectWrap<StructType>::Unwrap(elem.As<Napi::Object>())->GetStructInfo();
+        conv.read = &ReadStructArg;
+        ffi_arg_types.push_back(conv.struct_info->GetFFIType());
+      } else if (elem.IsObject() && IsArrayType(elem.As<Napi::Object>())) {
+        conv.type = CType::CTYPES_ARRAY;
+        conv.array_info = Napi::ObjectWrap<ArrayType>::Unwrap(elem.As<Napi::Object>())->GetArrayInfo();
+        conv.read = &ReadArrayArg;
+        ffi_arg_types.push_back(conv.array_info->GetFFIType());
+      } else {
+        throw std::runtime_error("Type must be CType enum value (number), StructType or ArrayType");
+      }
+    } catch (const std::exception& e) {
+      Napi::Error::New(env, std::format("Invalid argument type at index {}: {}", i, e.what()))
+        .ThrowAsJavaScriptException();
+      return false;
+    }
+    arg_types.push_back(conv.type);
+    plan.push_back(std::move(conv));
+  }
+  return true;
+}
+
 // ========================================================================
 // Callback - Solo main thread, semplice e veloce
 // ========================================================================
@@ -41,9 +204,9 @@ static void CallbackHandler(ffi_cif* cif, void* ret, void** args, void* user_dat
     js_args = heap_args.data();
   }
 
+  const CallbackArgConv* plan = data->arg_plan.data();
   for (unsigned int i = 0; i < cif->nargs; i++) {
-    // Usa CToJS per tipi primitivi (callback non supportano struct/array)
-    js_args[i] = CToJS(env, args[i], data->arg_types[i]);
+    js_args[i] = plan[i].read(env, args[i], plan[i]);
   }
 
   // Chiama la funzione JS usando napi_call_function per evitare copia vector
@@ -105,14 +268,7 @@ static void CallbackHandler(ffi_cif* cif, void* ret, void** args, void* user_dat
   // Converti risultato JS -> C direttamente nel buffer di ret, senza
   // heap-allocare un vettore temporaneo e memcpy in ogni invocazione.
   // `ret` è fornito da libffi ed è abbastanza grande per il tipo dichiarato.
-  if (data->return_type != CType::CTYPES_VOID) {
-    size_t ret_size = CTypeSize(data->return_type);
-    Napi::Value result(env, result_val);
-    int written = JSToC(env, result, data->return_type, static_cast<uint8_t*>(ret), ret_size);
-    if (written <= 0) {
-      memset(ret, 0, ret_size);
-    }
-  }
+  data->write_return(env, result_val, data->return_type, ret, CTypeSize(data->return_type));
 }
 
 Napi::Function Callback::GetClass(Napi::Env env) {
@@ -159,20 +315,9 @@ Callback::Callback(const Napi::CallbackInfo& info) : Napi::ObjectWrap<Callback>(
     return;
   }
 
-  Napi::Array arr = info[2].As<Napi::Array>();
-  for (uint32_t i = 0; i < arr.Length(); i++) {
-    Napi::Value elem = arr.Get(i);
-    try {
-      if (elem.IsNumber()) {
-        data_->arg_types.push_back(IntToCType(elem.As<Napi::Number>().Int32Value()));
-      } else {
-        throw std::runtime_error("Type must be CType enum value (number) or CType object");
-      }
-    } catch (const std::exception& e) {
-      Napi::Error::New(env, std::format("Invalid argument type at index {}: {}", i, e.what()))
-        .ThrowAsJavaScriptException();
-      return;
-    }
+  if (!ParseCallbackArgTypes(env, info[2].As<Napi::Array>(), data_->arg_types, data_->ffi_arg_types,
+                             data_->arg_plan)) {
+    return;
   }
 
   // Parse optional 4th argument: calling convention string
@@ -181,11 +326,9 @@ Callback::Callback(const Napi::CallbackInfo& info) : Napi::ObjectWrap<Callback>(
     abi = CallConvToFFI(StringToCallConv(info[3].As<Napi::String>().Utf8Value()));
   }
 
-  // Prepara FFI types
+  // Prepara FFI type di ritorno (quelli degli argomenti vengono dal parse)
   data_->ffi_return_type = CTypeToFFI(data_->return_type);
-  for (const auto& type : data_->arg_types) {
-    data_->ffi_arg_types.push_back(CTypeToFFI(type));
-  }
+  data_->write_return = SelectReturnWriter(data_->return_type);
 
   // Prepara CIF
   ffi_status status =
@@ -299,6 +442,323 @@ Napi::Value Callback::GetLastError(const Napi::CallbackInfo& info) {
 // ThreadSafeCallback - Supporta chiamate da qualsiasi thread
 // ========================================================================
 
+// Estrae l'eccezione JS pendente, la salva in last_error e la inoltra
+// all'error handler (o a process.emitWarning). Solo main thread.
+static void ReportThreadSafeCallbackError(Napi::Env env, ThreadSafeCallbackData* data, const char* fallback) {
+  std::string error_msg = fallback;
+  bool is_pending;
+  if (napi_is_exception_pending(env, &is_pending) == napi_ok && is_pending) {
+    napi_value exception;
+    if (napi_get_and_clear_last_exception(env, &exception) == napi_ok) {
+      Napi::Error err(env, exception);
+      error_msg = err.Message();
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(data->result_mutex);
+    data->last_error = error_msg;
+  }
+
+  if (!data->error_handler_ref.IsEmpty()) {
+    try {
+      Napi::Function error_handler = data->error_handler_ref.Value();
+      error_handler.Call({Napi::String::New(env, error_msg)});
+    } catch (...) {
+    }
+  } else {
+    // Emetti warning
+    napi_value process, emit_warning;
+    if (napi_get_global(env, &process) == napi_ok &&
+        napi_get_named_property(env, process, "emitWarning", &emit_warning) == napi_ok) {
+      napi_value warning_msg_val;
+      napi_create_string_utf8(env, error_msg.c_str(), NAPI_AUTO_LENGTH, &warning_msg_val);
+      napi_value warning_type;
+      napi_create_string_utf8(env, "ThreadSafeCallbackError", NAPI_AUTO_LENGTH, &warning_type);
+      napi_value warn_args[2] = {warning_msg_val, warning_type};
+      napi_value warn_result;
+      napi_call_function(env, process, emit_warning, 2, warn_args, &warn_result);
+    }
+  }
+}
+
+// ------------------------------------------------------------------------
+// EventRing
+// ------------------------------------------------------------------------
+
+void EventRing::Init(size_t capacity, size_t record_size) {
+  size_t slots = 2;
+  while (slots < capacity) {
+    slots <<= 1;
+  }
+  mask_ = slots - 1;
+  slot_size_ = (kHeaderSize + record_size + kCacheLine - 1) / kCacheLine * kCacheLine;
+  storage_ = std::make_unique<CacheLine[]>(slots * (slot_size_ / kCacheLine));
+  for (size_t i = 0; i < slots; i++) {
+    new (Slot(i)) std::atomic<size_t>(i);
+  }
+  enqueue_pos_.store(0, std::memory_order_relaxed);
+  dequeue_pos_ = 0;
+}
+
+uint8_t* EventRing::Reserve(size_t& pos) {
+  pos = enqueue_pos_.load(std::memory_order_relaxed);
+  for (;;) {
+    size_t seq = Sequence(pos).load(std::memory_order_acquire);
+    intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+    if (diff == 0) {
+      if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        return Slot(pos) + kHeaderSize;
+      }
+    } else if (diff < 0) {
+      return nullptr;  // pieno: il consumer non ha ancora liberato lo slot
+    } else {
+      pos = enqueue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+void EventRing::Commit(size_t pos) {
+  Sequence(pos).store(pos + 1, std::memory_order_release);
+}
+
+const uint8_t* EventRing::Front() {
+  size_t seq = Sequence(dequeue_pos_).load(std::memory_order_acquire);
+  if (seq != dequeue_pos_ + 1) {
+    return nullptr;
+  }
+  return Slot(dequeue_pos_) + kHeaderSize;
+}
+
+void EventRing::Pop() {
+  Sequence(dequeue_pos_).store(dequeue_pos_ + mask_ + 1, std::memory_order_release);
+  dequeue_pos_++;
+}
+
+// ------------------------------------------------------------------------
+// Modalità non bloccante: enqueue dai thread esterni, drain sul main thread
+// ------------------------------------------------------------------------
+
+// Accoda un wakeup sul TSFN solo se non ce n'è già uno in volo: con molti
+// produttori il costo di uv_async_send viene pagato una volta per batch.
+static void ScheduleDrain(ThreadSafeCallbackData* data) {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (data->drain_scheduled.exchange(true, std::memory_order_seq_cst)) {
+    return;
+  }
+  if (data->tsfn.NonBlockingCall() != napi_ok) {
+    data->drain_scheduled.store(false, std::memory_order_seq_cst);
+  }
+}
+
+// Copia gli argomenti di libffi nel layout del piano
+static inline void CopyArgs(const ThreadSafeCallbackData* data, void** args, uint8_t* dst) {
+  const size_t nargs = data->arg_plan.size();
+  const CallbackArgConv* plan = data->arg_plan.data();
+  for (size_t i = 0; i < nargs; i++) {
+    memcpy(dst + plan[i].offset, args[i], plan[i].size);
+  }
+}
+
+static void EnqueueEvent(ThreadSafeCallbackData* data, void** args) {
+  size_t pos;
+  uint8_t* record;
+  if ((record = data->ring.Reserve(pos)) == nullptr) {
+    // Ring pieno: l'evento viene scartato e contato. Attendere qui non è
+    // sicuro: il main thread può essere bloccato proprio su questo thread
+    // (es. pthread_join) e non svuoterebbe mai il ring.
+    data->dropped.fetch_add(1, std::memory_order_relaxed);
+    if (!data->released.load(std::memory_order_acquire)) {
+      ScheduleDrain(data);
+    }
+    return;
+  }
+
+  CopyArgs(data, args, record);
+  data->ring.Commit(pos);
+  ScheduleDrain(data);
+}
+
+// Converte un record del ring (o gli argomenti di un CallFrame) in argomenti JS
+static void RecordToJS(Napi::Env env, ThreadSafeCallbackData* data, const uint8_t* record, napi_value* js_args) {
+  const size_t nargs = data->arg_plan.size();
+  const CallbackArgConv* plan = data->arg_plan.data();
+  for (size_t i = 0; i < nargs; i++) {
+    js_args[i] = plan[i].read(env, record + plan[i].offset, plan[i]);
+  }
+}
+
+// Svuota fino a `budget` record. Ritorna il numero di record consumati.
+static size_t DrainBatch(Napi::Env env, Napi::Function js_callback, ThreadSafeCallbackData* data, size_t budget) {
+  const size_t nargs = data->arg_types.size();
+  napi_value inline_args[kMaxInlineCallbackArgs];
+  std::vector<napi_value> heap_args;
+  napi_value* js_args = inline_args;
+  if (nargs > kMaxInlineCallbackArgs) {
+    heap_args.resize(nargs);
+    js_args = heap_args.data();
+  }
+
+  napi_value undefined;
+  napi_get_undefined(env, &undefined);
+  size_t drained = 0;
+
+  if (data->batch) {
+    Napi::HandleScope scope(env);
+    napi_value records;
+    napi_create_array(env, &records);
+    const uint8_t* record;
+    while (drained < budget && (record = data->ring.Front()) != nullptr) {
+      RecordToJS(env, data, record, js_args);
+      data->ring.Pop();
+      napi_value entry;
+      napi_create_array_with_length(env, nargs, &entry);
+      for (size_t i = 0; i < nargs; i++) {
+        napi_set_element(env, entry, static_cast<uint32_t>(i), js_args[i]);
+      }
+      napi_set_element(env, records, static_cast<uint32_t>(drained), entry);
+      drained++;
+    }
+    if (drained > 0) {
+      napi_value result_val;
+      if (napi_call_function(env, undefined, js_callback, 1, &records, &result_val) != napi_ok) {
+        ReportThreadSafeCallbackError(env, data, "Unknown error in thread-safe callback (batch)");
+      }
+    }
+    return drained;
+  }
+
+  const uint8_t* record;
+  while (drained < budget && (record = data->ring.Front()) != nullptr) {
+    Napi::HandleScope scope(env);
+    RecordToJS(env, data, record, js_args);
+    data->ring.Pop();
+    drained++;
+
+    napi_value result_val;
+    if (napi_call_function(env, undefined, js_callback, nargs, js_args, &result_val) != napi_ok) {
+      ReportThreadSafeCallbackError(env, data, "Unknown error in thread-safe callback (external thread)");
+    }
+    if (data->released.load(std::memory_order_acquire)) {
+      break;  // release() chiamato dal callback stesso
+    }
+  }
+  return drained;
+}
+
+static void DrainEventRing(Napi::Env env, Napi::Function js_callback, ThreadSafeCallbackData* data) {
+  if (env == nullptr || data->released.load(std::memory_order_acquire)) {
+    data->drain_scheduled.store(false, std::memory_order_seq_cst);
+    return;
+  }
+
+  // Al massimo un ring pieno per wakeup, poi si cede all'event loop
+  const size_t budget = data->ring.Capacity();
+  for (;;) {
+    size_t drained = DrainBatch(env, js_callback, data, budget);
+    if (data->released.load(std::memory_order_acquire)) {
+      data->drain_scheduled.store(false, std::memory_order_seq_cst);
+      return;
+    }
+    if (drained == budget) {
+      // Il flag resta true: nessun produttore riaccoda, lo facciamo noi
+      if (data->tsfn.NonBlockingCall() != napi_ok) {
+        data->drain_scheduled.store(false, std::memory_order_seq_cst);
+      }
+      return;
+    }
+
+    // Un produttore può aver pubblicato dopo l'ultimo Front() ma visto il
+    // flag ancora true: dopo averlo abbassato ricontrolla il ring.
+    data->drain_scheduled.store(false, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (data->ring.Front() == nullptr || data->drain_scheduled.exchange(true, std::memory_order_seq_cst)) {
+      return;
+    }
+  }
+}
+
+// ------------------------------------------------------------------------
+// Modalità bloccante: CallFrame riciclati
+// ------------------------------------------------------------------------
+
+static CallFrame* AcquireFrame(ThreadSafeCallbackData* data) {
+  std::lock_guard<std::mutex> lock(data->frame_mutex);
+  CallFrame* frame = data->free_frames;
+  if (frame) {
+    data->free_frames = frame->next;
+  } else {
+    // Prima chiamata a questo livello di concorrenza: unica allocazione
+    const size_t ret_size = data->return_type != CType::CTYPES_VOID ? CTypeSize(data->return_type) : 0;
+    const size_t result_offset = (data->args_size + 15) & ~size_t{15};
+    auto owned = std::make_unique<CallFrame>();
+    owned->storage = std::make_unique<uint8_t[]>(std::max<size_t>(result_offset + ret_size, 1));
+    owned->args = owned->storage.get();
+    owned->result = owned->storage.get() + result_offset;
+    frame = owned.get();
+    data->frames.push_back(std::move(owned));
+  }
+  frame->next = nullptr;
+  frame->ready = false;
+  return frame;
+}
+
+static void ReleaseFrame(ThreadSafeCallbackData* data, CallFrame* frame) {
+  std::lock_guard<std::mutex> lock(data->frame_mutex);
+  frame->next = data->free_frames;
+  data->free_frames = frame;
+}
+
+// Main thread: esegue la chiamata JS di un frame e sveglia il thread in attesa
+static void InvokeFrame(Napi::Env env, Napi::Function js_callback, ThreadSafeCallbackData* data, CallFrame* frame) {
+  const size_t ret_size = data->return_type != CType::CTYPES_VOID ? CTypeSize(data->return_type) : 0;
+
+  if (env != nullptr) {
+    Napi::HandleScope scope(env);
+
+    // SBO: usa stack buffer per callback comuni, heap solo se necessario
+    const size_t nargs = data->arg_plan.size();
+    napi_value inline_args[kMaxInlineCallbackArgs];
+    std::vector<napi_value> heap_args;
+    napi_value* js_args = inline_args;
+    if (nargs > kMaxInlineCallbackArgs) {
+      heap_args.resize(nargs);
+      js_args = heap_args.data();
+    }
+    RecordToJS(env, data, frame->args, js_args);
+
+    napi_value result_val;
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    if (napi_call_function(env, undefined, js_callback, nargs, js_args, &result_val) != napi_ok) {
+      ReportThreadSafeCallbackError(env, data, "Unknown error in thread-safe callback (external thread)");
+      memset(frame->result, 0, ret_size);
+    } else {
+      data->write_return(env, result_val, data->return_type, frame->result, ret_size);
+    }
+  } else {
+    // TSFN in chiusura: nessuna chiamata JS, ma il thread va comunque svegliato
+    memset(frame->result, 0, ret_size);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(data->result_mutex);
+    frame->ready = true;
+  }
+  data->result_cv.notify_all();
+}
+
+void ThreadSafeCallbackCallJs(Napi::Env env,
+                              Napi::Function js_callback,
+                              ThreadSafeCallbackData* data,
+                              CallFrame* frame) {
+  if (frame) {
+    InvokeFrame(env, js_callback, data, frame);
+  } else {
+    DrainEventRing(env, js_callback, data);
+  }
+}
+
 // Handler per ThreadSafeCallback
 static void ThreadSafeCallbackHandler(ffi_cif* cif, void* ret, void** args, void* user_data) {
   ThreadSafeCallbackData* data = static_cast<ThreadSafeCallbackData*>(user_data);
@@ -329,55 +789,34 @@ static void ThreadSafeCallbackHandler(ffi_cif* cif, void* ret, void** args, void
       js_args = heap_args.data();
     }
 
+    const CallbackArgConv* plan = data->arg_plan.data();
     for (unsigned int i = 0; i < cif->nargs; i++) {
-      js_args[i] = CToJS(env, args[i], data->arg_types[i]);
+      js_args[i] = plan[i].read(env, args[i], plan[i]);
     }
 
     // Chiama la funzione JS usando napi_call_function per evitare copia vector
     napi_value result_val;
     napi_value undefined;
     napi_get_undefined(env, &undefined);
-    napi_status call_status =
-      napi_call_function(env, undefined, data->js_function_ref.Value(), cif->nargs, js_args, &result_val);
+    napi_status call_status;
+    if (data->batch) {
+      // Stessa forma del drain: un batch con un solo record
+      napi_value entry, records;
+      napi_create_array_with_length(env, cif->nargs, &entry);
+      for (unsigned int i = 0; i < cif->nargs; i++) {
+        napi_set_element(env, entry, i, js_args[i]);
+      }
+      napi_create_array_with_length(env, 1, &records);
+      napi_set_element(env, records, 0, entry);
+      call_status = napi_call_function(env, undefined, data->js_function_ref.Value(), 1, &records, &result_val);
+    } else {
+      call_status =
+        napi_call_function(env, undefined, data->js_function_ref.Value(), cif->nargs, js_args, &result_val);
+    }
 
     // Gestisce errori/eccezioni
     if (call_status != napi_ok) {
-      // Estrae messaggio di errore dall'eccezione JS
-      std::string error_msg = "Unknown error in thread-safe callback";
-      bool is_pending;
-      if (napi_is_exception_pending(env, &is_pending) == napi_ok && is_pending) {
-        napi_value exception;
-        if (napi_get_and_clear_last_exception(env, &exception) == napi_ok) {
-          Napi::Error err(env, exception);
-          error_msg = err.Message();
-        }
-      }
-
-      {
-        std::lock_guard<std::mutex> lock(data->result_mutex);
-        data->last_error = error_msg;
-      }
-
-      if (!data->error_handler_ref.IsEmpty()) {
-        try {
-          Napi::Function error_handler = data->error_handler_ref.Value();
-          error_handler.Call({Napi::String::New(env, error_msg)});
-        } catch (...) {
-        }
-      } else {
-        // Emetti warning
-        napi_value process, emit_warning;
-        if (napi_get_global(env, &process) == napi_ok &&
-            napi_get_named_property(env, process, "emitWarning", &emit_warning) == napi_ok) {
-          napi_value warning_msg_val;
-          napi_create_string_utf8(env, error_msg.c_str(), NAPI_AUTO_LENGTH, &warning_msg_val);
-          napi_value warning_type;
-          napi_create_string_utf8(env, "ThreadSafeCallbackError", NAPI_AUTO_LENGTH, &warning_type);
-          napi_value warn_args[2] = {warning_msg_val, warning_type};
-          napi_value warn_result;
-          napi_call_function(env, process, emit_warning, 2, warn_args, &warn_result);
-        }
-      }
+      ReportThreadSafeCallbackError(env, data, "Unknown error in thread-safe callback");
 
       if (data->return_type != CType::CTYPES_VOID) {
         memset(ret, 0, CTypeSize(data->return_type));
@@ -385,136 +824,36 @@ static void ThreadSafeCallbackHandler(ffi_cif* cif, void* ret, void** args, void
       return;
     }
 
-    if (data->return_type != CType::CTYPES_VOID) {
-      // Scrivi direttamente in `ret` (buffer fornito da libffi) invece di
-      // allocare un vector temporaneo e fare memcpy — stesso fix della
-      // Callback main-thread path.
-      size_t ret_size = CTypeSize(data->return_type);
-      Napi::Value result(env, result_val);
-      int written = JSToC(env, result, data->return_type, static_cast<uint8_t*>(ret), ret_size);
-      if (written <= 0) {
-        memset(ret, 0, ret_size);
-      }
-    }
+    // Scrivi direttamente in `ret` (buffer fornito da libffi) invece di
+    // allocare un vector temporaneo e fare memcpy — stesso fix della
+    // Callback main-thread path.
+    data->write_return(env, result_val, data->return_type, ret, CTypeSize(data->return_type));
+  } else if (data->non_blocking) {
+    // Percorso thread esterno, fire-and-forget: copia gli argomenti nel ring
+    // e ritorna senza aspettare il main thread
+    EnqueueEvent(data, args);
   } else {
-    // Percorso thread esterno: usa TSFN + sincronizzazione
-    {
-      std::lock_guard<std::mutex> lock(data->result_mutex);
-      data->result_ready.store(false, std::memory_order_release);
-    }
-
-    // Cattura args per la lambda
-    std::vector<std::vector<uint8_t>> args_copy;
-    args_copy.reserve(cif->nargs);
-    for (unsigned int i = 0; i < cif->nargs; i++) {
-      size_t size = CTypeSize(data->arg_types[i]);
-      std::vector<uint8_t> arg_data(size);
-      memcpy(arg_data.data(), args[i], size);
-      args_copy.push_back(std::move(arg_data));
-    }
-
-    auto invoke = [data, args_copy = std::move(args_copy)](Napi::Env env, Napi::Function js_callback) {
-      // SBO: usa stack buffer per callback comuni, heap solo se necessario
-      const size_t nargs = args_copy.size();
-      napi_value inline_args[kMaxInlineCallbackArgs];
-      std::vector<napi_value> heap_args;
-      napi_value* js_args;
-
-      if (nargs <= kMaxInlineCallbackArgs) {
-        js_args = inline_args;
-      } else {
-        heap_args.resize(nargs);
-        js_args = heap_args.data();
-      }
-
-      for (size_t i = 0; i < nargs; i++) {
-        // Usa CToJS per tipi primitivi (callback non supportano struct/array)
-        js_args[i] = CToJS(env, args_copy[i].data(), data->arg_types[i]);
-      }
-
-      // Chiama la funzione JS usando napi_call_function per evitare copia vector
-      napi_value result_val;
-      napi_value undefined;
-      napi_get_undefined(env, &undefined);
-      napi_status call_status = napi_call_function(env, undefined, js_callback, nargs, js_args, &result_val);
-
-      // Gestisce errori/eccezioni
-      if (call_status != napi_ok) {
-        // Estrae messaggio di errore dall'eccezione JS
-        std::string error_msg = "Unknown error in thread-safe callback (external thread)";
-        bool is_pending;
-        if (napi_is_exception_pending(env, &is_pending) == napi_ok && is_pending) {
-          napi_value exception;
-          if (napi_get_and_clear_last_exception(env, &exception) == napi_ok) {
-            Napi::Error err(env, exception);
-            error_msg = err.Message();
-          }
-        }
-
-        {
-          std::lock_guard<std::mutex> lock(data->result_mutex);
-          data->last_error = error_msg;
-        }
-
-        if (!data->error_handler_ref.IsEmpty()) {
-          try {
-            Napi::Function error_handler = data->error_handler_ref.Value();
-            error_handler.Call({Napi::String::New(env, error_msg)});
-          } catch (...) {
-          }
-        } else {
-          // Emetti warning
-          napi_value process, emit_warning;
-          if (napi_get_global(env, &process) == napi_ok &&
-              napi_get_named_property(env, process, "emitWarning", &emit_warning) == napi_ok) {
-            napi_value warning_msg_val;
-            napi_create_string_utf8(env, error_msg.c_str(), NAPI_AUTO_LENGTH, &warning_msg_val);
-            napi_value warning_type;
-            napi_create_string_utf8(env, "ThreadSafeCallbackError", NAPI_AUTO_LENGTH, &warning_type);
-            napi_value warn_args[2] = {warning_msg_val, warning_type};
-            napi_value warn_result;
-            napi_call_function(env, process, emit_warning, 2, warn_args, &warn_result);
-          }
-        }
-
-        // Segnala errore e ritorna
-        {
-          std::lock_guard<std::mutex> lock(data->result_mutex);
-          data->result_ready.store(true, std::memory_order_release);
-        }
-        data->result_cv.notify_one();
-        return;
-      }
-
-      // Salva risultato
-      {
-        std::lock_guard<std::mutex> lock(data->result_mutex);
-        if (data->return_type != CType::CTYPES_VOID && result_val != nullptr) {
-          size_t ret_size = CTypeSize(data->return_type);
-          data->result_buffer.resize(ret_size);  // Ensure buffer is large enough
-          Napi::Value result(env, result_val);
-          JSToC(env, result, data->return_type, data->result_buffer.data(), data->result_buffer.size());
-        }
-        data->result_ready.store(true, std::memory_order_release);
-      }
-      data->result_cv.notify_one();
-    };
+    // Percorso thread esterno: argomenti nel CallFrame, attesa del risultato
+    CallFrame* frame = AcquireFrame(data);
+    CopyArgs(data, args, frame->args);
 
     // Verifica nuovamente se rilasciato (race condition check)
     if (data->released.load(std::memory_order_acquire)) {
+      ReleaseFrame(data, frame);
       if (data->return_type != CType::CTYPES_VOID) {
         memset(ret, 0, CTypeSize(data->return_type));
       }
       return;
     }
 
-    napi_status status = data->tsfn.BlockingCall(invoke);
+    napi_status status = data->tsfn.BlockingCall(frame);
     if (status != napi_ok) {
       // Salva errore senza logging - l'utente può controllare last_error
       {
         std::lock_guard<std::mutex> lock(data->result_mutex);
         data->last_error = std::format("Failed to queue callback (napi_status: {})", static_cast<int>(status));
       }
+      ReleaseFrame(data, frame);
 
       if (data->return_type != CType::CTYPES_VOID) {
         memset(ret, 0, CTypeSize(data->return_type));
@@ -525,19 +864,14 @@ static void ThreadSafeCallbackHandler(ffi_cif* cif, void* ret, void** args, void
     // Aspetta risultato
     {
       std::unique_lock<std::mutex> lock(data->result_mutex);
-      data->result_cv.wait(lock, [data] { return data->result_ready.load(std::memory_order_acquire); });
+      data->result_cv.wait(lock, [frame] { return frame->ready; });
     }
 
     // Copia risultato
     if (data->return_type != CType::CTYPES_VOID) {
-      std::lock_guard<std::mutex> lock(data->result_mutex);
-      size_t ret_size = CTypeSize(data->return_type);
-      if (data->result_buffer.size() >= ret_size) {
-        memcpy(ret, data->result_buffer.data(), ret_size);
-      } else {
-        memset(ret, 0, ret_size);
-      }
+      memcpy(ret, frame->result, CTypeSize(data->return_type));
     }
+    ReleaseFrame(data, frame);
   }
 }
 
@@ -548,6 +882,7 @@ Napi::Function ThreadSafeCallback::GetClass(Napi::Env env) {
                        InstanceMethod("release", &ThreadSafeCallback::Release),
                        InstanceMethod("setErrorHandler", &ThreadSafeCallback::SetErrorHandler),
                        InstanceMethod("getLastError", &ThreadSafeCallback::GetLastError),
+                       InstanceMethod("getDroppedCount", &ThreadSafeCallback::GetDroppedCount),
                      });
 }
 
@@ -589,20 +924,9 @@ ThreadSafeCallback::ThreadSafeCallback(const Napi::CallbackInfo& info) : Napi::O
     return;
   }
 
-  Napi::Array arr = info[2].As<Napi::Array>();
-  for (uint32_t i = 0; i < arr.Length(); i++) {
-    Napi::Value elem = arr.Get(i);
-    try {
-      if (elem.IsNumber()) {
-        data_->arg_types.push_back(IntToCType(elem.As<Napi::Number>().Int32Value()));
-      } else {
-        throw std::runtime_error("Type must be CType enum value (number) or CType object");
-      }
-    } catch (const std::exception& e) {
-      Napi::Error::New(env, std::format("Invalid argument type at index {}: {}", i, e.what()))
-        .ThrowAsJavaScriptException();
-      return;
-    }
+  if (!ParseCallbackArgTypes(env, info[2].As<Napi::Array>(), data_->arg_types, data_->ffi_arg_types,
+                             data_->arg_plan)) {
+    return;
   }
 
   // Parse optional 4th argument: calling convention string
@@ -611,12 +935,47 @@ ThreadSafeCallback::ThreadSafeCallback(const Napi::CallbackInfo& info) : Napi::O
     abi = CallConvToFFI(StringToCallConv(info[3].As<Napi::String>().Utf8Value()));
   }
 
-  // Prepara FFI types
-  data_->ffi_return_type = CTypeToFFI(data_->return_type);
-  for (const auto& type : data_->arg_types) {
-    data_->ffi_arg_types.push_back(CTypeToFFI(type));
+  // Parse optional 5th argument: { nonBlocking, batch, capacity }
+  if (info.Length() > 4 && info[4].IsObject()) {
+    Napi::Object options = info[4].As<Napi::Object>();
+    data_->non_blocking = options.Get("nonBlocking").ToBoolean();
+    data_->batch = options.Get("batch").ToBoolean();
+    if (data_->batch && !data_->non_blocking) {
+      Napi::TypeError::New(env, "batch requires nonBlocking").ThrowAsJavaScriptException();
+      return;
+    }
+    if (data_->non_blocking) {
+      if (data_->return_type != CType::CTYPES_VOID) {
+        Napi::TypeError::New(env, "nonBlocking requires a void return type").ThrowAsJavaScriptException();
+        return;
+      }
+
+      // Record a dimensione fissa: gli argomenti-stringa punterebbero a
+      // memoria del chiamante non più valida quando il main thread li legge
+      for (const auto& type : data_->arg_types) {
+        if (type == CType::CTYPES_STRING || type == CType::CTYPES_WSTRING) {
+          Napi::TypeError::New(env, "nonBlocking callbacks cannot take string arguments (use c_void_p)")
+            .ThrowAsJavaScriptException();
+          return;
+        }
+      }
+
+      Napi::Value capacity_val = options.Get("capacity");
+      if (!capacity_val.IsUndefined()) {
+        double requested = capacity_val.IsNumber() ? capacity_val.As<Napi::Number>().DoubleValue() : 0;
+        if (requested < 1 || requested > (1 << 24) || std::floor(requested) != requested) {
+          Napi::RangeError::New(env, "capacity must be an integer between 1 and 16777216").ThrowAsJavaScriptException();
+          return;
+        }
+        data_->ring_capacity = static_cast<size_t>(requested);
+      }
+    }
   }
 
+  // Prepara FFI type di ritorno (quelli degli argomenti vengono dal parse)
+  data_->ffi_return_type = CTypeToFFI(data_->return_type);
+  data_->write_return = SelectReturnWriter(data_->return_type);
+
   // Prepara CIF
   ffi_status status =
     ffi_prep_cif(&data_->cif, abi, static_cast<unsigned int>(data_->ffi_arg_types.size()), data_->ffi_return_type,
@@ -627,11 +986,28 @@ ThreadSafeCallback::ThreadSafeCallback(const Napi::CallbackInfo& info) : Napi::O
     return;
   }
 
-  // Crea ThreadSafeFunction
-  data_->tsfn = Napi::ThreadSafeFunction::New(env, js_func, "ThreadSafeCallback",
-                                              0,  // Unlimited queue
-                                              1   // Initial thread count
-  );
+  // Layout degli argomenti copiati dai thread esterni (CallFrame / ring),
+  // dalle dimensioni e dagli allineamenti del cif appena preparato
+  for (unsigned int i = 0; i < data_->cif.nargs; i++) {
+    const ffi_type* arg_type = data_->cif.arg_types[i];
+    const size_t align = std::max<size_t>(arg_type->alignment, 1);
+    data_->args_size = (data_->args_size + align - 1) / align * align;
+    data_->arg_plan[i].offset = data_->args_size;
+    data_->arg_plan[i].size = arg_type->size;
+    data_->args_size += arg_type->size;
+  }
+  if (data_->non_blocking) {
+    data_->ring.Init(data_->ring_capacity, data_->args_size);
+  }
+
+  // Crea ThreadSafeFunction: items = CallFrame* (nullptr per i wakeup del
+  // ring), niente allocazioni per chiamata
+  data_->tsfn =
+    Napi::TypedThreadSafeFunction<ThreadSafeCallbackData, CallFrame, &ThreadSafeCallbackCallJs>::New(
+      env, js_func, "ThreadSafeCallback",
+      0,  // Unlimited queue
+      1,  // Initial thread count
+      data_.get());
 
   // Alloca closure
   data_->closure = static_cast<ffi_closure*>(ffi_closure_alloc(sizeof(ffi_closure), &data_->code_ptr));
@@ -696,6 +1072,16 @@ Napi::Value ThreadSafeCallback::GetLastError(const Napi::CallbackInfo& info) {
   return Napi::String::New(env, data_->last_error);
 }
 
+Napi::Value ThreadSafeCallback::GetDroppedCount(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!data_) {
+    return Napi::Number::New(env, 0);
+  }
+
+  return Napi::Number::New(env, static_cast<double>(data_->dropped.load(std::memory_order_relaxed)));
+}
+
 Napi::Value ThreadSafeCallback::GetPointer(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
 
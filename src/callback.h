@@ -1,10 +1,33 @@
 #pragma once
 
+#include "array.h"
 #include "shared.h"
+#include "struct.h"
 #include "types.h"
 
 namespace ctypes {
 
+// ========================================================================
+// Piano di conversione per-signature, costruito alla creazione del
+// callback: un reader C → JS per argomento e un writer JS → C per il
+// ritorno. Gli handler percorrono il piano senza ridispatchare su CType;
+// struct / union / array per valore hanno il loro reader (StructToJS /
+// ArrayToJS) al posto di CToJS.
+// ========================================================================
+
+struct CallbackArgConv;
+using CallbackArgReader = napi_value (*)(napi_env env, const void* src, const CallbackArgConv& conv);
+using CallbackReturnWriter = void (*)(napi_env env, napi_value value, CType type, void* ret, size_t size);
+
+struct CallbackArgConv {
+  CallbackArgReader read = nullptr;
+  CType type = CType::CTYPES_VOID;
+  size_t offset = 0;  // posizione nel record del ring / CallFrame (solo ThreadSafeCallback)
+  size_t size = 0;
+  std::shared_ptr<StructInfo> struct_info;  // by-value struct / union
+  std::shared_ptr<ArrayInfo> array_info;    // by-value array
+};
+
 // ========================================================================
 // Callback - Solo main thread, veloce, zero overhead
 // ========================================================================
@@ -19,6 +42,8 @@ struct CallbackData {
   std::vector<CType> arg_types;
   std::vector<ffi_type*> ffi_arg_types;
   ffi_type* ffi_return_type = nullptr;
+  std::vector<CallbackArgConv> arg_plan;
+  CallbackReturnWriter write_return = nullptr;
   std::atomic<bool> released{false};
   std::string last_error;  // Ultimo errore catturato
   std::mutex error_mutex;  // Protezione per last_error
@@ -44,8 +69,71 @@ class Callback : public Napi::ObjectWrap<Callback> {
 // ThreadSafeCallback - Supporta chiamate da qualsiasi thread
 // ========================================================================
 
+// Ring buffer MPSC bounded per la modalità non bloccante (schema Vyukov:
+// numero di sequenza per slot, una CAS per produttore, consumer unico senza
+// atomiche RMW). Ogni slot contiene un record a dimensione fissa con gli
+// argomenti grezzi della chiamata; gli slot sono multipli di cache line per
+// evitare false sharing tra produttori che scrivono slot adiacenti.
+class EventRing {
+ public:
+  // capacity arrotondata alla potenza di 2 successiva
+  void Init(size_t capacity, size_t record_size);
+
+  // Produttori (qualsiasi thread): riserva uno slot, scrive il record e lo
+  // pubblica con Commit(). nullptr se il ring è pieno.
+  uint8_t* Reserve(size_t& pos);
+  void Commit(size_t pos);
+
+  // Consumer (solo main thread): record in testa o nullptr se vuoto
+  // (o se il produttore non ha ancora fatto Commit).
+  const uint8_t* Front();
+  void Pop();
+
+  size_t Capacity() const { return mask_ + 1; }
+
+ private:
+  static constexpr size_t kCacheLine = 64;
+  static constexpr size_t kHeaderSize = 16;  // sequenza + padding (record allineato a 16)
+
+  struct alignas(kCacheLine) CacheLine {
+    uint8_t bytes[kCacheLine];
+  };
+
+  std::atomic<size_t>& Sequence(size_t index) {
+    return *reinterpret_cast<std::atomic<size_t>*>(Slot(index));
+  }
+  uint8_t* Slot(size_t index) { return reinterpret_cast<uint8_t*>(storage_.get()) + (index & mask_) * slot_size_; }
+
+  std::unique_ptr<CacheLine[]> storage_;
+  size_t slot_size_ = 0;
+  size_t mask_ = 0;
+  alignas(kCacheLine) std::atomic<size_t> enqueue_pos_{0};
+  alignas(kCacheLine) size_t dequeue_pos_ = 0;
+};
+
+struct ThreadSafeCallbackData;
+
+// Frame di una chiamata bloccante da thread esterno: argomenti copiati e
+// spazio per il valore di ritorno in un'unica allocazione, dimensionata dal
+// cif alla costruzione. I frame vengono riciclati tramite la free list del
+// callback: a regime nessuna malloc/free dai thread esterni.
+struct CallFrame {
+  CallFrame* next = nullptr;  // free list (protetta da frame_mutex)
+  bool ready = false;         // protetto da result_mutex
+  std::unique_ptr<uint8_t[]> storage;
+  uint8_t* args = nullptr;    // layout: offset / size di ThreadSafeCallbackData::arg_plan
+  uint8_t* result = nullptr;  // CTypeSize(return_type) byte
+};
+
+// Eseguita sul main thread per ogni item del TSFN. frame == nullptr è un
+// wakeup della modalità non bloccante (drain del ring).
+void ThreadSafeCallbackCallJs(Napi::Env env,
+                              Napi::Function js_callback,
+                              ThreadSafeCallbackData* data,
+                              CallFrame* frame);
+
 struct ThreadSafeCallbackData {
-  Napi::ThreadSafeFunction tsfn;
+  Napi::TypedThreadSafeFunction<ThreadSafeCallbackData, CallFrame, &ThreadSafeCallbackCallJs> tsfn;
   Napi::FunctionReference js_function_ref;
   Napi::FunctionReference error_handler_ref;  // Error handler opzionale
   std::thread::id main_thread_id;
@@ -56,14 +144,33 @@ struct ThreadSafeCallbackData {
   std::vector<CType> arg_types;
   std::vector<ffi_type*> ffi_arg_types;
   ffi_type* ffi_return_type = nullptr;
+  std::vector<CallbackArgConv> arg_plan;  // include il layout degli argomenti copiati (ring / CallFrame)
+  CallbackReturnWriter write_return = nullptr;
   std::atomic<bool> released{false};
 
   // Sincronizzazione per thread esterni
   std::mutex result_mutex;
-  std::condition_variable result_cv;
-  std::vector<uint8_t> result_buffer;  // Dynamic buffer to prevent overflow
-  std::atomic<bool> result_ready{false};
-  std::string last_error;  // Ultimo errore catturato
+  std::condition_variable result_cv;  // notify_all: ogni thread aspetta il proprio frame
+  std::string last_error;             // Ultimo errore catturato
+
+  // Dimensione degli argomenti copiati (ring e CallFrame), calcolata dal cif
+  size_t args_size = 0;
+
+  // Pool di CallFrame: cresce fino al numero massimo di chiamate bloccanti
+  // concorrenti, poi solo riuso
+  std::mutex frame_mutex;
+  CallFrame* free_frames = nullptr;
+  std::vector<std::unique_ptr<CallFrame>> frames;
+
+  // Modalità non bloccante (solo callback void): i thread esterni copiano
+  // gli argomenti nel ring e ritornano subito; il main thread svuota più
+  // record per ogni wakeup del TSFN.
+  bool non_blocking = false;
+  bool batch = false;  // una chiamata JS per batch con array di record
+  size_t ring_capacity = 4096;
+  EventRing ring;
+  std::atomic<bool> drain_scheduled{false};  // wakeup già accodato sul TSFN
+  std::atomic<uint64_t> dropped{0};          // eventi scartati a ring pieno
 };
 
 class ThreadSafeCallback : public Napi::ObjectWrap<ThreadSafeCallback> {
@@ -77,6 +184,7 @@ class ThreadSafeCallback : public Napi::ObjectWrap<ThreadSafeCallback> {
   Napi::Value Release(const Napi::CallbackInfo& info);
   Napi::Value SetErrorHandler(const Napi::CallbackInfo& info);
   Napi::Value GetLastError(const Napi::CallbackInfo& info);
+  Napi::Value GetDroppedCount(const Napi::CallbackInfo& info);
 
  private:
   std::unique_ptr<ThreadSafeCallbackData> data_;
@@ -1,6 +1,7 @@
 #include "function.h"
 
 #include "addon.h"  // CTypesAddon per gli slot captured_last_error / captured_errno
+#include "text.h"
 
 namespace ctypes {
 
@@ -42,11 +43,20 @@ Napi::Function FFIFunction::GetClass(Napi::Env env) {
                      {
                        InstanceMethod("call", &FFIFunction::Call),
                        InstanceMethod("callAsync", &FFIFunction::CallAsync),
+                       InstanceMethod("submit", &FFIFunction::Submit),
+                       InstanceMethod("callBatch", &FFIFunction::CallBatch),
+                       InstanceMethod("mapAsync", &FFIFunction::MapAsync),
                        InstanceMethod("setErrcheck", &FFIFunction::SetErrcheck),
+                       InstanceMethod("setErrcheckPolicy", &FFIFunction::SetErrcheckPolicy),
+                       InstanceMethod("getFastCall", &FFIFunction::GetFastCall),
+                       InstanceMethod("getVariadicCacheStats", &FFIFunction::GetVariadicCacheStats),
+                       InstanceMethod("getStats", &FFIFunction::GetStats),
+                       InstanceMethod("resetStats", &FFIFunction::ResetStats),
                        InstanceMethod("getCapturedLastError", &FFIFunction::GetLastErrorCaptured),
                        InstanceMethod("getCapturedErrno", &FFIFunction::GetErrnoCaptured),
                        InstanceAccessor("name", &FFIFunction::GetName, nullptr),
                        InstanceAccessor("address", &FFIFunction::GetAddress, nullptr),
+                       InstanceAccessor("outValues", &FFIFunction::GetOutValues, nullptr),
                      });
 }
 
@@ -61,17 +71,20 @@ Napi::Value FFIFunction::GetErrnoCaptured(const Napi::CallbackInfo& info) {
 FFIFunction::FFIFunction(const Napi::CallbackInfo& info)
   : Napi::ObjectWrap<FFIFunction>(info),
     fn_ptr_(nullptr),
+    cif_(nullptr),
     cif_prepared_(false),
     abi_(FFI_DEFAULT_ABI),
     return_type_(CType::CTYPES_VOID),
-    ffi_return_type_(nullptr),
+    pointer_mode_(PointerMode::BIGINT),
     inline_string_offset_(0),
     use_inline_storage_(true),
-    next_cache_slot_(0),
+    return_converter_(nullptr),
+    trampoline_(nullptr),
     capture_last_error_(false),
     capture_errno_(false),
     last_error_(0),
     last_errno_(0),
+    stats_enabled_(false),
     addon_(nullptr) {
   Napi::Env env = info.Env();
   addon_ = env.GetInstanceData<CTypesAddon>();
@@ -191,6 +204,47 @@ FFIFunction::FFIFunction(const Napi::CallbackInfo& info)
     if (opts.Has("use_errno")) {
       capture_errno_ = opts.Get("use_errno").ToBoolean().Value();
     }
+    if (opts.Has("stats")) {
+      stats_enabled_ = opts.Get("stats").ToBoolean().Value();
+    }
+    if (opts.Has("pointerMode")) {
+      Napi::Value mode = opts.Get("pointerMode");
+      if (!mode.IsUndefined() && !ParsePointerMode(env, mode, pointer_mode_)) {
+        return;
+      }
+    }
+    if (opts.Has("queue")) {
+      Napi::Value queue = opts.Get("queue");
+      if (!queue.IsUndefined() && !queue.IsNull()) {
+        serial_queue_ = SerialQueueFromHandle(env, queue);
+        if (!serial_queue_) {
+          Napi::TypeError::New(env, "queue must be a handle returned by createSerialQueue()")
+            .ThrowAsJavaScriptException();
+          return;
+        }
+      }
+    }
+    if (opts.Has("struct_view")) {
+      Napi::Value view = opts.Get("struct_view");
+      if (!view.IsUndefined() && !view.IsNull()) {
+        if (!view.IsFunction()) {
+          Napi::TypeError::New(env, "struct_view must be a function").ThrowAsJavaScriptException();
+          return;
+        }
+        if (!return_struct_info_) {
+          Napi::TypeError::New(env, "struct_view requires a struct or union return type")
+            .ThrowAsJavaScriptException();
+          return;
+        }
+        struct_view_ = Napi::Persistent(view.As<Napi::Function>());
+      }
+    }
+    if (opts.Has("outParams")) {
+      Napi::Value out = opts.Get("outParams");
+      if (!out.IsUndefined() && !out.IsNull() && !ParseOutParams(env, out)) {
+        return;
+      }
+    }
   }
 
   // Determina se usare storage inline o heap
@@ -199,8 +253,8 @@ FFIFunction::FFIFunction(const Napi::CallbackInfo& info)
   // Precalcola a construction time: la signature usa argomenti stringa
   // (STRING/WSTRING) o overflow (STRUCT/UNION/ARRAY oltre ARG_SLOT_SIZE)?
   // L'hot path di Call() usa questi flag per saltare il reset di
-  // string_buffer_ e sync_large_arg_buffers_.clear() quando nessuno dei
-  // due è stato toccato dalla call precedente.
+  // string_buffer_ e di sync_aggregates_ quando nessuno dei due è stato
+  // toccato dalla call precedente.
   has_string_args_ = false;
   has_struct_array_args_ = false;
   for (const auto& t : arg_types_) {
@@ -211,23 +265,41 @@ FFIFunction::FFIFunction(const Napi::CallbackInfo& info)
     }
   }
 
-  // Pre-alloca heap storage se necessario (come CPython - pool struct argument)
-  if (!use_inline_storage_) {
-    heap_arg_storage_.resize(arg_types_.size() * ARG_SLOT_SIZE);
-    heap_arg_values_.resize(arg_types_.size());
+  // Arena degli aggregati by-value: somma dei layout che non stanno nello
+  // slot (arrotondati ai blocchi da 16 di AggregateArena), più il ritorno
+  aggregate_arena_bytes_ = 0;
+  for (size_t i = 0; i < arg_types_.size(); i++) {
+    const size_t size = arg_struct_infos_[i]  ? arg_struct_infos_[i]->GetSize()
+                        : arg_array_infos_[i] ? arg_array_infos_[i]->GetSize()
+                                              : 0;
+    if (size > ARG_SLOT_SIZE) {
+      aggregate_arena_bytes_ += (size + 15) & ~static_cast<size_t>(15);
+    }
+  }
+  large_return_size_ = 0;
+  if (return_type_ == CType::CTYPES_STRUCT && return_struct_info_) {
+    large_return_size_ = return_struct_info_->GetSize();
+  } else if (return_type_ == CType::CTYPES_ARRAY && return_array_info_) {
+    large_return_size_ = return_array_info_->GetSize();
   }
-  // Per arg counts piccoli usiamo sempre inline_arg_values_ (stack allocation)
+  if (large_return_size_ <= sizeof(ReturnValue)) {
+    large_return_size_ = 0;
+  }
+  uses_aggregate_arena_ = has_struct_array_args_ || large_return_size_ > 0;
+  sync_aggregates_.SetCapacity(aggregate_arena_bytes_ + ((large_return_size_ + 15) & ~static_cast<size_t>(15)));
 
-  // Pre-alloca string buffer (stima iniziale)
-  size_t string_count = 0;
-  for (const auto& type : arg_types_) {
-    if (type == CType::CTYPES_STRING) {
-      string_count++;
-    }
+  // Piano di conversione per-signature (vedi function.h)
+  arg_marshalers_.reserve(arg_types_.size());
+  for (const auto& t : arg_types_) {
+    arg_marshalers_.push_back(SelectArgMarshaler(t));
   }
-  if (string_count > 0) {
-    string_buffer_.reserve(string_count * 128);  // 128 bytes per stringa media
+  for (const auto& out : out_params_) {
+    arg_marshalers_[out.index] = &MarshalOutArg;
   }
+  return_converter_ = SelectReturnConverter();
+
+  // Scratch (storage inline / heap, string buffer) allocato alla prima
+  // call: vedi EnsureScratch() e il setup dello storage in Call().
 
   if (!PrepareFFI(env)) {
     return;
@@ -239,44 +311,144 @@ FFIFunction::~FFIFunction() {
   if (!errcheck_callback_.IsEmpty()) {
     errcheck_callback_.Reset();
   }
+  errcheck_error_.Reset();
+  if (stats_ && addon_) {
+    addon_->instrumented_functions.erase(this);
+  }
 }
 
 bool FFIFunction::PrepareFFI(Napi::Env env) {
+  // Layout di struct/array referenziati: la signature internata li tiene
+  // vivi finché qualcuno la usa (vedi signature.h)
+  std::vector<std::shared_ptr<void>> layouts;
+
   // Return type FFI
+  ffi_type* ffi_return_type;
   if (return_type_ == CType::CTYPES_STRUCT && return_struct_info_) {
-    ffi_return_type_ = return_struct_info_->GetFFIType();
+    ffi_return_type = return_struct_info_->GetFFIType();
+    layouts.push_back(return_struct_info_);
   } else if (return_type_ == CType::CTYPES_ARRAY && return_array_info_) {
-    ffi_return_type_ = return_array_info_->GetFFIType();
+    ffi_return_type = return_array_info_->GetFFIType();
+    layouts.push_back(return_array_info_);
   } else {
-    ffi_return_type_ = CTypeToFFI(return_type_);
+    ffi_return_type = CTypeToFFI(return_type_);
   }
 
   // Argument types FFI
-  ffi_arg_types_.clear();
-  ffi_arg_types_.reserve(arg_types_.size());
+  std::vector<ffi_type*> ffi_arg_types;
+  ffi_arg_types.reserve(arg_types_.size());
   for (size_t i = 0; i < arg_types_.size(); i++) {
     if (arg_types_[i] == CType::CTYPES_STRUCT && arg_struct_infos_[i]) {
-      ffi_arg_types_.push_back(arg_struct_infos_[i]->GetFFIType());
+      ffi_arg_types.push_back(arg_struct_infos_[i]->GetFFIType());
+      layouts.push_back(arg_struct_infos_[i]);
     } else if (arg_types_[i] == CType::CTYPES_ARRAY && arg_array_infos_[i]) {
-      ffi_arg_types_.push_back(arg_array_infos_[i]->GetFFIType());
+      ffi_arg_types.push_back(arg_array_infos_[i]->GetFFIType());
+      layouts.push_back(arg_array_infos_[i]);
     } else {
-      ffi_arg_types_.push_back(CTypeToFFI(arg_types_[i]));
+      ffi_arg_types.push_back(CTypeToFFI(arg_types_[i]));
     }
   }
 
-  ffi_status status = ffi_prep_cif(&cif_, abi_, static_cast<unsigned int>(ffi_arg_types_.size()), ffi_return_type_,
-                                   ffi_arg_types_.empty() ? nullptr : ffi_arg_types_.data());
-
-  if (status != FFI_OK) {
+  signature_ = SignatureRegistry::Shared().Intern(abi_, ffi_return_type, ffi_arg_types, std::move(layouts));
+  if (!signature_) {
     const char* msg = "Failed to prepare FFI call interface";
     Napi::Error::New(env, msg).ThrowAsJavaScriptException();
     return false;
   }
 
+  cif_ = &signature_->cif;
   cif_prepared_ = true;
+
+  // Trampolino specializzato per signature tutte primitive: bypassa
+  // MarshalArguments / ffi_call / ConvertReturn. Escluse le ABI non di
+  // default e la cattura di errno / last-error (lo snapshot deve avvenire
+  // prima di qualsiasi chiamata N-API, cosa che il path libffi garantisce).
+  trampoline_ = nullptr;
+  if (abi_ == FFI_DEFAULT_ABI && !capture_last_error_ && !capture_errno_ && out_params_.empty()) {
+    trampoline_ = SelectTrampoline(fn_ptr_, return_type_, arg_types_, pointer_mode_, trampoline_plan_);
+  }
+  return true;
+}
+
+// ============================================================================
+// Out param nativi
+// ============================================================================
+
+// outParams: [{ index, type }], `type` = CType primitivo puntato
+bool FFIFunction::ParseOutParams(Napi::Env env, const Napi::Value& value) {
+  if (!value.IsArray()) {
+    Napi::TypeError::New(env, "outParams must be an array of { index, type }").ThrowAsJavaScriptException();
+    return false;
+  }
+  Napi::Array entries = value.As<Napi::Array>();
+  const uint32_t count = entries.Length();
+  for (uint32_t j = 0; j < count; j++) {
+    Napi::Value entry = entries.Get(j);
+    Napi::Value index_value = entry.IsObject() ? entry.As<Napi::Object>().Get("index") : env.Undefined();
+    Napi::Value type_value = entry.IsObject() ? entry.As<Napi::Object>().Get("type") : env.Undefined();
+    if (!index_value.IsNumber() || !type_value.IsNumber()) {
+      Napi::TypeError::New(env, std::format("outParams[{}] must be {{ index: number, type: CType }}", j))
+        .ThrowAsJavaScriptException();
+      return false;
+    }
+    const int64_t index = index_value.As<Napi::Number>().Int64Value();
+    if (index < 0 || static_cast<uint64_t>(index) >= arg_types_.size() ||
+        arg_types_[static_cast<size_t>(index)] != CType::CTYPES_POINTER) {
+      Napi::TypeError::New(env, std::format("outParams[{}]: argument {} is not a pointer argument", j, index))
+        .ThrowAsJavaScriptException();
+      return false;
+    }
+    const int32_t type_raw = type_value.As<Napi::Number>().Int32Value();
+    const CType type = IsValidCType(type_raw) ? static_cast<CType>(type_raw) : CType::CTYPES_VOID;
+    if (type == CType::CTYPES_VOID || type == CType::CTYPES_STRUCT || type == CType::CTYPES_UNION ||
+        type == CType::CTYPES_ARRAY || CTypeSize(type) > sizeof(uint64_t)) {
+      Napi::TypeError::New(env, std::format("outParams[{}]: type must be a primitive CType", j))
+        .ThrowAsJavaScriptException();
+      return false;
+    }
+    for (const auto& out : out_params_) {
+      if (out.index == static_cast<size_t>(index)) {
+        Napi::TypeError::New(env, std::format("outParams[{}]: argument {} declared twice", j, index))
+          .ThrowAsJavaScriptException();
+        return false;
+      }
+    }
+    out_params_.push_back({static_cast<size_t>(index), type});
+  }
+  if (!out_params_.empty()) {
+    out_storage_.assign(out_params_.size(), 0);
+    out_values_ = Napi::Persistent(Napi::Array::New(env, out_params_.size()));
+  }
+  return true;
+}
+
+// Il valore JS passato per l'out param viene ignorato (di solito undefined)
+bool FFIFunction::MarshalOutArg(FFIFunction* self, CallContext&, size_t index, const Napi::Value&, uint8_t* slot) {
+  for (size_t j = 0; j < self->out_params_.size(); j++) {
+    if (self->out_params_[j].index == index) {
+      uint64_t* cell = &self->out_storage_[j];
+      *cell = 0;
+      memcpy(slot, &cell, sizeof(cell));
+      break;
+    }
+  }
   return true;
 }
 
+void FFIFunction::StoreOutValues(Napi::Env env) {
+  Napi::Array values = out_values_.Value();
+  for (size_t j = 0; j < out_params_.size(); j++) {
+    values.Set(static_cast<uint32_t>(j), CToJS(env, &out_storage_[j], out_params_[j].type, pointer_mode_));
+  }
+}
+
+Napi::Value FFIFunction::GetOutValues(const Napi::CallbackInfo& info) {
+  if (out_values_.IsEmpty()) {
+    return info.Env().Undefined();
+  }
+  return out_values_.Value();
+}
+
 // ============================================================================
 // InferTypeFromJS - Shared by Call() and CallAsync() for variadic inference
 // ============================================================================
@@ -307,7 +479,7 @@ CType FFIFunction::InferTypeFromJS(const Napi::Value& val) {
   if (val.IsBuffer()) {
     return CType::CTYPES_POINTER;
   }
-  if (val.IsNull() || val.IsUndefined()) {
+  if (val.IsNull() || val.IsUndefined() || val.IsExternal()) {
     return CType::CTYPES_POINTER;
   }
   return CType::CTYPES_INT32;  // fallback
@@ -373,42 +545,14 @@ Napi::Value FFIFunction::ConvertReturn(Napi::Env env,
       if (rv->str == nullptr) {
         return env.Null();
       }
-      napi_value result;
-      napi_create_string_utf8(env, rv->str, NAPI_AUTO_LENGTH, &result);
-      return Napi::Value(env, result);
+      return CStringToJS(env, rv->str, strlen(rv->str));
     }
 
     case CType::CTYPES_WSTRING: {
       if (rv->wstr == nullptr) {
         return env.Null();
       }
-#ifdef _WIN32
-      // Windows: wchar_t è 16-bit (UTF-16)
-      return Napi::String::New(env, reinterpret_cast<const char16_t*>(rv->wstr));
-#else
-      // Unix: wchar_t è 32-bit, converti a UTF-8
-      std::wstring wstr(rv->wstr);
-      std::string utf8;
-      utf8.reserve(wstr.size() * 4);
-      for (wchar_t wc : wstr) {
-        if (wc < 0x80) {
-          utf8.push_back(static_cast<char>(wc));
-        } else if (wc < 0x800) {
-          utf8.push_back(static_cast<char>(0xC0 | (wc >> 6)));
-          utf8.push_back(static_cast<char>(0x80 | (wc & 0x3F)));
-        } else if (wc < 0x10000) {
-          utf8.push_back(static_cast<char>(0xE0 | (wc >> 12)));
-          utf8.push_back(static_cast<char>(0x80 | ((wc >> 6) & 0x3F)));
-          utf8.push_back(static_cast<char>(0x80 | (wc & 0x3F)));
-        } else {
-          utf8.push_back(static_cast<char>(0xF0 | (wc >> 18)));
-          utf8.push_back(static_cast<char>(0x80 | ((wc >> 12) & 0x3F)));
-          utf8.push_back(static_cast<char>(0x80 | ((wc >> 6) & 0x3F)));
-          utf8.push_back(static_cast<char>(0x80 | (wc & 0x3F)));
-        }
-      }
-      return Napi::String::New(env, utf8);
-#endif
+      return WStringToJS(env, rv->wstr, FindWStringEnd(rv->wstr, SIZE_MAX));
     }
 
     case CType::CTYPES_LONG:
@@ -487,6 +631,11 @@ inline bool FFIFunction::MarshalPrimitive(Napi::Env env, const Napi::Value& val,
       } else if (val.IsArrayBuffer()) {
         void* ptr = val.As<Napi::ArrayBuffer>().Data();
         v = static_cast<int64_t>(reinterpret_cast<intptr_t>(ptr));
+      } else if (val.IsExternal()) {
+        // Handle da pointerMode "number" (indirizzo oltre 2^53)
+        void* ptr = nullptr;
+        GetPointerHandle(env, val, ptr);
+        v = static_cast<int64_t>(reinterpret_cast<intptr_t>(ptr));
       } else {
         napi_value nv = val;
         if (napi_get_value_int64(env, nv, &v) != napi_ok) {
@@ -563,6 +712,31 @@ inline bool FFIFunction::MarshalPrimitive(Napi::Env env, const Napi::Value& val,
   }
 }
 
+// ============================================================================
+// MarshalPointer - Shared by Call() and CallBatch()
+// (CallAsync ha una sua variante che pinna anche i Buffer)
+// ============================================================================
+
+inline void FFIFunction::MarshalPointer(Napi::Env env, const Napi::Value& val, uint8_t* slot) {
+  void* ptr = nullptr;
+  if (val.IsNull() || val.IsUndefined()) {
+    ptr = nullptr;
+  } else if (val.IsBuffer()) {
+    ptr = val.As<Napi::Buffer<uint8_t>>().Data();
+  } else if (val.IsBigInt()) {
+    bool lossless;
+    ptr = reinterpret_cast<void*>(val.As<Napi::BigInt>().Uint64Value(&lossless));
+  } else if (val.IsNumber()) {
+    napi_value nv = val;
+    int64_t v;
+    napi_get_value_int64(env, nv, &v);
+    ptr = reinterpret_cast<void*>(static_cast<uintptr_t>(v));
+  } else if (val.IsExternal()) {
+    GetPointerHandle(env, val, ptr);
+  }
+  memcpy(slot, &ptr, sizeof(ptr));
+}
+
 // ============================================================================
 // MarshalStructArg - Shared by Call() and CallAsync()
 // Returns false on error (JS exception already thrown)
@@ -574,16 +748,15 @@ bool FFIFunction::MarshalStructArg(Napi::Env env,
                                    const std::shared_ptr<StructInfo>& struct_info,
                                    uint8_t* slot,
                                    void** arg_value_ptr,
-                                   std::vector<std::vector<uint8_t>>& large_buffers,
+                                   AggregateArena& aggregates,
                                    std::vector<size_t>* large_indices) {
   size_t struct_size = struct_info->GetSize();
 
-  // Use overflow buffer if struct > slot size
+  // Struct > slot size: spazio azzerato nell'arena degli aggregati
   uint8_t* dest = slot;
   size_t dest_size = ARG_SLOT_SIZE;
   if (struct_size > ARG_SLOT_SIZE) {
-    large_buffers.emplace_back(struct_size, 0);
-    dest = large_buffers.back().data();
+    dest = aggregates.Allocate(struct_size);
     dest_size = struct_size;
     *arg_value_ptr = dest;
     if (large_indices) {
@@ -640,16 +813,15 @@ bool FFIFunction::MarshalArrayArg(Napi::Env env,
                                   const std::shared_ptr<ArrayInfo>& array_info,
                                   uint8_t* slot,
                                   void** arg_value_ptr,
-                                  std::vector<std::vector<uint8_t>>& large_buffers,
+                                  AggregateArena& aggregates,
                                   std::vector<size_t>* large_indices) {
   size_t array_size = array_info->GetSize();
 
-  // Use overflow buffer if array > slot size
+  // Array > slot size: spazio azzerato nell'arena degli aggregati
   uint8_t* dest = slot;
   size_t dest_size = ARG_SLOT_SIZE;
   if (array_size > ARG_SLOT_SIZE) {
-    large_buffers.emplace_back(array_size, 0);
-    dest = large_buffers.back().data();
+    dest = aggregates.Allocate(array_size);
     dest_size = array_size;
     *arg_value_ptr = dest;
     if (large_indices) {
@@ -657,7 +829,12 @@ bool FFIFunction::MarshalArrayArg(Napi::Env env,
     }
   }
 
-  if (val.IsBuffer()) {
+  // Buffer / Uint8Array: byte grezzi. Gli altri TypedArray passano da
+  // JSToArray (memcpy se gli elementi coincidono, altrimenti conversione).
+  napi_typedarray_type ta_type;
+  void* ta_data = nullptr;
+  size_t ta_length = 0;
+  if (val.IsBuffer() && !GetElementTypedArray(env, val, ta_type, ta_data, ta_length)) {
     Napi::Buffer<uint8_t> buf = val.As<Napi::Buffer<uint8_t>>();
     if (buf.Length() >= array_size) {
       memcpy(dest, buf.Data(), array_size);
@@ -676,6 +853,160 @@ bool FFIFunction::MarshalArrayArg(Napi::Env env,
   return true;
 }
 
+// ============================================================================
+// Piano di conversione per-signature
+//
+// Primitivi: un'istanza di MarshalPrimitiveArg per CType, in cui lo switch
+// di MarshalPrimitive si riduce al solo caso del tipo (costante). Tutto il
+// resto passa da MarshalValue. Stesso schema per il ritorno.
+// ============================================================================
+
+template <CType T>
+bool FFIFunction::MarshalPrimitiveArg(FFIFunction*, CallContext& ctx, size_t, const Napi::Value& val, uint8_t* slot) {
+  MarshalPrimitive(ctx.env, val, T, slot);
+  return true;
+}
+
+bool FFIFunction::MarshalGenericArg(FFIFunction* self,
+                                    CallContext& ctx,
+                                    size_t index,
+                                    const Napi::Value& val,
+                                    uint8_t* slot) {
+  return self->MarshalValue(ctx, index, self->arg_types_[index], val, slot);
+}
+
+FFIFunction::ArgMarshaler FFIFunction::SelectArgMarshaler(CType type) {
+  switch (type) {
+    case CType::CTYPES_INT8:
+      return &MarshalPrimitiveArg<CType::CTYPES_INT8>;
+    case CType::CTYPES_UINT8:
+      return &MarshalPrimitiveArg<CType::CTYPES_UINT8>;
+    case CType::CTYPES_INT16:
+      return &MarshalPrimitiveArg<CType::CTYPES_INT16>;
+    case CType::CTYPES_UINT16:
+      return &MarshalPrimitiveArg<CType::CTYPES_UINT16>;
+    case CType::CTYPES_INT32:
+      return &MarshalPrimitiveArg<CType::CTYPES_INT32>;
+    case CType::CTYPES_UINT32:
+      return &MarshalPrimitiveArg<CType::CTYPES_UINT32>;
+    case CType::CTYPES_INT64:
+    case CType::CTYPES_UINT64:
+    case CType::CTYPES_SIZE_T:
+    case CType::CTYPES_SSIZE_T:
+      return &MarshalPrimitiveArg<CType::CTYPES_INT64>;
+    case CType::CTYPES_LONG:
+      return &MarshalPrimitiveArg<CType::CTYPES_LONG>;
+    case CType::CTYPES_ULONG:
+      return &MarshalPrimitiveArg<CType::CTYPES_ULONG>;
+    case CType::CTYPES_FLOAT:
+      return &MarshalPrimitiveArg<CType::CTYPES_FLOAT>;
+    case CType::CTYPES_DOUBLE:
+      return &MarshalPrimitiveArg<CType::CTYPES_DOUBLE>;
+    case CType::CTYPES_BOOL:
+      return &MarshalPrimitiveArg<CType::CTYPES_BOOL>;
+    default:
+      return &MarshalGenericArg;
+  }
+}
+
+static Napi::Value ConvertVoidReturnStep(FFIFunction*, Napi::Env env, void*) {
+  return env.Undefined();
+}
+
+static Napi::Value ConvertInt32ReturnStep(FFIFunction*, Napi::Env env, void* return_data) {
+  napi_value result;
+  napi_create_int32(env, static_cast<ReturnValue*>(return_data)->i32, &result);
+  return Napi::Value(env, result);
+}
+
+static Napi::Value ConvertUint32ReturnStep(FFIFunction*, Napi::Env env, void* return_data) {
+  napi_value result;
+  napi_create_uint32(env, static_cast<ReturnValue*>(return_data)->u32, &result);
+  return Napi::Value(env, result);
+}
+
+static Napi::Value ConvertDoubleReturnStep(FFIFunction*, Napi::Env env, void* return_data) {
+  napi_value result;
+  napi_create_double(env, static_cast<ReturnValue*>(return_data)->d, &result);
+  return Napi::Value(env, result);
+}
+
+static Napi::Value ConvertPointerReturnStep(FFIFunction*, Napi::Env env, void* return_data) {
+  void* p = static_cast<ReturnValue*>(return_data)->p;
+  if (p == nullptr) {
+    return env.Null();
+  }
+  return Napi::BigInt::New(env, reinterpret_cast<uint64_t>(p));
+}
+
+// pointerMode "number" (vedi PointerMode in types.h)
+static Napi::Value ConvertPointerNumberReturnStep(FFIFunction*, Napi::Env env, void* return_data) {
+  return PointerToJS(env, static_cast<ReturnValue*>(return_data)->p, PointerMode::NUMBER);
+}
+
+static Napi::Value ConvertInt64NumberReturnStep(FFIFunction*, Napi::Env env, void* return_data) {
+  return Int64ToJS(env, static_cast<ReturnValue*>(return_data)->i64, PointerMode::NUMBER);
+}
+
+static Napi::Value ConvertUint64NumberReturnStep(FFIFunction*, Napi::Env env, void* return_data) {
+  return Uint64ToJS(env, static_cast<ReturnValue*>(return_data)->u64, PointerMode::NUMBER);
+}
+
+static Napi::Value ConvertLongNumberReturnStep(FFIFunction*, Napi::Env env, void* return_data) {
+  const long v = static_cast<long>(static_cast<ReturnValue*>(return_data)->i64);
+  return Int64ToJS(env, static_cast<int64_t>(v), PointerMode::NUMBER);
+}
+
+static Napi::Value ConvertUlongNumberReturnStep(FFIFunction*, Napi::Env env, void* return_data) {
+  const unsigned long v = static_cast<unsigned long>(static_cast<ReturnValue*>(return_data)->u64);
+  return Uint64ToJS(env, static_cast<uint64_t>(v), PointerMode::NUMBER);
+}
+
+Napi::Value FFIFunction::ConvertStructReturnStep(FFIFunction* self, Napi::Env env, void* return_data) {
+  return self->ConvertStructReturn(env, return_data);
+}
+
+Napi::Value FFIFunction::ConvertGenericReturnStep(FFIFunction* self, Napi::Env env, void* return_data) {
+  return ConvertReturn(env, return_data, self->return_type_, self->return_struct_info_, self->return_array_info_);
+}
+
+FFIFunction::ReturnConverter FFIFunction::SelectReturnConverter() const {
+  if (pointer_mode_ == PointerMode::NUMBER) {
+    switch (return_type_) {
+      case CType::CTYPES_POINTER:
+        return &ConvertPointerNumberReturnStep;
+      case CType::CTYPES_INT64:
+      case CType::CTYPES_SSIZE_T:
+        return &ConvertInt64NumberReturnStep;
+      case CType::CTYPES_UINT64:
+      case CType::CTYPES_SIZE_T:
+        return &ConvertUint64NumberReturnStep;
+      case CType::CTYPES_LONG:
+        return &ConvertLongNumberReturnStep;
+      case CType::CTYPES_ULONG:
+        return &ConvertUlongNumberReturnStep;
+      default:
+        break;
+    }
+  }
+  switch (return_type_) {
+    case CType::CTYPES_VOID:
+      return &ConvertVoidReturnStep;
+    case CType::CTYPES_INT32:
+      return &ConvertInt32ReturnStep;
+    case CType::CTYPES_UINT32:
+      return &ConvertUint32ReturnStep;
+    case CType::CTYPES_DOUBLE:
+      return &ConvertDoubleReturnStep;
+    case CType::CTYPES_POINTER:
+      return &ConvertPointerReturnStep;
+    case CType::CTYPES_STRUCT:
+      return &ConvertStructReturnStep;
+    default:
+      return &ConvertGenericReturnStep;
+  }
+}
+
 // ============================================================================
 // Call - Ottimizzato con fast paths
 // ============================================================================
@@ -685,16 +1016,17 @@ bool FFIFunction::MarshalArrayArg(Napi::Env env,
 // ============================================================================
 
 // Convalida argc e determina se la call è variadic.
-// Shared tra Call() (sync) e CallAsync() (async).
+// Shared tra Call() (sync) e CallAsync() / Submit() (async).
 CTYPES_ALWAYS_INLINE bool FFIFunction::ValidateAndResolveArgc(Napi::Env env,
                                                               const Napi::CallbackInfo& info,
                                                               size_t& out_argc,
-                                                              bool& out_is_variadic) const {
+                                                              bool& out_is_variadic,
+                                                              size_t first_arg) const {
   if (!cif_prepared_) [[unlikely]] {
     Napi::Error::New(env, "FFI call interface not prepared").ThrowAsJavaScriptException();
     return false;
   }
-  const size_t info_argc = info.Length();
+  const size_t info_argc = info.Length() > first_arg ? info.Length() - first_arg : 0;
   const size_t expected_argc = arg_types_.size();
   if (info_argc == expected_argc) [[likely]] {
     out_argc = expected_argc;
@@ -711,205 +1043,155 @@ CTYPES_ALWAYS_INLINE bool FFIFunction::ValidateAndResolveArgc(Napi::Env env,
   return false;
 }
 
-CTYPES_ALWAYS_INLINE CType FFIFunction::ResolveArgType(const CallContext& ctx,
-                                                       size_t i,
-                                                       const CType* extra_types_stack,
-                                                       const std::vector<CType>& extra_types_heap) const {
-  if (i < ctx.expected_argc) [[likely]] {
-    return arg_types_[i];
-  }
-  if (ctx.cache_entry) {
-    return ctx.cache_entry->extra_types[i - ctx.expected_argc];
-  }
-  const size_t extra_idx = i - ctx.expected_argc;
-  return (ctx.num_extra <= MAX_VARIADIC_EXTRA_ARGS) ? extra_types_stack[extra_idx] : extra_types_heap[extra_idx];
-}
-
-// Loop di marshalling per-argomento. Dispatch su CType con fast path
-// primitivo. Ritorna false se un'eccezione JS è stata lanciata e il
-// caller deve restituire env.Undefined().
+// Loop di marshalling per-argomento: gli argomenti dichiarati seguono il
+// piano (arg_marshalers_), gli extra variadici il tipo inferito. Ritorna
+// false se un'eccezione JS è stata lanciata e il caller deve restituire
+// env.Undefined().
 CTYPES_ALWAYS_INLINE bool FFIFunction::MarshalArguments(CallContext& ctx) {
-  Napi::Env env = ctx.env;
   const auto& info = ctx.info;
   const size_t argc = ctx.argc;
   const size_t expected_argc = ctx.expected_argc;
   uint8_t* const arg_storage = ctx.arg_storage;
   void** const arg_values = ctx.arg_values;
+  ArgMarshaler* const plan = arg_marshalers_.data();
 
-  for (size_t i = 0; i < argc; i++) {
+  for (size_t i = 0; i < expected_argc; i++) {
     uint8_t* slot = arg_storage + (i * ARG_SLOT_SIZE);
     arg_values[i] = slot;
-    const Napi::Value& val = info[i];
-
-    // Il tipo è risolto direttamente qui (non tramite ResolveArgType) per
-    // accedere al path stack/heap senza passare i buffer di nuovo.
-    CType type;
-    if (i < expected_argc) [[likely]] {
-      type = arg_types_[i];
-    } else if (ctx.cache_entry) {
-      type = ctx.cache_entry->extra_types[i - expected_argc];
-    } else {
-      type = ctx.extra_types_ptr[i - expected_argc];
+    if (!plan[i](this, ctx, i, info[i], slot)) [[unlikely]] {
+      return false;
     }
+  }
 
-    // Fast path: primitivi.
-    if (MarshalPrimitive(env, val, type, slot)) {
+  for (size_t i = expected_argc; i < argc; i++) {
+    uint8_t* slot = arg_storage + (i * ARG_SLOT_SIZE);
+    arg_values[i] = slot;
+    const Napi::Value& val = info[i];
+    const CType type = ctx.extra_types_ptr[i - expected_argc];
+    if (MarshalPrimitive(ctx.env, val, type, slot)) {
       continue;
     }
+    if (!MarshalValue(ctx, i, type, val, slot)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Marshalling di un argomento non primitivo nello slot `index`
+bool FFIFunction::MarshalValue(CallContext& ctx, size_t index, CType type, const Napi::Value& val, uint8_t* slot) {
+  Napi::Env env = ctx.env;
+  switch (type) {
+    case CType::CTYPES_POINTER: {
+      MarshalPointer(env, val, slot);
+      break;
+    }
 
-    switch (type) {
-      case CType::CTYPES_POINTER: {
-        void* ptr = nullptr;
-        if (val.IsNull() || val.IsUndefined()) {
-          ptr = nullptr;
-        } else if (val.IsBuffer()) {
-          ptr = val.As<Napi::Buffer<uint8_t>>().Data();
-        } else if (val.IsBigInt()) {
-          bool lossless;
-          ptr = reinterpret_cast<void*>(val.As<Napi::BigInt>().Uint64Value(&lossless));
-        } else if (val.IsNumber()) {
-          napi_value nv = val;
-          int64_t v;
-          napi_get_value_int64(env, nv, &v);
-          ptr = reinterpret_cast<void*>(static_cast<uintptr_t>(v));
+    case CType::CTYPES_STRING: {
+      if (val.IsString()) {
+        napi_value nval = val;
+        // SBO: se il limite superiore entra nel buffer inline la stringa
+        // viene trascodificata una volta sola direttamente lì
+        const size_t room = kInlineStringBufferSize - inline_string_offset_;
+        size_t bound = Utf8StringBound(env, nval);
+        if (bound > room && (bound - 1) / 3 < room) {
+          // Il caso peggiore (3 byte per unit) non entra, ma almeno 1 byte
+          // per unit sì: la lunghezza esatta costa una scansione, il
+          // fallback heap un'allocazione e una copia
+          size_t exact = 0;
+          napi_get_value_string_utf8(env, nval, nullptr, 0, &exact);
+          bound = exact + 1;
         }
-        memcpy(slot, &ptr, sizeof(ptr));
-        break;
-      }
-
-      case CType::CTYPES_STRING: {
-        if (val.IsString()) {
-          napi_value nval = val;
-          // SBO: prova prima il buffer inline
-          size_t remaining = kInlineStringBufferSize - inline_string_offset_;
-          if (remaining > 1) {
-            size_t copied;
-            char* dest = inline_string_buffer_ + inline_string_offset_;
-            napi_status status = napi_get_value_string_utf8(env, nval, dest, remaining, &copied);
-            if (status == napi_ok && copied < remaining - 1) {
-              const char* str_ptr = dest;
-              memcpy(slot, &str_ptr, sizeof(str_ptr));
-              inline_string_offset_ += copied + 1;
-              break;
-            }
-          }
-          // Fallback: heap string_buffer_
-          size_t len;
-          napi_get_value_string_utf8(env, nval, nullptr, 0, &len);
-          size_t offset = string_buffer_.size();
-          string_buffer_.resize(offset + len + 1);
-          napi_get_value_string_utf8(env, nval, string_buffer_.data() + offset, len + 1, &len);
-          const char* str_ptr = string_buffer_.data() + offset;
+        if (bound <= room) {
+          size_t copied = 0;
+          char* dest = scratch_->string_buffer + inline_string_offset_;
+          napi_get_value_string_utf8(env, nval, dest, bound, &copied);
+          const char* str_ptr = dest;
           memcpy(slot, &str_ptr, sizeof(str_ptr));
-        } else if (val.IsBuffer()) {
-          const char* ptr = reinterpret_cast<const char*>(val.As<Napi::Buffer<uint8_t>>().Data());
-          memcpy(slot, &ptr, sizeof(ptr));
-        } else if (val.IsBigInt()) {
-          bool lossless;
-          uint64_t addr = val.As<Napi::BigInt>().Uint64Value(&lossless);
-          const char* ptr = reinterpret_cast<const char*>(addr);
-          memcpy(slot, &ptr, sizeof(ptr));
-        } else if (val.IsNumber()) {
-          const char* ptr = reinterpret_cast<const char*>(static_cast<uintptr_t>(val.As<Napi::Number>().Int64Value()));
-          memcpy(slot, &ptr, sizeof(ptr));
+          inline_string_offset_ += copied + 1;
         } else {
-          const char* null_ptr = nullptr;
-          memcpy(slot, &null_ptr, sizeof(null_ptr));
+          // Fallback heap: string_buffer_ può riallocarsi, il puntatore
+          // viene scritto a marshalling finito (vedi Call)
+          string_fixups_.emplace_back(index, AppendUtf8String(env, nval, string_buffer_));
         }
-        break;
+      } else if (val.IsBuffer()) {
+        const char* ptr = reinterpret_cast<const char*>(val.As<Napi::Buffer<uint8_t>>().Data());
+        memcpy(slot, &ptr, sizeof(ptr));
+      } else if (val.IsBigInt()) {
+        bool lossless;
+        uint64_t addr = val.As<Napi::BigInt>().Uint64Value(&lossless);
+        const char* ptr = reinterpret_cast<const char*>(addr);
+        memcpy(slot, &ptr, sizeof(ptr));
+      } else if (val.IsNumber()) {
+        const char* ptr = reinterpret_cast<const char*>(static_cast<uintptr_t>(val.As<Napi::Number>().Int64Value()));
+        memcpy(slot, &ptr, sizeof(ptr));
+      } else {
+        const char* null_ptr = nullptr;
+        memcpy(slot, &null_ptr, sizeof(null_ptr));
       }
+      break;
+    }
 
-      case CType::CTYPES_WSTRING: {
-        if (val.IsString()) {
-          napi_value nval = val;
-          size_t u16_len = 0;
-          napi_get_value_string_utf16(env, nval, nullptr, 0, &u16_len);
-          constexpr size_t wchar_size = sizeof(wchar_t);
-          constexpr size_t wchar_align = alignof(wchar_t);
-          size_t byte_len = (u16_len + 1) * wchar_size;
-          size_t offset = string_buffer_.size();
-          offset = (offset + wchar_align - 1) & ~(wchar_align - 1);
-          string_buffer_.resize(offset + byte_len);
-          wchar_t* wptr = reinterpret_cast<wchar_t*>(string_buffer_.data() + offset);
-#ifdef _WIN32
-          size_t written = 0;
-          napi_get_value_string_utf16(env, nval, reinterpret_cast<char16_t*>(wptr), u16_len + 1, &written);
-#else
-          std::u16string u16str = val.As<Napi::String>().Utf16Value();
-          for (size_t j = 0; j < u16str.length(); j++) {
-            wptr[j] = static_cast<wchar_t>(u16str[j]);
-          }
-          wptr[u16str.length()] = L'\0';
-#endif
-          const wchar_t* str_ptr = wptr;
-          memcpy(slot, &str_ptr, sizeof(str_ptr));
-        } else if (val.IsBuffer()) {
-          const wchar_t* ptr = reinterpret_cast<const wchar_t*>(val.As<Napi::Buffer<uint8_t>>().Data());
-          memcpy(slot, &ptr, sizeof(ptr));
-        } else if (val.IsBigInt()) {
-          bool lossless;
-          uint64_t addr = val.As<Napi::BigInt>().Uint64Value(&lossless);
-          const wchar_t* ptr = reinterpret_cast<const wchar_t*>(addr);
-          memcpy(slot, &ptr, sizeof(ptr));
-        } else if (val.IsNumber()) {
-          const wchar_t* ptr =
-            reinterpret_cast<const wchar_t*>(static_cast<uintptr_t>(val.As<Napi::Number>().Int64Value()));
-          memcpy(slot, &ptr, sizeof(ptr));
-        } else {
-          const wchar_t* null_ptr = nullptr;
-          memcpy(slot, &null_ptr, sizeof(null_ptr));
-        }
-        break;
+    case CType::CTYPES_WSTRING: {
+      if (val.IsString()) {
+        string_fixups_.emplace_back(index, AppendWideString(env, val, string_buffer_));
+      } else if (val.IsBuffer()) {
+        const wchar_t* ptr = reinterpret_cast<const wchar_t*>(val.As<Napi::Buffer<uint8_t>>().Data());
+        memcpy(slot, &ptr, sizeof(ptr));
+      } else if (val.IsBigInt()) {
+        bool lossless;
+        uint64_t addr = val.As<Napi::BigInt>().Uint64Value(&lossless);
+        const wchar_t* ptr = reinterpret_cast<const wchar_t*>(addr);
+        memcpy(slot, &ptr, sizeof(ptr));
+      } else if (val.IsNumber()) {
+        const wchar_t* ptr =
+          reinterpret_cast<const wchar_t*>(static_cast<uintptr_t>(val.As<Napi::Number>().Int64Value()));
+        memcpy(slot, &ptr, sizeof(ptr));
+      } else {
+        const wchar_t* null_ptr = nullptr;
+        memcpy(slot, &null_ptr, sizeof(null_ptr));
       }
+      break;
+    }
 
-      case CType::CTYPES_STRUCT: {
-        if (i < expected_argc && arg_struct_infos_[i]) {
-          if (!MarshalStructArg(env, val, i, arg_struct_infos_[i], slot, &arg_values[i], sync_large_arg_buffers_,
-                                nullptr)) {
-            return false;
-          }
-        } else {
-          JSToC(env, val, type, slot, ARG_SLOT_SIZE);
+    case CType::CTYPES_STRUCT: {
+      if (index < ctx.expected_argc && arg_struct_infos_[index]) {
+        if (!MarshalStructArg(env, val, index, arg_struct_infos_[index], slot, &ctx.arg_values[index],
+                              sync_aggregates_, nullptr)) {
+          return false;
         }
-        break;
+      } else {
+        JSToC(env, val, type, slot, ARG_SLOT_SIZE);
       }
+      break;
+    }
 
-      case CType::CTYPES_ARRAY: {
-        if (i < expected_argc && arg_array_infos_[i]) {
-          if (!MarshalArrayArg(env, val, i, arg_array_infos_[i], slot, &arg_values[i], sync_large_arg_buffers_,
-                               nullptr)) {
-            return false;
-          }
-        } else {
-          JSToC(env, val, type, slot, ARG_SLOT_SIZE);
+    case CType::CTYPES_ARRAY: {
+      if (index < ctx.expected_argc && arg_array_infos_[index]) {
+        if (!MarshalArrayArg(env, val, index, arg_array_infos_[index], slot, &ctx.arg_values[index],
+                             sync_aggregates_, nullptr)) {
+          return false;
         }
-        break;
+      } else {
+        JSToC(env, val, type, slot, ARG_SLOT_SIZE);
       }
+      break;
+    }
 
-      default:
-        JSToC(env, val, type, slot, ARG_SLOT_SIZE);
-        break;
-    }
+    default:
+      JSToC(env, val, type, slot, ARG_SLOT_SIZE);
+      break;
   }
   return true;
 }
 
 // Seleziona il return buffer: inline ReturnValue per tipi primitivi,
-// sync_return_buffer_ per struct/array > sizeof(ReturnValue).
+// sync_aggregates_ per struct/array > sizeof(ReturnValue) (dopo gli
+// argomenti, nello stesso blocco).
 CTYPES_ALWAYS_INLINE void FFIFunction::SelectReturnPtr(CallContext& ctx) {
   ctx.return_ptr = &return_value_;
-  if (return_type_ == CType::CTYPES_STRUCT && return_struct_info_) {
-    size_t ret_size = return_struct_info_->GetSize();
-    if (ret_size > sizeof(ReturnValue)) {
-      sync_return_buffer_.resize(ret_size);
-      ctx.return_ptr = sync_return_buffer_.data();
-    }
-  } else if (return_type_ == CType::CTYPES_ARRAY && return_array_info_) {
-    size_t ret_size = return_array_info_->GetSize();
-    if (ret_size > sizeof(ReturnValue)) {
-      sync_return_buffer_.resize(ret_size);
-      ctx.return_ptr = sync_return_buffer_.data();
-    }
+  if (large_return_size_ > 0) {
+    ctx.return_ptr = sync_aggregates_.Allocate(large_return_size_);
   }
 }
 
@@ -937,9 +1219,28 @@ CTYPES_ALWAYS_INLINE void FFIFunction::CaptureErrorState() {
   }
 }
 
-// Convert return value e applica errcheck se presente.
+Napi::Value FFIFunction::ConvertStructReturn(Napi::Env env, void* return_data) {
+  if (struct_view_.IsEmpty()) {
+    return ConvertReturn(env, return_data, return_type_, return_struct_info_, return_array_info_);
+  }
+  // return_data è lo scratch della call (o del frame async): la view deve
+  // avere il suo buffer
+  Napi::Buffer<uint8_t> copy =
+    Napi::Buffer<uint8_t>::Copy(env, static_cast<const uint8_t*>(return_data), return_struct_info_->GetSize());
+  return struct_view_.Call({copy});
+}
+
+// Convert return value e applica policy / errcheck se presenti.
 CTYPES_ALWAYS_INLINE Napi::Value FFIFunction::FinalizeCall(CallContext& ctx) {
-  Napi::Value result = ConvertReturn(ctx.env, ctx.return_ptr, return_type_, return_struct_info_, return_array_info_);
+  if (!out_params_.empty()) [[unlikely]] {
+    StoreOutValues(ctx.env);
+  }
+  Napi::Value result = return_converter_(this, ctx.env, ctx.return_ptr);
+  if (errcheck_fail_ != ErrcheckFail::NONE) [[unlikely]] {
+    if (!ApplyErrcheckPolicy(ctx.env, result, ctx.info)) {
+      return ctx.env.Undefined();
+    }
+  }
   if (errcheck_callback_.IsEmpty()) [[likely]] {
     return result;
   }
@@ -949,6 +1250,27 @@ CTYPES_ALWAYS_INLINE Napi::Value FFIFunction::FinalizeCall(CallContext& ctx) {
 Napi::Value FFIFunction::Call(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
 
+  CallStats* const stats = ActiveStats();
+  const uint64_t start_ns = stats ? StatsNow() : 0;
+
+  // Fast path: trampolino specializzato (signature primitiva, non variadic).
+  // Con statistiche attive si passa dal percorso generico, che misura le fasi.
+  if (trampoline_ != nullptr && stats == nullptr && info.Length() == arg_types_.size()) [[likely]] {
+    napi_value argv[MAX_TRAMPOLINE_ARGS];
+    for (size_t i = 0; i < arg_types_.size(); i++) {
+      argv[i] = info[i];
+    }
+    Napi::Value result = trampoline_(env, argv, trampoline_plan_);
+    // Niente use_errno / use_last_error sul trampolino: la policy usa il ritorno
+    if (errcheck_fail_ != ErrcheckFail::NONE && !ApplyErrcheckPolicy(env, result, info)) {
+      return env.Undefined();
+    }
+    if (!errcheck_callback_.IsEmpty()) {
+      result = ApplyErrcheck(env, result, info);
+    }
+    return result;
+  }
+
   size_t argc;
   bool need_reprep = false;
   if (!ValidateAndResolveArgc(env, info, argc, need_reprep)) {
@@ -958,8 +1280,8 @@ Napi::Value FFIFunction::Call(const Napi::CallbackInfo& info) {
   // =====================================================================
   // Gestione variadic ottimizzata (ispirata a CPython ctypes)
   // =====================================================================
-  ffi_cif* active_cif = &cif_;
-  VariadicCifCache* cache_entry = nullptr;
+  ffi_cif* active_cif = cif_;
+  std::shared_ptr<PreparedSignature> variadic_sig;
   size_t num_extra = 0;  // Numero di argomenti extra variadic
 
   // Stack-allocated array per piccoli numeri di argomenti extra (come alloca in CPython)
@@ -983,61 +1305,13 @@ Napi::Value FFIFunction::Call(const Napi::CallbackInfo& info) {
       extra_types[i] = InferTypeFromJS(info[fixed_args + i]);
     }
 
-    // Cerca in cache
-    for (size_t i = 0; i < MAX_CACHED_VARIADIC_CIFS; i++) {
-      if (variadic_cache_[i].valid && variadic_cache_[i].total_args == argc &&
-          variadic_cache_[i].extra_types.size() == num_extra) {
-        // Verifica match dei tipi extra
-        bool match = true;
-        for (size_t j = 0; j < num_extra; j++) {
-          if (variadic_cache_[i].extra_types[j] != extra_types[j]) {
-            match = false;
-            break;
-          }
-        }
-
-        if (match) {
-          cache_entry = &variadic_cache_[i];
-          active_cif = &cache_entry->cif;
-          break;
-        }
-      }
-    }
-
-    // Cache miss — prepara il nuovo CIF direttamente nello slot di cache
-    // (così riutilizzabile per chiamate successive) invece di prepararlo
-    // due volte.
-    if (!cache_entry) {
-      size_t slot = next_cache_slot_;
-      next_cache_slot_ = (next_cache_slot_ + 1) % MAX_CACHED_VARIADIC_CIFS;
-
-      VariadicCifCache& entry = variadic_cache_[slot];
-      entry.valid = false;  // invalidate durante rebuild
-      entry.total_args = argc;
-      entry.extra_types.assign(extra_types, extra_types + num_extra);
-      entry.ffi_types.resize(argc);
-
-      // Copia tipi fissi
-      for (size_t i = 0; i < fixed_args; i++) {
-        entry.ffi_types[i] = ffi_arg_types_[i];
-      }
-      // Aggiungi tipi extra
-      for (size_t i = 0; i < num_extra; i++) {
-        entry.ffi_types[fixed_args + i] = CTypeToFFI(extra_types[i]);
-      }
-
-      ffi_status status = ffi_prep_cif_var(&entry.cif, abi_, static_cast<unsigned int>(fixed_args),
-                                           static_cast<unsigned int>(argc), ffi_return_type_, entry.ffi_types.data());
-
-      if (status != FFI_OK) {
-        Napi::Error::New(env, "Failed to prepare variadic FFI call").ThrowAsJavaScriptException();
-        return env.Undefined();
-      }
-
-      entry.valid = true;
-      cache_entry = &entry;
-      active_cif = &entry.cif;
+    // Lookup hashed + LRU; il riferimento locale tiene vivo il CIF anche se
+    // una call rientrante lo sfratta prima di ffi_call
+    variadic_sig = GetVariadicSignature(env, extra_types, num_extra);
+    if (!variadic_sig) {
+      return env.Undefined();
     }
+    active_cif = &variadic_sig->cif;
   }
 
   // =====================================================================
@@ -1050,7 +1324,6 @@ Napi::Value FFIFunction::Call(const Napi::CallbackInfo& info) {
   ctx.argc = argc;
   ctx.expected_argc = expected_argc;
   ctx.active_cif = active_cif;
-  ctx.cache_entry = cache_entry;
   ctx.num_extra = num_extra;
   // Punta al primo elemento dell'array di tipi inferiti (stack o heap).
   // Valido solo se need_reprep (altrimenti non c'è extra).
@@ -1058,10 +1331,12 @@ Napi::Value FFIFunction::Call(const Napi::CallbackInfo& info) {
     need_reprep ? (num_extra <= MAX_VARIADIC_EXTRA_ARGS ? extra_types_stack : extra_types_heap.data()) : nullptr;
 
   // ---- Select arg storage (inline vs heap) --------------------------
+  // Lo scratch serve comunque: MarshalArguments usa il suo string buffer.
+  CallScratch& scratch = EnsureScratch();
   const bool use_inline_for_call = (argc <= MAX_INLINE_ARGS);
   if (use_inline_for_call) {
-    ctx.arg_storage = inline_arg_storage_;
-    ctx.arg_values = inline_arg_values_;
+    ctx.arg_storage = scratch.arg_storage;
+    ctx.arg_values = scratch.arg_values;
   } else {
     const size_t required_size = argc * ARG_SLOT_SIZE;
     if (heap_arg_storage_.capacity() < required_size) {
@@ -1080,9 +1355,10 @@ Napi::Value FFIFunction::Call(const Napi::CallbackInfo& info) {
     ctx.arg_values = heap_arg_values_.data();
   }
 
-  // ---- Pre-reserve string buffer -----------------------------------
-  // Se eventuali resize() nel loop di marshalling riallocano, i char*/wchar_t*
-  // già salvati in arg slot diventerebbero dangling → crash in ffi_call.
+  // ---- Reset string buffer ----------------------------------------
+  // Una sola passata per stringa: niente pre-dimensionamento, le stringhe
+  // che finiscono in string_buffer_ ricevono il puntatore dopo il
+  // marshalling (string_fixups_), quando il buffer non si sposta più.
   const bool call_has_strings = has_string_args_ || (need_reprep && [&] {
                                   for (size_t i = 0; i < num_extra; i++) {
                                     CType t = ctx.extra_types_ptr[i];
@@ -1095,34 +1371,35 @@ Napi::Value FFIFunction::Call(const Napi::CallbackInfo& info) {
   if (call_has_strings) {
     inline_string_offset_ = 0;
     string_buffer_.clear();
+    string_fixups_.clear();
     if (string_buffer_.capacity() > 10 * 1024 * 1024) {
       string_buffer_.shrink_to_fit();
     }
-    size_t reserve_bytes = 0;
-    for (size_t i = 0; i < argc; i++) {
-      CType t = ResolveArgType(ctx, i, extra_types_stack, extra_types_heap);
-      if ((t == CType::CTYPES_STRING || t == CType::CTYPES_WSTRING) && info[i].IsString()) {
-        size_t len = 0;
-        napi_get_value_string_utf16(env, info[i], nullptr, 0, &len);
-        const size_t per_unit = (t == CType::CTYPES_WSTRING) ? sizeof(wchar_t) : 4;
-        reserve_bytes += (len + 1) * per_unit + alignof(wchar_t);
-      }
-    }
-    if (reserve_bytes > string_buffer_.capacity()) {
-      string_buffer_.reserve(reserve_bytes);
-    }
   }
 
-  // Overflow buffer per struct/array grandi viene ripulito solo se può
-  // essere stato popolato da una call precedente (flag precalcolato).
-  if (has_struct_array_args_) {
-    sync_large_arg_buffers_.clear();
+  // L'arena degli aggregati viene azzerata solo se la signature la usa
+  // (flag precalcolato): argomenti struct/array o ritorno grande.
+  if (uses_aggregate_arena_) {
+    sync_aggregates_.Reset();
   }
 
   // ---- Marshal arguments -------------------------------------------
+  const size_t string_capacity = string_buffer_.capacity();
   if (!MarshalArguments(ctx)) {
     return env.Undefined();
   }
+  if (call_has_strings) {
+    const char* str_base = string_buffer_.data();
+    for (const auto& [slot_index, str_offset] : string_fixups_) {
+      const char* str_ptr = str_base + str_offset;
+      memcpy(ctx.arg_storage + (slot_index * ARG_SLOT_SIZE), &str_ptr, sizeof(str_ptr));
+    }
+  }
+  const uint64_t marshal_end_ns = stats ? StatsNow() : 0;
+  if (stats) [[unlikely]] {
+    stats->marshal.Record(marshal_end_ns - start_ns);
+    stats->string_buffer_growths += string_buffer_.capacity() > string_capacity;
+  }
 
   // ---- Select return buffer ---------------------------------------
   SelectReturnPtr(ctx);
@@ -1132,7 +1409,448 @@ Napi::Value FFIFunction::Call(const Napi::CallbackInfo& info) {
   CaptureErrorState();
 
   // ---- Convert return + apply errcheck -----------------------------
-  return FinalizeCall(ctx);
+  if (!stats) [[likely]] {
+    return FinalizeCall(ctx);
+  }
+  const uint64_t call_end_ns = StatsNow();
+  Napi::Value result = FinalizeCall(ctx);
+  const uint64_t end_ns = StatsNow();
+  stats->calls++;
+  stats->trampoline_calls += trampoline_ != nullptr;
+  // Dopo SelectReturnPtr: conta anche il buffer dei ritorni grandi
+  stats->large_arg_overflows += uses_aggregate_arena_ ? sync_aggregates_.Overflows() : 0;
+  stats->ffi_call.Record(call_end_ns - marshal_end_ns);
+  stats->finalize.Record(end_ns - call_end_ns);
+  stats->total.Record(end_ns - start_ns);
+  return result;
+}
+
+// ============================================================================
+// Helper condivisi da CallBatch (sync) e MapAsync (pool)
+// ============================================================================
+
+// Per i parametri puntatore solo un BigInt64Array / BigUint64Array della
+// dimensione di un puntatore è una colonna di indirizzi: ogni altro
+// ArrayBufferView (Buffer, Uint8Array, ...) è lo stesso buffer per ogni riga.
+static bool IsPointerColumn(Napi::Env env, Napi::Value col) {
+  napi_typedarray_type ta_type;
+  napi_get_typedarray_info(env, col, &ta_type, nullptr, nullptr, nullptr, nullptr);
+  return (ta_type == napi_bigint64_array || ta_type == napi_biguint64_array) && sizeof(void*) == sizeof(int64_t);
+}
+
+// Valida le colonne: i TypedArray diventano colonne "vive" verso il loro
+// slot in `arg_storage`, gli scalari sono marshallati una volta sola nello
+// slot e ci restano per tutto il batch. `pins`, se non null, riceve i
+// riferimenti a colonne e Buffer da tenere vivi finché il batch gira.
+bool FFIFunction::MarshalBatchColumns(Napi::Env env,
+                                      Napi::Array columns,
+                                      size_t count,
+                                      uint8_t* arg_storage,
+                                      std::vector<BatchColumn>& live_columns,
+                                      std::vector<Napi::ObjectReference>* pins,
+                                      const char* api) {
+  const size_t argc = arg_types_.size();
+  live_columns.reserve(argc);
+
+  for (size_t j = 0; j < argc; j++) {
+    const CType type = arg_types_[j];
+    uint8_t* slot = arg_storage + (j * ARG_SLOT_SIZE);
+    Napi::Value col = columns.Get(static_cast<uint32_t>(j));
+
+    if (col.IsTypedArray() && (type != CType::CTYPES_POINTER || IsPointerColumn(env, col))) {
+      napi_typedarray_type ta_type;
+      size_t length;
+      void* data;
+      napi_get_typedarray_info(env, col, &ta_type, &length, &data, nullptr, nullptr);
+      if (!TypedArrayMatchesCType(ta_type, type)) {
+        Napi::TypeError::New(env, std::format("Column {} is not a TypedArray compatible with {}", j, CTypeToName(type)))
+          .ThrowAsJavaScriptException();
+        return false;
+      }
+      if (length < count) {
+        Napi::RangeError::New(env, std::format("Column {} has {} elements, expected at least {}", j, length, count))
+          .ThrowAsJavaScriptException();
+        return false;
+      }
+      live_columns.push_back({static_cast<const uint8_t*>(data), CTypeSize(type), slot});
+      if (pins) {
+        pins->push_back(Napi::Persistent(col.As<Napi::Object>()));
+      }
+      continue;
+    }
+
+    if (MarshalPrimitive(env, col, type, slot)) {
+      continue;
+    }
+    if (type == CType::CTYPES_POINTER) {
+      MarshalPointer(env, col, slot);
+      if (pins && col.IsObject()) {
+        pins->push_back(Napi::Persistent(col.As<Napi::Object>()));
+      }
+      continue;
+    }
+    Napi::TypeError::New(env, std::format("{} supports only primitive arguments (argument {} is {})", api, j,
+                                          CTypeToName(type)))
+      .ThrowAsJavaScriptException();
+    return false;
+  }
+  return true;
+}
+
+// `out_arg` (TypedArray compatibile, almeno `count` elementi) oppure un
+// nuovo TypedArray canonico per il tipo di ritorno. Funzioni void: `out`
+// resta undefined e `out_data` nullptr.
+bool FFIFunction::PrepareBatchOutput(Napi::Env env,
+                                     Napi::Value out_arg,
+                                     size_t count,
+                                     Napi::Value& out,
+                                     uint8_t*& out_data,
+                                     const char* api) {
+  out = env.Undefined();
+  out_data = nullptr;
+  if (return_type_ == CType::CTYPES_VOID) {
+    return true;
+  }
+  napi_typedarray_type ret_ta_type;
+  if (!CTypeToTypedArrayType(return_type_, ret_ta_type)) {
+    Napi::TypeError::New(env, std::format("{} does not support {} return values", api, CTypeToName(return_type_)))
+      .ThrowAsJavaScriptException();
+    return false;
+  }
+  if (out_arg.IsTypedArray()) {
+    napi_typedarray_type ta_type;
+    size_t length;
+    void* data;
+    napi_get_typedarray_info(env, out_arg, &ta_type, &length, &data, nullptr, nullptr);
+    if (!TypedArrayMatchesCType(ta_type, return_type_) || length < count) {
+      Napi::TypeError::New(env, std::format("out must be a TypedArray compatible with {} and at least {} elements",
+                                            CTypeToName(return_type_), count))
+        .ThrowAsJavaScriptException();
+      return false;
+    }
+    out = out_arg;
+    out_data = static_cast<uint8_t*>(data);
+    return true;
+  }
+  void* data = nullptr;
+  napi_value arraybuffer;
+  napi_value typedarray;
+  if (napi_create_arraybuffer(env, count * CTypeSize(return_type_), &data, &arraybuffer) != napi_ok ||
+      napi_create_typedarray(env, ret_ta_type, count, arraybuffer, 0, &typedarray) != napi_ok) {
+    Napi::Error::New(env, std::format("Failed to allocate {} result array", api)).ThrowAsJavaScriptException();
+    return false;
+  }
+  out = Napi::Value(env, typedarray);
+  out_data = static_cast<uint8_t*>(data);
+  return true;
+}
+
+size_t FFIFunction::BatchReturnOffset() const {
+  // libffi allarga i ritorni interi stretti a ffi_arg: su big-endian il
+  // valore sta nei byte alti del registro.
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  const size_t ret_size = CTypeSize(return_type_);
+  if (ret_size < sizeof(ffi_arg) && return_type_ != CType::CTYPES_FLOAT) {
+    return sizeof(ffi_arg) - ret_size;
+  }
+#endif
+  return 0;
+}
+
+// ============================================================================
+// CallBatch - invoca la funzione `count` volte in un solo crossing JS → C
+//
+//   fn.callBatch([colA, colB, ...], count[, out])
+//
+// Ogni colonna è un TypedArray compatibile col tipo del parametro (stessa
+// dimensione di elemento, vedi TypedArrayMatchesCType) oppure uno scalare
+// ripetuto per tutte le iterazioni (es. un puntatore di contesto). Il loop
+// interno riusa cif_ e lo storage inline: per iterazione solo memcpy degli
+// elementi negli slot + ffi_call. I risultati finiscono in `out` (o in un
+// nuovo TypedArray canonico per il tipo di ritorno).
+// errcheck non viene applicato per elemento; errno / last-error riflettono
+// l'ultima iterazione.
+// ============================================================================
+
+Napi::Value FFIFunction::CallBatch(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!cif_prepared_) [[unlikely]] {
+    Napi::Error::New(env, "FFI call interface not prepared").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (info.Length() < 2 || !info[0].IsArray() || !info[1].IsNumber()) {
+    Napi::TypeError::New(env, "callBatch requires (argsColumns, count[, out])").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (!out_params_.empty()) {
+    Napi::TypeError::New(env, "callBatch is not supported for functions with outParams").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Array columns = info[0].As<Napi::Array>();
+  const size_t argc = arg_types_.size();
+  if (columns.Length() != argc) {
+    Napi::TypeError::New(env, std::format("Expected {} argument columns, got {}", argc, columns.Length()))
+      .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  const int64_t count_value = info[1].As<Napi::Number>().Int64Value();
+  if (count_value < 0) {
+    Napi::RangeError::New(env, "count must be non-negative").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  const size_t count = static_cast<size_t>(count_value);
+
+  if (CallStats* stats = ActiveStats()) [[unlikely]] {
+    stats->batch_calls++;
+  }
+
+  CallScratch& scratch = EnsureScratch();
+  if (!use_inline_storage_) {
+    heap_arg_storage_.resize(std::max(heap_arg_storage_.size(), argc * ARG_SLOT_SIZE));
+    heap_arg_values_.resize(std::max(heap_arg_values_.size(), argc));
+  }
+  uint8_t* const arg_storage = use_inline_storage_ ? scratch.arg_storage : heap_arg_storage_.data();
+  void** const arg_values = use_inline_storage_ ? scratch.arg_values : heap_arg_values_.data();
+  for (size_t j = 0; j < argc; j++) {
+    arg_values[j] = arg_storage + (j * ARG_SLOT_SIZE);
+  }
+
+  std::vector<BatchColumn> live_columns;
+  if (!MarshalBatchColumns(env, columns, count, arg_storage, live_columns, nullptr, "callBatch")) {
+    return env.Undefined();
+  }
+
+  // ---- Output ---------------------------------------------------------
+  Napi::Value out = env.Undefined();
+  uint8_t* out_data = nullptr;
+  if (!PrepareBatchOutput(env, info.Length() > 2 ? info[2] : env.Undefined(), count, out, out_data, "callBatch")) {
+    return env.Undefined();
+  }
+  const size_t ret_size = CTypeSize(return_type_);
+  const uint8_t* ret_src = reinterpret_cast<const uint8_t*>(&return_value_) + BatchReturnOffset();
+
+  // ---- Hot loop -------------------------------------------------------
+  const BatchColumn* const cols = live_columns.data();
+  const size_t num_cols = live_columns.size();
+  for (size_t i = 0; i < count; i++) {
+    for (size_t c = 0; c < num_cols; c++) {
+      memcpy(cols[c].slot, cols[c].data + (i * cols[c].stride), cols[c].stride);
+    }
+    ffi_call(cif_, FFI_FN(fn_ptr_), &return_value_, arg_values);
+    if (out_data != nullptr) {
+      memcpy(out_data + (i * ret_size), ret_src, ret_size);
+    }
+  }
+  CaptureErrorState();
+
+  return out;
+}
+
+// ============================================================================
+// MapAsync - callBatch a chunk sul CallPool
+//
+//   fn.mapAsync([colA, colB, ...], count[, { concurrency, out }]) → Promise
+//
+// Stesse colonne e stesso output di callBatch, ma il batch è diviso in
+// `concurrency` chunk (default: thread del pool) che girano in parallelo
+// sullo stesso cif_, ognuno con i suoi slot. Una sola Promise, risolta con
+// l'output quando l'ultimo chunk è completato. Le funzioni con una coda
+// seriale (library `serial` o opzione `queue`) non sono thread-safe: un
+// solo chunk, sulla loro coda. Come callBatch niente errcheck né snapshot
+// di errno / last-error.
+// ============================================================================
+
+struct FFIFunction::MapBatch {
+  // Colonna con lo slot come offset: ogni chunk ha il suo storage
+  struct Column {
+    const uint8_t* data;
+    size_t stride;
+    size_t slot_offset;
+  };
+
+  explicit MapBatch(FFIFunction* fn) : function(fn) {
+    function->Ref();  // Pin the FFIFunction instance per tutto il batch
+  }
+  ~MapBatch() { function->Unref(); }
+
+  FFIFunction* function;
+  std::vector<uint8_t> slots;  // argc slot con gli scalari già marshallati
+  std::vector<Column> columns;
+  uint8_t* out_data = nullptr;
+  size_t ret_size = 0;
+  size_t ret_offset = 0;
+  std::vector<Napi::ObjectReference> pins;  // colonne e Buffer scalari
+  std::optional<Napi::Promise::Deferred> deferred;
+  Napi::ObjectReference out;
+  size_t remaining = 0;      // chunk non ancora completati (main thread)
+  std::string error;         // primo errore di un chunk
+};
+
+Napi::Value FFIFunction::MapAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!cif_prepared_) [[unlikely]] {
+    Napi::Error::New(env, "FFI call interface not prepared").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (info.Length() < 2 || !info[0].IsArray() || !info[1].IsNumber() ||
+      (info.Length() > 2 && !info[2].IsUndefined() && !info[2].IsObject())) {
+    Napi::TypeError::New(env, "mapAsync requires (argsColumns, count[, { concurrency, out }])")
+      .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (!out_params_.empty()) {
+    Napi::TypeError::New(env, "mapAsync is not supported for functions with outParams").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Array columns = info[0].As<Napi::Array>();
+  const size_t argc = arg_types_.size();
+  if (columns.Length() != argc) {
+    Napi::TypeError::New(env, std::format("Expected {} argument columns, got {}", argc, columns.Length()))
+      .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  const int64_t count_value = info[1].As<Napi::Number>().Int64Value();
+  if (count_value < 0) {
+    Napi::RangeError::New(env, "count must be non-negative").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  const size_t count = static_cast<size_t>(count_value);
+
+  size_t concurrency = addon_->call_pool.GetStats().threads;
+  Napi::Value out_arg = env.Undefined();
+  if (info.Length() > 2 && info[2].IsObject()) {
+    Napi::Object options = info[2].As<Napi::Object>();
+    Napi::Value value = options.Get("concurrency");
+    if (!value.IsUndefined()) {
+      const double requested = value.IsNumber() ? value.As<Napi::Number>().DoubleValue() : 0;
+      if (!(requested >= 1) || requested != static_cast<double>(static_cast<int64_t>(requested))) {
+        Napi::RangeError::New(env, "concurrency must be a positive integer").ThrowAsJavaScriptException();
+        return env.Undefined();
+      }
+      concurrency = static_cast<size_t>(requested);
+    }
+    out_arg = options.Get("out");
+  }
+  if (serial_queue_) {
+    concurrency = 1;
+  }
+  concurrency = std::max<size_t>(1, std::min(concurrency, count));
+
+  if (CallStats* stats = ActiveStats()) [[unlikely]] {
+    stats->batch_calls++;
+  }
+
+  auto batch = std::make_shared<MapBatch>(this);
+  batch->slots.resize(argc * ARG_SLOT_SIZE, 0);
+  std::vector<BatchColumn> live_columns;
+  if (!MarshalBatchColumns(env, columns, count, batch->slots.data(), live_columns, &batch->pins, "mapAsync")) {
+    return env.Undefined();
+  }
+  batch->columns.reserve(live_columns.size());
+  for (const BatchColumn& col : live_columns) {
+    batch->columns.push_back({col.data, col.stride, static_cast<size_t>(col.slot - batch->slots.data())});
+  }
+
+  Napi::Value out;
+  if (!PrepareBatchOutput(env, out_arg, count, out, batch->out_data, "mapAsync")) {
+    return env.Undefined();
+  }
+  batch->ret_size = CTypeSize(return_type_);
+  batch->ret_offset = BatchReturnOffset();
+  if (out.IsObject()) {
+    batch->out = Napi::Persistent(out.As<Napi::Object>());
+  }
+
+  batch->deferred.emplace(Napi::Promise::Deferred::New(env));
+  Napi::Promise promise = batch->deferred->Promise();
+  if (count == 0) {
+    batch->deferred->Resolve(out);
+    return promise;
+  }
+
+  // Chunk bilanciati: i primi `count % concurrency` hanno una riga in più
+  std::vector<MapChunk*> chunks;
+  chunks.reserve(concurrency);
+  const size_t base_rows = count / concurrency;
+  const size_t extra_rows = count % concurrency;
+  size_t begin = 0;
+  for (size_t i = 0; i < concurrency; i++) {
+    const size_t end = begin + base_rows + (i < extra_rows ? 1 : 0);
+    chunks.push_back(new MapChunk(batch, begin, end));
+    begin = end;
+  }
+  batch->remaining = chunks.size();
+
+  for (size_t i = 0; i < chunks.size(); i++) {
+    if (!addon_->call_pool.Submit(env, chunks[i], serial_queue_)) {
+      // Submit fallisce solo all'avvio del pool, quindi al primo chunk (il
+      // pool ha già riciclato chunks[i]); gli altri non partono
+      for (size_t k = i + 1; k < chunks.size(); k++) {
+        delete chunks[k];
+      }
+      batch->remaining -= chunks.size() - i;
+      return env.Undefined();
+    }
+  }
+  return promise;
+}
+
+FFIFunction::MapChunk::MapChunk(std::shared_ptr<MapBatch> batch, size_t begin, size_t end)
+  : batch_(std::move(batch)), begin_(begin), end_(end), arg_storage_(batch_->slots) {
+  const size_t argc = arg_storage_.size() / ARG_SLOT_SIZE;
+  arg_values_.resize(argc);
+  for (size_t j = 0; j < argc; j++) {
+    arg_values_[j] = arg_storage_.data() + (j * ARG_SLOT_SIZE);
+  }
+}
+
+void FFIFunction::MapChunk::Execute() {
+  // *** WORKER THREAD - Nessun accesso a V8! ***
+  const MapBatch& batch = *batch_;
+  const FFIFunction* fn = batch.function;
+  uint8_t* const storage = arg_storage_.data();
+  void** const arg_values = arg_values_.empty() ? nullptr : arg_values_.data();
+  alignas(16) ReturnValue return_value;
+  const uint8_t* ret_src = reinterpret_cast<const uint8_t*>(&return_value) + batch.ret_offset;
+
+  try {
+    for (size_t i = begin_; i < end_; i++) {
+      for (const MapBatch::Column& col : batch.columns) {
+        memcpy(storage + col.slot_offset, col.data + (i * col.stride), col.stride);
+      }
+      ffi_call(fn->cif_, FFI_FN(fn->fn_ptr_), &return_value, arg_values);
+      if (batch.out_data != nullptr) {
+        memcpy(batch.out_data + (i * batch.ret_size), ret_src, batch.ret_size);
+      }
+    }
+  } catch (...) {
+    error_ = "Native function threw an exception";
+  }
+}
+
+void FFIFunction::MapChunk::Complete(Napi::Env env) {
+  // *** MAIN THREAD *** (HandleScope aperta dal CallPool)
+  MapBatch& batch = *batch_;
+  if (!error_.empty() && batch.error.empty()) {
+    batch.error = error_;
+  }
+  if (--batch.remaining > 0) {
+    return;
+  }
+  if (!batch.error.empty()) {
+    batch.deferred->Reject(Napi::Error::New(env, batch.error).Value());
+  } else {
+    batch.deferred->Resolve(batch.out.IsEmpty() ? env.Undefined() : batch.out.Value());
+  }
+}
+
+void FFIFunction::MapChunk::Recycle() {
+  // L'ultimo chunk rilascia il MapBatch: riferimenti JS e pin della funzione
+  delete this;
 }
 
 Napi::Value FFIFunction::SetErrcheck(const Napi::CallbackInfo& info) {
@@ -1158,6 +1876,133 @@ Napi::Value FFIFunction::SetErrcheck(const Napi::CallbackInfo& info) {
   return env.Undefined();
 }
 
+Napi::Value FFIFunction::SetErrcheckPolicy(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || info[0].IsNull() || info[0].IsUndefined()) {
+    errcheck_fail_ = ErrcheckFail::NONE;
+    errcheck_error_.Reset();
+    return env.Undefined();
+  }
+  if (!info[0].IsObject()) {
+    Napi::TypeError::New(env, "errcheck policy must be an object or null").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  Napi::Object policy = info[0].As<Napi::Object>();
+
+  static const std::unordered_map<std::string, ErrcheckFail> fail_names = {
+    {"nonzero", ErrcheckFail::NONZERO},
+    {"zero", ErrcheckFail::ZERO},
+    {"negative", ErrcheckFail::NEGATIVE},
+    {"minusOne", ErrcheckFail::MINUS_ONE},
+  };
+  static const std::unordered_map<std::string, ErrcheckCode> code_names = {
+    {"result", ErrcheckCode::RESULT},
+    {"errno", ErrcheckCode::ERRNO},
+    {"lastError", ErrcheckCode::LAST_ERROR},
+  };
+
+  Napi::Value fail_value = policy.Get("fail");
+  auto fail = fail_value.IsString() ? fail_names.find(fail_value.As<Napi::String>().Utf8Value()) : fail_names.end();
+  if (fail == fail_names.end()) {
+    Napi::TypeError::New(env, "errcheck policy: fail must be 'nonzero', 'zero', 'negative' or 'minusOne'")
+      .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  ErrcheckCode code = ErrcheckCode::RESULT;
+  Napi::Value code_value = policy.Get("code");
+  if (!code_value.IsUndefined()) {
+    auto it = code_value.IsString() ? code_names.find(code_value.As<Napi::String>().Utf8Value()) : code_names.end();
+    if (it == code_names.end()) {
+      Napi::TypeError::New(env, "errcheck policy: code must be 'result', 'errno' or 'lastError'")
+        .ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    code = it->second;
+  }
+  Napi::Value error = policy.Get("error");
+  if (!error.IsFunction()) {
+    Napi::TypeError::New(env, "errcheck policy: error must be a function").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (return_type_ == CType::CTYPES_VOID || return_type_ == CType::CTYPES_STRUCT ||
+      return_type_ == CType::CTYPES_UNION || return_type_ == CType::CTYPES_ARRAY) {
+    Napi::TypeError::New(env, std::format("errcheck policy on '{}': the return type has no status to check", name_))
+      .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  // Gli snapshot esistono solo con la cattura attiva: senza, errno e
+  // last-error sarebbero quelli di una call qualsiasi
+  if (code == ErrcheckCode::ERRNO && !capture_errno_) {
+    Napi::TypeError::New(env, std::format("errcheck policy on '{}': code 'errno' requires use_errno", name_))
+      .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (code == ErrcheckCode::LAST_ERROR && !capture_last_error_) {
+    Napi::TypeError::New(env,
+                         std::format("errcheck policy on '{}': code 'lastError' requires use_last_error", name_))
+      .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  errcheck_fail_ = fail->second;
+  errcheck_code_ = code;
+  errcheck_error_ = Napi::Persistent(error.As<Napi::Function>());
+  return env.Undefined();
+}
+
+// ============================================================================
+// GetFastCall - funzione JS standalone equivalente a fn.call(...)
+//
+// Node-API non espone le V8 Fast API (CFunction), quindi il minimo overhead
+// raggiungibile è una callback N-API diretta: niente lookup di `.call`,
+// niente Unwrap del receiver e, sul path trampolino, niente CallbackInfo.
+// Tutto ciò che il trampolino non copre (variadic, errcheck, stringhe,
+// struct, use_errno...) ricade su Call() con semantica identica.
+// ============================================================================
+
+napi_value FFIFunction::FastCallEntry(napi_env env, napi_callback_info cbinfo) {
+  size_t argc = MAX_TRAMPOLINE_ARGS;
+  napi_value argv[MAX_TRAMPOLINE_ARGS];
+  void* data = nullptr;
+  if (napi_get_cb_info(env, cbinfo, &argc, argv, nullptr, &data) != napi_ok) {
+    return nullptr;
+  }
+  FFIFunction* self = static_cast<FFIFunction*>(data);
+
+  try {
+    // Con statistiche attive si passa da Call(), che misura le fasi sul percorso generico
+    const bool use_trampoline = self->trampoline_ != nullptr && argc == self->arg_types_.size() &&
+                                self->errcheck_callback_.IsEmpty() && self->errcheck_fail_ == ErrcheckFail::NONE &&
+                                self->ActiveStats() == nullptr;
+    if (use_trampoline) [[likely]] {
+      return self->trampoline_(Napi::Env(env), argv, self->trampoline_plan_);
+    }
+    Napi::CallbackInfo info(env, cbinfo);
+    return self->Call(info);
+  } catch (const Napi::Error& e) {
+    e.ThrowAsJavaScriptException();
+    return nullptr;
+  }
+}
+
+Napi::Value FFIFunction::GetFastCall(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  napi_value fn;
+  if (napi_create_function(env, name_.c_str(), name_.size(), &FFIFunction::FastCallEntry, this, &fn) != napi_ok) {
+    Napi::Error::New(env, "Failed to create fast call entry").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  // La funzione porta un raw pointer a questa istanza: la property _ffi
+  // tiene vivo il wrapper JS finché la funzione è raggiungibile.
+  Napi::Function result(env, fn);
+  result.DefineProperty(Napi::PropertyDescriptor::Value("_ffi", Value(), napi_default));
+  return result;
+}
+
 Napi::Value FFIFunction::ApplyErrcheck(Napi::Env env, Napi::Value result, const Napi::CallbackInfo& info) {
   // Se non c'è errcheck, restituisci il risultato direttamente
   if (errcheck_callback_.IsEmpty()) {
@@ -1170,7 +2015,9 @@ Napi::Value FFIFunction::ApplyErrcheck(Napi::Env env, Napi::Value result, const
   for (size_t i = 0; i < info.Length(); i++) {
     args_array.Set(i, info[i]);
   }
-  napi_value errcheck_args[3] = {result, info.This(), args_array};
+  // Value() e non info.This(): Call() può arrivare anche da FastCallEntry,
+  // dove il receiver non è l'istanza FFIFunction.
+  napi_value errcheck_args[3] = {result, Value(), args_array};
   napi_value out;
   napi_status status = napi_call_function(env, env.Undefined(), errcheck_callback_.Value(), 3, errcheck_args, &out);
   if (status != napi_ok) {
@@ -1180,6 +2027,95 @@ Napi::Value FFIFunction::ApplyErrcheck(Napi::Env env, Napi::Value result, const
   return Napi::Value(env, out);
 }
 
+bool ErrcheckFails(napi_env env, napi_value result, ErrcheckFail fail) {
+  // Il ritorno è già convertito: Number, BigInt (64 bit), Boolean, null
+  // (puntatore / stringa NULL), stringa o oggetto (mai "zero")
+  napi_valuetype type;
+  napi_typeof(env, result, &type);
+  bool zero = false;
+  bool negative = false;
+  bool minus_one = false;
+  switch (type) {
+    case napi_number: {
+      double v = 0;
+      napi_get_value_double(env, result, &v);
+      zero = v == 0;
+      negative = v < 0;
+      minus_one = v == -1;
+      break;
+    }
+    case napi_bigint: {
+      int64_t v = 0;
+      bool lossless = false;
+      napi_get_value_bigint_int64(env, result, &v, &lossless);
+      // Non lossless: oltre INT64_MAX (uint64), quindi positivo
+      zero = lossless && v == 0;
+      negative = lossless && v < 0;
+      minus_one = lossless && v == -1;
+      break;
+    }
+    case napi_boolean: {
+      bool v = false;
+      napi_get_value_bool(env, result, &v);
+      zero = !v;
+      break;
+    }
+    case napi_null:
+    case napi_undefined:
+      zero = true;
+      break;
+    default:
+      break;
+  }
+  switch (fail) {
+    case ErrcheckFail::NONZERO:
+      return !zero;
+    case ErrcheckFail::ZERO:
+      return zero;
+    case ErrcheckFail::NEGATIVE:
+      return negative;
+    case ErrcheckFail::MINUS_ONE:
+      return minus_one;
+    default:
+      return false;
+  }
+}
+
+Napi::Value FFIFunction::ErrcheckPolicyError(Napi::Env env, Napi::Value result, Napi::Value args, int errno_value,
+                                             uint32_t last_error) {
+  Napi::Value code;
+  switch (errcheck_code_) {
+    case ErrcheckCode::ERRNO:
+      code = Napi::Number::New(env, errno_value);
+      break;
+    case ErrcheckCode::LAST_ERROR:
+      code = Napi::Number::New(env, static_cast<double>(last_error));
+      break;
+    default:
+      code = result;
+      break;
+  }
+  try {
+    return errcheck_error_.Call({code, result, Value(), args});
+  } catch (const Napi::Error& e) {
+    return e.Value();
+  }
+}
+
+bool FFIFunction::ApplyErrcheckPolicy(Napi::Env env, Napi::Value result, const Napi::CallbackInfo& info) {
+  if (!ErrcheckFails(env, result, errcheck_fail_)) [[likely]] {
+    return true;
+  }
+  // Solo sul fallimento: array degli argomenti e chiamata alla factory
+  Napi::Array args_array = Napi::Array::New(env, info.Length());
+  for (size_t i = 0; i < info.Length(); i++) {
+    args_array.Set(i, info[i]);
+  }
+  Napi::Value error = ErrcheckPolicyError(env, result, args_array, last_errno_, last_error_);
+  napi_throw(env, error);
+  return false;
+}
+
 Napi::Value FFIFunction::GetName(const Napi::CallbackInfo& info) {
   return Napi::String::New(info.Env(), name_);
 }
@@ -1196,103 +2132,153 @@ Napi::Value FFIFunction::GetAddress(const Napi::CallbackInfo& info) {
 Napi::Value FFIFunction::CallAsync(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
 
+  CallWorker* worker = MarshalAsyncFrame(info, 0, "callAsync");
+  if (!worker) {
+    return env.Undefined();
+  }
+
+  worker->errcheck_ref_ = errcheck_callback_.IsEmpty() ? nullptr : &errcheck_callback_;
+  // errcheck e policy ricevono gli stessi argomenti del percorso sync
+  if (worker->errcheck_ref_ || errcheck_fail_ != ErrcheckFail::NONE) {
+    Napi::Array args_array = Napi::Array::New(env, info.Length());
+    for (size_t i = 0; i < info.Length(); i++) {
+      args_array.Set(i, info[i]);
+    }
+    worker->args_ref_ = Napi::Persistent(args_array);
+  }
+  worker->deferred_.emplace(Napi::Promise::Deferred::New(env));
+  Napi::Promise promise = worker->deferred_->Promise();
+
+  if (!addon_->call_pool.Submit(env, worker, serial_queue_)) {
+    return env.Undefined();
+  }
+
+  return promise;
+}
+
+// ============================================================================
+// Submit - come CallAsync, ma il risultato va in un CompletionRing (ring.h)
+// invece che in una Promise: submit(ring, tag, ...args)
+// ============================================================================
+
+Napi::Value FFIFunction::Submit(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 2 || !info[0].IsObject() ||
+      !info[0].As<Napi::Object>().InstanceOf(addon_->CompletionRingConstructor->Value())) {
+    Napi::TypeError::New(env, "submit requires a CompletionRing as first argument").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (!info[1].IsNumber()) {
+    Napi::TypeError::New(env, "submit requires a numeric tag as second argument").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  RingValueFormat format;
+  if (!GetRingValueFormat(return_type_, pointer_mode_, format)) {
+    Napi::TypeError::New(env, "submit is not supported for struct, union or array return types")
+      .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  CompletionRing* ring = CompletionRing::Unwrap(info[0].As<Napi::Object>());
+  if (!ring->Reserve()) {
+    Napi::RangeError::New(env, "completion ring is full: drain it before submitting more calls")
+      .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  CallWorker* worker = MarshalAsyncFrame(info, 2, "submit");
+  if (!worker) {
+    ring->CancelReservation();
+    return env.Undefined();
+  }
+
+  // Il frame tiene vivo il ring fino al Recycle (Unref in ReleaseCallWorker)
+  ring->Ref();
+  worker->ring_ = ring;
+  worker->ring_tag_ = info[1].As<Napi::Number>().DoubleValue();
+  worker->ring_format_ = format;
+
+  if (!addon_->call_pool.Submit(env, worker, serial_queue_)) {
+    ring->CancelReservation();
+  }
+  return env.Undefined();
+}
+
+// Marshalling nel frame condiviso da CallAsync e Submit: gli argomenti
+// della funzione C iniziano da info[first_arg]. nullptr con eccezione JS
+// pendente se la validazione o il marshalling falliscono (il frame è già
+// tornato nel pool).
+FFIFunction::CallWorker* FFIFunction::MarshalAsyncFrame(const Napi::CallbackInfo& info,
+                                                        size_t first_arg,
+                                                        const char* api) {
+  Napi::Env env = info.Env();
+
   size_t argc;
   bool is_variadic = false;
-  if (!ValidateAndResolveArgc(env, info, argc, is_variadic)) {
-    return env.Undefined();
+  if (!ValidateAndResolveArgc(env, info, argc, is_variadic, first_arg)) {
+    return nullptr;
   }
   const size_t expected_argc = arg_types_.size();
+  if (!out_params_.empty()) {
+    Napi::TypeError::New(env, std::format("{} is not supported for functions with outParams", api))
+      .ThrowAsJavaScriptException();
+    return nullptr;
+  }
 
-  // ---- Validate argc (shared with Call sync, done above) -----------
-  //       fatto da ValidateAndResolveArgc sopra.
+  if (CallStats* stats = ActiveStats()) [[unlikely]] {
+    stats->async_calls++;
+  }
+
+  // ---- Frame riusabile (vedi CallWorker) ---------------------------
+  // Tutto lo stato della call vive nel frame: niente vector temporanei da
+  // muovere nel worker. In caso di errore il frame torna subito nel pool.
+  CallWorker* worker = AcquireCallWorker(argc);
+  std::vector<CType>& extra_types = worker->extra_types_;
 
-  // ---- Infer types for extra variadic args -------------------------
   // =====================================================================
   // Tipi per argomenti extra variadic (inferiti dai valori JS)
   // =====================================================================
-  std::vector<CType> extra_types;
   if (is_variadic) {
-    extra_types.reserve(argc - expected_argc);
     for (size_t i = expected_argc; i < argc; i++) {
-      extra_types.push_back(InferTypeFromJS(info[i]));
+      extra_types.push_back(InferTypeFromJS(info[first_arg + i]));
     }
   }
 
   // =====================================================================
-  // ---- Variadic CIF (owned by the worker thread) -------------------
-  // Variadic CIF (owned dal worker)
+  // ---- Variadic CIF (shared with the sync path) --------------------
   //
-  // Per il path sincrono possiamo usare la cache perché CIF e ffi_types
-  // vivono nell'istanza. Per async, il worker gira su un altro thread e
-  // deve possedere tutto → allochiamo su heap con unique_ptr.
+  // Stessa cache LRU di Call(): le entry sono immutabili e il frame ne
+  // tiene un riferimento, quindi il worker thread può usarla anche se nel
+  // frattempo viene sfrattata.
   // =====================================================================
-  std::unique_ptr<ffi_cif> owned_cif;
-  std::vector<ffi_type*> owned_ffi_types;
-  ffi_cif* active_cif = &cif_;
-
   if (is_variadic) {
-    owned_cif = std::make_unique<ffi_cif>();
-    owned_ffi_types.resize(argc);
-
-    // Copia tipi fissi
-    for (size_t i = 0; i < expected_argc; i++) {
-      owned_ffi_types[i] = ffi_arg_types_[i];
-    }
-    // Tipi extra (inferiti)
-    for (size_t i = 0; i < extra_types.size(); i++) {
-      owned_ffi_types[expected_argc + i] = CTypeToFFI(extra_types[i]);
-    }
-
-    ffi_status status = ffi_prep_cif_var(owned_cif.get(), abi_, static_cast<unsigned int>(expected_argc),
-                                         static_cast<unsigned int>(argc), ffi_return_type_, owned_ffi_types.data());
-
-    if (status != FFI_OK) {
-      Napi::Error::New(env, "Failed to prepare variadic FFI call for async").ThrowAsJavaScriptException();
-      return env.Undefined();
+    worker->variadic_sig_ = GetVariadicSignature(env, extra_types.data(), extra_types.size());
+    if (!worker->variadic_sig_) {
+      ReleaseCallWorker(worker);
+      return nullptr;
     }
-
-    active_cif = owned_cif.get();
+    worker->active_cif_ = &worker->variadic_sig_->cif;
   }
 
   // =====================================================================
   // ---- Marshal JS → C (main thread), with Buffer pinning
-  //              e fixup post-move per le stringhe --------------------
-  //
-  // Tutto va su heap. Tracciamo string offsets per fixup post-move
-  // e pinniamo i Buffer JS.
+  //              e fixup a fine riempimento per le stringhe ------------
   // =====================================================================
 
-  std::vector<uint8_t> async_arg_storage(argc * ARG_SLOT_SIZE, 0);
-  std::vector<void*> async_arg_values(argc);
-  std::vector<char> async_string_buffer;
-  std::vector<std::pair<size_t, size_t>> string_fixups;
-  std::vector<std::pair<size_t, size_t>> wstring_fixups;
-  std::vector<Napi::ObjectReference> buffer_refs;
-  std::vector<std::vector<uint8_t>> large_arg_buffers;
-  std::vector<size_t> large_arg_indices;  // tracks which arg slots use large_arg_buffers (in order)
-
-  // Stima spazio stringhe
-  {
-    size_t str_count = 0;
-    for (size_t i = 0; i < argc; i++) {
-      CType t = (i < expected_argc) ? arg_types_[i] : extra_types[i - expected_argc];
-      if (t == CType::CTYPES_STRING || t == CType::CTYPES_WSTRING) {
-        str_count++;
-      }
-    }
-    if (str_count > 0) {
-      async_string_buffer.reserve(str_count * 128);
-    }
-  }
-
-  uint8_t* arg_storage = async_arg_storage.data();
+  std::vector<char>& async_string_buffer = worker->string_buffer_;
+  std::vector<std::pair<size_t, size_t>>& string_fixups = worker->string_fixups_;
+  std::vector<std::pair<size_t, size_t>>& wstring_fixups = worker->wstring_fixups_;
+  std::vector<Napi::ObjectReference>& buffer_refs = worker->buffer_refs_;
+  AggregateArena& aggregates = worker->aggregates_;
+  void** async_arg_values = worker->arg_values_;
+  uint8_t* arg_storage = worker->arena_.data();
 
   for (size_t i = 0; i < argc; i++) {
-    async_arg_values[i] = arg_storage + (i * ARG_SLOT_SIZE);
     uint8_t* slot = arg_storage + (i * ARG_SLOT_SIZE);
 
     CType type = (i < expected_argc) ? arg_types_[i] : extra_types[i - expected_argc];
-    const Napi::Value& val = info[i];
+    const Napi::Value& val = info[first_arg + i];
 
     // Fast path: primitive types (shared implementation)
     if (MarshalPrimitive(env, val, type, slot)) {
@@ -1314,6 +2300,8 @@ Napi::Value FFIFunction::CallAsync(const Napi::CallbackInfo& info) {
           ptr = reinterpret_cast<void*>(val.As<Napi::BigInt>().Uint64Value(&lossless));
         } else if (val.IsNumber()) {
           ptr = reinterpret_cast<void*>(static_cast<uintptr_t>(val.As<Napi::Number>().Int64Value()));
+        } else if (val.IsExternal()) {
+          GetPointerHandle(env, val, ptr);
         }
         memcpy(slot, &ptr, sizeof(ptr));
         break;
@@ -1321,17 +2309,8 @@ Napi::Value FFIFunction::CallAsync(const Napi::CallbackInfo& info) {
 
       case CType::CTYPES_STRING: {
         if (val.IsString()) {
-          std::string str = val.As<Napi::String>().Utf8Value();
-          size_t offset = async_string_buffer.size();
-          async_string_buffer.resize(offset + str.size() + 1);
-          memcpy(async_string_buffer.data() + offset, str.c_str(), str.size() + 1);
-
-          // Puntatore provvisorio (verrà fixato dal worker)
-          const char* str_ptr = async_string_buffer.data() + offset;
-          memcpy(slot, &str_ptr, sizeof(str_ptr));
-
-          // Registra per fixup post-move
-          string_fixups.emplace_back(i, offset);
+          // Il puntatore nello slot viene scritto da FixupPointers()
+          string_fixups.emplace_back(i, AppendUtf8String(env, val, async_string_buffer));
         } else if (val.IsBuffer()) {
           auto buf = val.As<Napi::Buffer<uint8_t>>();
           const char* ptr = reinterpret_cast<const char*>(buf.Data());
@@ -1355,31 +2334,7 @@ Napi::Value FFIFunction::CallAsync(const Napi::CallbackInfo& info) {
 
       case CType::CTYPES_WSTRING: {
         if (val.IsString()) {
-          std::u16string u16str = val.As<Napi::String>().Utf16Value();
-          size_t wchar_size = sizeof(wchar_t);
-          size_t byte_len = (u16str.length() + 1) * wchar_size;
-
-          // Align offset for wchar_t to avoid unaligned access
-          // (critical on ARM, perf penalty on x86)
-          size_t offset = async_string_buffer.size();
-          constexpr size_t wchar_align = alignof(wchar_t);
-          offset = (offset + wchar_align - 1) & ~(wchar_align - 1);
-          async_string_buffer.resize(offset + byte_len);
-
-#ifdef _WIN32
-          memcpy(async_string_buffer.data() + offset, u16str.data(), byte_len);
-#else
-          wchar_t* wptr = reinterpret_cast<wchar_t*>(async_string_buffer.data() + offset);
-          for (size_t j = 0; j < u16str.length(); j++) {
-            wptr[j] = static_cast<wchar_t>(u16str[j]);
-          }
-          wptr[u16str.length()] = L'\0';
-#endif
-
-          const wchar_t* str_ptr = reinterpret_cast<const wchar_t*>(async_string_buffer.data() + offset);
-          memcpy(slot, &str_ptr, sizeof(str_ptr));
-
-          wstring_fixups.emplace_back(i, offset);
+          wstring_fixups.emplace_back(i, AppendWideString(env, val, async_string_buffer));
         } else if (val.IsBuffer()) {
           auto buf = val.As<Napi::Buffer<uint8_t>>();
           const wchar_t* ptr = reinterpret_cast<const wchar_t*>(buf.Data());
@@ -1404,9 +2359,12 @@ Napi::Value FFIFunction::CallAsync(const Napi::CallbackInfo& info) {
 
       case CType::CTYPES_STRUCT: {
         if (i < expected_argc && arg_struct_infos_[i]) {
-          if (!MarshalStructArg(env, val, i, arg_struct_infos_[i], slot, &async_arg_values[i], large_arg_buffers,
-                                &large_arg_indices)) {
-            return env.Undefined();
+          // Lo spazio dell'arena non si sposta fino al prossimo Begin:
+          // arg_values_[i] resta valido senza fixup.
+          if (!MarshalStructArg(env, val, i, arg_struct_infos_[i], slot, &async_arg_values[i], aggregates,
+                                nullptr)) {
+            ReleaseCallWorker(worker);
+            return nullptr;
           }
         } else {
           JSToC(env, val, type, slot, ARG_SLOT_SIZE);
@@ -1416,9 +2374,10 @@ Napi::Value FFIFunction::CallAsync(const Napi::CallbackInfo& info) {
 
       case CType::CTYPES_ARRAY: {
         if (i < expected_argc && arg_array_infos_[i]) {
-          if (!MarshalArrayArg(env, val, i, arg_array_infos_[i], slot, &async_arg_values[i], large_arg_buffers,
-                               &large_arg_indices)) {
-            return env.Undefined();
+          if (!MarshalArrayArg(env, val, i, arg_array_infos_[i], slot, &async_arg_values[i], aggregates,
+                               nullptr)) {
+            ReleaseCallWorker(worker);
+            return nullptr;
           }
         } else {
           JSToC(env, val, type, slot, ARG_SLOT_SIZE);
@@ -1432,111 +2391,174 @@ Napi::Value FFIFunction::CallAsync(const Napi::CallbackInfo& info) {
     }
   }
 
-  // =====================================================================
-  // ---- Create worker, move buffers, return Promise ----------------
-  // =====================================================================
+  worker->FixupPointers();
+  return worker;
+}
 
-  Napi::FunctionReference* errcheck_ptr = nullptr;
-  if (!errcheck_callback_.IsEmpty()) {
-    errcheck_ptr = &errcheck_callback_;
+// ============================================================================
+// Cache dei CIF variadici (vedi VariadicSignatureCache in signature.h)
+// ============================================================================
+
+std::shared_ptr<PreparedSignature> FFIFunction::GetVariadicSignature(Napi::Env env,
+                                                                     const CType* extra_types,
+                                                                     size_t num_extra) {
+  if (!variadic_cache_) [[unlikely]] {
+    variadic_cache_ = std::make_unique<VariadicSignatureCache>(MAX_CACHED_VARIADIC_CIFS);
+  }
+  std::shared_ptr<PreparedSignature> sig = variadic_cache_->Get(*signature_, extra_types, num_extra);
+  if (!sig) {
+    Napi::Error::New(env, "Failed to prepare variadic FFI call").ThrowAsJavaScriptException();
   }
+  return sig;
+}
 
-  auto* worker = new CallWorker(env, this, &cif_, fn_ptr_, return_type_, return_struct_info_, return_array_info_,
-                                std::move(async_arg_storage), std::move(async_arg_values),
-                                std::move(async_string_buffer), std::move(string_fixups), std::move(wstring_fixups),
-                                std::move(buffer_refs), std::move(owned_cif), std::move(owned_ffi_types),
-                                std::move(large_arg_buffers), std::move(large_arg_indices), errcheck_ptr);
+Napi::Value FFIFunction::GetVariadicCacheStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::Object stats = Napi::Object::New(env);
+  const VariadicSignatureCache* cache = variadic_cache_.get();
+  stats.Set("hits", Napi::Number::New(env, cache ? static_cast<double>(cache->Hits()) : 0));
+  stats.Set("misses", Napi::Number::New(env, cache ? static_cast<double>(cache->Misses()) : 0));
+  stats.Set("size", Napi::Number::New(env, cache ? static_cast<double>(cache->Size()) : 0));
+  stats.Set("capacity", Napi::Number::New(env, static_cast<double>(MAX_CACHED_VARIADIC_CIFS)));
+  return stats;
+}
 
-  Napi::Promise promise = worker->GetPromise();
-  worker->Queue();
+CallStats* FFIFunction::EnsureStats() {
+  if (!stats_) [[unlikely]] {
+    stats_ = std::make_unique<CallStats>();
+    addon_->instrumented_functions.insert(this);
+  }
+  return stats_.get();
+}
 
-  return promise;
+Napi::Object FFIFunction::StatsSnapshot(Napi::Env env) const {
+  Napi::Object obj = Napi::Object::New(env);
+  obj.Set("name", Napi::String::New(env, name_));
+  obj.Set("address", Napi::BigInt::New(env, reinterpret_cast<uint64_t>(fn_ptr_)));
+  obj.Set("enabled", Napi::Boolean::New(env, stats_enabled_ || addon_->stats_enabled));
+  CallStatsToJS(env, stats_ ? *stats_ : CallStats{}, obj);
+
+  const VariadicSignatureCache* cache = variadic_cache_.get();
+  obj.Set("variadicCacheHits", Napi::Number::New(env, cache ? static_cast<double>(cache->Hits()) : 0));
+  obj.Set("variadicCacheMisses", Napi::Number::New(env, cache ? static_cast<double>(cache->Misses()) : 0));
+  return obj;
+}
+
+Napi::Value FFIFunction::GetStats(const Napi::CallbackInfo& info) {
+  return StatsSnapshot(info.Env());
+}
+
+Napi::Value FFIFunction::ResetStats(const Napi::CallbackInfo& info) {
+  if (stats_) {
+    *stats_ = CallStats{};
+  }
+  return info.Env().Undefined();
 }
 
 // ============================================================================
-// CallWorker implementations (nested class)
+// Pool dei frame async
 // ============================================================================
 
-FFIFunction::CallWorker::CallWorker(Napi::Env env,
-                                    FFIFunction* parent,
-                                    ffi_cif* cif,
-                                    void* fn_ptr,
-                                    CType return_type,
-                                    std::shared_ptr<StructInfo> return_struct_info,
-                                    std::shared_ptr<ArrayInfo> return_array_info,
-                                    std::vector<uint8_t>&& arg_storage,
-                                    std::vector<void*>&& arg_values,
-                                    std::vector<char>&& string_buffer,
-                                    std::vector<std::pair<size_t, size_t>>&& string_fixups,
-                                    std::vector<std::pair<size_t, size_t>>&& wstring_fixups,
-                                    std::vector<Napi::ObjectReference>&& buffer_refs,
-                                    std::unique_ptr<ffi_cif>&& owned_cif,
-                                    std::vector<ffi_type*>&& owned_ffi_types,
-                                    std::vector<std::vector<uint8_t>>&& large_arg_buffers,
-                                    std::vector<size_t>&& large_arg_indices,
-                                    Napi::FunctionReference* errcheck_ref)
-  : Napi::AsyncWorker(env),
-    ffi_function_(parent),
-    fn_ptr_(fn_ptr),
-    return_type_(return_type),
-    return_struct_info_(std::move(return_struct_info)),
-    return_array_info_(std::move(return_array_info)),
-    arg_storage_(std::move(arg_storage)),
-    arg_values_(std::move(arg_values)),
-    string_buffer_(std::move(string_buffer)),
-    string_fixups_(std::move(string_fixups)),
-    wstring_fixups_(std::move(wstring_fixups)),
-    buffer_refs_(std::move(buffer_refs)),
-    owned_cif_(std::move(owned_cif)),
-    owned_ffi_types_(std::move(owned_ffi_types)),
-    large_arg_buffers_(std::move(large_arg_buffers)),
-    large_arg_indices_(std::move(large_arg_indices)),
-    return_ptr_(nullptr),
-    deferred_(Napi::Promise::Deferred::New(env)),
-    errcheck_ref_(errcheck_ref) {
-  ffi_function_->Ref();  // Pin the FFIFunction instance
+FFIFunction::CallWorker* FFIFunction::AcquireCallWorker(size_t argc) {
+  CallWorker* worker;
+  if (!free_workers_.empty()) {
+    worker = free_workers_.back().release();
+    free_workers_.pop_back();
+  } else {
+    worker = new CallWorker(this);
+  }
+  worker->Begin(argc);
+  return worker;
+}
 
-  memset(&return_value_, 0, sizeof(return_value_));
+void FFIFunction::ReleaseCallWorker(CallWorker* worker) {
+  // Rilascia subito i riferimenti JS: un frame nel pool non deve tenere
+  // vivi Buffer né Promise
+  worker->buffer_refs_.clear();
+  worker->deferred_.reset();
+  worker->variadic_sig_.reset();
+  worker->errcheck_ref_ = nullptr;
+  worker->args_ref_.Reset();
+  if (worker->ring_) {
+    worker->ring_->Unref();
+    worker->ring_ = nullptr;
+  }
+
+  if (free_workers_.size() < MAX_POOLED_CALL_WORKERS) {
+    free_workers_.emplace_back(worker);
+  } else {
+    delete worker;
+  }
+  Unref();  // Unpin the FFIFunction instance (vedi CallWorker::Begin)
+}
 
-  // Seleziona il CIF attivo: owned (variadic) o esterno (fisso)
-  active_cif_ = owned_cif_ ? owned_cif_.get() : cif;
+// ============================================================================
+// CallWorker implementations (nested class)
+// ============================================================================
 
-  // Allocate return buffer for large struct/array returns
-  return_ptr_ = &return_value_;
-  if (return_type_ == CType::CTYPES_STRUCT && return_struct_info_) {
-    size_t ret_size = return_struct_info_->GetSize();
-    if (ret_size > sizeof(ReturnValue)) {
-      return_buffer_.resize(ret_size, 0);
-      return_ptr_ = return_buffer_.data();
-    }
-  } else if (return_type_ == CType::CTYPES_ARRAY && return_array_info_) {
-    size_t ret_size = return_array_info_->GetSize();
-    if (ret_size > sizeof(ReturnValue)) {
-      return_buffer_.resize(ret_size, 0);
-      return_ptr_ = return_buffer_.data();
-    }
+FFIFunction::CallWorker::CallWorker(FFIFunction* parent)
+  : ffi_function_(parent),
+    active_cif_(parent->cif_),
+    arg_values_(nullptr),
+    argc_(0),
+    return_ptr_(&return_value_),
+    errcheck_ref_(nullptr) {
+  // Arena dimensionata sull'arity dichiarata: le call non variadiche non
+  // la fanno mai crescere.
+  const size_t argc = parent->arg_types_.size();
+  arena_.resize(argc * (ARG_SLOT_SIZE + sizeof(void*)));
+  aggregates_.SetCapacity(parent->aggregate_arena_bytes_);
+
+  // Allocate return buffer for large struct/array returns (il tipo di
+  // ritorno è fisso per FFIFunction, quindi basta farlo una volta)
+  size_t ret_size = 0;
+  if (parent->return_type_ == CType::CTYPES_STRUCT && parent->return_struct_info_) {
+    ret_size = parent->return_struct_info_->GetSize();
+  } else if (parent->return_type_ == CType::CTYPES_ARRAY && parent->return_array_info_) {
+    ret_size = parent->return_array_info_->GetSize();
+  }
+  if (ret_size > sizeof(ReturnValue)) {
+    return_buffer_.resize(ret_size, 0);
+    return_ptr_ = return_buffer_.data();
   }
-
-  // Ricalcola tutti i puntatori dopo il move
-  FixupPointers();
 }
 
-void FFIFunction::CallWorker::FixupPointers() {
-  uint8_t* base = arg_storage_.data();
-  const size_t argc = arg_values_.size();
-
-  // 1. Ricalcola arg_values_ come offsets dal nuovo base
+void FFIFunction::CallWorker::Begin(size_t argc) {
+  ffi_function_->Ref();  // Pin the FFIFunction instance (Unref in ReleaseCallWorker)
+
+  // clear() conserva la capacity dei buffer usati dalla call precedente
+  extra_types_.clear();
+  string_buffer_.clear();
+  string_fixups_.clear();
+  wstring_fixups_.clear();
+  aggregates_.Reset();
+  error_.clear();
+  active_cif_ = ffi_function_->cif_;
+
+  argc_ = argc;
+  const size_t slots_bytes = argc * ARG_SLOT_SIZE;
+  const size_t needed = slots_bytes + argc * sizeof(void*);
+  if (arena_.size() < needed) {
+    arena_.resize(needed);
+  }
+  uint8_t* base = arena_.data();
+  memset(base, 0, slots_bytes);
+  // slots_bytes è multiplo di 16: la tabella dei void* resta allineata
+  arg_values_ = reinterpret_cast<void**>(base + slots_bytes);
   for (size_t i = 0; i < argc; i++) {
     arg_values_[i] = base + (i * ARG_SLOT_SIZE);
   }
 
-  // 2. Fixup large struct/array args: point to their overflow buffers
-  for (size_t k = 0; k < large_arg_indices_.size(); k++) {
-    size_t arg_idx = large_arg_indices_[k];
-    arg_values_[arg_idx] = large_arg_buffers_[k].data();
+  memset(&return_value_, 0, sizeof(return_value_));
+  if (!return_buffer_.empty()) {
+    memset(return_buffer_.data(), 0, return_buffer_.size());
   }
+}
 
-  // 3. Fixup puntatori a stringhe (char*) dentro gli slot
+void FFIFunction::CallWorker::FixupPointers() {
+  uint8_t* base = arena_.data();
+
+  // Puntatori a stringhe (char*) dentro gli slot
   const char* str_base = string_buffer_.data();
   for (const auto& [slot_index, str_offset] : string_fixups_) {
     uint8_t* slot = base + (slot_index * ARG_SLOT_SIZE);
@@ -1544,7 +2566,7 @@ void FFIFunction::CallWorker::FixupPointers() {
     memcpy(slot, &new_ptr, sizeof(new_ptr));
   }
 
-  // 4. Fixup puntatori a wstring (wchar_t*) dentro gli slot
+  // Puntatori a wstring (wchar_t*) dentro gli slot
   for (const auto& [slot_index, str_offset] : wstring_fixups_) {
     uint8_t* slot = base + (slot_index * ARG_SLOT_SIZE);
     const wchar_t* new_ptr = reinterpret_cast<const wchar_t*>(str_base + str_offset);
@@ -1552,49 +2574,79 @@ void FFIFunction::CallWorker::FixupPointers() {
   }
 }
 
-FFIFunction::CallWorker::~CallWorker() {
-  ffi_function_->Unref();  // Unpin the FFIFunction instance
+void FFIFunction::CallWorker::Recycle() {
+  ffi_function_->ReleaseCallWorker(this);
 }
 
 void FFIFunction::CallWorker::Execute() {
   // *** WORKER THREAD - Nessun accesso a V8! ***
   try {
-    ffi_call(active_cif_, FFI_FN(fn_ptr_), return_ptr_, arg_values_.empty() ? nullptr : arg_values_.data());
+    ffi_call(active_cif_, FFI_FN(ffi_function_->fn_ptr_), return_ptr_, argc_ == 0 ? nullptr : arg_values_);
   } catch (...) {
-    SetError("Native function threw an exception");
+    error_ = "Native function threw an exception";
+  }
+  // Snapshot per la policy errcheck (il parent non è toccato dal worker)
+  if (ffi_function_->capture_errno_) {
+    errno_value_ = errno;
+  }
+  if (ffi_function_->capture_last_error_) {
+#ifdef _WIN32
+    last_error_ = static_cast<uint32_t>(::GetLastError());
+#else
+    last_error_ = static_cast<uint32_t>(errno);
+#endif
+  }
+  if (ring_) {
+    // Il record è visibile a JS da subito, il risveglio arriva dal drain
+    const bool ok = error_.empty();
+    ring_->Publish(ring_tag_, ok ? 0 : 1, ring_format_,
+                   ok ? NormalizeRingValue(ffi_function_->return_type_, return_ptr_) : 0);
   }
 }
 
-void FFIFunction::CallWorker::OnOK() {
-  // *** MAIN THREAD ***
-  Napi::Env env = Env();
-  Napi::HandleScope scope(env);
+void FFIFunction::CallWorker::Complete(Napi::Env env) {
+  // *** MAIN THREAD *** (HandleScope aperta dal CallPool)
+  if (ring_) {
+    ring_->Completed(ffi_function_->addon_->call_pool);
+    return;
+  }
+  if (!error_.empty()) {
+    deferred_->Reject(Napi::Error::New(env, error_).Value());
+    return;
+  }
+  OnOK(env);
+}
 
+void FFIFunction::CallWorker::OnOK(Napi::Env env) {
   try {
-    // Riusa ConvertReturn statico (shared con ConvertReturnValue sync)
-    Napi::Value result =
-      FFIFunction::ConvertReturn(env, return_ptr_, return_type_, return_struct_info_, return_array_info_);
+    // Stesso converter del ritorno sync (piano della FFIFunction)
+    Napi::Value result = ffi_function_->return_converter_(ffi_function_, env, return_ptr_);
+
+    // Argomenti della call (CallAsync li conserva solo con errcheck / policy)
+    Napi::Value args = args_ref_.IsEmpty() ? Napi::Array::New(env, 0) : args_ref_.Value();
+
+    // Policy errcheck (se presente)
+    if (ffi_function_->errcheck_fail_ != ErrcheckFail::NONE &&
+        ErrcheckFails(env, result, ffi_function_->errcheck_fail_)) {
+      deferred_->Reject(ffi_function_->ErrcheckPolicyError(env, result, args, errno_value_, last_error_));
+      return;
+    }
 
     // Errcheck (se presente)
     if (errcheck_ref_ && !errcheck_ref_->IsEmpty()) {
       try {
-        Napi::Array args_array = Napi::Array::New(env, 0);
-        std::vector<napi_value> errcheck_args = {result, ffi_function_->Value(), args_array};
+        std::vector<napi_value> errcheck_args = {result, ffi_function_->Value(), args};
         result = errcheck_ref_->Call(errcheck_args);
       } catch (const Napi::Error& e) {
-        deferred_.Reject(e.Value());
+        deferred_->Reject(e.Value());
         return;
       }
     }
 
-    deferred_.Resolve(result);
+    deferred_->Resolve(result);
   } catch (const Napi::Error& e) {
-    deferred_.Reject(e.Value());
+    deferred_->Reject(e.Value());
   }
 }
 
-void FFIFunction::CallWorker::OnError(const Napi::Error& error) {
-  deferred_.Reject(error.Value());
-}
-
 }  // namespace ctypes
@@ -2,8 +2,13 @@
 
 #include "addon.h"
 #include "array.h"
+#include "pool.h"
+#include "ring.h"
 #include "shared.h"
+#include "signature.h"
+#include "stats.h"
 #include "struct.h"
+#include "trampoline.h"
 #include "types.h"
 
 namespace ctypes {
@@ -19,9 +24,10 @@ static constexpr size_t MAX_INLINE_ARGS = 16;
 static constexpr size_t ARG_SLOT_SIZE = 16;  // Abbastanza per qualsiasi tipo base
 static constexpr size_t RETURN_BUFFER_SIZE = 64;
 static constexpr size_t MAX_VARIADIC_EXTRA_ARGS = 8;    // Per stack allocation
-static constexpr size_t MAX_CACHED_VARIADIC_CIFS = 16;  // Cache per pattern comuni
+static constexpr size_t MAX_CACHED_VARIADIC_CIFS = 64;  // LRU per pattern comuni (VariadicSignatureCache)
 static constexpr size_t SMALL_STRING_BUFFER = 1024;     // Stack buffer per stringhe piccole
 static constexpr int MAX_AS_PARAMETER_DEPTH = 100;      // Ricorsione _as_parameter_ (come CPython)
+static constexpr size_t MAX_POOLED_CALL_WORKERS = 64;   // Frame callAsync riusabili per FFIFunction
 
 // Union per return value (come CPython - migliore cache locality)
 union ReturnValue {
@@ -41,17 +47,80 @@ union ReturnValue {
   wchar_t* wstr;
 };
 
-// Cache entry per CIF variadici (es. sprintf con 1-2 argomenti extra)
-struct VariadicCifCache {
-  size_t total_args;  // Numero totale argomenti (fissi + variadici)
-  ffi_cif cif;
-  std::vector<ffi_type*> ffi_types;
-  std::vector<CType> extra_types;  // Tipi degli argomenti extra
-  bool valid;
+// ============================================================================
+// Arena bump per aggregati by-value
+//
+// Struct / union / array oltre ARG_SLOT_SIZE e ritorni oltre
+// sizeof(ReturnValue) non stanno nello slot dell'argomento. Prima ognuno
+// era un std::vector<uint8_t> allocato a ogni call; qui un solo blocco,
+// dimensionato dai layout della signature (SetCapacity alla costruzione,
+// allocato al primo Reset), viene riassegnato a ogni call: a regime zero
+// allocazioni. Blocchi da 16 byte (come gli slot).
+//
+// Se la richiesta supera il blocco (layout cambiato dopo la costruzione)
+// ripiega su un buffer a parte, che non si sposta finché la call è viva;
+// il Reset successivo allarga il blocco al picco osservato.
+// ============================================================================
+class AggregateArena {
+ public:
+  void SetCapacity(size_t bytes) { capacity_ = bytes; }
+
+  // Inizio call: tutto lo spazio torna libero
+  void Reset() {
+    if (peak_ > capacity_) [[unlikely]] {
+      capacity_ = peak_;
+    }
+    if (block_.size() < capacity_) [[unlikely]] {
+      block_.assign(capacity_, 0);
+    }
+    if (!overflow_.empty()) [[unlikely]] {
+      overflow_.clear();
+    }
+    used_ = 0;
+  }
+
+  // `size` byte azzerati, validi fino al prossimo Reset
+  uint8_t* Allocate(size_t size) {
+    const size_t bytes = (size + 15) & ~static_cast<size_t>(15);
+    uint8_t* ptr;
+    if (used_ + bytes <= block_.size()) [[likely]] {
+      ptr = block_.data() + used_;
+    } else {
+      overflow_.emplace_back(bytes);
+      ptr = overflow_.back().data();
+    }
+    used_ += bytes;
+    peak_ = std::max(peak_, used_);
+    memset(ptr, 0, size);
+    return ptr;
+  }
+
+  // Allocazioni della call corrente finite fuori dal blocco
+  size_t Overflows() const { return overflow_.size(); }
+
+ private:
+  std::vector<uint8_t> block_;
+  std::vector<std::vector<uint8_t>> overflow_;
+  size_t capacity_ = 0;
+  size_t used_ = 0;
+  size_t peak_ = 0;
+};
 
-  VariadicCifCache() : total_args(0), valid(false) {}
+// Predicato di fallimento di un errcheck dichiarativo (setErrcheckPolicy)
+enum class ErrcheckFail : uint8_t {
+  NONE,       // nessuna policy
+  NONZERO,    // result != 0 (status code)
+  ZERO,       // result == 0 / NULL / false (BOOL, HANDLE, puntatori)
+  NEGATIVE,   // result < 0 (HRESULT, syscall che ritornano -errno)
+  MINUS_ONE,  // result == -1 (syscall POSIX con errno)
 };
 
+// Da dove viene il codice passato alla factory dell'errore
+enum class ErrcheckCode : uint8_t { RESULT, ERRNO, LAST_ERROR };
+
+// true se `result` (valore JS già convertito) soddisfa il predicato
+bool ErrcheckFails(napi_env env, napi_value result, ErrcheckFail fail);
+
 // Wrapper per una funzione C chiamabile da JavaScript
 class FFIFunction : public Napi::ObjectWrap<FFIFunction> {
  public:
@@ -62,6 +131,15 @@ class FFIFunction : public Napi::ObjectWrap<FFIFunction> {
 
   Napi::Value Call(const Napi::CallbackInfo& info);
   Napi::Value CallAsync(const Napi::CallbackInfo& info);
+  // submit(ring, tag, ...args): come callAsync, ma tag e risultato finiscono
+  // in un CompletionRing (ring.h) invece che in una Promise
+  Napi::Value Submit(const Napi::CallbackInfo& info);
+  // callBatch(argsColumns, count[, out]): N chiamate in un solo crossing
+  // JS → C. Una colonna (TypedArray) per parametro, o uno scalare ripetuto.
+  Napi::Value CallBatch(const Napi::CallbackInfo& info);
+  // mapAsync(argsColumns, count[, { concurrency, out }]): come callBatch,
+  // ma a chunk su più thread del CallPool; una Promise per tutto il batch.
+  Napi::Value MapAsync(const Napi::CallbackInfo& info);
 
   // ==========================================================================
   // CallContext — mutable state shared tra le fasi di Call().
@@ -80,7 +158,6 @@ class FFIFunction : public Napi::ObjectWrap<FFIFunction> {
     size_t argc = 0;
     size_t expected_argc = 0;
     ffi_cif* active_cif = nullptr;
-    VariadicCifCache* cache_entry = nullptr;
     size_t num_extra = 0;
     // Puntatore al primo elemento dell'array di tipi extra (che risiede
     // su stack o heap nel frame di Call()). Valido solo se need_reprep.
@@ -91,7 +168,22 @@ class FFIFunction : public Napi::ObjectWrap<FFIFunction> {
   };
   Napi::Value GetName(const Napi::CallbackInfo& info);
   Napi::Value GetAddress(const Napi::CallbackInfo& info);
+  // Array riusato con i valori degli out param dell'ultima call (o undefined)
+  Napi::Value GetOutValues(const Napi::CallbackInfo& info);
   Napi::Value SetErrcheck(const Napi::CallbackInfo& info);
+  // setErrcheckPolicy({ fail, code, error } | null): vedi ErrcheckFail
+  Napi::Value SetErrcheckPolicy(const Napi::CallbackInfo& info);
+  Napi::Value GetFastCall(const Napi::CallbackInfo& info);
+  // { hits, misses, size, capacity } della cache dei CIF variadici
+  Napi::Value GetVariadicCacheStats(const Napi::CallbackInfo& info);
+  // Statistiche per-funzione (stats.h): snapshot e azzeramento
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+  Napi::Value ResetStats(const Napi::CallbackInfo& info);
+
+  // { name, address, enabled, calls, ..., marshal, ffiCall, ... }; usato
+  // anche dallo snapshot di modulo (CTypesAddon::GetStatsSnapshot)
+  Napi::Object StatsSnapshot(Napi::Env env) const;
+  const std::string& GetFunctionName() const { return name_; }
 
   // Static helpers shared between sync Call() and async CallWorker
   static CType InferTypeFromJS(const Napi::Value& val);
@@ -101,13 +193,16 @@ class FFIFunction : public Napi::ObjectWrap<FFIFunction> {
                                    const std::shared_ptr<StructInfo>& struct_info,
                                    const std::shared_ptr<ArrayInfo>& array_info);
   static inline bool MarshalPrimitive(Napi::Env env, const Napi::Value& val, CType type, uint8_t* slot);
+  // CTYPES_POINTER sync: null/undefined, Buffer, BigInt, Number (indirizzo) o
+  // handle di puntatore
+  static inline void MarshalPointer(Napi::Env env, const Napi::Value& val, uint8_t* slot);
   static bool MarshalStructArg(Napi::Env env,
                                const Napi::Value& val,
                                size_t arg_index,
                                const std::shared_ptr<StructInfo>& struct_info,
                                uint8_t* slot,
                                void** arg_value_ptr,
-                               std::vector<std::vector<uint8_t>>& large_buffers,
+                               AggregateArena& aggregates,
                                std::vector<size_t>* large_indices);
   static bool MarshalArrayArg(Napi::Env env,
                               const Napi::Value& val,
@@ -115,12 +210,49 @@ class FFIFunction : public Napi::ObjectWrap<FFIFunction> {
                               const std::shared_ptr<ArrayInfo>& array_info,
                               uint8_t* slot,
                               void** arg_value_ptr,
-                              std::vector<std::vector<uint8_t>>& large_buffers,
+                              AggregateArena& aggregates,
                               std::vector<size_t>* large_indices);
 
  private:
   bool PrepareFFI(Napi::Env env);
 
+  // Entry point N-API "nudo" restituito da GetFastCall(): FFIFunction* nel
+  // data pointer della funzione, quindi niente ObjectWrap::Unwrap di `this`
+  // né Napi::CallbackInfo quando il trampolino copre la chiamata.
+  static napi_value FastCallEntry(napi_env env, napi_callback_info cbinfo);
+
+  // ============================================================
+  // Piano di conversione per-signature, costruito nel costruttore:
+  // un converter per argomento dichiarato e uno per il ritorno. Il loop
+  // di MarshalArguments e FinalizeCall chiamano direttamente il
+  // puntatore a funzione invece di ridispatchare su CType ad ogni call.
+  // ============================================================
+  using ArgMarshaler =
+    bool (*)(FFIFunction* self, CallContext& ctx, size_t index, const Napi::Value& val, uint8_t* slot);
+  using ReturnConverter = Napi::Value (*)(FFIFunction* self, Napi::Env env, void* return_data);
+
+  static ArgMarshaler SelectArgMarshaler(CType type);
+  ReturnConverter SelectReturnConverter() const;
+  template <CType T>
+  static bool MarshalPrimitiveArg(FFIFunction* self,
+                                  CallContext& ctx,
+                                  size_t index,
+                                  const Napi::Value& val,
+                                  uint8_t* slot);
+  static bool MarshalGenericArg(FFIFunction* self,
+                                CallContext& ctx,
+                                size_t index,
+                                const Napi::Value& val,
+                                uint8_t* slot);
+  static bool MarshalOutArg(FFIFunction* self, CallContext& ctx, size_t index, const Napi::Value& val, uint8_t* slot);
+  static Napi::Value ConvertStructReturnStep(FFIFunction* self, Napi::Env env, void* return_data);
+  static Napi::Value ConvertGenericReturnStep(FFIFunction* self, Napi::Env env, void* return_data);
+  // Tipi non primitivi (puntatori, stringhe, struct, array, extra variadici)
+  bool MarshalValue(CallContext& ctx, size_t index, CType type, const Napi::Value& val, uint8_t* slot);
+
+  std::vector<ArgMarshaler> arg_marshalers_;
+  ReturnConverter return_converter_;
+
   // Per-section helpers for Call(). `always_inline` marcato sulla definition
   // (vedi function.cc) — vengono chiamati esattamente una volta dal
   // caller, l'overhead di call erode il hot path FFI.
@@ -133,89 +265,147 @@ class FFIFunction : public Napi::ObjectWrap<FFIFunction> {
   // valida info.Length() vs arg_types_.size(), produce argc effettivo
   // e flag is_variadic. In caso di errore, throws JS exception e
   // ritorna false (caller deve restituire env.Undefined()).
+  // `first_arg`: argomenti JS che precedono quelli della funzione C.
   bool ValidateAndResolveArgc(Napi::Env env,
                               const Napi::CallbackInfo& info,
                               size_t& out_argc,
-                              bool& out_is_variadic) const;
-  // Risolve il CType di un argomento all'indice `i` nel contesto corrente.
-  // Estrae la logica duplicata tra il loop di pre-reserve string buffer e
-  // il loop di marshalling.
-  inline CType ResolveArgType(const CallContext& ctx, size_t i,
-                              const CType* extra_types_stack,
-                              const std::vector<CType>& extra_types_heap) const;
-
+                              bool& out_is_variadic,
+                              size_t first_arg = 0) const;
   // Thin wrapper that calls ConvertReturn with member state
   inline Napi::Value ConvertReturnValue(Napi::Env env) {
     return ConvertReturn(env, &return_value_, return_type_, return_struct_info_, return_array_info_);
   }
 
   // ============================================================
-  // Nested async worker for CallAsync (no separate files)
+  // Nested async worker for CallAsync (no separate files).
+  // Gira sul CallPool dell'addon (vedi pool.h), non sul threadpool libuv.
+  //
+  // È anche il "frame" della call: ogni FFIFunction tiene un piccolo pool
+  // di worker riusabili (free_workers_) e Recycle() ci rimette il frame
+  // invece di distruggerlo. I buffer vengono svuotati ma conservano la
+  // capacity, quindi a regime una callAsync non alloca nulla lato C++
+  // (restano solo gli oggetti JS: Promise e riferimenti ai Buffer).
   // ============================================================
-  class CallWorker : public Napi::AsyncWorker {
+  class CallWorker : public PoolJob {
    public:
-    CallWorker(Napi::Env env,
-               FFIFunction* ffi_function,
-               ffi_cif* cif,
-               void* fn_ptr,
-               CType return_type,
-               std::shared_ptr<StructInfo> return_struct_info,
-               std::shared_ptr<ArrayInfo> return_array_info,
-               std::vector<uint8_t>&& arg_storage,
-               std::vector<void*>&& arg_values,
-               std::vector<char>&& string_buffer,
-               std::vector<std::pair<size_t, size_t>>&& string_fixups,
-               std::vector<std::pair<size_t, size_t>>&& wstring_fixups,
-               std::vector<Napi::ObjectReference>&& buffer_refs,
-               std::unique_ptr<ffi_cif>&& owned_cif,
-               std::vector<ffi_type*>&& owned_ffi_types,
-               std::vector<std::vector<uint8_t>>&& large_arg_buffers,
-               std::vector<size_t>&& large_arg_indices,
-               Napi::FunctionReference* errcheck_ref);
-    ~CallWorker();
+    explicit CallWorker(FFIFunction* ffi_function);
 
     void Execute() override;
-    void OnOK() override;
-    void OnError(const Napi::Error& error) override;
-    Napi::Promise GetPromise() { return deferred_.Promise(); }
+    void Complete(Napi::Env env) override;
+    void Recycle() override;
 
    private:
+    friend class FFIFunction;  // CallAsync / Submit marshallano direttamente nel frame
+
+    // Main thread: dimensiona l'arena per `argc` argomenti e pinna il parent
+    void Begin(size_t argc);
+    // Main thread, a marshalling finito: sistema i puntatori a stringa
+    // (string_buffer_ può essere stato riallocato durante il riempimento)
     void FixupPointers();
+    void OnOK(Napi::Env env);
 
     FFIFunction* ffi_function_;
     ffi_cif* active_cif_;
-    void* fn_ptr_;
-    CType return_type_;
-    std::shared_ptr<StructInfo> return_struct_info_;
-    std::shared_ptr<ArrayInfo> return_array_info_;
     alignas(16) ReturnValue return_value_;
-    std::vector<uint8_t> arg_storage_;
-    std::vector<void*> arg_values_;
+    // Arena contigua: [argc slot da ARG_SLOT_SIZE][argc void*]. Dimensionata
+    // alla costruzione sull'arity dichiarata, cresce solo per i variadici.
+    std::vector<uint8_t> arena_;
+    void** arg_values_;
+    size_t argc_;
+    std::vector<CType> extra_types_;  // tipi inferiti degli argomenti variadici
     std::vector<char> string_buffer_;
     std::vector<std::pair<size_t, size_t>> string_fixups_;
     std::vector<std::pair<size_t, size_t>> wstring_fixups_;
     std::vector<Napi::ObjectReference> buffer_refs_;
-    std::unique_ptr<ffi_cif> owned_cif_;
-    std::vector<ffi_type*> owned_ffi_types_;
-    std::vector<std::vector<uint8_t>> large_arg_buffers_;  // overflow for struct/array > ARG_SLOT_SIZE
-    std::vector<size_t> large_arg_indices_;                // which arg slots use large_arg_buffers_ (in order)
+    std::shared_ptr<PreparedSignature> variadic_sig_;  // CIF della call variadica (dalla cache LRU)
+    AggregateArena aggregates_;                            // struct/array > ARG_SLOT_SIZE (vedi AggregateArena)
     std::vector<uint8_t> return_buffer_;                   // for struct/array returns > sizeof(ReturnValue)
     void* return_ptr_;                                     // &return_value_ or return_buffer_.data()
-    Napi::Promise::Deferred deferred_;
+    std::optional<Napi::Promise::Deferred> deferred_;      // creato per-call, a marshalling riuscito
     Napi::FunctionReference* errcheck_ref_;
+    Napi::Reference<Napi::Array> args_ref_;  // argomenti JS per errcheck / policy (solo se impostati)
+    std::string error_;  // impostato da Execute() (worker thread)
+    int errno_value_ = 0;        // snapshot per la policy (se use_errno)
+    uint32_t last_error_ = 0;    // snapshot per la policy (se use_last_error)
+    // submit(): destinazione del risultato al posto di deferred_
+    CompletionRing* ring_ = nullptr;
+    double ring_tag_ = 0;
+    RingValueFormat ring_format_ = RingValueFormat::VOID;
   };
 
+  // Marshalling di CallAsync / Submit nel frame (vedi function.cc)
+  CallWorker* MarshalAsyncFrame(const Napi::CallbackInfo& info, size_t first_arg, const char* api);
+
+  // ============================================================
+  // Batch colonnari (callBatch / mapAsync)
+  // ============================================================
+  // Colonna "viva": sorgente + stride + slot di destinazione
+  struct BatchColumn {
+    const uint8_t* data;
+    size_t stride;
+    uint8_t* slot;
+  };
+  bool MarshalBatchColumns(Napi::Env env,
+                           Napi::Array columns,
+                           size_t count,
+                           uint8_t* arg_storage,
+                           std::vector<BatchColumn>& live_columns,
+                           std::vector<Napi::ObjectReference>* pins,
+                           const char* api);
+  bool PrepareBatchOutput(Napi::Env env,
+                          Napi::Value out_arg,
+                          size_t count,
+                          Napi::Value& out,
+                          uint8_t*& out_data,
+                          const char* api);
+  // Offset del valore di ritorno dentro ReturnValue (big-endian, vedi .cc)
+  size_t BatchReturnOffset() const;
+
+  // Stato condiviso dai chunk di una mapAsync (definito in function.cc).
+  // Vive finché l'ultimo chunk non è riciclato, sempre sul main thread.
+  struct MapBatch;
+
+  // Un chunk [begin, end) di una mapAsync: storage degli argomenti proprio
+  // (copia degli slot scalari), colonne e output condivisi con gli altri
+  // chunk, che scrivono su righe disgiunte.
+  class MapChunk : public PoolJob {
+   public:
+    MapChunk(std::shared_ptr<MapBatch> batch, size_t begin, size_t end);
+
+    void Execute() override;
+    void Complete(Napi::Env env) override;
+    void Recycle() override;
+
+   private:
+    std::shared_ptr<MapBatch> batch_;
+    size_t begin_;
+    size_t end_;
+    std::vector<uint8_t> arg_storage_;
+    std::vector<void*> arg_values_;
+    std::string error_;  // impostato da Execute() (worker thread)
+  };
+
+  // Pool dei frame async (solo main thread: acquire in CallAsync, release
+  // nel drain del CallPool)
+  CallWorker* AcquireCallWorker(size_t argc);
+  void ReleaseCallWorker(CallWorker* worker);
+  std::vector<std::unique_ptr<CallWorker>> free_workers_;
+
   void* fn_ptr_;
   std::string name_;
 
-  // FFI stuff
-  ffi_cif cif_;
+  // FFI stuff. Il CIF è condiviso tra tutte le FFIFunction con la stessa
+  // signature (vedi signature.h); cif_ punta dentro signature_.
+  std::shared_ptr<PreparedSignature> signature_;
+  ffi_cif* cif_;
   bool cif_prepared_;
   ffi_abi abi_;
 
   // Tipi
   CType return_type_;
   std::vector<CType> arg_types_;
+  // Opzione `pointerMode`: rappresentazione dei ritorni puntatore / 64 bit
+  PointerMode pointer_mode_;
 
   // Struct/Array info per argomenti e return (se STRUCT/UNION/ARRAY)
   std::shared_ptr<StructInfo> return_struct_info_;
@@ -223,52 +413,73 @@ class FFIFunction : public Napi::ObjectWrap<FFIFunction> {
   std::vector<std::shared_ptr<StructInfo>> arg_struct_infos_;
   std::vector<std::shared_ptr<ArrayInfo>> arg_array_infos_;
 
-  // Cache dei tipi FFI
-  ffi_type* ffi_return_type_;
-  std::vector<ffi_type*> ffi_arg_types_;
-
   // ============================================================
-  // Buffer pre-allocati per evitare allocazioni in Call()
+  // Buffer per-call riusati da Call() / CallBatch()
+  //
+  // Allocati alla prima call sul path libffi (EnsureScratch): molte
+  // FFIFunction di un binding non vengono mai chiamate, e quelle coperte
+  // dai trampolini non ne hanno bisogno.
   // ============================================================
 
-  // Buffer inline per argomenti (fino a MAX_INLINE_ARGS)
-  alignas(16) uint8_t inline_arg_storage_[MAX_INLINE_ARGS * ARG_SLOT_SIZE];
-  void* inline_arg_values_[MAX_INLINE_ARGS];
+  static constexpr size_t kInlineStringBufferSize = 512;
+  struct CallScratch {
+    // Buffer inline per argomenti (fino a MAX_INLINE_ARGS)
+    alignas(16) uint8_t arg_storage[MAX_INLINE_ARGS * ARG_SLOT_SIZE];
+    void* arg_values[MAX_INLINE_ARGS];
+    // SBO per stringhe: buffer inline per stringhe corte
+    alignas(16) char string_buffer[kInlineStringBufferSize];
+  };
+  std::unique_ptr<CallScratch> scratch_;
+  size_t inline_string_offset_;  // Offset corrente in scratch_->string_buffer
+
+  inline CallScratch& EnsureScratch() {
+    if (!scratch_) [[unlikely]] {
+      scratch_ = std::make_unique<CallScratch>();
+    }
+    return *scratch_;
+  }
 
   // Union per return value (ottimizza cache locality)
   alignas(16) ReturnValue return_value_;
 
-  // SBO per stringhe: buffer inline per stringhe corte
-  static constexpr size_t kInlineStringBufferSize = 512;
-  alignas(16) char inline_string_buffer_[kInlineStringBufferSize];
-  size_t inline_string_offset_;  // Offset corrente nel buffer inline
-
-  // Buffer per stringhe lunghe (fallback quando inline esaurisce)
+  // Buffer per stringhe lunghe (fallback quando inline esaurisce) e
+  // (slot, offset) dei puntatori da scrivere a marshalling finito
   std::vector<char> string_buffer_;
+  std::vector<std::pair<size_t, size_t>> string_fixups_;
 
   // Heap fallback per molti argomenti
   std::vector<uint8_t> heap_arg_storage_;
   std::vector<void*> heap_arg_values_;
 
-  // Overflow buffers for struct/array args > ARG_SLOT_SIZE (sync path)
-  std::vector<std::vector<uint8_t>> sync_large_arg_buffers_;
-
-  // Return buffer for struct/array returns > sizeof(ReturnValue) (sync path)
-  std::vector<uint8_t> sync_return_buffer_;
+  // Struct/array args > ARG_SLOT_SIZE e return > sizeof(ReturnValue) (sync
+  // path). Capacità dai layout della signature: aggregate_arena_bytes_.
+  AggregateArena sync_aggregates_;
+  size_t aggregate_arena_bytes_ = 0;  // solo argomenti (i frame async hanno il loro return_buffer_)
+  size_t large_return_size_ = 0;      // 0 se il ritorno sta in ReturnValue
 
   // Flag per sapere se usare inline o heap
   bool use_inline_storage_;
 
+  // Trampolino specializzato (vedi trampoline.h). nullptr = path libffi.
+  // Scelto una volta in PrepareFFI, usato da Call() solo con argc esatto.
+  TrampolineFn trampoline_;
+  TrampolinePlan trampoline_plan_;
+
   // Precalcolati a construction time per saltare il setup per-call
   // quando la signature non ha argomenti stringa / struct / array / union.
   bool has_string_args_;        // almeno uno STRING/WSTRING in arg_types_
   bool has_struct_array_args_;  // almeno uno STRUCT/UNION/ARRAY in arg_types_
+  bool uses_aggregate_arena_ = false;  // argomenti o ritorno in sync_aggregates_
 
   // ============================================================
-  // Cache per CIF variadici (ottimizzazione chiamate ripetute)
+  // Cache LRU per CIF variadici, condivisa da Call() e CallAsync().
+  // Allocata alla prima call variadica.
   // ============================================================
-  VariadicCifCache variadic_cache_[MAX_CACHED_VARIADIC_CIFS];
-  size_t next_cache_slot_;  // Round-robin replacement
+  std::unique_ptr<VariadicSignatureCache> variadic_cache_;
+
+  // CIF variadico per gli argomenti extra `extra_types`; nullptr con
+  // eccezione JS pendente se ffi_prep_cif_var fallisce.
+  std::shared_ptr<PreparedSignature> GetVariadicSignature(Napi::Env env, const CType* extra_types, size_t num_extra);
 
   // ============================================================
   // Error checking callback (Python ctypes errcheck)
@@ -278,6 +489,35 @@ class FFIFunction : public Napi::ObjectWrap<FFIFunction> {
   // Helper per applicare errcheck callback
   Napi::Value ApplyErrcheck(Napi::Env env, Napi::Value result, const Napi::CallbackInfo& info);
 
+  // ============================================================
+  // Errcheck dichiarativo (setErrcheckPolicy): il predicato sul valore di
+  // ritorno è valutato qui, senza chiamare JS. Solo quando la call
+  // fallisce si chiama la factory JS error(code, result, func, args) e se
+  // ne lancia il risultato; il codice viene dal ritorno stesso o dagli
+  // snapshot di errno / last-error.
+  // ============================================================
+  ErrcheckFail errcheck_fail_ = ErrcheckFail::NONE;  // NONE: nessuna policy
+  ErrcheckCode errcheck_code_ = ErrcheckCode::RESULT;
+  Napi::FunctionReference errcheck_error_;
+
+  // Errore della factory per una call fallita (`args`: array degli
+  // argomenti JS); se la factory lancia, l'eccezione stessa.
+  Napi::Value ErrcheckPolicyError(Napi::Env env, Napi::Value result, Napi::Value args, int errno_value,
+                                  uint32_t last_error);
+  // Path sync: false con eccezione JS pendente se la policy fallisce
+  bool ApplyErrcheckPolicy(Napi::Env env, Napi::Value result, const Napi::CallbackInfo& info);
+
+  // ============================================================
+  // Struct return lazy (opzione `struct_view`): invece di costruire
+  // l'oggetto con StructToJS, i byte della struct vengono copiati una
+  // volta in un Buffer e passati a struct_view_, che ritorna la view JS
+  // (accessor che decodificano i campi solo quando vengono letti).
+  // ============================================================
+  Napi::FunctionReference struct_view_;
+
+  // Return CTYPES_STRUCT via struct_view_ (se impostata) o ConvertReturn
+  Napi::Value ConvertStructReturn(Napi::Env env, void* return_data);
+
   // ============================================================
   // Cattura last-error / errno (parity Python use_last_error / use_errno).
   // Snapshot subito dopo ffi_call così il codice successivo non può
@@ -288,6 +528,45 @@ class FFIFunction : public Napi::ObjectWrap<FFIFunction> {
   uint32_t last_error_;      // DWORD-like (unsigned), parity Win32
   int last_errno_;           // errno è int in POSIX
 
+  // ============================================================
+  // Out param nativi (opzione `outParams`, solo tipi primitivi).
+  // L'argomento `index` non legge il valore JS: riceve il puntatore a una
+  // cella di out_storage_, azzerata a ogni call, e dopo la call il valore
+  // puntato finisce in out_values_ (stesso array a ogni call, un elemento
+  // per out param). Niente Buffer per call; le celle sono per-funzione,
+  // quindi callAsync / callBatch rifiutano le funzioni con out param.
+  // ============================================================
+  struct OutParam {
+    size_t index;  // argomento dichiarato (POINTER)
+    CType type;    // tipo puntato
+  };
+  std::vector<OutParam> out_params_;
+  std::vector<uint64_t> out_storage_;  // una cella (8 byte) per out param
+  Napi::Reference<Napi::Array> out_values_;
+
+  bool ParseOutParams(Napi::Env env, const Napi::Value& value);
+  void StoreOutValues(Napi::Env env);
+
+  // Coda seriale del CallPool (opzione `queue`): nullptr = fan-out sul pool.
+  // Condivisa tra tutte le FFIFunction di una Library aperta con serial: true.
+  std::shared_ptr<SerialQueue> serial_queue_;
+
+  // ============================================================
+  // Strumentazione opt-in (vedi stats.h). stats_ viene allocato alla
+  // prima call misurata e registrato nell'addon per lo snapshot.
+  // ============================================================
+  bool stats_enabled_;  // opzione `stats`
+  std::unique_ptr<CallStats> stats_;
+
+  // Statistiche della call corrente, nullptr se la strumentazione è spenta
+  CTYPES_ALWAYS_INLINE CallStats* ActiveStats() {
+    if (!stats_enabled_ && !addon_->stats_enabled) [[likely]] {
+      return nullptr;
+    }
+    return EnsureStats();
+  }
+  CallStats* EnsureStats();
+
   // Cached addon pointer (avoid GetInstanceData<>() map lookup on every call).
   // CTypesAddon lives in env instance data; lifetime >= this object's lifetime.
   CTypesAddon* addon_;
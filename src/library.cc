@@ -2,6 +2,7 @@
 
 #include "addon.h"
 #include "function.h"
+#include "registry.h"
 
 namespace ctypes {
 
@@ -96,6 +97,7 @@ Napi::Function Library::GetClass(Napi::Env env) {
   return DefineClass(env, "Library",
                      {
                        InstanceMethod("func", &Library::GetFunction),
+                       InstanceMethod("bindAll", &Library::BindAll),
                        InstanceMethod("callback", &Library::GetCallback),
                        InstanceMethod("symbol", &Library::GetSymbol),
                        InstanceMethod("close", &Library::Close),
@@ -162,9 +164,9 @@ Library::Library(const Napi::CallbackInfo& info)
       Napi::Error::New(env, std::format("Failed to set DLL directory: {}", ex.what())).ThrowAsJavaScriptException();
       return;
     }
-    handle_ = LoadSharedLibrary(path_, error);
+    handle_ = AcquireSharedLibrary(path_, error);
 #else
-    handle_ = LoadSharedLibrary(path_, error);
+    handle_ = AcquireSharedLibrary(path_, error);
 #endif
   }
 
@@ -180,7 +182,7 @@ Library::Library(const Napi::CallbackInfo& info)
 
 Library::~Library() {
   if (is_loaded_ && handle_ && !path_.empty()) {
-    CloseSharedLibrary(handle_);
+    ReleaseSharedLibrary(path_);
   }
 }
 
@@ -207,7 +209,7 @@ Napi::Value Library::GetFunction(const Napi::CallbackInfo& info) {
 
   // Trova il simbolo
   std::string error;
-  void* fn_ptr = GetSymbolAddress(handle_, name, error);
+  void* fn_ptr = ResolveSymbol(name, error);
 
   if (!fn_ptr) {
     Napi::Error::New(env, std::format("Symbol '{}' not found{}", name, error.empty() ? "" : std::format(": {}", error)))
@@ -215,34 +217,102 @@ Napi::Value Library::GetFunction(const Napi::CallbackInfo& info) {
     return env.Undefined();
   }
 
-  // Crea l'oggetto FFIFunction
-  // Passiamo: fn_ptr (come External), returnType, argTypes
-  std::vector<napi_value> args;
-  args.push_back(Napi::External<void>::New(env, fn_ptr));
-  args.push_back(Napi::String::New(env, name));
+  return NewFunction(env, fn_ptr, name, info[1], info.Length() > 2 ? info[2] : env.Undefined(),
+                     info.Length() > 3 ? info[3] : env.Undefined());
+}
 
-  // Return type
-  args.push_back(info[1]);
+Napi::Value Library::BindAll(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
 
-  // Arg types (se presenti)
-  if (info.Length() > 2) {
-    args.push_back(info[2]);
-  } else {
-    args.push_back(Napi::Array::New(env, 0));
+  if (!is_loaded_) {
+    Napi::Error::New(env, "Library is not loaded").ThrowAsJavaScriptException();
+    return env.Undefined();
   }
 
-  // Options (se presenti)
-  if (info.Length() > 3) {
-    args.push_back(info[3]);
+  if (info.Length() < 1 || !info[0].IsArray()) {
+    Napi::TypeError::New(env, "bindAll requires an array of { name, restype, argtypes, options }")
+      .ThrowAsJavaScriptException();
+    return env.Undefined();
   }
 
+  Napi::Array specs = info[0].As<Napi::Array>();
+  const uint32_t count = specs.Length();
+  Napi::Array result = Napi::Array::New(env, count);
+  std::string error;
+
+  for (uint32_t i = 0; i < count; i++) {
+    Napi::Value spec_val = specs.Get(i);
+    if (!spec_val.IsObject()) {
+      Napi::TypeError::New(env, std::format("bindAll: entry {} must be an object", i)).ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    Napi::Object spec = spec_val.As<Napi::Object>();
+
+    Napi::Value name_val = spec.Get("name");
+    if (!name_val.IsString()) {
+      Napi::TypeError::New(env, std::format("bindAll: entry {} requires a string name", i))
+        .ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    std::string name = name_val.As<Napi::String>().Utf8Value();
+
+    error.clear();
+    void* fn_ptr = ResolveSymbol(name, error);
+    if (!fn_ptr) {
+      Napi::Error::New(env, std::format("bindAll: symbol '{}' not found{}", name,
+                                        error.empty() ? "" : std::format(": {}", error)))
+        .ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+
+    Napi::Value fn = NewFunction(env, fn_ptr, name, spec.Get("restype"), spec.Get("argtypes"), spec.Get("options"));
+    if (env.IsExceptionPending()) {
+      return env.Undefined();
+    }
+    result.Set(i, fn);
+  }
+
+  return result;
+}
+
+void* Library::ResolveSymbol(const std::string& name, std::string& error) {
+  auto it = symbols_.find(name);
+  if (it != symbols_.end()) {
+    return it->second;
+  }
+
+  void* addr = GetSymbolAddress(handle_, name, error);
+  if (addr) {
+    symbols_.emplace(name, addr);
+  }
+  return addr;
+}
+
+Napi::Value Library::NewFunction(Napi::Env env,
+                                 void* fn_ptr,
+                                 const std::string& name,
+                                 Napi::Value return_type,
+                                 Napi::Value arg_types,
+                                 Napi::Value options) {
   // Ottieni il costruttore FFIFunction dall'addon
   CTypesAddon* addon = env.GetInstanceData<CTypesAddon>();
   if (!addon || !addon->FFIFunctionConstructor) {
     Napi::Error::New(env, "FFIFunction constructor not available").ThrowAsJavaScriptException();
     return env.Undefined();
   }
-  return addon->FFIFunctionConstructor->New(args);
+
+  // Argomenti del costruttore: fn_ptr (come External), nome, returnType,
+  // argTypes e options (se presenti)
+  napi_value args[5] = {
+    Napi::External<void>::New(env, fn_ptr),
+    Napi::String::New(env, name),
+    return_type,
+    arg_types.IsUndefined() ? Napi::Array::New(env, 0) : arg_types,
+    options,
+  };
+  const size_t argc = options.IsUndefined() ? 4 : 5;
+
+  return addon->FFIFunctionConstructor->New(argc, args);
 }
 
 Napi::Value Library::GetSymbol(const Napi::CallbackInfo& info) {
@@ -261,7 +331,7 @@ Napi::Value Library::GetSymbol(const Napi::CallbackInfo& info) {
   std::string name = info[0].As<Napi::String>().Utf8Value();
 
   std::string error;
-  void* sym_ptr = GetSymbolAddress(handle_, name, error);
+  void* sym_ptr = ResolveSymbol(name, error);
 
   if (!sym_ptr) {
     Napi::Error::New(env, std::format("Symbol '{}' not found{}", name, error.empty() ? "" : std::format(": {}", error)))
@@ -277,9 +347,10 @@ Napi::Value Library::Close(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
 
   if (is_loaded_ && handle_ && !path_.empty()) {
-    CloseSharedLibrary(handle_);
+    ReleaseSharedLibrary(path_);
     handle_ = nullptr;
     is_loaded_ = false;
+    symbols_.clear();
   }
 
   return env.Undefined();
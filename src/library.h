@@ -29,6 +29,10 @@ class Library : public Napi::ObjectWrap<Library> {
   // Ottiene un puntatore a funzione
   Napi::Value GetFunction(const Napi::CallbackInfo& info);
 
+  // bindAll([{ name, restype, argtypes, options }]) -> FFIFunction[]:
+  // risolve e prepara un intero manifest in un solo crossing
+  Napi::Value BindAll(const Napi::CallbackInfo& info);
+
   // Ottiene un callback
   Napi::Value GetCallback(const Napi::CallbackInfo& info);
 
@@ -43,9 +47,23 @@ class Library : public Napi::ObjectWrap<Library> {
   Napi::Value GetIsLoaded(const Napi::CallbackInfo& info);
 
  private:
+  // dlsym / GetProcAddress tramite la tabella dei simboli della libreria
+  void* ResolveSymbol(const std::string& name, std::string& error);
+
+  // Costruisce una FFIFunction per fn_ptr (firma come func())
+  Napi::Value NewFunction(Napi::Env env,
+                          void* fn_ptr,
+                          const std::string& name,
+                          Napi::Value return_type,
+                          Napi::Value arg_types,
+                          Napi::Value options);
+
   void* handle_;
   std::string path_;
   bool is_loaded_;
+  // Simboli già risolti: func() / symbol() / bindAll() ripetuti sullo stesso
+  // nome non rientrano nel loader. Svuotata da close().
+  std::unordered_map<std::string, void*> symbols_;
 #ifdef _WIN32
   std::unique_ptr<void, DllDirectoryDeleter> m_dll_directory_cookie;
 #endif
@@ -0,0 +1,331 @@
+#include "manifest.h"
+
+#include "addon.h"
+#include "array.h"
+#include "struct.h"
+
+namespace ctypes {
+
+static constexpr uint32_t kManifestVersion = 1;
+
+// ============================================================================
+// Generazione
+// ============================================================================
+
+// Emette i tipi in ordine di dipendenza: nested / element prima del tipo
+// che li usa, ognuno una sola volta (identità di StructInfo / ArrayInfo).
+class ManifestWriter {
+ public:
+  explicit ManifestWriter(Napi::Env env) : env_(env), types_(Napi::Array::New(env)) {}
+
+  uint32_t AddStruct(const std::shared_ptr<StructInfo>& info) {
+    auto it = index_.find(info.get());
+    if (it != index_.end()) {
+      return it->second;
+    }
+
+    const auto& fields = info->GetFields();
+    Napi::Array js_fields = Napi::Array::New(env_, fields.size());
+    for (size_t i = 0; i < fields.size(); i++) {
+      const FieldInfo& field = fields[i];
+      Napi::Object js_field = Napi::Object::New(env_);
+      js_field.Set("name", Napi::String::New(env_, field.name));
+      js_field.Set("type", TypeRef(field.type, field.struct_type, field.array_type));
+      js_field.Set("offset", Napi::Number::New(env_, static_cast<double>(field.offset)));
+      if (field.is_anonymous) {
+        js_field.Set("anonymous", Napi::Boolean::New(env_, true));
+      }
+      js_fields.Set(static_cast<uint32_t>(i), js_field);
+    }
+
+    Napi::Object entry = Napi::Object::New(env_);
+    entry.Set("kind", Napi::String::New(env_, info->IsUnion() ? "union" : "struct"));
+    entry.Set("size", Napi::Number::New(env_, static_cast<double>(info->GetSize())));
+    entry.Set("alignment", Napi::Number::New(env_, static_cast<double>(info->GetAlignment())));
+    entry.Set("fields", js_fields);
+    return Push(info.get(), entry);
+  }
+
+  uint32_t AddArray(const std::shared_ptr<ArrayInfo>& info) {
+    auto it = index_.find(info.get());
+    if (it != index_.end()) {
+      return it->second;
+    }
+
+    Napi::Object entry = Napi::Object::New(env_);
+    entry.Set("kind", Napi::String::New(env_, "array"));
+    entry.Set("element", TypeRef(info->GetElementType(), info->GetElementStruct(), nullptr));
+    entry.Set("length", Napi::Number::New(env_, static_cast<double>(info->GetCount())));
+    if (info->IsTyped()) {
+      entry.Set("typed", Napi::Boolean::New(env_, true));
+    }
+    return Push(info.get(), entry);
+  }
+
+  Napi::Array Types() const { return types_; }
+
+ private:
+  Napi::Value TypeRef(CType type, const std::shared_ptr<StructInfo>& nested, const std::shared_ptr<ArrayInfo>& array) {
+    if (!nested && !array) {
+      return Napi::Number::New(env_, static_cast<int32_t>(type));
+    }
+    Napi::Object ref = Napi::Object::New(env_);
+    ref.Set("ref", Napi::Number::New(env_, nested ? AddStruct(nested) : AddArray(array)));
+    return ref;
+  }
+
+  uint32_t Push(const void* key, const Napi::Object& entry) {
+    uint32_t index = types_.Length();
+    types_.Set(index, entry);
+    index_.emplace(key, index);
+    return index;
+  }
+
+  Napi::Env env_;
+  Napi::Array types_;
+  std::unordered_map<const void*, uint32_t> index_;
+};
+
+Napi::Value DescribeTypes(Napi::Env env, const Napi::Array& types) {
+  ManifestWriter writer(env);
+  Napi::Array roots = Napi::Array::New(env, types.Length());
+
+  for (uint32_t i = 0; i < types.Length(); i++) {
+    Napi::Value elem = types.Get(i);
+    uint32_t index;
+    if (elem.IsObject() && IsStructType(elem.As<Napi::Object>())) {
+      index = writer.AddStruct(Napi::ObjectWrap<StructType>::Unwrap(elem.As<Napi::Object>())->GetStructInfo());
+    } else if (elem.IsObject() && IsArrayType(elem.As<Napi::Object>())) {
+      index = writer.AddArray(Napi::ObjectWrap<ArrayType>::Unwrap(elem.As<Napi::Object>())->GetArrayInfo());
+    } else {
+      Napi::TypeError::New(env, std::format("Type at index {} must be a StructType or ArrayType", i))
+        .ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    roots.Set(i, Napi::Number::New(env, index));
+  }
+
+  Napi::Object manifest = Napi::Object::New(env);
+  manifest.Set("version", Napi::Number::New(env, kManifestVersion));
+  manifest.Set("pointerSize", Napi::Number::New(env, static_cast<double>(sizeof(void*))));
+  manifest.Set("wcharSize", Napi::Number::New(env, static_cast<double>(sizeof(wchar_t))));
+  manifest.Set("longSize", Napi::Number::New(env, static_cast<double>(sizeof(long))));
+  manifest.Set("types", writer.Types());
+  manifest.Set("roots", roots);
+  return manifest;
+}
+
+// ============================================================================
+// Caricamento
+// ============================================================================
+
+static void ThrowManifestError(Napi::Env env, const std::string& message) {
+  Napi::Error::New(env, std::format("Invalid manifest: {}", message)).ThrowAsJavaScriptException();
+}
+
+// Intero non negativo (offset, size, indici)
+static bool GetIndex(const Napi::Value& value, size_t& out) {
+  if (!value.IsNumber()) {
+    return false;
+  }
+  double d = value.As<Napi::Number>().DoubleValue();
+  if (d < 0 || std::floor(d) != d || d > static_cast<double>(1ULL << 53)) {
+    return false;
+  }
+  out = static_cast<size_t>(d);
+  return true;
+}
+
+// Risolve `type` / `element`: CType primitivo o { ref } a un tipo già
+// caricato. Riempie type / struct_type / array_type / size di `field`;
+// `resolved` è il valore accettato da addField / new ArrayType.
+static bool ResolveTypeRef(Napi::Env env,
+                           const Napi::Value& value,
+                           const std::vector<Napi::Object>& loaded,
+                           const std::string& where,
+                           FieldInfo& field,
+                           Napi::Value& resolved) {
+  if (value.IsNumber()) {
+    try {
+      field.type = IntToCType(value.As<Napi::Number>().Int32Value());
+    } catch (const std::exception& e) {
+      ThrowManifestError(env, std::format("{}: {}", where, e.what()));
+      return false;
+    }
+    if (field.type == CType::CTYPES_STRUCT || field.type == CType::CTYPES_ARRAY) {
+      ThrowManifestError(env, std::format("{}: struct / array types must be given as {{ ref }}", where));
+      return false;
+    }
+    field.size = CTypeSize(field.type);
+    resolved = value;
+    return true;
+  }
+
+  size_t ref;
+  if (!value.IsObject() || !GetIndex(value.As<Napi::Object>().Get("ref"), ref) || ref >= loaded.size()) {
+    ThrowManifestError(env, std::format("{}: type must be a CType value or {{ ref }} to an earlier type", where));
+    return false;
+  }
+
+  const Napi::Object& target = loaded[ref];
+  if (IsStructType(target)) {
+    field.type = CType::CTYPES_STRUCT;
+    field.struct_type = Napi::ObjectWrap<StructType>::Unwrap(target)->GetStructInfo();
+    field.size = field.struct_type->GetSize();
+  } else {
+    field.type = CType::CTYPES_ARRAY;
+    field.array_type = Napi::ObjectWrap<ArrayType>::Unwrap(target)->GetArrayInfo();
+    field.size = field.array_type->GetSize();
+  }
+  resolved = target;
+  return true;
+}
+
+static Napi::Value LoadStruct(Napi::Env env,
+                              CTypesAddon* addon,
+                              const Napi::Object& entry,
+                              bool is_union,
+                              const std::vector<Napi::Object>& loaded,
+                              size_t index) {
+  size_t size, alignment;
+  Napi::Value fields_val = entry.Get("fields");
+  if (!GetIndex(entry.Get("size"), size) || !GetIndex(entry.Get("alignment"), alignment) || !fields_val.IsArray()) {
+    ThrowManifestError(env, std::format("types[{}] requires size, alignment and fields", index));
+    return env.Undefined();
+  }
+
+  Napi::Array js_fields = fields_val.As<Napi::Array>();
+  std::vector<FieldInfo> fields;
+  fields.reserve(js_fields.Length());
+  for (uint32_t i = 0; i < js_fields.Length(); i++) {
+    std::string where = std::format("types[{}].fields[{}]", index, i);
+    Napi::Value js_field_val = js_fields.Get(i);
+    if (!js_field_val.IsObject()) {
+      ThrowManifestError(env, std::format("{} must be an object", where));
+      return env.Undefined();
+    }
+    Napi::Object js_field = js_field_val.As<Napi::Object>();
+
+    FieldInfo field;
+    Napi::Value name = js_field.Get("name");
+    if (!name.IsString() || !GetIndex(js_field.Get("offset"), field.offset)) {
+      ThrowManifestError(env, std::format("{} requires name and offset", where));
+      return env.Undefined();
+    }
+    field.name = name.As<Napi::String>().Utf8Value();
+    field.is_anonymous = js_field.Get("anonymous").ToBoolean();
+    Napi::Value resolved;
+    if (!ResolveTypeRef(env, js_field.Get("type"), loaded, where, field, resolved)) {
+      return env.Undefined();
+    }
+    if (field.is_anonymous && !field.struct_type) {
+      ThrowManifestError(env, std::format("{}: only struct / union fields can be anonymous", where));
+      return env.Undefined();
+    }
+    fields.push_back(std::move(field));
+  }
+
+  Napi::Object options = Napi::Object::New(env);
+  options.Set("union", Napi::Boolean::New(env, is_union));
+  Napi::Object obj = addon->StructTypeConstructor->New({options});
+  StructType* st = Napi::ObjectWrap<StructType>::Unwrap(obj);
+  if (!st->GetStructInfo()->SetLayout(std::move(fields), size, alignment)) {
+    ThrowManifestError(env, std::format("types[{}]: layout does not match the field types on this platform", index));
+    return env.Undefined();
+  }
+  return obj;
+}
+
+static Napi::Value LoadArray(Napi::Env env,
+                             CTypesAddon* addon,
+                             const Napi::Object& entry,
+                             const std::vector<Napi::Object>& loaded,
+                             size_t index) {
+  size_t length;
+  if (!GetIndex(entry.Get("length"), length)) {
+    ThrowManifestError(env, std::format("types[{}] requires a length", index));
+    return env.Undefined();
+  }
+
+  FieldInfo element;
+  Napi::Value element_val;
+  std::string where = std::format("types[{}].element", index);
+  if (!ResolveTypeRef(env, entry.Get("element"), loaded, where, element, element_val)) {
+    return env.Undefined();
+  }
+  if (element.array_type) {
+    ThrowManifestError(env, std::format("{}: arrays of arrays are not supported", where));
+    return env.Undefined();
+  }
+
+  // Stesso costruttore di `new ArrayType(element, length, { typed })`
+  Napi::Object options = Napi::Object::New(env);
+  options.Set("typed", entry.Get("typed").ToBoolean());
+  return addon->ArrayTypeConstructor->New({element_val, Napi::Number::New(env, static_cast<double>(length)), options});
+}
+
+Napi::Value LoadTypes(Napi::Env env, const Napi::Object& manifest) {
+  CTypesAddon* addon = env.GetInstanceData<CTypesAddon>();
+  if (!addon || !addon->StructTypeConstructor || !addon->ArrayTypeConstructor) {
+    Napi::Error::New(env, "StructType / ArrayType constructors not available").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  size_t version;
+  if (!GetIndex(manifest.Get("version"), version) || version != kManifestVersion) {
+    ThrowManifestError(env, std::format("unsupported version (expected {})", kManifestVersion));
+    return env.Undefined();
+  }
+
+  // Layout calcolati altrove valgono solo con gli stessi modelli di dati
+  static constexpr std::pair<const char*, size_t> kPlatformSizes[] = {
+    {"pointerSize", sizeof(void*)},
+    {"wcharSize", sizeof(wchar_t)},
+    {"longSize", sizeof(long)},
+  };
+  for (const auto& [key, expected] : kPlatformSizes) {
+    size_t actual;
+    if (!GetIndex(manifest.Get(key), actual) || actual != expected) {
+      ThrowManifestError(env, std::format("generated for a different platform ({} is not {})", key, expected));
+      return env.Undefined();
+    }
+  }
+
+  Napi::Value types_val = manifest.Get("types");
+  if (!types_val.IsArray()) {
+    ThrowManifestError(env, "types must be an array");
+    return env.Undefined();
+  }
+
+  Napi::Array types = types_val.As<Napi::Array>();
+  const uint32_t count = types.Length();
+  Napi::Array result = Napi::Array::New(env, count);
+  std::vector<Napi::Object> loaded;
+  loaded.reserve(count);
+
+  for (uint32_t i = 0; i < count; i++) {
+    Napi::Value entry_val = types.Get(i);
+    Napi::Value kind = entry_val.IsObject() ? entry_val.As<Napi::Object>().Get("kind") : env.Undefined();
+    std::string kind_str = kind.IsString() ? kind.As<Napi::String>().Utf8Value() : std::string();
+
+    Napi::Value obj;
+    if (kind_str == "struct" || kind_str == "union") {
+      obj = LoadStruct(env, addon, entry_val.As<Napi::Object>(), kind_str == "union", loaded, i);
+    } else if (kind_str == "array") {
+      obj = LoadArray(env, addon, entry_val.As<Napi::Object>(), loaded, i);
+    } else {
+      ThrowManifestError(env, std::format("types[{}].kind must be \"struct\", \"union\" or \"array\"", i));
+      return env.Undefined();
+    }
+    if (env.IsExceptionPending()) {
+      return env.Undefined();
+    }
+
+    loaded.push_back(obj.As<Napi::Object>());
+    result.Set(i, obj);
+  }
+
+  return result;
+}
+
+}  // namespace ctypes
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "shared.h"
+
+namespace ctypes {
+
+// ============================================================================
+// Binding manifest — layout di struct / union / array serializzati
+//
+// Definire i tipi a runtime significa rieseguire addField da JS per ogni
+// campo, e ogni addField ricalcola l'intero layout. Il manifest è un plain
+// object (JSON-serializzabile) generato una volta, per esempio a build time:
+//
+//   {
+//     version: 1, pointerSize, wcharSize, longSize,
+//     types: [
+//       { kind: "struct" | "union", size, alignment,
+//         fields: [{ name, type, offset, anonymous? }] },
+//       { kind: "array", element, length, typed? },
+//     ],
+//   }
+//
+// `type` / `element` sono un valore CType (number) oppure { ref: i }, con i
+// indice di un tipo precedente in `types` (le dipendenze vengono prima).
+// Il caricamento ricostruisce StructInfo / ArrayInfo con gli offset del
+// manifest (StructInfo::SetLayout) invece di ricalcolarli.
+//
+// I manifest dipendono dalla piattaforma: pointerSize / wcharSize /
+// longSize diversi da quelli del processo vengono rifiutati.
+// ============================================================================
+
+// types: array di StructType / ArrayType. Ritorna { version, ..., types,
+// roots } dove roots[i] è l'indice in `types` dell'i-esimo input.
+Napi::Value DescribeTypes(Napi::Env env, const Napi::Array& types);
+
+// Ricostruisce i tipi di un manifest: array di StructType / ArrayType nello
+// stesso ordine di manifest.types. Undefined con eccezione JS pendente.
+Napi::Value LoadTypes(Napi::Env env, const Napi::Object& manifest);
+
+}  // namespace ctypes
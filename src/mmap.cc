@@ -0,0 +1,289 @@
+#include "mmap.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ctypes {
+
+namespace {
+
+struct MappingRegistry {
+  std::mutex mutex;
+  std::map<uintptr_t, size_t> regions;  // indirizzo base → byte mappati
+};
+
+// Di processo: gli indirizzi sono unici nel processo, e i finalizer dei
+// Buffer possono girare dopo il teardown dell'instance data dell'addon
+MappingRegistry& Mappings() {
+  static MappingRegistry* registry = new MappingRegistry();
+  return *registry;
+}
+
+size_t MappingGranularity() {
+#ifdef _WIN32
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return static_cast<size_t>(info.dwAllocationGranularity);
+#else
+  return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+size_t PageSize() {
+#ifdef _WIN32
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return static_cast<size_t>(info.dwPageSize);
+#else
+  return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+void UnmapRegion(void* base, size_t length) {
+#ifdef _WIN32
+  (void)length;
+  UnmapViewOfFile(base);
+#else
+  munmap(base, length);
+#endif
+}
+
+// Applica l'hint a [addr, addr + length), già allineato alla pagina
+bool ApplyAdvice(void* addr, size_t length, MapAdvice advice) {
+#ifdef _WIN32
+  switch (advice) {
+    case MapAdvice::WillNeed: {
+      WIN32_MEMORY_RANGE_ENTRY range{addr, length};
+      return PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0) != 0;
+    }
+    case MapAdvice::DontNeed:
+      // Su pagine non bloccate VirtualUnlock fallisce ma le toglie dal
+      // working set: è il modo documentato per scaricarle
+      VirtualUnlock(addr, length);
+      return true;
+    default:
+      // Nessun equivalente di accesso sequenziale / casuale per le view
+      return advice == MapAdvice::Normal;
+  }
+#else
+  int flag = MADV_NORMAL;
+  switch (advice) {
+    case MapAdvice::Normal:
+      flag = MADV_NORMAL;
+      break;
+    case MapAdvice::Sequential:
+      flag = MADV_SEQUENTIAL;
+      break;
+    case MapAdvice::Random:
+      flag = MADV_RANDOM;
+      break;
+    case MapAdvice::WillNeed:
+      flag = MADV_WILLNEED;
+      break;
+    case MapAdvice::DontNeed:
+      flag = MADV_DONTNEED;
+      break;
+  }
+  return madvise(addr, length, flag) == 0;
+#endif
+}
+
+std::string LastSystemError() {
+#ifdef _WIN32
+  return std::format("error 0x{:08x}", static_cast<uint32_t>(GetLastError()));
+#else
+  return std::strerror(errno);
+#endif
+}
+
+}  // namespace
+
+bool ParseMapAdvice(const std::string& name, MapAdvice& advice) {
+  static const std::unordered_map<std::string, MapAdvice> names = {
+    {"normal", MapAdvice::Normal},     {"sequential", MapAdvice::Sequential}, {"random", MapAdvice::Random},
+    {"willneed", MapAdvice::WillNeed}, {"dontneed", MapAdvice::DontNeed},
+  };
+  auto it = names.find(name);
+  if (it == names.end()) {
+    return false;
+  }
+  advice = it->second;
+  return true;
+}
+
+Napi::Value MapFile(Napi::Env env, const std::string& path, const MapFileOptions& options) {
+  uint64_t file_size = 0;
+
+#ifdef _WIN32
+  const int wide_len = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+  std::wstring wide_path(wide_len > 0 ? wide_len : 1, L'\0');
+  MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, wide_path.data(), wide_len);
+
+  const DWORD access = options.readonly ? GENERIC_READ : (GENERIC_READ | GENERIC_WRITE);
+  HANDLE file = CreateFileW(wide_path.c_str(), access, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    Napi::Error::New(env, std::format("mmap: cannot open '{}': {}", path, LastSystemError()))
+      .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size)) {
+    std::string error = LastSystemError();
+    CloseHandle(file);
+    Napi::Error::New(env, std::format("mmap: cannot stat '{}': {}", path, error)).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  file_size = static_cast<uint64_t>(size.QuadPart);
+#else
+  const int fd = open(path.c_str(), (options.readonly ? O_RDONLY : O_RDWR) | O_CLOEXEC);
+  if (fd < 0) {
+    Napi::Error::New(env, std::format("mmap: cannot open '{}': {}", path, LastSystemError()))
+      .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    std::string error = LastSystemError();
+    close(fd);
+    Napi::Error::New(env, std::format("mmap: cannot stat '{}': {}", path, error)).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  file_size = static_cast<uint64_t>(st.st_size);
+#endif
+
+  auto close_file = [&]() {
+#ifdef _WIN32
+    CloseHandle(file);
+#else
+    close(fd);
+#endif
+  };
+
+  if (options.offset > file_size) {
+    close_file();
+    Napi::RangeError::New(env, std::format("mmap: offset {} is past the end of '{}' ({} bytes)", options.offset, path,
+                                           file_size))
+      .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  const uint64_t length = options.length.value_or(file_size - options.offset);
+  if (length == 0 || length > file_size - options.offset) {
+    close_file();
+    Napi::RangeError::New(env, length == 0 ? std::format("mmap: nothing to map in '{}'", path)
+                                           : std::format("mmap: range {}+{} exceeds '{}' ({} bytes)", options.offset,
+                                                         length, path, file_size))
+      .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  // La mappatura parte da un offset allineato; il Buffer salta il delta
+  const uint64_t delta = options.offset % MappingGranularity();
+  const uint64_t map_offset = options.offset - delta;
+  if (length + delta > static_cast<uint64_t>(SIZE_MAX)) {
+    close_file();
+    Napi::RangeError::New(env, "mmap: range too large for the address space").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  const size_t map_length = static_cast<size_t>(length + delta);
+
+#ifdef _WIN32
+  HANDLE mapping =
+    CreateFileMappingW(file, nullptr, options.readonly ? PAGE_READONLY : PAGE_READWRITE, 0, 0, nullptr);
+  void* base = nullptr;
+  if (mapping) {
+    base = MapViewOfFile(mapping, options.readonly ? FILE_MAP_READ : FILE_MAP_WRITE,
+                         static_cast<DWORD>(map_offset >> 32), static_cast<DWORD>(map_offset & 0xFFFFFFFFu),
+                         map_length);
+  }
+  std::string map_error = base ? std::string() : LastSystemError();
+  // La view resta valida anche chiusi file e oggetto di mapping
+  if (mapping) {
+    CloseHandle(mapping);
+  }
+#else
+  void* base = mmap(nullptr, map_length, options.readonly ? PROT_READ : (PROT_READ | PROT_WRITE), MAP_SHARED, fd,
+                    static_cast<off_t>(map_offset));
+  if (base == MAP_FAILED) {
+    base = nullptr;
+  }
+  std::string map_error = base ? std::string() : LastSystemError();
+#endif
+  close_file();
+
+  if (!base) {
+    Napi::Error::New(env, std::format("mmap: cannot map '{}': {}", path, map_error)).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (options.advice != MapAdvice::Normal) {
+    ApplyAdvice(base, map_length, options.advice);
+  }
+
+  {
+    MappingRegistry& registry = Mappings();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.regions.emplace(reinterpret_cast<uintptr_t>(base), map_length);
+  }
+
+  auto finalize = [base, map_length](Napi::Env, uint8_t*) {
+    {
+      MappingRegistry& registry = Mappings();
+      std::lock_guard<std::mutex> lock(registry.mutex);
+      registry.regions.erase(reinterpret_cast<uintptr_t>(base));
+    }
+    UnmapRegion(base, map_length);
+  };
+
+  try {
+    return Napi::Buffer<uint8_t>::New(env, static_cast<uint8_t*>(base) + delta, static_cast<size_t>(length), finalize);
+  } catch (...) {
+    // Buffer non creato (es. oltre buffer.constants.MAX_LENGTH): nessun
+    // finalizer girerà, la regione va smappata qui
+    finalize(env, nullptr);
+    throw;
+  }
+}
+
+Napi::Value AdviseMapping(Napi::Env env, const uint8_t* data, size_t length, MapAdvice advice) {
+  const uintptr_t begin = reinterpret_cast<uintptr_t>(data);
+  uintptr_t region_end = 0;
+  {
+    MappingRegistry& registry = Mappings();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    // Ultima regione con base <= data
+    auto it = registry.regions.upper_bound(begin);
+    if (it != registry.regions.begin()) {
+      --it;
+      if (begin < it->first + it->second) {
+        region_end = it->first + it->second;
+      }
+    }
+  }
+  if (region_end == 0) {
+    Napi::TypeError::New(env, "madvise: Buffer is not a memory-mapped file (use ctypes.mmap)")
+      .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (length > region_end - begin) {
+    Napi::RangeError::New(env, "madvise: range exceeds the mapping").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (length == 0) {
+    return Napi::Boolean::New(env, true);
+  }
+
+  // madvise vuole un indirizzo allineato alla pagina: si estende il range
+  // all'indietro fino all'inizio della pagina (sempre dentro la regione)
+  const uintptr_t page = PageSize();
+  const uintptr_t aligned = begin & ~(page - 1);
+  const size_t aligned_length = static_cast<size_t>(begin + length - aligned);
+  return Napi::Boolean::New(env, ApplyAdvice(reinterpret_cast<void*>(aligned), aligned_length, advice));
+}
+
+}  // namespace ctypes
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "shared.h"
+
+namespace ctypes {
+
+// ============================================================================
+// File mappati in memoria — ctypes.mmap()
+//
+// Passare un file di dati a una libreria C significava leggerlo in un
+// Buffer (copia completa, RSS pari alla dimensione del file) oppure
+// mapparlo con un altro binding e rivestirlo con ptrToBuffer. Qui il file
+// viene mappato con mmap / MapViewOfFile e restituito come Buffer esterno:
+//
+//   - zero copie: il Buffer è la mappatura, quindi è accettato ovunque lo
+//     sia un Buffer (argomenti POINTER / STRING, readValue, readArray...);
+//   - MAP_SHARED: le pagine sono quelle della page cache, condivise con
+//     gli altri processi che mappano lo stesso file;
+//   - il finalizer del Buffer smappa la regione (il GC ne decide la vita,
+//     come per ogni Buffer: le view con subarray() la tengono viva).
+//
+// `offset` qualsiasi: la mappatura parte dalla pagina (su Windows dalla
+// granularità di allocazione) che lo contiene e il Buffer inizia al byte
+// richiesto. Le regioni vive sono in un registry di processo, così
+// madvise() opera solo su memoria mappata da qui (MADV_DONTNEED su memoria
+// anonima ne azzererebbe il contenuto).
+//
+// Scrivere in una mappatura readonly è un accesso a memoria protetta: il
+// processo termina, come scrivendo attraverso un qualsiasi puntatore const.
+// ============================================================================
+
+enum class MapAdvice {
+  Normal,
+  Sequential,
+  Random,
+  WillNeed,  // prefetch: lettura anticipata in page cache
+  DontNeed,  // le pagine possono essere scaricate (si rileggono dal file)
+};
+
+struct MapFileOptions {
+  uint64_t offset = 0;
+  std::optional<uint64_t> length;  // default: fino alla fine del file
+  bool readonly = true;
+  MapAdvice advice = MapAdvice::Normal;
+};
+
+// "normal" | "sequential" | "random" | "willneed" | "dontneed"
+bool ParseMapAdvice(const std::string& name, MapAdvice& advice);
+
+// Mappa `path` e ritorna il Buffer. Undefined con eccezione JS pendente se
+// il file non si apre, il range è fuori dal file o la mappatura fallisce.
+Napi::Value MapFile(Napi::Env env, const std::string& path, const MapFileOptions& options);
+
+// Hint sul range [data, data + length) di una regione mappata da MapFile.
+// false se la piattaforma non supporta l'hint; TypeError / RangeError se
+// il range non appartiene a una mappatura.
+Napi::Value AdviseMapping(Napi::Env env, const uint8_t* data, size_t length, MapAdvice advice);
+
+}  // namespace ctypes
@@ -0,0 +1,293 @@
+#include "pool.h"
+
+namespace ctypes {
+
+// Stesso ordine di grandezza del threadpool libuv, ma scalato sui core:
+// le call C bloccanti occupano un thread senza usare CPU.
+static size_t DefaultPoolThreads() {
+  return std::clamp<size_t>(std::thread::hardware_concurrency(), 4, 32);
+}
+
+CallPool::CallPool() : target_threads_(DefaultPoolThreads()) {}
+
+CallPool::~CallPool() {
+  // Normalmente già fatto dal cleanup hook (l'instance data dell'addon viene
+  // distrutta dopo gli hook); qui resta solo il caso "mai avviato".
+  Shutdown();
+}
+
+void CallPool::ReleaseJob(PoolJob* job) {
+  job->queue_.reset();
+  job->Recycle();
+}
+
+bool CallPool::EnsureStarted(Napi::Env env) {
+  if (started_) [[likely]] {
+    return true;
+  }
+
+  // Nessuna funzione JS: il lavoro lo fa Drain() tramite il context.
+  tsfn_ = Napi::TypedThreadSafeFunction<CallPool, void, &CallPool::Drain>::New(env, "ctypes.CallPool", 0, 1, this);
+  // Il TSFN tiene vivo l'event loop solo mentre ci sono job pendenti
+  // (vedi Ref/Unref in Submit e Drain).
+  tsfn_.Unref(env);
+
+  // Nessun worker avviato: il pool resta "non avviato" (il prossimo Submit
+  // riprova) e il Submit corrente fallisce con l'errore già pendente.
+  if (!SpawnWorkers(env, target_threads_)) {
+    tsfn_.Release();
+    tsfn_ = {};
+    return false;
+  }
+
+  // Registrato DOPO la creazione del TSFN: gli hook girano in ordine
+  // inverso, quindi fermiamo i worker prima che N-API chiuda il TSFN.
+  napi_add_env_cleanup_hook(
+    env, [](void* arg) { static_cast<CallPool*>(arg)->Shutdown(); }, this);
+
+  started_ = true;
+  return true;
+}
+
+bool CallPool::SpawnWorkers(Napi::Env env, size_t count) {
+  try {
+    for (size_t i = 0; i < count; i++) {
+      workers_.emplace_back([this]() { WorkerLoop(); });
+    }
+  } catch (const std::system_error& e) {
+    if (workers_.empty()) {
+      Napi::Error::New(env, std::format("Failed to start FFI call pool: {}", e.what())).ThrowAsJavaScriptException();
+      return false;
+    }
+    // Pool parziale: meglio meno thread che nessuno
+  }
+  return true;
+}
+
+bool CallPool::SetThreadCount(Napi::Env env, size_t threads) {
+  if (threads == 0 || threads > MAX_CALL_POOL_THREADS) {
+    Napi::RangeError::New(env, std::format("Call pool size must be between 1 and {}", MAX_CALL_POOL_THREADS))
+      .ThrowAsJavaScriptException();
+    return false;
+  }
+
+  if (!started_) {
+    target_threads_ = threads;
+    return true;
+  }
+
+  if (threads < workers_.size()) {
+    Napi::RangeError::New(env, std::format("Call pool already started with {} threads and cannot shrink",
+                                           workers_.size()))
+      .ThrowAsJavaScriptException();
+    return false;
+  }
+  target_threads_ = threads;
+  return SpawnWorkers(env, threads - workers_.size());
+}
+
+CallPoolStats CallPool::GetStats() {
+  CallPoolStats stats;
+  stats.threads = started_ ? workers_.size() : target_threads_;
+  stats.pending = pending_;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.submitted = submitted_;
+    stats.completed = completed_count_;
+  }
+  return stats;
+}
+
+bool CallPool::Submit(Napi::Env env, PoolJob* job, std::shared_ptr<SerialQueue> queue) {
+  if (!EnsureStarted(env)) {
+    ReleaseJob(job);
+    return false;
+  }
+
+  if (pending_++ == 0) {
+    tsfn_.Ref(env);
+  }
+
+  job->queue_ = std::move(queue);
+  SerialQueue* q = job->queue_.get();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    submitted_++;
+    if (q && q->running) {
+      // La coda ha già un job in volo: lo rilancerà il worker al termine
+      q->pending.push_back(job);
+      return true;
+    }
+    if (q) {
+      q->running = true;
+    }
+    ready_.push_back(job);
+  }
+  cv_.notify_one();
+  return true;
+}
+
+void CallPool::WorkerLoop() {
+  for (;;) {
+    PoolJob* job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this]() { return stopping_ || !ready_.empty(); });
+      if (stopping_) {
+        return;
+      }
+      job = ready_.front();
+      ready_.pop_front();
+    }
+
+    job->Execute();
+
+    bool signal = false;
+    bool wake = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (SerialQueue* q = job->queue_.get()) {
+        if (!q->pending.empty()) {
+          ready_.push_back(q->pending.front());
+          q->pending.pop_front();
+          wake = true;
+        } else {
+          q->running = false;
+        }
+      }
+      completed_.push_back(job);
+      completed_count_++;
+      if (!drain_scheduled_) {
+        drain_scheduled_ = true;
+        signal = true;
+      }
+    }
+    if (wake) {
+      cv_.notify_one();
+    }
+    if (signal) {
+      tsfn_.NonBlockingCall();
+    }
+  }
+}
+
+void CallPool::Drain(Napi::Env env, Napi::Function, CallPool* pool, void*) {
+  // env nullo: il TSFN si sta chiudendo, i job li libera Shutdown()
+  if (env == nullptr) {
+    return;
+  }
+
+  std::vector<PoolJob*> done;
+  {
+    std::lock_guard<std::mutex> lock(pool->mutex_);
+    done.swap(pool->completed_);
+    pool->drain_scheduled_ = false;
+  }
+
+  for (PoolJob* job : done) {
+    {
+      Napi::HandleScope scope(env);
+      job->Complete(env);
+    }
+    ReleaseJob(job);
+    if (--pool->pending_ == 0) {
+      pool->tsfn_.Unref(env);
+    }
+  }
+
+  // Un hook che lancia non deve saltare i successivi (un ring senza notify
+  // lascia i suoi wait() appesi): si tiene il primo errore e lo si lancia alla fine
+  std::vector<DrainHook*> hooks;
+  hooks.swap(pool->after_drain_);
+  std::optional<Napi::Error> first_error;
+  for (DrainHook* hook : hooks) {
+    Napi::HandleScope scope(env);
+    try {
+      hook->OnDrained(env);
+    } catch (const Napi::Error& e) {
+      if (!first_error) {
+        first_error = e;
+      }
+    }
+  }
+  if (first_error) {
+    first_error->ThrowAsJavaScriptException();
+  }
+}
+
+void CallPool::AfterDrain(DrainHook* hook) {
+  after_drain_.push_back(hook);
+}
+
+void CallPool::Shutdown() {
+  if (!started_ || stopping_) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  cv_.notify_all();
+  // Attende le call C in corso: non possiamo interromperle né lasciare che
+  // scrivano in buffer già liberati.
+  for (auto& t : workers_) {
+    if (t.joinable()) {
+      t.join();
+    }
+  }
+  workers_.clear();
+
+  // Environment in teardown: le Promise non verranno mai osservate, basta
+  // rilasciare i job (e i riferimenti JS che tengono).
+  std::vector<PoolJob*> leftovers;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    leftovers.assign(ready_.begin(), ready_.end());
+    leftovers.insert(leftovers.end(), completed_.begin(), completed_.end());
+    ready_.clear();
+    completed_.clear();
+  }
+  // I job in attesa su una coda seriale sono raggiungibili solo dal job
+  // della stessa coda ancora in ready_ / completed_
+  const size_t direct = leftovers.size();
+  for (size_t i = 0; i < direct; i++) {
+    if (SerialQueue* q = leftovers[i]->queue_.get()) {
+      leftovers.insert(leftovers.end(), q->pending.begin(), q->pending.end());
+      q->pending.clear();
+    }
+  }
+  for (PoolJob* job : leftovers) {
+    ReleaseJob(job);
+  }
+  pending_ = 0;
+
+  tsfn_.Release();
+}
+
+// ============================================================================
+// SerialQueue handle
+// ============================================================================
+
+static const napi_type_tag kSerialQueueTypeTag = {0x9d1c6a3e52f04b7bULL, 0x8e37c0a1f6d2495cULL};
+
+Napi::Value CreateSerialQueueHandle(Napi::Env env) {
+  auto* holder = new std::shared_ptr<SerialQueue>(std::make_shared<SerialQueue>());
+  auto handle = Napi::External<std::shared_ptr<SerialQueue>>::New(
+    env, holder, [](Napi::Env, std::shared_ptr<SerialQueue>* data) { delete data; });
+  napi_type_tag_object(env, handle, &kSerialQueueTypeTag);
+  return handle;
+}
+
+std::shared_ptr<SerialQueue> SerialQueueFromHandle(Napi::Env env, const Napi::Value& val) {
+  if (!val.IsExternal()) {
+    return nullptr;
+  }
+  bool tagged = false;
+  if (napi_check_object_type_tag(env, val, &kSerialQueueTypeTag, &tagged) != napi_ok || !tagged) {
+    return nullptr;
+  }
+  return *val.As<Napi::External<std::shared_ptr<SerialQueue>>>().Data();
+}
+
+}  // namespace ctypes
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <deque>
+
+#include "shared.h"
+
+namespace ctypes {
+
+// ============================================================================
+// CallPool — worker pool dedicato per FFIFunction::CallAsync
+//
+// Con Napi::AsyncWorker ogni callAsync finiva nel threadpool di libuv (4
+// thread di default, condivisi con fs / dns / crypto): poche chiamate C
+// bloccanti bastavano a saturarlo e a far esplodere la latenza dell'I/O.
+// Il pool è posseduto da CTypesAddon (uno per environment), parte al primo
+// submit e ha una dimensione configurabile (configureCallPool).
+//
+// Le completion tornano sul main thread tramite UN solo ThreadSafeFunction
+// condiviso: i worker accodano i job finiti in `completed_` e segnalano il
+// TSFN solo se non c'è già un drain in programma, quindi N completion
+// ravvicinate costano un solo uv_async e un solo giro di event loop.
+//
+// SerialQueue: le librerie non thread-safe possono essere pinnate a una coda
+// seriale (per Library o per singola FFIFunction). I job della stessa coda
+// eseguono uno alla volta e in ordine FIFO; code diverse (e i job senza
+// coda) si distribuiscono liberamente sui worker.
+// ============================================================================
+
+static constexpr size_t MAX_CALL_POOL_THREADS = 256;
+
+class CallPool;
+class PoolJob;
+
+// Coda seriale. Tutti i campi sono protetti dal mutex del CallPool.
+struct SerialQueue {
+  std::deque<PoolJob*> pending;  // in attesa che il job corrente finisca
+  bool running = false;          // un job della coda è in ready_ / in esecuzione
+};
+
+// Unità di lavoro del pool. Ownership: il pool la rilascia con Recycle()
+// sul main thread subito dopo Complete() (o al teardown).
+class PoolJob {
+ public:
+  virtual ~PoolJob() = default;
+
+  // *** WORKER THREAD — nessun accesso a V8 ***
+  virtual void Execute() = 0;
+  // *** MAIN THREAD *** (dentro una HandleScope aperta dal pool). Può lanciare
+  // Napi::Error: il pool serve comunque gli hook successivi
+  virtual void Complete(Napi::Env env) = 0;
+  // *** MAIN THREAD *** Default: delete. I job riusabili (CallWorker) si
+  // rimettono nel pool del proprietario.
+  virtual void Recycle() { delete this; }
+
+ private:
+  friend class CallPool;
+  std::shared_ptr<SerialQueue> queue_;
+};
+
+// Azione da eseguire una sola volta alla fine di un drain, dopo i Complete()
+// dei job (es. CompletionRing: un Atomics.notify per tutto il blocco)
+class DrainHook {
+ public:
+  virtual ~DrainHook() = default;
+  // *** MAIN THREAD *** (dentro una HandleScope aperta dal pool). Può lanciare
+  // Napi::Error: il pool serve comunque gli hook successivi
+  virtual void OnDrained(Napi::Env env) = 0;
+};
+
+struct CallPoolStats {
+  size_t threads = 0;
+  uint64_t submitted = 0;
+  uint64_t completed = 0;
+  size_t pending = 0;  // submitted ma non ancora completati su JS
+};
+
+class CallPool {
+ public:
+  CallPool();
+  ~CallPool();
+
+  CallPool(const CallPool&) = delete;
+  CallPool& operator=(const CallPool&) = delete;
+
+  // Main thread. Prende ownership di `job` (anche in caso di errore). Avvia
+  // il pool se necessario; false con eccezione JS pendente se i thread non
+  // possono essere creati.
+  bool Submit(Napi::Env env, PoolJob* job, std::shared_ptr<SerialQueue> queue);
+
+  // Main thread. Prima dell'avvio imposta la dimensione; dopo può solo
+  // crescere (i thread esistenti possono essere dentro una call C bloccante,
+  // non c'è modo sicuro di fermarli). false con RangeError JS pendente.
+  bool SetThreadCount(Napi::Env env, size_t threads);
+
+  CallPoolStats GetStats();
+
+  // Main thread, da un Complete(): `hook` gira alla fine del drain corrente.
+  // Il chiamante evita i duplicati e tiene vivo `hook` fino ad OnDrained.
+  void AfterDrain(DrainHook* hook);
+
+ private:
+  static void Drain(Napi::Env env, Napi::Function, CallPool* pool, void*);
+  static void ReleaseJob(PoolJob* job);
+
+  bool EnsureStarted(Napi::Env env);
+  bool SpawnWorkers(Napi::Env env, size_t count);
+  void WorkerLoop();
+  void Shutdown();
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<PoolJob*> ready_;       // pronti per un worker
+  std::vector<PoolJob*> completed_;  // eseguiti, in attesa del drain su JS
+  std::vector<std::thread> workers_;
+  size_t target_threads_;
+  bool started_ = false;
+  bool stopping_ = false;
+  bool drain_scheduled_ = false;  // coalescing delle NonBlockingCall
+  uint64_t submitted_ = 0;
+  uint64_t completed_count_ = 0;
+
+  // Solo main thread
+  size_t pending_ = 0;
+  std::vector<DrainHook*> after_drain_;
+  Napi::TypedThreadSafeFunction<CallPool, void, &CallPool::Drain> tsfn_;
+};
+
+// Handle JS di una SerialQueue: External con type tag che possiede uno
+// shared_ptr (la coda sopravvive finché c'è un job in volo).
+Napi::Value CreateSerialQueueHandle(Napi::Env env);
+// nullptr se `val` non è un handle creato da CreateSerialQueueHandle
+std::shared_ptr<SerialQueue> SerialQueueFromHandle(Napi::Env env, const Napi::Value& val);
+
+}  // namespace ctypes
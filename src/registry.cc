@@ -0,0 +1,120 @@
+#include "registry.h"
+
+#include "library.h"
+
+namespace ctypes {
+
+namespace {
+
+struct SharedLibraryEntry {
+  void* handle;
+  size_t refs;
+};
+
+struct SharedRegistry {
+  std::mutex mutex;
+  std::unordered_map<std::string, SharedLibraryEntry> libraries;
+  std::unordered_map<uint64_t, std::vector<SharedTypeEntry>> binding_sets;
+  uint64_t next_binding_set = 1;
+};
+
+// Mai distrutto: Library / binding set possono sopravvivere fino all'exit
+// del processo (distruttori statici in ordine non garantito)
+SharedRegistry& Registry() {
+  static SharedRegistry* registry = new SharedRegistry();
+  return *registry;
+}
+
+std::atomic<uint64_t> next_layout_id{1};
+
+}  // namespace
+
+void* AcquireSharedLibrary(const std::string& path, std::string& error) {
+  SharedRegistry& registry = Registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  auto it = registry.libraries.find(path);
+  if (it != registry.libraries.end()) {
+    it->second.refs++;
+    return it->second.handle;
+  }
+
+  // Sotto lock: due Worker che aprono lo stesso path insieme non devono
+  // ritrovarsi con due handle (e due refcount) diversi
+  void* handle = LoadSharedLibrary(path, error);
+  if (handle) {
+    registry.libraries.emplace(path, SharedLibraryEntry{handle, 1});
+  }
+  return handle;
+}
+
+void ReleaseSharedLibrary(const std::string& path) {
+  SharedRegistry& registry = Registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  auto it = registry.libraries.find(path);
+  if (it == registry.libraries.end()) {
+    return;
+  }
+  if (--it->second.refs == 0) {
+    CloseSharedLibrary(it->second.handle);
+    registry.libraries.erase(it);
+  }
+}
+
+uint64_t NextSharedLayoutId() {
+  return next_layout_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t PublishBindingSet(std::vector<SharedTypeEntry> types) {
+  SharedRegistry& registry = Registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  uint64_t id = registry.next_binding_set++;
+  registry.binding_sets.emplace(id, std::move(types));
+  return id;
+}
+
+bool FindBindingSet(uint64_t id, std::vector<SharedTypeEntry>& out) {
+  SharedRegistry& registry = Registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  auto it = registry.binding_sets.find(id);
+  if (it == registry.binding_sets.end()) {
+    return false;
+  }
+  out = it->second;
+  return true;
+}
+
+bool RevokeBindingSet(uint64_t id) {
+  std::vector<SharedTypeEntry> released;
+  {
+    SharedRegistry& registry = Registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    auto it = registry.binding_sets.find(id);
+    if (it == registry.binding_sets.end()) {
+      return false;
+    }
+    released = std::move(it->second);
+    registry.binding_sets.erase(it);
+  }
+  // Gli ultimi riferimenti ai layout si rilasciano fuori dal lock
+  return true;
+}
+
+SharedRegistryStats GetSharedRegistryStats() {
+  SharedRegistry& registry = Registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  SharedRegistryStats stats;
+  stats.libraries = registry.libraries.size();
+  for (const auto& [path, entry] : registry.libraries) {
+    stats.library_refs += entry.refs;
+  }
+  stats.binding_sets = registry.binding_sets.size();
+  return stats;
+}
+
+}  // namespace ctypes
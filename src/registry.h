@@ -0,0 +1,61 @@
+#pragma once
+
+#include "shared.h"
+
+namespace ctypes {
+
+class StructInfo;
+class ArrayInfo;
+
+// ============================================================================
+// Registry di processo — stato immutabile condiviso tra environment
+//
+// CTypesAddon è per-environment: senza condivisione ogni Worker thread
+// riapre le librerie, ricostruisce StructInfo / ArrayInfo da JS e riprepara
+// i CIF. Tre cose però non dipendono dall'isolate e una volta costruite non
+// cambiano più:
+//
+//   - handle di dlopen / LoadLibrary: refcount per path, una sola apertura
+//     per processo (le Library di tutti gli environment lo condividono);
+//   - layout condivisi: StructInfo / ArrayInfo resi immutabili con Share()
+//     e pubblicati come *binding set*; un altro environment li adotta per
+//     id (un numero, trasferibile con postMessage / workerData) creando
+//     solo i wrapper StructType / ArrayType;
+//   - CIF: SignatureRegistry è di processo (signature.h), quindi layout
+//     condivisi (stessi ffi_type) portano a CIF condivisi.
+//
+// Tutto protetto da un mutex: le operazioni sono di setup (load, export,
+// import), mai sul path di Call().
+// ============================================================================
+
+// Tipo di un binding set: esattamente uno dei due è valorizzato
+struct SharedTypeEntry {
+  std::shared_ptr<StructInfo> struct_info;
+  std::shared_ptr<ArrayInfo> array_info;
+};
+
+// dlopen / LoadLibrary con refcount per path: solo il primo acquire apre la
+// libreria, solo l'ultimo release la chiude. nullptr con `error` valorizzato
+// se il caricamento fallisce.
+void* AcquireSharedLibrary(const std::string& path, std::string& error);
+void ReleaseSharedLibrary(const std::string& path);
+
+// Id univoco di processo per un layout condiviso (StructInfo::Share)
+uint64_t NextSharedLayoutId();
+
+// Binding set: pubblicazione, lookup (copia degli shared_ptr) e revoca.
+// Gli environment che hanno già adottato i tipi li tengono vivi anche dopo
+// la revoca.
+uint64_t PublishBindingSet(std::vector<SharedTypeEntry> types);
+bool FindBindingSet(uint64_t id, std::vector<SharedTypeEntry>& out);
+bool RevokeBindingSet(uint64_t id);
+
+struct SharedRegistryStats {
+  size_t libraries = 0;     // path aperti
+  size_t library_refs = 0;  // Library vive (somma dei refcount)
+  size_t binding_sets = 0;
+};
+
+SharedRegistryStats GetSharedRegistryStats();
+
+}  // namespace ctypes
@@ -0,0 +1,213 @@
+#include "ring.h"
+
+namespace ctypes {
+
+bool GetRingValueFormat(CType type, PointerMode mode, RingValueFormat& out) {
+  const bool numbers = mode == PointerMode::NUMBER;
+  switch (type) {
+    case CType::CTYPES_VOID:
+      out = RingValueFormat::VOID;
+      return true;
+    case CType::CTYPES_FLOAT:
+    case CType::CTYPES_DOUBLE:
+      out = RingValueFormat::DOUBLE;
+      return true;
+    case CType::CTYPES_INT8:
+    case CType::CTYPES_INT16:
+    case CType::CTYPES_INT32:
+      out = RingValueFormat::INT;
+      return true;
+    case CType::CTYPES_UINT8:
+    case CType::CTYPES_UINT16:
+    case CType::CTYPES_UINT32:
+    case CType::CTYPES_WCHAR:
+      out = RingValueFormat::UINT;
+      return true;
+    case CType::CTYPES_INT64:
+    case CType::CTYPES_SSIZE_T:
+    case CType::CTYPES_LONG:
+      out = numbers ? RingValueFormat::INT_NUMBER : RingValueFormat::BIGINT;
+      return true;
+    case CType::CTYPES_UINT64:
+    case CType::CTYPES_SIZE_T:
+    case CType::CTYPES_ULONG:
+      out = numbers ? RingValueFormat::UINT_NUMBER : RingValueFormat::BIGUINT;
+      return true;
+    case CType::CTYPES_BOOL:
+      out = RingValueFormat::BOOL;
+      return true;
+    case CType::CTYPES_POINTER:
+    case CType::CTYPES_STRING:
+    case CType::CTYPES_WSTRING:
+      out = numbers ? RingValueFormat::POINTER_NUMBER : RingValueFormat::POINTER;
+      return true;
+    default:
+      return false;
+  }
+}
+
+uint64_t NormalizeRingValue(CType type, const void* return_data) {
+  // Stessi campi di ConvertReturn: libffi allarga i ritorni interi a
+  // ffi_arg, il valore utile è nei byte bassi
+  int64_t i64;
+  memcpy(&i64, return_data, sizeof(i64));
+  const uint64_t u64 = static_cast<uint64_t>(i64);
+  uint64_t bits = 0;
+  switch (type) {
+    case CType::CTYPES_FLOAT: {
+      float f;
+      memcpy(&f, return_data, sizeof(f));
+      const double d = static_cast<double>(f);
+      memcpy(&bits, &d, sizeof(bits));
+      return bits;
+    }
+    case CType::CTYPES_DOUBLE:
+      memcpy(&bits, return_data, sizeof(bits));
+      return bits;
+    case CType::CTYPES_INT8:
+      return static_cast<uint64_t>(static_cast<int64_t>(static_cast<int8_t>(u64)));
+    case CType::CTYPES_INT16:
+      return static_cast<uint64_t>(static_cast<int64_t>(static_cast<int16_t>(u64)));
+    case CType::CTYPES_INT32:
+      return static_cast<uint64_t>(static_cast<int64_t>(static_cast<int32_t>(u64)));
+    case CType::CTYPES_UINT8:
+    case CType::CTYPES_BOOL:
+      return static_cast<uint8_t>(u64);
+    case CType::CTYPES_UINT16:
+      return static_cast<uint16_t>(u64);
+    case CType::CTYPES_UINT32:
+      return static_cast<uint32_t>(u64);
+    case CType::CTYPES_WCHAR:
+      return static_cast<uint64_t>(static_cast<std::make_unsigned_t<wchar_t>>(u64));
+    case CType::CTYPES_LONG:
+      return static_cast<uint64_t>(static_cast<int64_t>(static_cast<long>(i64)));
+    case CType::CTYPES_ULONG:
+      return static_cast<uint64_t>(static_cast<unsigned long>(u64));
+    case CType::CTYPES_POINTER:
+    case CType::CTYPES_STRING:
+    case CType::CTYPES_WSTRING: {
+      void* p;
+      memcpy(&p, return_data, sizeof(p));
+      return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(p));
+    }
+    case CType::CTYPES_VOID:
+      return 0;
+    default:
+      return u64;
+  }
+}
+
+Napi::Function CompletionRing::GetClass(Napi::Env env) {
+  return DefineClass(env, "CompletionRing",
+                     {
+                       InstanceAccessor("capacity", &CompletionRing::GetCapacity, nullptr),
+                       InstanceAccessor("inflight", &CompletionRing::GetInflight, nullptr),
+                     });
+}
+
+CompletionRing::CompletionRing(const Napi::CallbackInfo& info) : Napi::ObjectWrap<CompletionRing>(info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsTypedArray() ||
+      info[0].As<Napi::TypedArray>().TypedArrayType() != napi_int32_array) {
+    Napi::TypeError::New(env, "CompletionRing requires an Int32Array over a SharedArrayBuffer")
+      .ThrowAsJavaScriptException();
+    return;
+  }
+  Napi::Int32Array view = info[0].As<Napi::Int32Array>();
+  const size_t bytes = view.ByteLength();
+  if (bytes < kRingHeaderSize + kRingRecordSize || reinterpret_cast<uintptr_t>(view.Data()) % 8 != 0) {
+    Napi::RangeError::New(env, "CompletionRing buffer too small or misaligned").ThrowAsJavaScriptException();
+    return;
+  }
+  const size_t capacity = (bytes - kRingHeaderSize) / kRingRecordSize;
+  if (capacity > INT32_MAX) {
+    Napi::RangeError::New(env, "CompletionRing capacity too large").ThrowAsJavaScriptException();
+    return;
+  }
+
+  if (info.Length() > 1 && !info[1].IsUndefined() && !info[1].IsNull()) {
+    if (!info[1].IsFunction()) {
+      Napi::TypeError::New(env, "onBatch must be a function").ThrowAsJavaScriptException();
+      return;
+    }
+    on_batch_ = Napi::Persistent(info[1].As<Napi::Function>());
+  }
+
+  header_ = view.Data();
+  records_ = reinterpret_cast<uint8_t*>(header_) + kRingHeaderSize;
+  capacity_ = static_cast<uint32_t>(capacity);
+  header_[2] = static_cast<int32_t>(capacity_);
+  header_[3] = static_cast<int32_t>(kRingRecordSize);
+
+  view_ = Napi::Persistent(view.As<Napi::Object>());
+  Napi::Object atomics = env.Global().Get("Atomics").As<Napi::Object>();
+  notify_ = Napi::Persistent(atomics.Get("notify").As<Napi::Function>());
+}
+
+uint32_t CompletionRing::LoadHeader(size_t index) const {
+  return static_cast<uint32_t>(std::atomic_ref<int32_t>(header_[index]).load(std::memory_order_acquire));
+}
+
+bool CompletionRing::Reserve() {
+  // uint32: il contatore di write può aver fatto wrap, la differenza no
+  const uint32_t unread = LoadHeader(0) - LoadHeader(1);
+  if (static_cast<uint64_t>(inflight_) + unread >= capacity_) {
+    return false;
+  }
+  inflight_++;
+  return true;
+}
+
+void CompletionRing::CancelReservation() {
+  inflight_--;
+}
+
+void CompletionRing::Publish(double tag, int32_t status, RingValueFormat format, uint64_t value) {
+  std::lock_guard<std::mutex> lock(publish_mutex_);
+
+  std::atomic_ref<int32_t> write(header_[0]);
+  const uint32_t seq = static_cast<uint32_t>(write.load(std::memory_order_relaxed));
+  uint8_t* record = records_ + static_cast<size_t>(seq % capacity_) * kRingRecordSize;
+  const int32_t format_code = static_cast<int32_t>(format);
+  memcpy(record, &tag, sizeof(tag));
+  memcpy(record + 8, &status, sizeof(status));
+  memcpy(record + 12, &format_code, sizeof(format_code));
+  memcpy(record + 16, &value, sizeof(value));
+  // Release: chi legge `write` con Atomics.load vede il record completo
+  write.store(static_cast<int32_t>(seq + 1), std::memory_order_release);
+}
+
+void CompletionRing::Completed(CallPool& pool) {
+  inflight_--;
+  if (!flush_scheduled_) {
+    flush_scheduled_ = true;
+    Ref();  // vivo fino a OnDrained anche se nessuno lo referenzia più
+    pool.AfterDrain(this);
+  }
+}
+
+void CompletionRing::OnDrained(Napi::Env env) {
+  flush_scheduled_ = false;
+  try {
+    notify_.Call({view_.Value(), Napi::Number::New(env, 0)});
+    if (!on_batch_.IsEmpty()) {
+      on_batch_.Call(Value(), {Value()});
+    }
+  } catch (...) {
+    // L'errore lo riporta CallPool::Drain dopo aver servito gli altri hook
+    Unref();
+    throw;
+  }
+  Unref();
+}
+
+Napi::Value CompletionRing::GetCapacity(const Napi::CallbackInfo& info) {
+  return Napi::Number::New(info.Env(), capacity_);
+}
+
+Napi::Value CompletionRing::GetInflight(const Napi::CallbackInfo& info) {
+  return Napi::Number::New(info.Env(), inflight_);
+}
+
+}  // namespace ctypes
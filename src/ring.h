@@ -0,0 +1,112 @@
+#pragma once
+
+#include "pool.h"
+#include "shared.h"
+#include "types.h"
+
+namespace ctypes {
+
+// ============================================================================
+// CompletionRing — completion di fn.submit() senza Promise
+//
+// Ogni callAsync alloca un Promise::Deferred e ogni risoluzione è un
+// microtask più ConvertReturn sul main thread. Con volumi alti è questo a
+// limitare il throughput, non il pool. In alternativa il chiamante accoda
+// call con un tag (fn.submit(ring, tag, ...args)) e il worker, appena
+// ffi_call ritorna, scrive tag, stato e valore di ritorno in un record di
+// un SharedArrayBuffer; JS li consuma a blocchi (ring.drain) svegliato da
+// Atomics.waitAsync o da una sola callback per drain del pool.
+//
+// Layout del SharedArrayBuffer (little-endian, letto dal lato JS in
+// lib/core/ring.js):
+//
+//   header (64 byte, Int32):
+//     [0] write     record pubblicati (contatore uint32, wrap ammesso)
+//     [1] read      record consumati (scritto solo da JS)
+//     [2] capacity  record nel ring
+//     [3] record    byte per record (kRingRecordSize)
+//   record i (i = seq % capacity) a 64 + i * 32:
+//     +0  f64  tag
+//     +8  i32  status (0 ok, 1 eccezione nativa)
+//     +12 i32  format (RingValueFormat: come decodificare il valore)
+//     +16 u64  valore (bit normalizzati, vedi NormalizeRingValue)
+//
+// Più worker pubblicano insieme: mutex tra produttori, `write` pubblicato
+// con release dopo il record. Il ring non si riempie mai: submit() riserva
+// un posto (call in volo + record non letti <= capacity) e lancia
+// RangeError se non ce n'è.
+//
+// Risveglio: i record sono visibili appena scritti, ma Atomics.notify e la
+// callback onBatch girano sul main thread, una volta per drain del
+// CallPool (DrainHook) anche se nel drain sono finite molte call.
+// ============================================================================
+
+static constexpr size_t kRingHeaderSize = 64;
+static constexpr size_t kRingRecordSize = 32;
+
+// Decodifica del campo valore (lib/core/ring.js)
+enum class RingValueFormat : int32_t {
+  VOID = 0,            // undefined
+  DOUBLE = 1,          // f64 → Number
+  INT = 2,             // int64 → Number (tipi fino a 32 bit)
+  UINT = 3,            // uint64 → Number (tipi fino a 32 bit)
+  BIGINT = 4,          // int64 → BigInt
+  BIGUINT = 5,         // uint64 → BigInt
+  INT_NUMBER = 6,      // int64 → Number se esatto, altrimenti BigInt
+  UINT_NUMBER = 7,     // uint64 → Number se esatto, altrimenti BigInt
+  BOOL = 8,            // uint64 != 0
+  POINTER = 9,         // indirizzo: null oppure BigInt
+  POINTER_NUMBER = 10  // indirizzo: null oppure Number / BigInt
+};
+
+// Formato per un tipo di ritorno primitivo (char* / wchar_t* come
+// indirizzi); false per struct / union / array.
+bool GetRingValueFormat(CType type, PointerMode mode, RingValueFormat& out);
+
+// Bit del valore di ritorno `type` letti da `return_data` (ReturnValue)
+uint64_t NormalizeRingValue(CType type, const void* return_data);
+
+class CompletionRing : public Napi::ObjectWrap<CompletionRing>, public DrainHook {
+ public:
+  static Napi::Function GetClass(Napi::Env env);
+
+  // new CompletionRing(int32View[, onBatch]): vista Int32Array su un
+  // SharedArrayBuffer già inizializzato dal lato JS (header compreso)
+  CompletionRing(const Napi::CallbackInfo& info);
+
+  // *** MAIN THREAD *** Riserva un record per una call; false se il ring
+  // è pieno (call in volo + record non letti).
+  bool Reserve();
+  // *** MAIN THREAD *** Annulla una Reserve() la cui call non è partita
+  void CancelReservation();
+
+  // *** WORKER THREAD *** Scrive e pubblica il record di una call
+  void Publish(double tag, int32_t status, RingValueFormat format, uint64_t value);
+
+  // *** MAIN THREAD *** Call conclusa (dal Complete del frame): programma
+  // notify / onBatch alla fine del drain corrente del pool
+  void Completed(CallPool& pool);
+  void OnDrained(Napi::Env env) override;
+
+  // Proprietà JS
+  Napi::Value GetCapacity(const Napi::CallbackInfo& info);
+  Napi::Value GetInflight(const Napi::CallbackInfo& info);
+
+ private:
+  uint32_t LoadHeader(size_t index) const;
+
+  int32_t* header_ = nullptr;
+  uint8_t* records_ = nullptr;
+  uint32_t capacity_ = 0;
+
+  std::mutex publish_mutex_;  // tra worker che pubblicano insieme
+
+  // Solo main thread
+  uint32_t inflight_ = 0;
+  bool flush_scheduled_ = false;
+  Napi::ObjectReference view_;
+  Napi::FunctionReference notify_;    // Atomics.notify
+  Napi::FunctionReference on_batch_;  // opzionale
+};
+
+}  // namespace ctypes
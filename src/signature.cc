@@ -0,0 +1,117 @@
+#include "signature.h"
+
+namespace ctypes {
+
+static std::string MakeSignatureKey(ffi_abi abi, ffi_type* return_type, const std::vector<ffi_type*>& arg_types) {
+  std::string key;
+  key.resize(sizeof(abi) + sizeof(ffi_type*) * (1 + arg_types.size()));
+  char* out = key.data();
+  memcpy(out, &abi, sizeof(abi));
+  out += sizeof(abi);
+  memcpy(out, &return_type, sizeof(ffi_type*));
+  out += sizeof(ffi_type*);
+  if (!arg_types.empty()) {
+    memcpy(out, arg_types.data(), sizeof(ffi_type*) * arg_types.size());
+  }
+  return key;
+}
+
+SignatureRegistry& SignatureRegistry::Shared() {
+  // Mai distrutta: le FFIFunction degli environment ancora vivi all'exit
+  // del processo rilasciano le signature dopo i distruttori statici
+  static SignatureRegistry* registry = new SignatureRegistry();
+  return *registry;
+}
+
+std::shared_ptr<PreparedSignature> SignatureRegistry::Intern(ffi_abi abi,
+                                                             ffi_type* return_type,
+                                                             const std::vector<ffi_type*>& arg_types,
+                                                             std::vector<std::shared_ptr<void>>&& layouts) {
+  std::string key = MakeSignatureKey(abi, return_type, arg_types);
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    if (auto existing = it->second.lock()) {
+      return existing;
+    }
+  }
+
+  auto sig = std::make_shared<PreparedSignature>();
+  sig->abi = abi;
+  sig->return_type = return_type;
+  sig->arg_types = arg_types;
+  sig->layouts = std::move(layouts);
+
+  ffi_status status = ffi_prep_cif(&sig->cif, abi, static_cast<unsigned int>(sig->arg_types.size()), return_type,
+                                   sig->arg_types.empty() ? nullptr : sig->arg_types.data());
+  if (status != FFI_OK) {
+    return nullptr;
+  }
+
+  if (it != entries_.end()) {
+    it->second = sig;
+  } else {
+    entries_.emplace(std::move(key), sig);
+    if (entries_.size() >= sweep_at_) {
+      Sweep();
+    }
+  }
+  return sig;
+}
+
+size_t SignatureRegistry::Size() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Sweep();
+  return entries_.size();
+}
+
+void SignatureRegistry::Sweep() {
+  std::erase_if(entries_, [](const auto& entry) { return entry.second.expired(); });
+  sweep_at_ = std::max<size_t>(64, entries_.size() * 2);
+}
+
+std::shared_ptr<PreparedSignature> VariadicSignatureCache::Get(const PreparedSignature& fixed,
+                                                               const CType* extra_types,
+                                                               size_t num_extra) {
+  lookup_key_.resize(num_extra);
+  for (size_t i = 0; i < num_extra; i++) {
+    lookup_key_[i] = static_cast<char>(extra_types[i]);
+  }
+
+  auto it = index_.find(std::string_view(lookup_key_));
+  if (it != index_.end()) [[likely]] {
+    hits_++;
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return it->second->sig;
+  }
+  misses_++;
+
+  auto sig = std::make_shared<PreparedSignature>();
+  sig->abi = fixed.abi;
+  sig->return_type = fixed.return_type;
+  sig->layouts = fixed.layouts;
+  const size_t fixed_args = fixed.arg_types.size();
+  sig->arg_types.reserve(fixed_args + num_extra);
+  sig->arg_types.assign(fixed.arg_types.begin(), fixed.arg_types.end());
+  for (size_t i = 0; i < num_extra; i++) {
+    sig->arg_types.push_back(CTypeToFFI(extra_types[i]));
+  }
+
+  ffi_status status = ffi_prep_cif_var(&sig->cif, sig->abi, static_cast<unsigned int>(fixed_args),
+                                       static_cast<unsigned int>(sig->arg_types.size()), sig->return_type,
+                                       sig->arg_types.data());
+  if (status != FFI_OK) {
+    return nullptr;
+  }
+
+  if (lru_.size() >= capacity_) {
+    index_.erase(std::string_view(lru_.back().key));
+    lru_.pop_back();
+  }
+  lru_.push_front(Entry{lookup_key_, sig});
+  index_.emplace(std::string_view(lru_.front().key), lru_.begin());
+  return sig;
+}
+
+}  // namespace ctypes
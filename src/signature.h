@@ -0,0 +1,107 @@
+#pragma once
+
+#include "shared.h"
+#include "types.h"
+
+namespace ctypes {
+
+// ============================================================================
+// SignatureRegistry — CIF preparati e condivisi tra FFIFunction
+//
+// Binding di SDK grandi creano migliaia di FFIFunction con una manciata di
+// signature distinte. Il ffi_cif e l'array di ffi_type che lo sostiene
+// dipendono solo da (abi, ffi_type di ritorno, ffi_type degli argomenti),
+// quindi vengono internati qui una volta sola e condivisi via shared_ptr.
+//
+// Per struct / union / array la chiave usa l'identità del loro ffi_type
+// (vive dentro StructInfo / ArrayInfo): la PreparedSignature tiene vivo il
+// layout, quindi un indirizzo non può essere riusato da un altro tipo
+// finché l'entry è raggiungibile.
+//
+// Un'unica istanza di processo (Shared()), condivisa dagli environment dei
+// Worker thread: con layout condivisi (registry.h) anche le signature con
+// struct / array by value si preparano una volta sola. Intern() prende un
+// mutex, ma solo alla creazione delle FFIFunction. Le PreparedSignature
+// sono immutabili dopo Intern(): ffi_call le legge senza lock anche dai
+// worker del CallPool.
+// ============================================================================
+
+struct PreparedSignature {
+  ffi_cif cif;
+  ffi_abi abi;
+  ffi_type* return_type;
+  std::vector<ffi_type*> arg_types;  // storage di cif.arg_types
+  // Mantengono vivi gli ffi_type di struct / array referenziati da cif
+  std::vector<std::shared_ptr<void>> layouts;
+};
+
+class SignatureRegistry {
+ public:
+  static SignatureRegistry& Shared();
+
+  // Ritorna la signature condivisa, preparandola al primo uso.
+  // nullptr se ffi_prep_cif fallisce.
+  std::shared_ptr<PreparedSignature> Intern(ffi_abi abi,
+                                            ffi_type* return_type,
+                                            const std::vector<ffi_type*>& arg_types,
+                                            std::vector<std::shared_ptr<void>>&& layouts);
+
+  // Numero di signature distinte ancora in uso
+  size_t Size();
+
+ private:
+  // Rimuove le entry scadute (nessuna FFIFunction le usa più). Chiamata
+  // con mutex_ acquisito.
+  void Sweep();
+
+  std::mutex mutex_;
+
+  // Chiave: byte grezzi di abi + puntatori ffi_type, confrontati esattamente
+  std::unordered_map<std::string, std::weak_ptr<PreparedSignature>> entries_;
+  size_t sweep_at_ = 64;  // prossima soglia di Sweep (raddoppia con la mappa)
+};
+
+// ============================================================================
+// VariadicSignatureCache — CIF variadici di una FFIFunction
+//
+// La parte fissa della signature è quella della FFIFunction; la chiave è
+// quindi solo la sequenza di CType degli argomenti extra, impacchettata un
+// byte per tipo (la lunghezza codifica argc) e cercata via hash con
+// confronto esatto. LRU vera: un hit porta l'entry in testa, un miss a
+// cache piena scarta la meno recente.
+//
+// Le entry sono PreparedSignature immutabili e refcounted, condivise tra
+// Call() e CallAsync(): il frame async tiene la sua copia dello shared_ptr,
+// quindi un'eviction mentre la call è in volo non invalida il CIF.
+// Solo main thread (entrambi i path preparano lì).
+// ============================================================================
+
+class VariadicSignatureCache {
+ public:
+  explicit VariadicSignatureCache(size_t capacity) : capacity_(capacity) {}
+
+  // CIF per `fixed` + argomenti extra di tipo `extra_types`, preparato con
+  // ffi_prep_cif_var al primo uso. nullptr se la preparazione fallisce.
+  std::shared_ptr<PreparedSignature> Get(const PreparedSignature& fixed, const CType* extra_types, size_t num_extra);
+
+  uint64_t Hits() const { return hits_; }
+  uint64_t Misses() const { return misses_; }
+  size_t Size() const { return lru_.size(); }
+  size_t Capacity() const { return capacity_; }
+
+ private:
+  struct Entry {
+    std::string key;
+    std::shared_ptr<PreparedSignature> sig;
+  };
+
+  size_t capacity_;
+  std::list<Entry> lru_;  // front = usata più di recente
+  // Le string_view puntano alla key dentro il nodo della lista (stabile)
+  std::unordered_map<std::string_view, std::list<Entry>::iterator> index_;
+  std::string lookup_key_;  // riusata: niente allocazioni per lookup
+  uint64_t hits_ = 0;
+  uint64_t misses_ = 0;
+};
+
+}  // namespace ctypes
@@ -0,0 +1,331 @@
+#include "slab.h"
+
+namespace ctypes {
+
+Napi::Function SlabPool::GetClass(Napi::Env env) {
+  return DefineClass(env, "SlabPool",
+                     {
+                       InstanceMethod("alloc", &SlabPool::Alloc),
+                       InstanceMethod("release", &SlabPool::Release),
+                       InstanceMethod("reset", &SlabPool::Reset),
+                       InstanceMethod("trim", &SlabPool::Trim),
+                       InstanceMethod("beginScope", &SlabPool::BeginScope),
+                       InstanceMethod("endScope", &SlabPool::EndScope),
+                       InstanceMethod("stats", &SlabPool::GetStats),
+                     });
+}
+
+// Opzione dimensionale: potenza di due in [min, max]. false con eccezione
+// JS pendente; opzione assente / undefined → `out` invariato.
+static bool ReadPowerOfTwoOption(Napi::Env env, const Napi::Object& opts, const char* name, size_t min, size_t max,
+                                 size_t& out) {
+  if (!opts.Has(name)) {
+    return true;
+  }
+  Napi::Value val = opts.Get(name);
+  if (val.IsUndefined()) {
+    return true;
+  }
+  if (!val.IsNumber()) {
+    Napi::TypeError::New(env, std::format("{} must be a number", name)).ThrowAsJavaScriptException();
+    return false;
+  }
+  int64_t raw = val.As<Napi::Number>().Int64Value();
+  if (raw < static_cast<int64_t>(min) || raw > static_cast<int64_t>(max) ||
+      !std::has_single_bit(static_cast<uint64_t>(raw))) {
+    Napi::RangeError::New(env, std::format("{} must be a power of two between {} and {}", name, min, max))
+      .ThrowAsJavaScriptException();
+    return false;
+  }
+  out = static_cast<size_t>(raw);
+  return true;
+}
+
+SlabPool::SlabPool(const Napi::CallbackInfo& info) : Napi::ObjectWrap<SlabPool>(info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() > 0 && !info[0].IsUndefined()) {
+    if (!info[0].IsObject()) {
+      Napi::TypeError::New(env, "SlabPool options must be an object").ThrowAsJavaScriptException();
+      return;
+    }
+    Napi::Object opts = info[0].As<Napi::Object>();
+    if (!ReadPowerOfTwoOption(env, opts, "slabSize", kSlabMinSize, kSlabMaxSize, slab_size_) ||
+        !ReadPowerOfTwoOption(env, opts, "maxBlockSize", kSlabMinBlockSize, kSlabMaxBlockSize, max_block_size_)) {
+      return;
+    }
+  }
+
+  for (size_t size = kSlabMinBlockSize; size <= max_block_size_; size <<= 1) {
+    SizeClass sc;
+    sc.block_size = static_cast<uint32_t>(size);
+    classes_.push_back(std::move(sc));
+  }
+
+  Napi::Value buffer = env.Global().Get("Buffer");
+  Napi::Value from = buffer.IsObject() ? buffer.As<Napi::Object>().Get("from") : env.Undefined();
+  if (!from.IsFunction()) {
+    Napi::Error::New(env, "SlabPool requires the global Buffer").ThrowAsJavaScriptException();
+    return;
+  }
+  buffer_ctor_ = Napi::Persistent(buffer.As<Napi::Object>());
+  buffer_from_ = Napi::Persistent(from.As<Napi::Function>());
+}
+
+void SlabPool::Grow(Napi::Env env, uint32_t size_class) {
+  // ArrayBuffer prima dello slot: se l'allocazione fallisce (eccezione)
+  // slabs_ resta com'era
+  Napi::ArrayBuffer ab = Napi::ArrayBuffer::New(env, slab_size_);
+
+  uint32_t slot;
+  if (!free_slots_.empty()) {
+    slot = free_slots_.back();
+    free_slots_.pop_back();
+  } else {
+    slot = static_cast<uint32_t>(slabs_.size());
+    slabs_.emplace_back();
+  }
+
+  SizeClass& sc = classes_[size_class];
+  const uint32_t blocks = static_cast<uint32_t>(slab_size_ / sc.block_size);
+
+  Slab& slab = slabs_[slot];
+  slab.buffer = Napi::Persistent(ab);
+  slab.data = static_cast<uint8_t*>(ab.Data());
+  slab.size_class = size_class;
+  slab.live = 0;
+  slab.used.assign((blocks + 63) / 64, 0);
+  slab_by_data_[slab.data] = slot;
+  sc.slabs++;
+
+  // In ordine inverso: il primo alloc() prende il blocco 0
+  sc.free.reserve(sc.free.size() + blocks);
+  for (uint32_t block = blocks; block-- > 0;) {
+    sc.free.push_back({slot, block});
+  }
+}
+
+bool SlabPool::IsLive(const BlockRef& ref) const {
+  const Slab& slab = slabs_[ref.slab];
+  return slab.data && ref.block / 64 < slab.used.size() && ((slab.used[ref.block / 64] >> (ref.block % 64)) & 1);
+}
+
+void SlabPool::ReleaseBlock(const BlockRef& ref) {
+  Slab& slab = slabs_[ref.slab];
+  SizeClass& sc = classes_[slab.size_class];
+  slab.used[ref.block / 64] &= ~(uint64_t{1} << (ref.block % 64));
+  slab.live--;
+  sc.live--;
+  sc.free.push_back(ref);
+  releases_++;
+}
+
+Napi::Value SlabPool::Alloc(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsNumber()) {
+    Napi::TypeError::New(env, "Size (number) expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  int64_t size_raw = info[0].ToNumber().Int64Value();
+  if (size_raw <= 0 || size_raw > static_cast<int64_t>(SIZE_MAX / 2)) {
+    Napi::RangeError::New(env, "Invalid buffer size: must be positive and within reasonable limits")
+      .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  const size_t size = static_cast<size_t>(size_raw);
+  allocations_++;
+
+  if (size > max_block_size_) {
+    fallbacks_++;
+    Napi::Buffer<uint8_t> buf = Napi::Buffer<uint8_t>::New(env, size);
+    std::memset(buf.Data(), 0, size);
+    return buf;
+  }
+
+  // Classe 0 = kSlabMinBlockSize (8), poi potenze di due successive
+  const uint32_t size_class =
+    size <= kSlabMinBlockSize ? 0
+                              : static_cast<uint32_t>(std::bit_width(size - 1) - std::bit_width(kSlabMinBlockSize - 1));
+  SizeClass& sc = classes_[size_class];
+  if (sc.free.empty()) {
+    Grow(env, size_class);
+  }
+
+  const BlockRef ref = sc.free.back();
+  sc.free.pop_back();
+
+  Slab& slab = slabs_[ref.slab];
+  slab.used[ref.block / 64] |= uint64_t{1} << (ref.block % 64);
+  slab.live++;
+  sc.live++;
+  if (!scope_marks_.empty()) {
+    scope_log_.push_back(ref);
+  }
+
+  const size_t offset = static_cast<size_t>(ref.block) * sc.block_size;
+  std::memset(slab.data + offset, 0, size);
+  return buffer_from_.Call(buffer_ctor_.Value(),
+                           {slab.buffer.Value(), Napi::Number::New(env, static_cast<double>(offset)),
+                            Napi::Number::New(env, static_cast<double>(size))});
+}
+
+Napi::Value SlabPool::Release(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsTypedArray()) {
+    Napi::TypeError::New(env, "release: Buffer expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::TypedArray view = info[0].As<Napi::TypedArray>();
+  auto it = slab_by_data_.find(view.ArrayBuffer().Data());
+  if (it == slab_by_data_.end()) {
+    // Fallback oltre maxBlockSize o Buffer estraneo: lo gestisce il GC
+    return Napi::Boolean::New(env, false);
+  }
+
+  const Slab& slab = slabs_[it->second];
+  const uint32_t block_size = classes_[slab.size_class].block_size;
+  const size_t offset = view.ByteOffset();
+  if (offset % block_size != 0 || view.ByteLength() == 0 || view.ByteLength() > block_size) {
+    Napi::Error::New(env, "release: buffer is not a block of this pool").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  const BlockRef ref{it->second, static_cast<uint32_t>(offset / block_size)};
+  if (!IsLive(ref)) {
+    Napi::Error::New(env, "release: block already released").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  ReleaseBlock(ref);
+  return Napi::Boolean::New(env, true);
+}
+
+Napi::Value SlabPool::Reset(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  for (SizeClass& sc : classes_) {
+    releases_ += sc.live;
+    sc.live = 0;
+    sc.free.clear();
+  }
+
+  for (uint32_t slot = static_cast<uint32_t>(slabs_.size()); slot-- > 0;) {
+    Slab& slab = slabs_[slot];
+    if (!slab.data) {
+      continue;
+    }
+    SizeClass& sc = classes_[slab.size_class];
+    const uint32_t blocks = static_cast<uint32_t>(slab_size_ / sc.block_size);
+    std::fill(slab.used.begin(), slab.used.end(), 0);
+    slab.live = 0;
+    for (uint32_t block = blocks; block-- > 0;) {
+      sc.free.push_back({slot, block});
+    }
+  }
+
+  // Gli scope aperti restano aperti, ma senza blocchi da rilasciare
+  scope_log_.clear();
+  std::fill(scope_marks_.begin(), scope_marks_.end(), 0);
+  return env.Undefined();
+}
+
+Napi::Value SlabPool::Trim(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  std::vector<bool> trimmed(slabs_.size(), false);
+  uint32_t count = 0;
+  for (uint32_t slot = 0; slot < slabs_.size(); slot++) {
+    Slab& slab = slabs_[slot];
+    if (!slab.data || slab.live != 0) {
+      continue;
+    }
+    classes_[slab.size_class].slabs--;
+    slab_by_data_.erase(slab.data);
+    // Le view ancora in giro tengono vivo l'ArrayBuffer: la memoria esce
+    // dal pool ma la libera il GC
+    slab.buffer.Reset();
+    slab.data = nullptr;
+    slab.used.clear();
+    free_slots_.push_back(slot);
+    trimmed[slot] = true;
+    count++;
+  }
+
+  if (count > 0) {
+    for (SizeClass& sc : classes_) {
+      std::erase_if(sc.free, [&](const BlockRef& ref) { return trimmed[ref.slab]; });
+    }
+  }
+  return Napi::Number::New(env, count);
+}
+
+Napi::Value SlabPool::BeginScope(const Napi::CallbackInfo& info) {
+  scope_marks_.push_back(scope_log_.size());
+  return Napi::Number::New(info.Env(), static_cast<double>(scope_marks_.size()));
+}
+
+Napi::Value SlabPool::EndScope(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (scope_marks_.empty()) {
+    Napi::Error::New(env, "endScope: no open scope").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  const size_t mark = scope_marks_.back();
+  scope_marks_.pop_back();
+
+  // I blocchi già rilasciati a mano (o riassegnati e quindi loggati di
+  // nuovo più avanti) si saltano con il bitmap
+  uint32_t released = 0;
+  for (size_t i = mark; i < scope_log_.size(); i++) {
+    if (IsLive(scope_log_[i])) {
+      ReleaseBlock(scope_log_[i]);
+      released++;
+    }
+  }
+  scope_log_.resize(mark);
+  return Napi::Number::New(env, released);
+}
+
+Napi::Value SlabPool::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Napi::Object stats = Napi::Object::New(env);
+  Napi::Array classes = Napi::Array::New(env, classes_.size());
+  size_t slabs = 0;
+  size_t live = 0;
+  size_t in_use = 0;
+  for (size_t i = 0; i < classes_.size(); i++) {
+    const SizeClass& sc = classes_[i];
+    Napi::Object entry = Napi::Object::New(env);
+    entry.Set("blockSize", Napi::Number::New(env, sc.block_size));
+    entry.Set("slabs", Napi::Number::New(env, sc.slabs));
+    entry.Set("live", Napi::Number::New(env, static_cast<double>(sc.live)));
+    entry.Set("free", Napi::Number::New(env, static_cast<double>(sc.free.size())));
+    classes.Set(static_cast<uint32_t>(i), entry);
+    slabs += sc.slabs;
+    live += sc.live;
+    in_use += sc.live * sc.block_size;
+  }
+
+  stats.Set("slabSize", Napi::Number::New(env, static_cast<double>(slab_size_)));
+  stats.Set("maxBlockSize", Napi::Number::New(env, static_cast<double>(max_block_size_)));
+  stats.Set("slabs", Napi::Number::New(env, static_cast<double>(slabs)));
+  stats.Set("reservedBytes", Napi::Number::New(env, static_cast<double>(slabs * slab_size_)));
+  stats.Set("liveBlocks", Napi::Number::New(env, static_cast<double>(live)));
+  stats.Set("inUseBytes", Napi::Number::New(env, static_cast<double>(in_use)));
+  stats.Set("allocations", Napi::Number::New(env, static_cast<double>(allocations_)));
+  stats.Set("releases", Napi::Number::New(env, static_cast<double>(releases_)));
+  stats.Set("fallbacks", Napi::Number::New(env, static_cast<double>(fallbacks_)));
+  stats.Set("scopes", Napi::Number::New(env, static_cast<double>(scope_marks_.size())));
+  stats.Set("classes", classes);
+  return stats;
+}
+
+}  // namespace ctypes
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "shared.h"
+
+namespace ctypes {
+
+// ============================================================================
+// SlabPool — allocatore a size class per buffer piccoli (ctypes.pool())
+//
+// alloc() / create_string_buffer() creano un Buffer (e un ArrayBuffer con
+// la sua contabilità di memoria esterna) per ogni oggetto, anche per struct
+// da pochi byte che vivono una sola chiamata. Con ritmi alti di allocazioni
+// minuscole la contabilità esterna forza GC frequenti e frammenta l'heap.
+//
+// Il pool riserva slab da `slabSize` byte (un solo ArrayBuffer ciascuno) e
+// li divide in blocchi di una size class (potenze di due da 8 byte a
+// `maxBlockSize`). alloc() ritorna un Buffer *view* su un blocco: nessun
+// nuovo backing store, nessuna memoria esterna in più. Le richieste oltre
+// maxBlockSize ripiegano su un Buffer ordinario (contato in `fallbacks`).
+//
+// Rilascio esplicito (release / reset) o a scope (beginScope / endScope,
+// usati da pool.scope() lato JS): il blocco torna nella free list della
+// sua classe. Un Buffer rilasciato resta una view valida sullo slab (lo
+// slab è tenuto vivo dal GC finché esistono view), ma il blocco può essere
+// riassegnato: usarlo dopo il rilascio è un errore come un use-after-free,
+// senza però toccare memoria già liberata.
+//
+// Solo main thread: il pool non è condiviso tra environment.
+// ============================================================================
+
+static constexpr size_t kSlabMinBlockSize = 8;
+static constexpr size_t kSlabDefaultBlockSize = 256;
+static constexpr size_t kSlabMaxBlockSize = 4096;
+static constexpr size_t kSlabDefaultSize = 64 * 1024;
+static constexpr size_t kSlabMinSize = 4 * 1024;
+static constexpr size_t kSlabMaxSize = 16 * 1024 * 1024;
+
+class SlabPool : public Napi::ObjectWrap<SlabPool> {
+ public:
+  static Napi::Function GetClass(Napi::Env env);
+
+  // new SlabPool({ slabSize?, maxBlockSize? })
+  SlabPool(const Napi::CallbackInfo& info);
+
+  // alloc(size) -> Buffer azzerato (view su slab, o Buffer ordinario oltre
+  // maxBlockSize)
+  Napi::Value Alloc(const Napi::CallbackInfo& info);
+  // release(buffer) -> true se il blocco è tornato al pool, false se il
+  // Buffer non viene da uno slab (fallback: lo libera il GC)
+  Napi::Value Release(const Napi::CallbackInfo& info);
+  // Rilascia tutti i blocchi (gli slab restano riservati)
+  Napi::Value Reset(const Napi::CallbackInfo& info);
+  // Restituisce gli slab senza blocchi vivi; ritorna quanti
+  Napi::Value Trim(const Napi::CallbackInfo& info);
+  // Scope annidati: endScope() rilascia i blocchi allocati dal beginScope()
+  // corrispondente e non ancora rilasciati
+  Napi::Value BeginScope(const Napi::CallbackInfo& info);
+  Napi::Value EndScope(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+
+ private:
+  struct Slab {
+    Napi::Reference<Napi::ArrayBuffer> buffer;
+    uint8_t* data = nullptr;
+    uint32_t size_class = 0;
+    uint32_t live = 0;
+    std::vector<uint64_t> used;  // bitmap dei blocchi assegnati
+  };
+
+  struct BlockRef {
+    uint32_t slab;
+    uint32_t block;
+  };
+
+  struct SizeClass {
+    uint32_t block_size = 0;
+    uint32_t slabs = 0;
+    size_t live = 0;
+    std::vector<BlockRef> free;
+  };
+
+  // Nuovo slab per la classe (Napi::Error se l'ArrayBuffer non si alloca)
+  void Grow(Napi::Env env, uint32_t size_class);
+  void ReleaseBlock(const BlockRef& ref);
+  // Blocco assegnato; false anche per slot restituiti da trim() o riusati
+  // da uno slab di un'altra classe
+  bool IsLive(const BlockRef& ref) const;
+
+  size_t slab_size_ = kSlabDefaultSize;
+  size_t max_block_size_ = kSlabDefaultBlockSize;
+  std::vector<SizeClass> classes_;
+  // Indicizzati per slot; gli slot restituiti da trim() hanno data == nullptr
+  // e finiscono in free_slots_
+  std::vector<Slab> slabs_;
+  std::vector<uint32_t> free_slots_;
+  std::unordered_map<const void*, uint32_t> slab_by_data_;
+
+  // Blocchi allocati dentro uno scope, e inizio di ogni scope aperto
+  std::vector<BlockRef> scope_log_;
+  std::vector<size_t> scope_marks_;
+
+  // Buffer.from(arrayBuffer, offset, length): crea la view con il prototype
+  // di Buffer (N-API crea solo Uint8Array su ArrayBuffer esistenti)
+  Napi::FunctionReference buffer_from_;
+  Napi::ObjectReference buffer_ctor_;
+
+  uint64_t allocations_ = 0;
+  uint64_t releases_ = 0;
+  uint64_t fallbacks_ = 0;
+};
+
+}  // namespace ctypes
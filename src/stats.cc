@@ -0,0 +1,29 @@
+#include "stats.h"
+
+namespace ctypes {
+
+static Napi::Object PhaseToJS(Napi::Env env, const PhaseStats& phase) {
+  Napi::Object obj = Napi::Object::New(env);
+  obj.Set("totalNs", Napi::Number::New(env, static_cast<double>(phase.total_ns)));
+  Napi::Array histogram = Napi::Array::New(env, kStatsHistogramBuckets);
+  for (size_t i = 0; i < kStatsHistogramBuckets; i++) {
+    histogram.Set(static_cast<uint32_t>(i), Napi::Number::New(env, static_cast<double>(phase.histogram[i])));
+  }
+  obj.Set("histogram", histogram);
+  return obj;
+}
+
+void CallStatsToJS(Napi::Env env, const CallStats& stats, Napi::Object& obj) {
+  obj.Set("calls", Napi::Number::New(env, static_cast<double>(stats.calls)));
+  obj.Set("trampolineCalls", Napi::Number::New(env, static_cast<double>(stats.trampoline_calls)));
+  obj.Set("asyncCalls", Napi::Number::New(env, static_cast<double>(stats.async_calls)));
+  obj.Set("batchCalls", Napi::Number::New(env, static_cast<double>(stats.batch_calls)));
+  obj.Set("stringBufferGrowths", Napi::Number::New(env, static_cast<double>(stats.string_buffer_growths)));
+  obj.Set("largeArgOverflows", Napi::Number::New(env, static_cast<double>(stats.large_arg_overflows)));
+  obj.Set("marshal", PhaseToJS(env, stats.marshal));
+  obj.Set("ffiCall", PhaseToJS(env, stats.ffi_call));
+  obj.Set("finalize", PhaseToJS(env, stats.finalize));
+  obj.Set("total", PhaseToJS(env, stats.total));
+}
+
+}  // namespace ctypes
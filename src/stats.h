@@ -0,0 +1,59 @@
+#pragma once
+
+#include "shared.h"
+
+namespace ctypes {
+
+// ============================================================================
+// CallStats — strumentazione opt-in per FFIFunction
+//
+// Attiva per funzione (opzione `stats`, anche a livello di Library) o
+// globalmente (setStatsEnabled). Da spenta il costo per call è il test di
+// due bool; da accesa tre letture di steady_clock per call. Le fasi
+// misurate sono quelle di Call(): MarshalArguments (incluso il setup
+// variadico), ffi_call + cattura errno, FinalizeCall (conversione del
+// ritorno + errcheck). Le call coperte da un trampolino non hanno fasi
+// separate e finiscono solo in `total`.
+//
+// Solo main thread: callAsync conta le chiamate ma non le misura (il
+// worker del pool non tocca le statistiche).
+// ============================================================================
+
+// Istogramma log2 in nanosecondi: bucket i = [2^i, 2^(i+1)) ns, il bucket 0
+// include anche 0 e l'ultimo raccoglie tutto ciò che è più lento.
+static constexpr size_t kStatsHistogramBuckets = 32;
+
+struct PhaseStats {
+  uint64_t total_ns = 0;
+  uint64_t histogram[kStatsHistogramBuckets] = {};
+
+  inline void Record(uint64_t ns) {
+    total_ns += ns;
+    size_t bucket = ns == 0 ? 0 : static_cast<size_t>(std::bit_width(ns)) - 1;
+    histogram[std::min(bucket, kStatsHistogramBuckets - 1)]++;
+  }
+};
+
+struct CallStats {
+  uint64_t calls = 0;                  // Call() completate
+  uint64_t trampoline_calls = 0;       // di cui con trampolino (misurate dal percorso generico)
+  uint64_t async_calls = 0;            // callAsync accodate
+  uint64_t batch_calls = 0;            // crossing di callBatch (non elementi)
+  uint64_t string_buffer_growths = 0;  // riallocazioni dello string buffer
+  uint64_t large_arg_overflows = 0;    // aggregati fuori dall'arena preallocata
+  PhaseStats marshal;
+  PhaseStats ffi_call;
+  PhaseStats finalize;
+  PhaseStats total;
+};
+
+inline uint64_t StatsNow() {
+  return static_cast<uint64_t>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count());
+}
+
+// Riempie `obj` con i contatori e le fasi di `stats`
+void CallStatsToJS(Napi::Env env, const CallStats& stats, Napi::Object& obj);
+
+}  // namespace ctypes
@@ -1,6 +1,8 @@
 #include "struct.h"
 
+#include "addon.h"
 #include "array.h"
+#include "registry.h"
 
 namespace ctypes {
 // ============================================================================
@@ -85,6 +87,7 @@ void StructInfo::CalculateLayout() {
   if (fields_.empty()) {
     size_ = 0;
     alignment_ = 1;
+    BuildPlan();
     return;
   }
 
@@ -123,6 +126,263 @@ void StructInfo::CalculateLayout() {
   // Padding finale per allineare la struct stessa
   size_t final_padding = (alignment_ - (size_ % alignment_)) % alignment_;
   size_ += final_padding;
+
+  BuildPlan();
+}
+
+bool StructInfo::SetLayout(std::vector<FieldInfo> fields, size_t size, size_t alignment) {
+  if (shared_id_) {
+    return false;
+  }
+  if (alignment == 0 || (alignment & (alignment - 1)) != 0 || size % alignment != 0) {
+    return false;
+  }
+
+  for (const auto& field : fields) {
+    size_t field_alignment = GetTypeAlignment(field.type, field.struct_type, field.array_type);
+    if (field_alignment > alignment || field.offset % field_alignment != 0 || field.offset > size ||
+        field.size > size - field.offset) {
+      return false;
+    }
+    if (is_union_ && field.offset != 0) {
+      return false;
+    }
+  }
+
+  fields_ = std::move(fields);
+  size_ = size;
+  alignment_ = alignment;
+  ffi_type_.reset();
+  BuildPlan();
+  return true;
+}
+
+// ============================================================================
+// Marshal plan
+//
+// JSToStruct / StructToJS giravano su fields_ ricorsivamente: ogni campo
+// creava la chiave V8 da std::string, i campi anonymous ricorrevano (con
+// un secondo memset della loro regione) e i primitivi passavano dallo
+// switch di JSToC / CToJS. Il plan fissa tutto in CalculateLayout: lista
+// piatta con offset assoluti e converter già risolti per tipo.
+// ============================================================================
+
+template <typename T>
+static napi_value ReadInt32Field(napi_env env, const void* src) {
+  T val;
+  memcpy(&val, src, sizeof(val));
+  napi_value result;
+  napi_create_int32(env, static_cast<int32_t>(val), &result);
+  return result;
+}
+
+template <typename T>
+static napi_value ReadUint32Field(napi_env env, const void* src) {
+  T val;
+  memcpy(&val, src, sizeof(val));
+  napi_value result;
+  napi_create_uint32(env, static_cast<uint32_t>(val), &result);
+  return result;
+}
+
+template <typename T>
+static napi_value ReadDoubleField(napi_env env, const void* src) {
+  T val;
+  memcpy(&val, src, sizeof(val));
+  napi_value result;
+  napi_create_double(env, static_cast<double>(val), &result);
+  return result;
+}
+
+// Stesso troncamento di JSToC (Int32Value / Uint32Value + static_cast)
+template <typename T>
+static bool WriteInt32Field(napi_env env, napi_value value, void* dest) {
+  int32_t raw;
+  if (napi_get_value_int32(env, value, &raw) != napi_ok) {
+    return false;
+  }
+  T val = static_cast<T>(raw);
+  memcpy(dest, &val, sizeof(val));
+  return true;
+}
+
+template <typename T>
+static bool WriteUint32Field(napi_env env, napi_value value, void* dest) {
+  uint32_t raw;
+  if (napi_get_value_uint32(env, value, &raw) != napi_ok) {
+    return false;
+  }
+  T val = static_cast<T>(raw);
+  memcpy(dest, &val, sizeof(val));
+  return true;
+}
+
+template <typename T>
+static bool WriteDoubleField(napi_env env, napi_value value, void* dest) {
+  double raw;
+  if (napi_get_value_double(env, value, &raw) != napi_ok) {
+    return false;
+  }
+  T val = static_cast<T>(raw);
+  memcpy(dest, &val, sizeof(val));
+  return true;
+}
+
+static void ResolveFieldConverters(FieldPlan& step) {
+  switch (step.type) {
+    case CType::CTYPES_INT8:
+      step.read = &ReadInt32Field<int8_t>;
+      step.write = &WriteInt32Field<int8_t>;
+      break;
+    case CType::CTYPES_UINT8:
+      step.read = &ReadUint32Field<uint8_t>;
+      step.write = &WriteUint32Field<uint8_t>;
+      break;
+    case CType::CTYPES_INT16:
+      step.read = &ReadInt32Field<int16_t>;
+      step.write = &WriteInt32Field<int16_t>;
+      break;
+    case CType::CTYPES_UINT16:
+      step.read = &ReadUint32Field<uint16_t>;
+      step.write = &WriteUint32Field<uint16_t>;
+      break;
+    case CType::CTYPES_INT32:
+      step.read = &ReadInt32Field<int32_t>;
+      step.write = &WriteInt32Field<int32_t>;
+      break;
+    case CType::CTYPES_UINT32:
+      step.read = &ReadUint32Field<uint32_t>;
+      step.write = &WriteUint32Field<uint32_t>;
+      break;
+    case CType::CTYPES_FLOAT:
+      step.read = &ReadDoubleField<float>;
+      step.write = &WriteDoubleField<float>;
+      break;
+    case CType::CTYPES_DOUBLE:
+      step.read = &ReadDoubleField<double>;
+      step.write = &WriteDoubleField<double>;
+      break;
+    default:
+      // BigInt, puntatori, stringhe, bool...: restano su CToJS / JSToC
+      step.read = nullptr;
+      step.write = nullptr;
+      break;
+  }
+}
+
+void StructInfo::AppendPlan(size_t base, std::vector<FieldPlan>& out) const {
+  for (const auto& field : fields_) {
+    if (field.struct_type && field.is_anonymous) {
+      // I sotto-campi vivono direttamente nell'oggetto del parent
+      field.struct_type->AppendPlan(base + field.offset, out);
+      continue;
+    }
+
+    FieldPlan step;
+    step.name = field.name;
+    step.type = field.type;
+    step.offset = base + field.offset;
+    step.size = field.size;
+    step.struct_type = field.struct_type;
+    step.array_type = field.array_type;
+    step.read = nullptr;
+    step.write = nullptr;
+    if (!field.struct_type && !field.array_type) {
+      ResolveFieldConverters(step);
+    }
+    out.push_back(std::move(step));
+  }
+}
+
+void StructInfo::BuildPlan() {
+  plan_.clear();
+  padding_.clear();
+  keys_.clear();
+  AppendPlan(0, plan_);
+
+  // Buchi tra i campi (padding di allineamento, finale, e dei nested
+  // anonymous). Con campi sovrapposti (union, anche anonymous) si torna al
+  // memset completo: un campo assente non va azzerato sopra a uno presente.
+  std::vector<std::pair<size_t, size_t>> ranges;
+  ranges.reserve(plan_.size());
+  for (const auto& step : plan_) {
+    ranges.emplace_back(step.offset, step.offset + step.size);
+  }
+  std::sort(ranges.begin(), ranges.end());
+
+  clear_all_ = is_union_;
+  size_t cursor = 0;
+  for (const auto& [begin, end] : ranges) {
+    if (begin < cursor) {
+      clear_all_ = true;
+      break;
+    }
+    if (begin > cursor) {
+      padding_.emplace_back(cursor, begin - cursor);
+    }
+    cursor = end;
+  }
+  if (!clear_all_ && cursor < size_) {
+    padding_.emplace_back(cursor, size_ - cursor);
+  }
+  if (clear_all_) {
+    padding_.clear();
+  }
+}
+
+const StructInfo::KeyList* StructInfo::EnsureKeys(Napi::Env env) {
+  if (!shared_id_) [[likely]] {
+    if (keys_.size() == plan_.size() || FillKeys(env, keys_)) [[likely]] {
+      return &keys_;
+    }
+    return nullptr;
+  }
+
+  // Layout condiviso: ogni environment ha le sue chiavi
+  CTypesAddon* addon = env.GetInstanceData<CTypesAddon>();
+  if (!addon) {
+    Napi::Error::New(env, "Addon not properly initialized").ThrowAsJavaScriptException();
+    return nullptr;
+  }
+  KeyList& keys = addon->shared_struct_keys[shared_id_];
+  if (keys.size() == plan_.size() || FillKeys(env, keys)) {
+    return &keys;
+  }
+  return nullptr;
+}
+
+bool StructInfo::FillKeys(Napi::Env env, KeyList& keys) const {
+  keys.clear();
+  keys.reserve(plan_.size());
+  for (const auto& step : plan_) {
+    napi_value key;
+    napi_status status = napi_create_string_utf8(env, step.name.data(), step.name.size(), &key);
+    if (status != napi_ok) {
+      keys.clear();
+      Napi::Error::New(env, "Failed to create struct field key").ThrowAsJavaScriptException();
+      return false;
+    }
+    keys.push_back(Napi::Persistent(Napi::String(env, key)));
+  }
+  return true;
+}
+
+void StructInfo::Share() {
+  if (shared_id_) {
+    return;
+  }
+  for (const auto& field : fields_) {
+    if (field.struct_type) {
+      field.struct_type->Share();
+    } else if (field.array_type) {
+      field.array_type->Share();
+    }
+  }
+  // Costruiti qui, sul thread proprietario: dopo la pubblicazione nessuno
+  // li modifica più
+  GetFFIType();
+  keys_.clear();
+  shared_id_ = NextSharedLayoutId();
 }
 
 ffi_type* StructInfo::GetFFIType() {
@@ -157,51 +417,54 @@ bool StructInfo::JSToStruct(Napi::Env env, Napi::Object obj, void* buffer, size_
     Napi::TypeError::New(env, "Buffer too small for struct").ThrowAsJavaScriptException();
     return false;
   }
+  const KeyList* keys = EnsureKeys(env);
+  if (!keys) {
+    return false;
+  }
 
-  // Inizializza buffer a zero
-  std::memset(buffer, 0, size_);
+  char* base = static_cast<char*>(buffer);
 
-  // Copia ogni campo
-  for (const auto& field : fields_) {
-    void* field_ptr = static_cast<char*>(buffer) + field.offset;
+  // Azzera solo i byte che nessun campo sovrascrive (vedi BuildPlan)
+  if (clear_all_) {
+    std::memset(buffer, 0, size_);
+  } else {
+    for (const auto& [offset, length] : padding_) {
+      std::memset(base + offset, 0, length);
+    }
+  }
 
-    if (field.array_type) {
-      // Array field — single Get() + undefined test evita il doppio
-      // V8-crossing di Has()+Get().
-      Napi::Value value = obj.Get(field.name);
-      if (value.IsUndefined()) {
-        continue;  // campo opzionale
+  for (size_t i = 0; i < plan_.size(); i++) {
+    const FieldPlan& step = plan_[i];
+    void* field_ptr = base + step.offset;
+
+    // Single Get() + undefined test evita il doppio V8-crossing di Has()+Get()
+    Napi::Value value = obj.Get((*keys)[i].Value());
+    if (value.IsUndefined()) {
+      // Campo opzionale
+      if (!clear_all_) {
+        std::memset(field_ptr, 0, step.size);
       }
-      if (!field.array_type->JSToArray(env, value, field_ptr, field.size)) {
+      continue;
+    }
+
+    if (step.array_type) {
+      if (!step.array_type->JSToArray(env, value, field_ptr, step.size)) {
         return false;
       }
-    } else if (field.struct_type) {
-      // Nested struct
-      if (field.is_anonymous) {
-        // Anonymous field: leggi i suoi campi direttamente dall'oggetto
-        if (!field.struct_type->JSToStruct(env, obj, field_ptr, field.size)) {
-          return false;
-        }
-      } else {
-        Napi::Value value = obj.Get(field.name);
-        if (value.IsUndefined()) {
-          continue;  // campo opzionale
-        }
-        if (!value.IsObject()) {
-          Napi::TypeError::New(env, std::format("Field {} must be an object", field.name)).ThrowAsJavaScriptException();
-          return false;
-        }
-        if (!field.struct_type->JSToStruct(env, value.As<Napi::Object>(), field_ptr, field.size)) {
-          return false;
-        }
+    } else if (step.struct_type) {
+      if (!value.IsObject()) {
+        Napi::TypeError::New(env, std::format("Field {} must be an object", step.name)).ThrowAsJavaScriptException();
+        return false;
       }
-    } else {
-      // Tipo primitivo
-      Napi::Value value = obj.Get(field.name);
-      if (value.IsUndefined()) {
-        continue;  // campo opzionale
+      if (!step.struct_type->JSToStruct(env, value.As<Napi::Object>(), field_ptr, step.size)) {
+        return false;
       }
-      if (JSToC(env, value, field.type, field_ptr, field.size) < 0) {
+    } else if (!step.write || !step.write(env, value, field_ptr)) {
+      // JSToC non garantisce di scrivere tutto il campo (es. errori): parte da zero
+      if (!clear_all_) {
+        std::memset(field_ptr, 0, step.size);
+      }
+      if (JSToC(env, value, step.type, field_ptr, step.size) < 0) {
         return false;
       }
     }
@@ -211,30 +474,64 @@ bool StructInfo::JSToStruct(Napi::Env env, Napi::Object obj, void* buffer, size_
 }
 
 Napi::Object StructInfo::StructToJS(Napi::Env env, const void* buffer) {
-  Napi::Object obj = Napi::Object::New(env);
-  WriteFieldsTo(env, buffer, obj);
-  return obj;
-}
+  const KeyList* keys = EnsureKeys(env);
+  if (!keys) {
+    return Napi::Object();
+  }
 
-void StructInfo::WriteFieldsTo(Napi::Env env, const void* buffer, Napi::Object obj) {
-  for (const auto& field : fields_) {
-    const void* field_ptr = static_cast<const char*>(buffer) + field.offset;
+  const char* base = static_cast<const char*>(buffer);
+  const size_t count = plan_.size();
+
+  // Le struct tipiche stanno nello stack; oltre si passa al vector
+  static constexpr size_t kInlineProperties = 16;
+  napi_property_descriptor inline_props[kInlineProperties];
+  std::vector<napi_property_descriptor> heap_props;
+  napi_property_descriptor* props = inline_props;
+  if (count > kInlineProperties) {
+    heap_props.resize(count);
+    props = heap_props.data();
+  }
 
-    if (field.array_type) {
-      obj.Set(field.name, field.array_type->ArrayToJS(env, field_ptr));
-    } else if (field.struct_type) {
-      if (field.is_anonymous) {
-        // Scrivi i sotto-campi direttamente nell'obj esterno: evita di
-        // creare un oggetto intermedio, enumerarne le chiavi e ricopiarle
-        // una a una (GetPropertyNames + N Get/Set coppie V8↔C++).
-        field.struct_type->WriteFieldsTo(env, field_ptr, obj);
-      } else {
-        obj.Set(field.name, field.struct_type->StructToJS(env, field_ptr));
-      }
+  for (size_t i = 0; i < count; i++) {
+    const FieldPlan& step = plan_[i];
+    const void* field_ptr = base + step.offset;
+
+    napi_value value;
+    if (step.array_type) {
+      value = step.array_type->ArrayToJS(env, field_ptr);
+    } else if (step.struct_type) {
+      value = step.struct_type->StructToJS(env, field_ptr);
+    } else if (step.read) {
+      value = step.read(env, field_ptr);
     } else {
-      obj.Set(field.name, CToJS(env, field_ptr, field.type));
+      value = CToJS(env, field_ptr, step.type);
+    }
+    if (value == nullptr) {
+      return Napi::Object();
+    }
+
+    props[i] = {nullptr, (*keys)[i].Value(), nullptr, nullptr, nullptr, value, napi_default_jsproperty, nullptr};
+  }
+
+  napi_value obj;
+  napi_status status = napi_create_object(env, &obj);
+  if (status == napi_ok && count > 0) {
+    status = napi_define_properties(env, obj, count, props);
+  }
+  if (status != napi_ok) {
+    Napi::Error::New(env, "Failed to create struct object").ThrowAsJavaScriptException();
+    return Napi::Object();
+  }
+  return Napi::Object(env, obj);
+}
+
+const FieldPlan* StructInfo::FindPlanField(const std::string& name) const {
+  for (const auto& step : plan_) {
+    if (step.name == name) {
+      return &step;
     }
   }
+  return nullptr;
 }
 
 // ============================================================================
@@ -250,6 +547,7 @@ Napi::Function StructType::GetClass(Napi::Env env) {
                        InstanceMethod("create", &StructType::Create),
                        InstanceMethod("read", &StructType::Read),
                        InstanceMethod("toObject", &StructType::ToObject),
+                       InstanceMethod("readColumns", &StructType::ReadColumns),
                      });
 }
 
@@ -271,6 +569,12 @@ StructType::StructType(const Napi::CallbackInfo& info) : Napi::ObjectWrap<Struct
 Napi::Value StructType::AddField(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
 
+  if (struct_info_->IsShared()) {
+    Napi::Error::New(env, "StructType is shared across environments and can no longer be modified")
+      .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
   if (info.Length() < 2) {
     Napi::TypeError::New(env, "Expected (name, type)").ThrowAsJavaScriptException();
     return env.Undefined();
@@ -432,4 +736,83 @@ Napi::Value StructType::ToObject(const Napi::CallbackInfo& info) {
   return env.Undefined();
 }
 
+// Array di N struct (AoS) -> una colonna TypedArray per campo (SoA). Ogni
+// colonna è un gather strided a dimensione di elemento costante.
+Napi::Value StructType::ReadColumns(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 3 || !info[2].IsArray()) {
+    Napi::TypeError::New(env, "Expected (ptr, count, fieldNames[, stride])").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  uint8_t* ptr = nullptr;
+  size_t limit = 0;
+  size_t count = 0;
+  if (!GetPointerArg(env, info[0], ptr, limit) || !GetSizeArg(env, info[1], "count", count)) {
+    return env.Undefined();
+  }
+
+  const size_t struct_size = struct_info_->GetSize();
+  size_t stride = struct_size;
+  if (info.Length() > 3 && !info[3].IsUndefined()) {
+    if (!GetSizeArg(env, info[3], "stride", stride)) {
+      return env.Undefined();
+    }
+    if (stride < struct_size) {
+      Napi::RangeError::New(env, std::format("stride must be >= struct size ({})", struct_size))
+        .ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+  }
+
+  if (!CheckStridedSpan(env, count, stride, struct_size, limit)) {
+    return env.Undefined();
+  }
+  if (!ptr && count > 0) {
+    Napi::Error::New(env, "Cannot read from null pointer").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Array names = info[2].As<Napi::Array>();
+  const uint32_t num_columns = names.Length();
+  Napi::Object result = Napi::Object::New(env);
+
+  for (uint32_t c = 0; c < num_columns; c++) {
+    Napi::Value name_val = names.Get(c);
+    if (!name_val.IsString()) {
+      Napi::TypeError::New(env, "fieldNames must be an array of strings").ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    std::string name = name_val.As<Napi::String>().Utf8Value();
+
+    const FieldPlan* step = struct_info_->FindPlanField(name);
+    if (!step) {
+      Napi::TypeError::New(env, std::format("Unknown field: {}", name)).ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    napi_typedarray_type ta_type;
+    if (step->struct_type || step->array_type || !CTypeToTypedArrayType(step->type, ta_type)) {
+      Napi::TypeError::New(env, std::format("readColumns: field {} is not a numeric primitive", name))
+        .ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+
+    void* data = nullptr;
+    napi_value arraybuffer;
+    napi_value column;
+    if (napi_create_arraybuffer(env, count * step->size, &data, &arraybuffer) != napi_ok ||
+        napi_create_typedarray(env, ta_type, count, arraybuffer, 0, &column) != napi_ok) {
+      Napi::Error::New(env, "Failed to allocate typed array").ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    if (count > 0) {
+      CopyStrided(data, step->size, ptr + step->offset, stride, count, step->size);
+    }
+    result.Set(name_val, Napi::Value(env, column));
+  }
+
+  return result;
+}
+
 }  // namespace ctypes
@@ -18,6 +18,24 @@ struct FieldInfo {
   bool is_anonymous;                              // se true, i suoi campi sono accessibili direttamente
 };
 
+// Converter precompilati di un campo primitivo (vedi FieldPlan). Il writer
+// ritorna false se il valore non è del tipo atteso: si ricade su JSToC.
+using FieldReader = napi_value (*)(napi_env env, const void* src);
+using FieldWriter = bool (*)(napi_env env, napi_value value, void* dest);
+
+// Un passo del marshal plan: i campi anonymous sono già appiattiti nel
+// parent, quindi l'offset è assoluto rispetto all'inizio della struct.
+struct FieldPlan {
+  std::string name;
+  CType type;
+  size_t offset;
+  size_t size;
+  std::shared_ptr<class StructInfo> struct_type;  // nested non anonymous
+  std::shared_ptr<ArrayInfo> array_type;
+  FieldReader read;   // nullptr: CToJS
+  FieldWriter write;  // nullptr: JSToC
+};
+
 // StructInfo - layout di una struct/union (come CPython StgInfo)
 class StructInfo {
  public:
@@ -36,6 +54,11 @@ class StructInfo {
   // Calcola offsets e padding (seguendo regole platform ABI)
   void CalculateLayout();
 
+  // Layout già calcolato (binding manifest, vedi manifest.h): offset e size
+  // dei campi arrivano dal manifest, niente CalculateLayout. false se il
+  // layout è incoerente con i tipi dei campi su questa piattaforma.
+  bool SetLayout(std::vector<FieldInfo> fields, size_t size, size_t alignment);
+
   // Getter
   size_t GetSize() const { return size_; }
   size_t GetAlignment() const { return alignment_; }
@@ -45,17 +68,36 @@ class StructInfo {
   // Crea ffi_type custom per questa struct (necessario per libffi)
   ffi_type* GetFFIType();
 
+  // Rende il layout immutabile e condivisibile tra environment (vedi
+  // registry.h): costruisce ffi_type (anche dei nested) e da qui in poi le
+  // chiavi JS dei campi vivono per-environment in CTypesAddon. AddField /
+  // SetLayout successivi falliscono.
+  void Share();
+  bool IsShared() const { return shared_id_ != 0; }
+
   // Converte JS object -> C struct buffer
   bool JSToStruct(Napi::Env env, Napi::Object obj, void* buffer, size_t bufsize);
 
-  // Converte C struct buffer -> JS object
+  // Converte C struct buffer -> JS object. Tutte le proprietà vengono
+  // definite con una sola napi_define_properties, sempre nello stesso
+  // ordine: gli oggetti prodotti condividono la hidden class.
   Napi::Object StructToJS(Napi::Env env, const void* buffer);
 
-  // Scrive i campi direttamente in un oggetto esistente. Usato dal path
-  // _anonymous_ per evitare oggetti intermedi.
-  void WriteFieldsTo(Napi::Env env, const void* buffer, Napi::Object target);
+  // Passo del plan per nome (campi anonymous già appiattiti); nullptr se
+  // non esiste
+  const FieldPlan* FindPlanField(const std::string& name) const;
 
  private:
+  // Ricostruisce plan_ / padding_ (chiamato da CalculateLayout)
+  void BuildPlan();
+  // Appiattisce i campi di questa struct in `out`, spostati di `base`
+  void AppendPlan(size_t base, std::vector<FieldPlan>& out) const;
+  using KeyList = std::vector<Napi::Reference<Napi::String>>;
+  // Chiavi JS persistenti per plan_ nell'environment `env`, create al primo
+  // uso. nullptr con eccezione JS pendente.
+  const KeyList* EnsureKeys(Napi::Env env);
+  bool FillKeys(Napi::Env env, KeyList& keys) const;
+
   bool is_union_;
   size_t size_;
   size_t alignment_;
@@ -63,6 +105,19 @@ class StructInfo {
   std::unique_ptr<ffi_type> ffi_type_;
   std::vector<ffi_type*> ffi_field_types_;  // per ffi_type.elements
 
+  // Marshal plan (vedi FieldPlan)
+  std::vector<FieldPlan> plan_;
+  // Byte non coperti da alcun campo: JSToStruct azzera solo questi (e i
+  // campi assenti) invece dell'intera struct
+  std::vector<std::pair<size_t, size_t>> padding_;
+  // Campi sovrapposti (union, anche anonymous): memset completo
+  bool clear_all_ = true;
+  // Property key per plan_ (stesso indice) nell'environment dello
+  // StructType che ha creato lo StructInfo. Vuoto dopo Share(): le chiavi
+  // stanno in CTypesAddon::shared_struct_keys[shared_id_].
+  KeyList keys_;
+  uint64_t shared_id_ = 0;
+
   // Helper per calcolare alignment di un tipo
   static size_t GetTypeAlignment(CType type, std::shared_ptr<StructInfo> nested, std::shared_ptr<ArrayInfo> array);
 };
@@ -81,8 +136,15 @@ class StructType : public Napi::ObjectWrap<StructType> {
   Napi::Value Create(const Napi::CallbackInfo& info);    // crea istanza struct
   Napi::Value Read(const Napi::CallbackInfo& info);      // legge struct da buffer
   Napi::Value ToObject(const Napi::CallbackInfo& info);  // converte buffer in plain object
+  // (ptr, count, fieldNames[, stride]) -> { name: TypedArray } da un array di struct
+  Napi::Value ReadColumns(const Napi::CallbackInfo& info);
 
   std::shared_ptr<StructInfo> GetStructInfo() const { return struct_info_; }
+  // Wrapper su un layout condiviso da un altro environment (importBindings)
+  void Adopt(std::shared_ptr<StructInfo> info) {
+    is_union_ = info->IsUnion();
+    struct_info_ = std::move(info);
+  }
 
  private:
   std::shared_ptr<StructInfo> struct_info_;
@@ -0,0 +1,348 @@
+#include "text.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CTYPES_TEXT_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define CTYPES_TEXT_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace ctypes {
+
+namespace {
+
+constexpr size_t kVectorBytes = 16;
+
+// Buffer di appoggio: inline per le stringhe corte, heap oltre
+template <typename T, size_t N = 256>
+class ScratchBuffer {
+ public:
+  explicit ScratchBuffer(size_t count) {
+    if (count > N) {
+      heap_.resize(count);
+    }
+  }
+  T* data() { return heap_.empty() ? inline_ : heap_.data(); }
+
+ private:
+  T inline_[N];
+  std::vector<T> heap_;
+};
+
+template <typename Unit>
+size_t FindZeroUnit(const Unit* s, size_t max) {
+  static_assert(sizeof(Unit) == 2 || sizeof(Unit) == 4);
+  const uintptr_t addr = reinterpret_cast<uintptr_t>(s);
+  size_t i = 0;
+
+#if CTYPES_TEXT_SSE2 || CTYPES_TEXT_NEON
+  constexpr size_t kLanes = kVectorBytes / sizeof(Unit);
+  if (addr % sizeof(Unit) == 0) {
+    // Fino al primo indirizzo allineato a 16: i load allineati restano
+    // nella pagina del terminatore anche se `max` va oltre la stringa
+    while (i < max && ((addr + i * sizeof(Unit)) % kVectorBytes) != 0) {
+      if (s[i] == 0) {
+        return i;
+      }
+      i++;
+    }
+#if CTYPES_TEXT_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + kLanes <= max; i += kLanes) {
+      const __m128i v = _mm_load_si128(reinterpret_cast<const __m128i*>(s + i));
+      __m128i eq;
+      if constexpr (sizeof(Unit) == 2) {
+        eq = _mm_cmpeq_epi16(v, zero);
+      } else {
+        eq = _mm_cmpeq_epi32(v, zero);
+      }
+      const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(eq));
+      if (mask != 0) {
+        return i + static_cast<size_t>(std::countr_zero(mask)) / sizeof(Unit);
+      }
+    }
+#else
+    for (; i + kLanes <= max; i += kLanes) {
+      bool found;
+      if constexpr (sizeof(Unit) == 2) {
+        const uint16x8_t v = vld1q_u16(reinterpret_cast<const uint16_t*>(s + i));
+        found = vmaxvq_u16(vceqq_u16(v, vdupq_n_u16(0))) != 0;
+      } else {
+        const uint32x4_t v = vld1q_u32(reinterpret_cast<const uint32_t*>(s + i));
+        found = vmaxvq_u32(vceqq_u32(v, vdupq_n_u32(0))) != 0;
+      }
+      if (found) {
+        break;  // posizione esatta dal loop scalare, dentro questo blocco
+      }
+    }
+#endif
+  }
+#endif
+
+  for (; i < max; i++) {
+    if (s[i] == 0) {
+      return i;
+    }
+  }
+  return max;
+}
+
+bool IsAscii(const char* s, size_t len) {
+  size_t i = 0;
+#if CTYPES_TEXT_SSE2
+  for (; i + kVectorBytes <= len; i += kVectorBytes) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+    if (_mm_movemask_epi8(v) != 0) {
+      return false;
+    }
+  }
+#elif CTYPES_TEXT_NEON
+  for (; i + kVectorBytes <= len; i += kVectorBytes) {
+    if (vmaxvq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(s + i))) >= 0x80) {
+      return false;
+    }
+  }
+#endif
+  uint8_t bits = 0;
+  for (; i < len; i++) {
+    bits |= static_cast<uint8_t>(s[i]);
+  }
+  return bits < 0x80;
+}
+
+#ifndef _WIN32
+// wchar_t a 32 bit (UTF-32) da qui in poi
+static_assert(sizeof(wchar_t) == 4);
+
+// true se tutte le unità stanno in latin1 (< 0x100)
+bool IsLatin1(const wchar_t* s, size_t len) {
+  size_t i = 0;
+#if CTYPES_TEXT_SSE2
+  const __m128i high = _mm_set1_epi32(static_cast<int>(0xFFFFFF00u));
+  for (; i + 8 <= len; i += 8) {
+    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + 4));
+    const __m128i bits = _mm_and_si128(_mm_or_si128(a, b), high);
+    if (_mm_movemask_epi8(_mm_cmpeq_epi32(bits, _mm_setzero_si128())) != 0xFFFF) {
+      return false;
+    }
+  }
+#elif CTYPES_TEXT_NEON
+  for (; i + 8 <= len; i += 8) {
+    const uint32x4_t a = vld1q_u32(reinterpret_cast<const uint32_t*>(s + i));
+    const uint32x4_t b = vld1q_u32(reinterpret_cast<const uint32_t*>(s + i + 4));
+    if (vmaxvq_u32(vorrq_u32(a, b)) >= 0x100) {
+      return false;
+    }
+  }
+#endif
+  uint32_t bits = 0;
+  for (; i < len; i++) {
+    bits |= static_cast<uint32_t>(s[i]);
+  }
+  return bits < 0x100;
+}
+
+// Unità già verificate < 0x100
+void NarrowToLatin1(const wchar_t* s, size_t len, uint8_t* out) {
+  size_t i = 0;
+#if CTYPES_TEXT_SSE2
+  for (; i + 16 <= len; i += 16) {
+    const __m128i* src = reinterpret_cast<const __m128i*>(s + i);
+    const __m128i ab = _mm_packs_epi32(_mm_loadu_si128(src), _mm_loadu_si128(src + 1));
+    const __m128i cd = _mm_packs_epi32(_mm_loadu_si128(src + 2), _mm_loadu_si128(src + 3));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(ab, cd));
+  }
+#elif CTYPES_TEXT_NEON
+  for (; i + 8 <= len; i += 8) {
+    const uint32x4_t a = vld1q_u32(reinterpret_cast<const uint32_t*>(s + i));
+    const uint32x4_t b = vld1q_u32(reinterpret_cast<const uint32_t*>(s + i + 4));
+    vst1_u8(out + i, vmovn_u16(vcombine_u16(vmovn_u32(a), vmovn_u32(b))));
+  }
+#endif
+  for (; i < len; i++) {
+    out[i] = static_cast<uint8_t>(s[i]);
+  }
+}
+
+// Un code point → 1 o 2 unità UTF-16 (U+FFFD se fuori da Unicode)
+inline size_t EncodeUtf16Unit(uint32_t cp, char16_t* out) {
+  if (cp < 0x10000) {
+    out[0] = static_cast<char16_t>(cp);
+    return 1;
+  }
+  if (cp <= 0x10FFFF) {
+    cp -= 0x10000;
+    out[0] = static_cast<char16_t>(0xD800 + (cp >> 10));
+    out[1] = static_cast<char16_t>(0xDC00 + (cp & 0x3FF));
+    return 2;
+  }
+  out[0] = static_cast<char16_t>(0xFFFD);
+  return 1;
+}
+
+// `out` ha spazio per 2 * len unità; ritorna quelle scritte
+size_t EncodeUtf16(const wchar_t* s, size_t len, char16_t* out) {
+  size_t i = 0;
+  size_t n = 0;
+#if CTYPES_TEXT_SSE2
+  // Blocchi interamente nel BMP: restringimento 32 → 16 bit. packs è con
+  // segno: lo spostamento di 0x8000 porta [0, 0xFFFF] in range int16.
+  const __m128i bias32 = _mm_set1_epi32(0x8000);
+  const __m128i bias16 = _mm_set1_epi16(static_cast<short>(0x8000));
+  const __m128i high = _mm_set1_epi32(static_cast<int>(0xFFFF0000u));
+  for (; i + 8 <= len; i += 8) {
+    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + 4));
+    const __m128i bits = _mm_and_si128(_mm_or_si128(a, b), high);
+    if (_mm_movemask_epi8(_mm_cmpeq_epi32(bits, _mm_setzero_si128())) == 0xFFFF) {
+      const __m128i packed = _mm_packs_epi32(_mm_sub_epi32(a, bias32), _mm_sub_epi32(b, bias32));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + n), _mm_add_epi16(packed, bias16));
+      n += 8;
+    } else {
+      for (size_t k = 0; k < 8; k++) {
+        n += EncodeUtf16Unit(static_cast<uint32_t>(s[i + k]), out + n);
+      }
+    }
+  }
+#elif CTYPES_TEXT_NEON
+  for (; i + 8 <= len; i += 8) {
+    const uint32x4_t a = vld1q_u32(reinterpret_cast<const uint32_t*>(s + i));
+    const uint32x4_t b = vld1q_u32(reinterpret_cast<const uint32_t*>(s + i + 4));
+    if (vmaxvq_u32(vorrq_u32(a, b)) < 0x10000) {
+      vst1q_u16(reinterpret_cast<uint16_t*>(out + n), vcombine_u16(vmovn_u32(a), vmovn_u32(b)));
+      n += 8;
+    } else {
+      for (size_t k = 0; k < 8; k++) {
+        n += EncodeUtf16Unit(static_cast<uint32_t>(s[i + k]), out + n);
+      }
+    }
+  }
+#endif
+  for (; i < len; i++) {
+    n += EncodeUtf16Unit(static_cast<uint32_t>(s[i]), out + n);
+  }
+  return n;
+}
+#endif  // !_WIN32
+
+Napi::Value FinishString(Napi::Env env, napi_status status, napi_value result) {
+  if (status != napi_ok) {
+    Napi::Error::New(env, "Failed to create string").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  return Napi::Value(env, result);
+}
+
+}  // namespace
+
+size_t FindCStringEnd(const char* s, size_t max) {
+  const void* nul = std::memchr(s, 0, max);
+  return nul ? static_cast<size_t>(static_cast<const char*>(nul) - s) : max;
+}
+
+size_t FindWStringEnd(const wchar_t* s, size_t max) {
+  return FindZeroUnit(s, max);
+}
+
+Napi::Value CStringToJS(Napi::Env env, const char* s, size_t len) {
+  napi_value result;
+  napi_status status = IsAscii(s, len) ? napi_create_string_latin1(env, s, len, &result)
+                                       : napi_create_string_utf8(env, s, len, &result);
+  return FinishString(env, status, result);
+}
+
+Napi::Value WStringToJS(Napi::Env env, const wchar_t* s, size_t len) {
+  napi_value result;
+#ifdef _WIN32
+  // wchar_t è già UTF-16
+  napi_status status = napi_create_string_utf16(env, reinterpret_cast<const char16_t*>(s), len, &result);
+#else
+  napi_status status;
+  if (IsLatin1(s, len)) {
+    ScratchBuffer<uint8_t> latin1(len);
+    NarrowToLatin1(s, len, latin1.data());
+    status = napi_create_string_latin1(env, reinterpret_cast<const char*>(latin1.data()), len, &result);
+  } else {
+    ScratchBuffer<char16_t> utf16(len * 2);
+    const size_t units = EncodeUtf16(s, len, utf16.data());
+    status = napi_create_string_utf16(env, utf16.data(), units, &result);
+  }
+#endif
+  return FinishString(env, status, result);
+}
+
+size_t WidenUtf16(const char* src, size_t units, char* dst) {
+  size_t j = 0;
+  size_t out = 0;
+
+  // Un code point (una unità o una coppia surrogata); le surrogate isolate
+  // passano invariate
+  auto scalar_step = [&]() {
+    char16_t unit;
+    memcpy(&unit, src + j * sizeof(char16_t), sizeof(unit));
+    uint32_t cp = unit;
+    j++;
+    if (unit >= 0xD800 && unit < 0xDC00 && j < units) {
+      char16_t low;
+      memcpy(&low, src + j * sizeof(char16_t), sizeof(low));
+      if (low >= 0xDC00 && low < 0xE000) {
+        cp = 0x10000 + ((static_cast<uint32_t>(unit) - 0xD800) << 10) + (static_cast<uint32_t>(low) - 0xDC00);
+        j++;
+      }
+    }
+    const wchar_t wc = static_cast<wchar_t>(cp);
+    memcpy(dst + out * sizeof(wchar_t), &wc, sizeof(wc));
+    out++;
+  };
+
+  // Nel blocco vettoriale il load precede lo store, e lo store (fino a
+  // 4 * out + 32 byte) non raggiunge le unità non ancora lette finché
+  // j + 8 <= units: vedi il vincolo su src - dst in text.h
+#if CTYPES_TEXT_SSE2
+  const __m128i surrogate_mask = _mm_set1_epi16(static_cast<short>(0xF800));
+  const __m128i surrogate_tag = _mm_set1_epi16(static_cast<short>(0xD800));
+  const __m128i zero = _mm_setzero_si128();
+  while (j + 8 <= units) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + j * sizeof(char16_t)));
+    const __m128i surrogates = _mm_cmpeq_epi16(_mm_and_si128(v, surrogate_mask), surrogate_tag);
+    if (_mm_movemask_epi8(surrogates) == 0) {
+      char* out_ptr = dst + out * sizeof(wchar_t);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out_ptr), _mm_unpacklo_epi16(v, zero));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out_ptr + 16), _mm_unpackhi_epi16(v, zero));
+      j += 8;
+      out += 8;
+    } else {
+      const size_t block_end = j + 8;
+      while (j < block_end) {
+        scalar_step();
+      }
+    }
+  }
+#elif CTYPES_TEXT_NEON
+  const uint16x8_t surrogate_mask = vdupq_n_u16(0xF800);
+  const uint16x8_t surrogate_tag = vdupq_n_u16(0xD800);
+  while (j + 8 <= units) {
+    const uint16x8_t v = vld1q_u16(reinterpret_cast<const uint16_t*>(src + j * sizeof(char16_t)));
+    if (vmaxvq_u16(vceqq_u16(vandq_u16(v, surrogate_mask), surrogate_tag)) == 0) {
+      uint32_t* out_ptr = reinterpret_cast<uint32_t*>(dst + out * sizeof(wchar_t));
+      vst1q_u32(out_ptr, vmovl_u16(vget_low_u16(v)));
+      vst1q_u32(out_ptr + 4, vmovl_u16(vget_high_u16(v)));
+      j += 8;
+      out += 8;
+    } else {
+      const size_t block_end = j + 8;
+      while (j < block_end) {
+        scalar_step();
+      }
+    }
+  }
+#endif
+  while (j < units) {
+    scalar_step();
+  }
+  return out;
+}
+
+}  // namespace ctypes
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "shared.h"
+
+namespace ctypes {
+
+// ============================================================================
+// Stringhe C ↔ JS — scansione e transcodifica vettorizzate
+//
+// Ritorni char* / wchar_t*, readCString e string_at / wstring_at leggevano
+// un'unità alla volta: ricerca del terminatore, conversione wchar_t (UTF-32
+// su Unix) → UTF-8 → V8. Con blob di testo grandi (log, dump) quei loop
+// dominavano il profilo. Qui:
+//
+//   - terminatore: memchr per char (SIMD in ogni libc), blocchi SSE2 / NEON
+//     per wchar_t con load allineati (non attraversano mai una pagina);
+//   - char*: se il testo è ASCII (verifica a blocchi da 16 byte) la stringa
+//     nasce latin1, senza passare dal decoder UTF-8;
+//   - UTF-32 → JS: tutto < 0x100 → latin1, altrimenti UTF-16 a blocchi da 8
+//     unità (coppie surrogate solo nei blocchi fuori dal BMP), senza il
+//     passaggio intermedio da UTF-8;
+//   - UTF-16 → UTF-32 (argomenti WSTRING): allargamento a blocchi, coppie
+//     surrogate ricombinate in un solo code point.
+//
+// SSE2 / NEON sono baseline su x86-64 / AArch64: niente dispatch a runtime.
+// Altre architetture usano i loop scalari.
+// ============================================================================
+
+// Posizione del primo terminatore entro `max` unità (`max` se assente)
+size_t FindCStringEnd(const char* s, size_t max);
+size_t FindWStringEnd(const wchar_t* s, size_t max);
+
+// Esattamente `len` unità (terminatori interni compresi) → stringa JS.
+// Undefined con eccezione JS pendente se V8 rifiuta la stringa.
+Napi::Value CStringToJS(Napi::Env env, const char* s, size_t len);
+Napi::Value WStringToJS(Napi::Env env, const wchar_t* s, size_t len);
+
+// Solo wchar_t a 32 bit: `units` code unit UTF-16 in `src` → code point in
+// `dst`. `dst` può precedere `src` nello stesso buffer purché
+// src - dst >= 2 * (units + 1) byte (vedi AppendWideString). Ritorna i
+// wchar_t scritti (terminatore escluso).
+size_t WidenUtf16(const char* src, size_t units, char* dst);
+
+}  // namespace ctypes
@@ -0,0 +1,501 @@
+#include "trampoline.h"
+
+#include <array>
+#include <tuple>
+
+namespace ctypes {
+
+namespace {
+
+// ============================================================================
+// Reader JS → C per la classe INT
+// Stessa semantica di FFIFunction::MarshalPrimitive / caso CTYPES_POINTER di
+// MarshalArguments: i tipi stretti vengono estesi a 64 bit col segno del tipo
+// dichiarato (clang, e l'ABI Apple arm64, assumono che il caller estenda).
+// ============================================================================
+
+int64_t ReadInt32(Napi::Env env, const Napi::Value& val) {
+  int32_t v = 0;
+  napi_get_value_int32(env, val, &v);
+  return v;
+}
+
+int64_t ReadUint32(Napi::Env env, const Napi::Value& val) {
+  uint32_t v = 0;
+  napi_get_value_uint32(env, val, &v);
+  return v;
+}
+
+int64_t ReadInt64(Napi::Env env, const Napi::Value& val) {
+  if (val.IsBigInt()) {
+    bool lossless;
+    return val.As<Napi::BigInt>().Int64Value(&lossless);
+  }
+  if (val.IsNull() || val.IsUndefined()) {
+    return 0;
+  }
+  if (val.IsBuffer()) {
+    return static_cast<int64_t>(reinterpret_cast<intptr_t>(val.As<Napi::Buffer<uint8_t>>().Data()));
+  }
+  if (val.IsArrayBuffer()) {
+    return static_cast<int64_t>(reinterpret_cast<intptr_t>(val.As<Napi::ArrayBuffer>().Data()));
+  }
+  if (val.IsExternal()) {
+    void* ptr = nullptr;
+    GetPointerHandle(env, val, ptr);
+    return static_cast<int64_t>(reinterpret_cast<intptr_t>(ptr));
+  }
+  int64_t v;
+  if (napi_get_value_int64(env, val, &v) != napi_ok) {
+    v = 0;
+  }
+  return v;
+}
+
+int64_t ReadBool(Napi::Env, const Napi::Value& val) {
+  return val.ToBoolean().Value() ? 1 : 0;
+}
+
+int64_t ReadInt8(Napi::Env, const Napi::Value& val) {
+  return static_cast<int8_t>(val.As<Napi::Number>().Int32Value());
+}
+
+int64_t ReadUint8(Napi::Env, const Napi::Value& val) {
+  return static_cast<uint8_t>(val.As<Napi::Number>().Uint32Value());
+}
+
+int64_t ReadInt16(Napi::Env, const Napi::Value& val) {
+  return static_cast<int16_t>(val.As<Napi::Number>().Int32Value());
+}
+
+int64_t ReadUint16(Napi::Env, const Napi::Value& val) {
+  return static_cast<uint16_t>(val.As<Napi::Number>().Uint32Value());
+}
+
+int64_t ReadLong(Napi::Env, const Napi::Value& val) {
+  long v;
+  if (val.IsBigInt()) {
+    bool lossless;
+    v = static_cast<long>(val.As<Napi::BigInt>().Int64Value(&lossless));
+  } else {
+    v = static_cast<long>(val.As<Napi::Number>().Int64Value());
+  }
+  return static_cast<int64_t>(v);
+}
+
+int64_t ReadUlong(Napi::Env, const Napi::Value& val) {
+  unsigned long v;
+  if (val.IsBigInt()) {
+    bool lossless;
+    v = static_cast<unsigned long>(val.As<Napi::BigInt>().Uint64Value(&lossless));
+  } else {
+    v = static_cast<unsigned long>(val.As<Napi::Number>().Int64Value());
+  }
+  return static_cast<int64_t>(static_cast<uint64_t>(v));
+}
+
+int64_t ReadPointer(Napi::Env env, const Napi::Value& val) {
+  void* ptr = nullptr;
+  if (val.IsNull() || val.IsUndefined()) {
+    ptr = nullptr;
+  } else if (val.IsBuffer()) {
+    ptr = val.As<Napi::Buffer<uint8_t>>().Data();
+  } else if (val.IsBigInt()) {
+    bool lossless;
+    ptr = reinterpret_cast<void*>(val.As<Napi::BigInt>().Uint64Value(&lossless));
+  } else if (val.IsNumber()) {
+    int64_t v;
+    napi_get_value_int64(env, val, &v);
+    ptr = reinterpret_cast<void*>(static_cast<uintptr_t>(v));
+  } else if (val.IsExternal()) {
+    GetPointerHandle(env, val, ptr);
+  }
+  return static_cast<int64_t>(reinterpret_cast<intptr_t>(ptr));
+}
+
+// ============================================================================
+// Writer C → JS per la classe INT
+// `raw` è il registro di ritorno: per i tipi stretti i bit alti non sono
+// definiti dall'ABI, quindi si tronca sempre al tipo dichiarato.
+// Stessa semantica di FFIFunction::ConvertReturn / CToJS.
+// ============================================================================
+
+Napi::Value WriteInt8(Napi::Env env, int64_t raw) {
+  return Napi::Number::New(env, static_cast<int8_t>(raw));
+}
+
+Napi::Value WriteUint8(Napi::Env env, int64_t raw) {
+  return Napi::Number::New(env, static_cast<uint8_t>(raw));
+}
+
+Napi::Value WriteInt16(Napi::Env env, int64_t raw) {
+  return Napi::Number::New(env, static_cast<int16_t>(raw));
+}
+
+Napi::Value WriteUint16(Napi::Env env, int64_t raw) {
+  return Napi::Number::New(env, static_cast<uint16_t>(raw));
+}
+
+Napi::Value WriteInt32(Napi::Env env, int64_t raw) {
+  napi_value result;
+  napi_create_int32(env, static_cast<int32_t>(raw), &result);
+  return Napi::Value(env, result);
+}
+
+Napi::Value WriteUint32(Napi::Env env, int64_t raw) {
+  napi_value result;
+  napi_create_uint32(env, static_cast<uint32_t>(raw), &result);
+  return Napi::Value(env, result);
+}
+
+Napi::Value WriteInt64(Napi::Env env, int64_t raw) {
+  return Napi::BigInt::New(env, raw);
+}
+
+Napi::Value WriteUint64(Napi::Env env, int64_t raw) {
+  return Napi::BigInt::New(env, static_cast<uint64_t>(raw));
+}
+
+Napi::Value WriteLong(Napi::Env env, int64_t raw) {
+  return Napi::BigInt::New(env, static_cast<int64_t>(static_cast<long>(raw)));
+}
+
+Napi::Value WriteUlong(Napi::Env env, int64_t raw) {
+  return Napi::BigInt::New(env, static_cast<uint64_t>(static_cast<unsigned long>(raw)));
+}
+
+Napi::Value WriteSsize(Napi::Env env, int64_t raw) {
+  return Napi::BigInt::New(env, static_cast<int64_t>(static_cast<ssize_t>(raw)));
+}
+
+Napi::Value WriteSize(Napi::Env env, int64_t raw) {
+  return Napi::BigInt::New(env, static_cast<uint64_t>(static_cast<size_t>(raw)));
+}
+
+Napi::Value WriteBool(Napi::Env env, int64_t raw) {
+  return Napi::Boolean::New(env, static_cast<uint8_t>(raw) != 0);
+}
+
+Napi::Value WritePointer(Napi::Env env, int64_t raw) {
+  if (raw == 0) {
+    return env.Null();
+  }
+  return Napi::BigInt::New(env, static_cast<uint64_t>(raw));
+}
+
+// pointerMode "number": Number se esatto, altrimenti BigInt / handle
+Napi::Value WriteInt64Number(Napi::Env env, int64_t raw) {
+  return Int64ToJS(env, raw, PointerMode::NUMBER);
+}
+
+Napi::Value WriteUint64Number(Napi::Env env, int64_t raw) {
+  return Uint64ToJS(env, static_cast<uint64_t>(raw), PointerMode::NUMBER);
+}
+
+Napi::Value WriteLongNumber(Napi::Env env, int64_t raw) {
+  return Int64ToJS(env, static_cast<int64_t>(static_cast<long>(raw)), PointerMode::NUMBER);
+}
+
+Napi::Value WriteUlongNumber(Napi::Env env, int64_t raw) {
+  return Uint64ToJS(env, static_cast<uint64_t>(static_cast<unsigned long>(raw)), PointerMode::NUMBER);
+}
+
+Napi::Value WriteSsizeNumber(Napi::Env env, int64_t raw) {
+  return Int64ToJS(env, static_cast<int64_t>(static_cast<ssize_t>(raw)), PointerMode::NUMBER);
+}
+
+Napi::Value WriteSizeNumber(Napi::Env env, int64_t raw) {
+  return Uint64ToJS(env, static_cast<uint64_t>(static_cast<size_t>(raw)), PointerMode::NUMBER);
+}
+
+Napi::Value WritePointerNumber(Napi::Env env, int64_t raw) {
+  return PointerToJS(env, reinterpret_cast<void*>(static_cast<intptr_t>(raw)), PointerMode::NUMBER);
+}
+
+TrampolineArgReader IntReaderFor(CType type) {
+  switch (type) {
+    case CType::CTYPES_INT8:
+      return &ReadInt8;
+    case CType::CTYPES_UINT8:
+      return &ReadUint8;
+    case CType::CTYPES_INT16:
+      return &ReadInt16;
+    case CType::CTYPES_UINT16:
+      return &ReadUint16;
+    case CType::CTYPES_INT32:
+      return &ReadInt32;
+    case CType::CTYPES_UINT32:
+      return &ReadUint32;
+    case CType::CTYPES_INT64:
+    case CType::CTYPES_UINT64:
+    case CType::CTYPES_SIZE_T:
+    case CType::CTYPES_SSIZE_T:
+      return &ReadInt64;
+    case CType::CTYPES_LONG:
+      return &ReadLong;
+    case CType::CTYPES_ULONG:
+      return &ReadUlong;
+    case CType::CTYPES_BOOL:
+      return &ReadBool;
+    case CType::CTYPES_POINTER:
+      return &ReadPointer;
+    default:
+      return nullptr;
+  }
+}
+
+TrampolineRetWriter IntWriterFor(CType type, PointerMode mode) {
+  if (mode == PointerMode::NUMBER) {
+    switch (type) {
+      case CType::CTYPES_INT64:
+        return &WriteInt64Number;
+      case CType::CTYPES_UINT64:
+        return &WriteUint64Number;
+      case CType::CTYPES_SIZE_T:
+        return &WriteSizeNumber;
+      case CType::CTYPES_SSIZE_T:
+        return &WriteSsizeNumber;
+      case CType::CTYPES_LONG:
+        return &WriteLongNumber;
+      case CType::CTYPES_ULONG:
+        return &WriteUlongNumber;
+      case CType::CTYPES_POINTER:
+        return &WritePointerNumber;
+      default:
+        break;
+    }
+  }
+  switch (type) {
+    case CType::CTYPES_INT8:
+      return &WriteInt8;
+    case CType::CTYPES_UINT8:
+      return &WriteUint8;
+    case CType::CTYPES_INT16:
+      return &WriteInt16;
+    case CType::CTYPES_UINT16:
+      return &WriteUint16;
+    case CType::CTYPES_INT32:
+      return &WriteInt32;
+    case CType::CTYPES_UINT32:
+      return &WriteUint32;
+    case CType::CTYPES_INT64:
+      return &WriteInt64;
+    case CType::CTYPES_UINT64:
+      return &WriteUint64;
+    case CType::CTYPES_SIZE_T:
+      return &WriteSize;
+    case CType::CTYPES_SSIZE_T:
+      return &WriteSsize;
+    case CType::CTYPES_LONG:
+      return &WriteLong;
+    case CType::CTYPES_ULONG:
+      return &WriteUlong;
+    case CType::CTYPES_BOOL:
+      return &WriteBool;
+    case CType::CTYPES_POINTER:
+      return &WritePointer;
+    default:
+      return nullptr;
+  }
+}
+
+// Classe ABI di un CType, o VOID se il tipo non è coperto dai trampolini
+TrampolineKind KindFor(CType type) {
+  if (type == CType::CTYPES_DOUBLE) {
+    return TrampolineKind::DOUBLE;
+  }
+  if (type == CType::CTYPES_FLOAT) {
+    return TrampolineKind::FLOAT;
+  }
+  return IntReaderFor(type) != nullptr ? TrampolineKind::INT : TrampolineKind::VOID;
+}
+
+#if CTYPES_HAS_TRAMPOLINES
+
+template <TrampolineKind K>
+struct TrampolineCType;
+template <>
+struct TrampolineCType<TrampolineKind::INT> {
+  using type = int64_t;
+};
+template <>
+struct TrampolineCType<TrampolineKind::DOUBLE> {
+  using type = double;
+};
+template <>
+struct TrampolineCType<TrampolineKind::FLOAT> {
+  using type = float;
+};
+template <>
+struct TrampolineCType<TrampolineKind::VOID> {
+  using type = void;
+};
+
+template <TrampolineKind K>
+using TrampolineArgT = typename TrampolineCType<K>::type;
+
+template <TrampolineKind K>
+CTYPES_ALWAYS_INLINE TrampolineArgT<K> ReadArg(Napi::Env env, const Napi::Value& val, TrampolineArgReader reader) {
+  if constexpr (K == TrampolineKind::INT) {
+    return reader(env, val);
+  } else {
+    double v;
+    napi_get_value_double(env, val, &v);
+    return static_cast<TrampolineArgT<K>>(v);
+  }
+}
+
+template <TrampolineKind R, TrampolineKind... A, size_t... I>
+CTYPES_ALWAYS_INLINE Napi::Value InvokeImpl(Napi::Env env,
+                                            const napi_value* argv,
+                                            const TrampolinePlan& plan,
+                                            std::index_sequence<I...>) {
+  using Fn = TrampolineArgT<R> (*)(TrampolineArgT<A>...);
+
+  // Braced init: valutazione garantita left-to-right, come il loop di
+  // MarshalArguments (conta per gli effetti collaterali di ToBoolean ecc.).
+  [[maybe_unused]] const std::tuple<TrampolineArgT<A>...> args{
+    ReadArg<A>(env, Napi::Value(env, argv[I]), plan.int_readers[I])...};
+  Fn fn = reinterpret_cast<Fn>(plan.fn_ptr);
+
+  if constexpr (R == TrampolineKind::VOID) {
+    fn(std::get<I>(args)...);
+    return env.Undefined();
+  } else if constexpr (R == TrampolineKind::INT) {
+    return plan.int_writer(env, fn(std::get<I>(args)...));
+  } else {
+    napi_value result;
+    napi_create_double(env, static_cast<double>(fn(std::get<I>(args)...)), &result);
+    return Napi::Value(env, result);
+  }
+}
+
+template <TrampolineKind R, TrampolineKind... A>
+Napi::Value Invoke(Napi::Env env, const napi_value* argv, const TrampolinePlan& plan) {
+  return InvokeImpl<R, A...>(env, argv, plan, std::make_index_sequence<sizeof...(A)>{});
+}
+
+// ---------------------------------------------------------------------------
+// Generazione delle tabelle: per ogni (return kind, arity) una tabella di
+// Radix^N trampolini, indicizzata dal "codice" della signature (cifre in
+// base Radix, una per argomento, cifra 0 = argomento 0).
+// ---------------------------------------------------------------------------
+
+constexpr size_t Radix(size_t argc) {
+  return argc <= MAX_TRAMPOLINE_FLOAT_ARGS ? 3 : 2;
+}
+
+constexpr size_t Pow(size_t base, size_t exp) {
+  size_t r = 1;
+  for (size_t i = 0; i < exp; i++) {
+    r *= base;
+  }
+  return r;
+}
+
+template <size_t N, size_t Code, size_t I>
+constexpr TrampolineKind KindAt() {
+  return static_cast<TrampolineKind>((Code / Pow(Radix(N), I)) % Radix(N));
+}
+
+template <TrampolineKind R, size_t N, size_t Code, size_t... I>
+constexpr TrampolineFn MakeEntry(std::index_sequence<I...>) {
+  return &Invoke<R, KindAt<N, Code, I>()...>;
+}
+
+template <TrampolineKind R, size_t N, size_t... Codes>
+constexpr std::array<TrampolineFn, sizeof...(Codes)> MakeTable(std::index_sequence<Codes...>) {
+  return {{MakeEntry<R, N, Codes>(std::make_index_sequence<N>{})...}};
+}
+
+template <TrampolineKind R, size_t N>
+constexpr auto kTable = MakeTable<R, N>(std::make_index_sequence<Pow(Radix(N), N)>{});
+
+template <TrampolineKind R>
+TrampolineFn Lookup(size_t argc, size_t code) {
+  static_assert(MAX_TRAMPOLINE_ARGS == 6, "aggiornare Lookup() insieme a MAX_TRAMPOLINE_ARGS");
+  switch (argc) {
+    case 0:
+      return kTable<R, 0>[code];
+    case 1:
+      return kTable<R, 1>[code];
+    case 2:
+      return kTable<R, 2>[code];
+    case 3:
+      return kTable<R, 3>[code];
+    case 4:
+      return kTable<R, 4>[code];
+    case 5:
+      return kTable<R, 5>[code];
+    case 6:
+      return kTable<R, 6>[code];
+    default:
+      return nullptr;
+  }
+}
+
+#endif  // CTYPES_HAS_TRAMPOLINES
+
+}  // namespace
+
+TrampolineFn SelectTrampoline(void* fn_ptr, CType return_type, const std::vector<CType>& arg_types,
+                              PointerMode pointer_mode, TrampolinePlan& plan) {
+#if CTYPES_HAS_TRAMPOLINES
+  const size_t argc = arg_types.size();
+  if (fn_ptr == nullptr || argc > MAX_TRAMPOLINE_ARGS) {
+    return nullptr;
+  }
+
+  TrampolinePlan candidate;
+  candidate.fn_ptr = fn_ptr;
+
+  // Codice della signature: una cifra (TrampolineKind) per argomento
+  const size_t radix = Radix(argc);
+  size_t code = 0;
+  size_t weight = 1;
+  for (size_t i = 0; i < argc; i++) {
+    const TrampolineKind kind = KindFor(arg_types[i]);
+    if (kind == TrampolineKind::VOID || static_cast<size_t>(kind) >= radix) {
+      return nullptr;
+    }
+    if (kind == TrampolineKind::INT) {
+      candidate.int_readers[i] = IntReaderFor(arg_types[i]);
+    }
+    code += static_cast<size_t>(kind) * weight;
+    weight *= radix;
+  }
+
+  TrampolineFn fn = nullptr;
+  if (return_type == CType::CTYPES_VOID) {
+    fn = Lookup<TrampolineKind::VOID>(argc, code);
+  } else {
+    switch (KindFor(return_type)) {
+      case TrampolineKind::INT:
+        candidate.int_writer = IntWriterFor(return_type, pointer_mode);
+        fn = Lookup<TrampolineKind::INT>(argc, code);
+        break;
+      case TrampolineKind::DOUBLE:
+        fn = Lookup<TrampolineKind::DOUBLE>(argc, code);
+        break;
+      case TrampolineKind::FLOAT:
+        fn = Lookup<TrampolineKind::FLOAT>(argc, code);
+        break;
+      default:
+        return nullptr;
+    }
+  }
+
+  if (fn != nullptr) {
+    plan = candidate;
+  }
+  return fn;
+#else
+  (void)fn_ptr;
+  (void)return_type;
+  (void)arg_types;
+  (void)plan;
+  return nullptr;
+#endif
+}
+
+}  // namespace ctypes
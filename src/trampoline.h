@@ -0,0 +1,69 @@
+#pragma once
+
+#include "shared.h"
+#include "types.h"
+
+namespace ctypes {
+
+// ============================================================================
+// Trampolini specializzati per signature primitive
+//
+// Per le signature più comuni — int(int,int), double(double),
+// void*(void*,size_t), ... — il costo di MarshalArguments + switch in
+// MarshalPrimitive + ffi_call + switch in ConvertReturn supera spesso quello
+// della funzione C stessa. Qui generiamo a compile-time (template) una
+// funzione per ogni combinazione di "classi ABI" degli argomenti, che
+// chiama direttamente il puntatore a funzione con la firma C corretta.
+//
+// Le classi ABI sono volutamente poche (INT / DOUBLE / FLOAT): su x86_64
+// (SysV e Win64) e AArch64 tutti gli interi ≤ 64 bit e i puntatori viaggiano
+// nei registri general-purpose, quindi passarli come int64_t (già
+// sign/zero-extended al tipo dichiarato) è ABI-compatibile. Il tipo esatto
+// conta solo per la conversione JS ↔ C, che è risolta una volta sola in
+// SelectTrampoline() tramite tabelle di function pointer (nessuno switch
+// per-call).
+//
+// Scelto in FFIFunction::PrepareFFI; libffi resta il fallback per tutto il
+// resto (variadic, stringhe, struct/array, ABI non di default, use_errno /
+// use_last_error, piattaforme a 32 bit).
+// ============================================================================
+
+#if (defined(__x86_64__) || defined(_M_X64) || defined(__aarch64__) || defined(_M_ARM64)) && !defined(_M_ARM64EC)
+#define CTYPES_HAS_TRAMPOLINES 1
+#else
+#define CTYPES_HAS_TRAMPOLINES 0
+#endif
+
+// Numero massimo di argomenti coperti dai trampolini
+static constexpr size_t MAX_TRAMPOLINE_ARGS = 6;
+// Fino a questa arity sono generate anche le combinazioni con FLOAT;
+// oltre, solo INT / DOUBLE (contiene la dimensione della tabella).
+static constexpr size_t MAX_TRAMPOLINE_FLOAT_ARGS = 3;
+
+// Classe ABI di argomento / return
+enum class TrampolineKind : uint8_t { INT = 0, DOUBLE = 1, FLOAT = 2, VOID = 3 };
+
+// Conversione JS → intero C (già esteso a 64 bit secondo il tipo dichiarato)
+using TrampolineArgReader = int64_t (*)(Napi::Env env, const Napi::Value& val);
+// Conversione intero C (registro di ritorno grezzo) → JS
+using TrampolineRetWriter = Napi::Value (*)(Napi::Env env, int64_t raw);
+
+// Stato immutabile del trampolino, calcolato una volta a construction time
+struct TrampolinePlan {
+  void* fn_ptr = nullptr;
+  TrampolineArgReader int_readers[MAX_TRAMPOLINE_ARGS] = {};  // solo slot INT
+  TrampolineRetWriter int_writer = nullptr;                   // solo return INT
+};
+
+// `argv` contiene esattamente arg_types.size() valori (argc già validato dal
+// caller): così il trampolino serve sia FFIFunction::Call sia l'entry point
+// nudo di FFIFunction::GetFastCall, che non costruisce Napi::CallbackInfo.
+using TrampolineFn = Napi::Value (*)(Napi::Env env, const napi_value* argv, const TrampolinePlan& plan);
+
+// Ritorna il trampolino per la signature (e popola `plan`), oppure nullptr
+// se la signature non è coperta e va usato libffi. `pointer_mode` sceglie
+// il writer del ritorno per puntatori e interi a 64 bit.
+TrampolineFn SelectTrampoline(void* fn_ptr, CType return_type, const std::vector<CType>& arg_types,
+                              PointerMode pointer_mode, TrampolinePlan& plan);
+
+}  // namespace ctypes
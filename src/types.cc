@@ -1,5 +1,7 @@
 #include "types.h"
 
+#include "text.h"
+
 namespace ctypes {
 // Converte int32 -> CType con validazione
 CType IntToCType(int32_t value) {
@@ -152,6 +154,280 @@ size_t CTypeSize(CType type) {
   }
 }
 
+// ============================================================================
+// TypedArray ↔ CType
+// ============================================================================
+
+bool TypedArrayMatchesCType(napi_typedarray_type ta_type, CType type) {
+  switch (type) {
+    case CType::CTYPES_FLOAT:
+      return ta_type == napi_float32_array;
+    case CType::CTYPES_DOUBLE:
+      return ta_type == napi_float64_array;
+    case CType::CTYPES_INT8:
+    case CType::CTYPES_UINT8:
+    case CType::CTYPES_INT16:
+    case CType::CTYPES_UINT16:
+    case CType::CTYPES_INT32:
+    case CType::CTYPES_UINT32:
+    case CType::CTYPES_INT64:
+    case CType::CTYPES_UINT64:
+    case CType::CTYPES_POINTER:
+    case CType::CTYPES_WCHAR:
+    case CType::CTYPES_BOOL:
+    case CType::CTYPES_SIZE_T:
+    case CType::CTYPES_SSIZE_T:
+    case CType::CTYPES_LONG:
+    case CType::CTYPES_ULONG:
+      break;
+    default:
+      return false;
+  }
+
+  size_t element_size;
+  switch (ta_type) {
+    case napi_int8_array:
+    case napi_uint8_array:
+    case napi_uint8_clamped_array:
+      element_size = 1;
+      break;
+    case napi_int16_array:
+    case napi_uint16_array:
+      element_size = 2;
+      break;
+    case napi_int32_array:
+    case napi_uint32_array:
+      element_size = 4;
+      break;
+    case napi_bigint64_array:
+    case napi_biguint64_array:
+      element_size = 8;
+      break;
+    default:
+      return false;  // float32/float64 solo per FLOAT/DOUBLE
+  }
+  return element_size == CTypeSize(type);
+}
+
+bool CTypeToTypedArrayType(CType type, napi_typedarray_type& out) {
+  const bool is_signed = type == CType::CTYPES_INT8 || type == CType::CTYPES_INT16 || type == CType::CTYPES_INT32 ||
+                         type == CType::CTYPES_INT64 || type == CType::CTYPES_SSIZE_T || type == CType::CTYPES_LONG;
+  switch (type) {
+    case CType::CTYPES_FLOAT:
+      out = napi_float32_array;
+      return true;
+    case CType::CTYPES_DOUBLE:
+      out = napi_float64_array;
+      return true;
+    case CType::CTYPES_STRING:
+    case CType::CTYPES_WSTRING:
+    case CType::CTYPES_STRUCT:
+    case CType::CTYPES_UNION:
+    case CType::CTYPES_ARRAY:
+    case CType::CTYPES_VOID:
+      return false;
+    default:
+      break;
+  }
+  switch (CTypeSize(type)) {
+    case 1:
+      out = is_signed ? napi_int8_array : napi_uint8_array;
+      return true;
+    case 2:
+      out = is_signed ? napi_int16_array : napi_uint16_array;
+      return true;
+    case 4:
+      out = is_signed ? napi_int32_array : napi_uint32_array;
+      return true;
+    case 8:
+      out = is_signed ? napi_bigint64_array : napi_biguint64_array;
+      return true;
+    default:
+      return false;
+  }
+}
+
+// ============================================================================
+// Bulk memory (readArray / writeArray / StructType.readColumns)
+// ============================================================================
+
+// Type tag degli handle di puntatore ("node-ctypes-ptr1"): fisso, così un
+// handle resta valido anche tra più istanze dell'addon nello stesso processo
+static constexpr napi_type_tag kPointerHandleTag = {0x6e6f64652d637479ULL, 0x7065732d70747231ULL};
+
+Napi::Value NewPointerHandle(Napi::Env env, void* ptr) {
+  napi_value handle;
+  napi_create_external(env, ptr, nullptr, nullptr, &handle);
+  napi_type_tag_object(env, handle, &kPointerHandleTag);
+  return Napi::Value(env, handle);
+}
+
+bool GetPointerHandle(napi_env env, napi_value value, void*& ptr) {
+  bool tagged = false;
+  if (napi_check_object_type_tag(env, value, &kPointerHandleTag, &tagged) != napi_ok || !tagged) {
+    return false;
+  }
+  return napi_get_value_external(env, value, &ptr) == napi_ok;
+}
+
+bool ParsePointerMode(Napi::Env env, const Napi::Value& value, PointerMode& out) {
+  if (value.IsString()) {
+    const std::string mode = value.As<Napi::String>().Utf8Value();
+    if (mode == "bigint") {
+      out = PointerMode::BIGINT;
+      return true;
+    }
+    if (mode == "number") {
+      out = PointerMode::NUMBER;
+      return true;
+    }
+  }
+  Napi::TypeError::New(env, "pointerMode must be 'bigint' or 'number'").ThrowAsJavaScriptException();
+  return false;
+}
+
+bool GetPointerArg(Napi::Env env, const Napi::Value& value, uint8_t*& ptr, size_t& limit) {
+  if (value.IsBuffer()) {
+    Napi::Buffer<uint8_t> buf = value.As<Napi::Buffer<uint8_t>>();
+    ptr = buf.Data();
+    limit = buf.Length();
+    return true;
+  }
+  limit = SIZE_MAX;
+  if (value.IsBigInt()) {
+    bool lossless;
+    uint64_t addr = value.As<Napi::BigInt>().Uint64Value(&lossless);
+    if (!lossless) {
+      Napi::TypeError::New(env, "BigInt conversion to pointer lost precision").ThrowAsJavaScriptException();
+      return false;
+    }
+    ptr = reinterpret_cast<uint8_t*>(static_cast<uintptr_t>(addr));
+    return true;
+  }
+  if (value.IsNumber()) {
+    ptr = reinterpret_cast<uint8_t*>(static_cast<uintptr_t>(value.As<Napi::Number>().Int64Value()));
+    return true;
+  }
+  void* handle = nullptr;
+  if (value.IsExternal() && GetPointerHandle(env, value, handle)) {
+    ptr = static_cast<uint8_t*>(handle);
+    return true;
+  }
+  Napi::TypeError::New(env, "Invalid pointer type").ThrowAsJavaScriptException();
+  return false;
+}
+
+// Dimensione di elemento costante: memcpy diventa una singola load/store e
+// il loop resta semplice da vettorizzare (gather/scatter dove l'ISA lo ha)
+template <size_t N>
+static void CopyStridedFixed(uint8_t* dst, size_t dst_stride, const uint8_t* src, size_t src_stride, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    memcpy(dst, src, N);
+    dst += dst_stride;
+    src += src_stride;
+  }
+}
+
+void CopyStrided(void* dst, size_t dst_stride, const void* src, size_t src_stride, size_t count, size_t elem_size) {
+  uint8_t* d = static_cast<uint8_t*>(dst);
+  const uint8_t* s = static_cast<const uint8_t*>(src);
+  if (count == 0) {
+    return;
+  }
+  if (dst_stride == elem_size && src_stride == elem_size) {
+    memcpy(d, s, count * elem_size);
+    return;
+  }
+  switch (elem_size) {
+    case 1:
+      CopyStridedFixed<1>(d, dst_stride, s, src_stride, count);
+      return;
+    case 2:
+      CopyStridedFixed<2>(d, dst_stride, s, src_stride, count);
+      return;
+    case 4:
+      CopyStridedFixed<4>(d, dst_stride, s, src_stride, count);
+      return;
+    case 8:
+      CopyStridedFixed<8>(d, dst_stride, s, src_stride, count);
+      return;
+    default:
+      for (size_t i = 0; i < count; i++) {
+        memcpy(d + i * dst_stride, s + i * src_stride, elem_size);
+      }
+      return;
+  }
+}
+
+bool GetSizeArg(Napi::Env env, const Napi::Value& value, const char* name, size_t& out) {
+  double raw = value.IsNumber() ? value.As<Napi::Number>().DoubleValue() : -1;
+  if (!(raw >= 0) || raw != std::floor(raw) || raw > 9007199254740991.0) {
+    Napi::RangeError::New(env, std::format("{} must be a non-negative integer", name)).ThrowAsJavaScriptException();
+    return false;
+  }
+  out = static_cast<size_t>(raw);
+  return true;
+}
+
+bool CheckStridedSpan(Napi::Env env, size_t count, size_t stride, size_t elem_size, size_t limit) {
+  if (count == 0) {
+    return true;
+  }
+  // Ultimo elemento: (count - 1) * stride + elem_size, senza overflow
+  if (elem_size > limit || (stride > 0 && count - 1 > (limit - elem_size) / stride)) {
+    Napi::RangeError::New(env, "Access would exceed buffer bounds").ThrowAsJavaScriptException();
+    return false;
+  }
+  return true;
+}
+
+// ============================================================================
+// Stringhe JS → buffer C
+// ============================================================================
+
+size_t AppendUtf8String(napi_env env, napi_value value, std::vector<char>& out) {
+  // Una sola trascodifica: il buffer è dimensionato sul limite superiore
+  // (O(1)) invece che su napi_get_value_string_utf8(nullptr), che per
+  // calcolare la lunghezza esatta dovrebbe già scorrere tutta la stringa.
+  const size_t offset = out.size();
+  const size_t bound = Utf8StringBound(env, value);
+  out.resize(offset + bound);
+  size_t written = 0;
+  napi_get_value_string_utf8(env, value, out.data() + offset, bound, &written);
+  // N-API ha già scritto il terminatore in offset + written
+  out.resize(offset + written + 1);
+  return offset;
+}
+
+size_t AppendWideString(napi_env env, napi_value value, std::vector<char>& out) {
+  size_t u16_len = 0;
+  napi_get_value_string_utf16(env, value, nullptr, 0, &u16_len);
+
+  // Allinea per wchar_t (accessi non allineati: crash su ARM, penalità su x86)
+  constexpr size_t wchar_align = alignof(wchar_t);
+  const size_t offset = (out.size() + wchar_align - 1) & ~(wchar_align - 1);
+  out.resize(offset + (u16_len + 1) * sizeof(wchar_t));
+  char* base = out.data() + offset;
+
+#ifdef _WIN32
+  // wchar_t è UTF-16: N-API scrive direttamente nella destinazione
+  size_t written = 0;
+  napi_get_value_string_utf16(env, value, reinterpret_cast<char16_t*>(base), u16_len + 1, &written);
+#else
+  // wchar_t a 32 bit: le code unit UTF-16 vengono lette nella metà alta
+  // della regione e allargate in avanti sul posto, senza u16string
+  // temporanea. Scrivere l'elemento j tocca solo byte di unit già lette.
+  // Le coppie surrogate diventano un solo code point (prima: due wchar_t).
+  char* src = base + (u16_len + 1) * sizeof(char16_t);
+  size_t written = 0;
+  napi_get_value_string_utf16(env, value, reinterpret_cast<char16_t*>(src), u16_len + 1, &written);
+  const size_t widened = WidenUtf16(src, written, base);
+  const wchar_t terminator = L'\0';
+  memcpy(base + widened * sizeof(wchar_t), &terminator, sizeof(terminator));
+#endif
+  return offset;
+}
+
 // ============================================================================
 // JSToC - Converte valore JS in bytes C
 // ============================================================================
@@ -288,6 +564,8 @@ int JSToC(Napi::Env env, Napi::Value value, CType type, void* buffer, size_t buf
         ptr = reinterpret_cast<void*>(addr);
       } else if (value.IsNumber()) {
         ptr = reinterpret_cast<void*>(static_cast<uintptr_t>(AsNumberFast(value).Int64Value()));
+      } else if (value.IsExternal()) {
+        GetPointerHandle(env, value, ptr);
       }
 
       memcpy(buffer, &ptr, sizeof(void*));
@@ -430,7 +708,7 @@ int JSToC(Napi::Env env, Napi::Value value, CType type, void* buffer, size_t buf
 // CToJS - Converte bytes C in valore JS
 // ============================================================================
 
-Napi::Value CToJS(Napi::Env env, const void* buffer, CType type) {
+Napi::Value CToJS(Napi::Env env, const void* buffer, CType type, PointerMode mode) {
   switch (type) {
     case CType::CTYPES_VOID:
       return env.Undefined();
@@ -474,13 +752,13 @@ Napi::Value CToJS(Napi::Env env, const void* buffer, CType type) {
     case CType::CTYPES_INT64: {
       int64_t val;
       memcpy(&val, buffer, sizeof(val));
-      return Napi::BigInt::New(env, val);
+      return Int64ToJS(env, val, mode);
     }
 
     case CType::CTYPES_UINT64: {
       uint64_t val;
       memcpy(&val, buffer, sizeof(val));
-      return Napi::BigInt::New(env, val);
+      return Uint64ToJS(env, val, mode);
     }
 
     case CType::CTYPES_FLOAT: {
@@ -498,10 +776,7 @@ Napi::Value CToJS(Napi::Env env, const void* buffer, CType type) {
     case CType::CTYPES_POINTER: {
       void* ptr;
       memcpy(&ptr, buffer, sizeof(void*));
-      if (ptr == nullptr) {
-        return env.Null();
-      }
-      return Napi::BigInt::New(env, reinterpret_cast<uint64_t>(ptr));
+      return PointerToJS(env, ptr, mode);
     }
 
     case CType::CTYPES_STRING: {
@@ -510,7 +785,7 @@ Napi::Value CToJS(Napi::Env env, const void* buffer, CType type) {
       if (str == nullptr) {
         return env.Null();
       }
-      return Napi::String::New(env, str);
+      return CStringToJS(env, str, strlen(str));
     }
 
     case CType::CTYPES_WSTRING: {
@@ -519,33 +794,7 @@ Napi::Value CToJS(Napi::Env env, const void* buffer, CType type) {
       if (str == nullptr) {
         return env.Null();
       }
-#ifdef _WIN32
-      // Windows: wchar_t è 16-bit (UTF-16)
-      return Napi::String::New(env, reinterpret_cast<const char16_t*>(str));
-#else
-      // Unix: wchar_t è 32-bit, dobbiamo convertire
-      std::wstring wstr(str);
-      std::string utf8;
-      utf8.reserve(wstr.size() * 4);
-      for (wchar_t wc : wstr) {
-        if (wc < 0x80) {
-          utf8.push_back(static_cast<char>(wc));
-        } else if (wc < 0x800) {
-          utf8.push_back(static_cast<char>(0xC0 | (wc >> 6)));
-          utf8.push_back(static_cast<char>(0x80 | (wc & 0x3F)));
-        } else if (wc < 0x10000) {
-          utf8.push_back(static_cast<char>(0xE0 | (wc >> 12)));
-          utf8.push_back(static_cast<char>(0x80 | ((wc >> 6) & 0x3F)));
-          utf8.push_back(static_cast<char>(0x80 | (wc & 0x3F)));
-        } else {
-          utf8.push_back(static_cast<char>(0xF0 | (wc >> 18)));
-          utf8.push_back(static_cast<char>(0x80 | ((wc >> 12) & 0x3F)));
-          utf8.push_back(static_cast<char>(0x80 | ((wc >> 6) & 0x3F)));
-          utf8.push_back(static_cast<char>(0x80 | (wc & 0x3F)));
-        }
-      }
-      return Napi::String::New(env, utf8);
-#endif
+      return WStringToJS(env, str, FindWStringEnd(str, SIZE_MAX));
     }
 
     case CType::CTYPES_WCHAR: {
@@ -563,25 +812,25 @@ Napi::Value CToJS(Napi::Env env, const void* buffer, CType type) {
     case CType::CTYPES_SIZE_T: {
       size_t val;
       memcpy(&val, buffer, sizeof(size_t));
-      return Napi::BigInt::New(env, static_cast<uint64_t>(val));
+      return Uint64ToJS(env, static_cast<uint64_t>(val), mode);
     }
 
     case CType::CTYPES_SSIZE_T: {
       ssize_t val;
       memcpy(&val, buffer, sizeof(ssize_t));
-      return Napi::BigInt::New(env, static_cast<int64_t>(val));
+      return Int64ToJS(env, static_cast<int64_t>(val), mode);
     }
 
     case CType::CTYPES_LONG: {
       long val;
       memcpy(&val, buffer, sizeof(long));
-      return Napi::BigInt::New(env, static_cast<int64_t>(val));
+      return Int64ToJS(env, static_cast<int64_t>(val), mode);
     }
 
     case CType::CTYPES_ULONG: {
       unsigned long val;
       memcpy(&val, buffer, sizeof(unsigned long));
-      return Napi::BigInt::New(env, static_cast<uint64_t>(val));
+      return Uint64ToJS(env, static_cast<uint64_t>(val), mode);
     }
 
     default:
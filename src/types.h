@@ -48,6 +48,128 @@ ffi_type* CTypeToFFI(CType type);
 // Dimensione di un tipo
 size_t CTypeSize(CType type);
 
+// Nome leggibile di un tipo (messaggi di errore / debug)
+const char* CTypeToName(CType type);
+
+// TypedArray ↔ CType (batch/bulk APIs). Un TypedArray è compatibile con un
+// tipo primitivo se ha la stessa dimensione di elemento e la stessa classe
+// (intero vs floating point); il segno non conta, i bit vengono copiati.
+bool TypedArrayMatchesCType(napi_typedarray_type ta_type, CType type);
+// TypedArray "di elementi": qualsiasi TypedArray tranne Uint8Array (e
+// quindi Buffer), che per compatibilità marshalla come byte grezzi.
+// `data` punta già al primo elemento (byte offset applicato).
+inline bool GetElementTypedArray(napi_env env,
+                                 napi_value value,
+                                 napi_typedarray_type& type,
+                                 void*& data,
+                                 size_t& length) {
+  bool is_typed = false;
+  if (napi_is_typedarray(env, value, &is_typed) != napi_ok || !is_typed) {
+    return false;
+  }
+  if (napi_get_typedarray_info(env, value, &type, &length, &data, nullptr, nullptr) != napi_ok) {
+    return false;
+  }
+  return type != napi_uint8_array;
+}
+// TypedArray "canonico" per un tipo primitivo (es. INT32 → Int32Array,
+// POINTER → BigUint64Array). Ritorna false per i tipi non primitivi.
+bool CTypeToTypedArrayType(CType type, napi_typedarray_type& out);
+
+// Puntatore da un argomento JS: Buffer / ArrayBufferView, BigInt, Number o
+// handle di puntatore.
+// `limit` = byte accessibili da `ptr` (SIZE_MAX per un indirizzo raw).
+// false con TypeError JS pendente.
+bool GetPointerArg(Napi::Env env, const Napi::Value& value, uint8_t*& ptr, size_t& limit);
+
+// Copia `count` elementi di `elem_size` byte tra due layout con stride
+// diversi: gather (src strided → dst contiguo), scatter (il contrario) o
+// strided → strided. Con entrambi gli stride uguali a elem_size è un memcpy.
+void CopyStrided(void* dst, size_t dst_stride, const void* src, size_t src_stride, size_t count, size_t elem_size);
+
+// Intero non negativo (count / stride) da un Number JS. false con
+// RangeError JS pendente (il messaggio cita `name`).
+bool GetSizeArg(Napi::Env env, const Napi::Value& value, const char* name, size_t& out);
+
+// `count` elementi di `elem_size` byte a passo `stride` stanno in `limit`
+// byte? false con RangeError JS pendente (anche in caso di overflow).
+bool CheckStridedSpan(Napi::Env env, size_t count, size_t stride, size_t elem_size, size_t limit);
+
+// Stringhe JS → C in un solo passaggio. Accodano a `out` la stringa
+// terminata (UTF-8 per char*, wchar_t per wchar_t*, allineata) e ritornano
+// l'offset del primo byte. `out` può essere riallocato: chi salva il
+// puntatore deve farlo a riempimento finito (offset + fixup).
+size_t AppendUtf8String(napi_env env, napi_value value, std::vector<char>& out);
+size_t AppendWideString(napi_env env, napi_value value, std::vector<char>& out);
+
+// Limite superiore sui byte UTF-8 (terminatore incluso) di una stringa JS.
+// O(1): la lunghezza UTF-16 è nota a V8, niente trascodifica.
+inline size_t Utf8StringBound(napi_env env, napi_value value) {
+  size_t u16_len = 0;
+  napi_get_value_string_utf16(env, value, nullptr, 0, &u16_len);
+  // 3 byte per code unit: copre BMP (≤ 3) e coppie surrogate (4 per 2 unit)
+  return u16_len * 3 + 1;
+}
+
+// ============================================================================
+// Rappresentazione JS di puntatori e interi a 64 bit (opzione pointerMode)
+//
+// BIGINT (default): sempre BigInt, un'allocazione su heap per ogni valore
+// ritornato e una Uint64Value per ogni valore ripassato al native.
+// NUMBER: Number se il valore è esatto in un double (≤ 2^53, tutti gli
+// indirizzi user space a 47/48 bit); un puntatore oltre diventa un handle
+// (External con type tag) che i marshaller riconoscono e scartano senza
+// conversione, un intero oltre resta BigInt.
+// ============================================================================
+
+enum class PointerMode : uint8_t { BIGINT = 0, NUMBER = 1 };
+
+inline constexpr uint64_t kMaxExactDoubleInteger = uint64_t{1} << 53;
+
+// Handle di puntatore: External con il type tag di node-ctypes
+Napi::Value NewPointerHandle(Napi::Env env, void* ptr);
+// true se `value` è un handle creato da NewPointerHandle (`ptr` valorizzato).
+// Da chiamare dopo IsExternal(): il check del tag costa una lookup.
+bool GetPointerHandle(napi_env env, napi_value value, void*& ptr);
+
+inline Napi::Value PointerToJS(Napi::Env env, void* ptr, PointerMode mode) {
+  if (ptr == nullptr) {
+    return env.Null();
+  }
+  const uint64_t addr = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr));
+  if (mode == PointerMode::BIGINT) {
+    return Napi::BigInt::New(env, addr);
+  }
+  if (addr <= kMaxExactDoubleInteger) {
+    napi_value result;
+    napi_create_double(env, static_cast<double>(addr), &result);
+    return Napi::Value(env, result);
+  }
+  return NewPointerHandle(env, ptr);
+}
+
+inline Napi::Value Int64ToJS(Napi::Env env, int64_t v, PointerMode mode) {
+  if (mode == PointerMode::NUMBER && v >= -static_cast<int64_t>(kMaxExactDoubleInteger) &&
+      v <= static_cast<int64_t>(kMaxExactDoubleInteger)) {
+    napi_value result;
+    napi_create_double(env, static_cast<double>(v), &result);
+    return Napi::Value(env, result);
+  }
+  return Napi::BigInt::New(env, v);
+}
+
+inline Napi::Value Uint64ToJS(Napi::Env env, uint64_t v, PointerMode mode) {
+  if (mode == PointerMode::NUMBER && v <= kMaxExactDoubleInteger) {
+    napi_value result;
+    napi_create_double(env, static_cast<double>(v), &result);
+    return Napi::Value(env, result);
+  }
+  return Napi::BigInt::New(env, v);
+}
+
+// "bigint" / "number" → PointerMode. false con TypeError JS pendente.
+bool ParsePointerMode(Napi::Env env, const Napi::Value& value, PointerMode& out);
+
 // Converte un valore JS in bytes C
 // Ritorna il numero di bytes scritti, o -1 per errore
 // NOTA: Solo per tipi primitivi. STRUCT/UNION/ARRAY usano StructInfo/ArrayInfo
@@ -55,7 +177,8 @@ int JSToC(Napi::Env env, Napi::Value value, CType type, void* buffer, size_t buf
 
 // Converte bytes C in valore JS
 // NOTA: Solo per tipi primitivi. STRUCT/UNION/ARRAY usano StructInfo/ArrayInfo
-Napi::Value CToJS(Napi::Env env, const void* buffer, CType type);
+// `mode` si applica a puntatori e interi a 64 bit (vedi PointerMode)
+Napi::Value CToJS(Napi::Env env, const void* buffer, CType type, PointerMode mode = PointerMode::BIGINT);
 
 // Crea oggetto CType esportato a JS (enum con tutti i valori)
 Napi::Object CreateCType(Napi::Env env);
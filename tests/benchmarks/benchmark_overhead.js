@@ -0,0 +1,468 @@
+// Benchmark: overhead di chiamata di node-ctypes per categoria, con
+// confronto contro una baseline salvata.
+//
+// Usa la libreria nativa ctypes_bench (funzioni a costo noto, nessuna
+// dipendenza da libc), da compilare prima con:
+//   npm run build:bench
+//
+// Run:
+//   node tests/benchmarks/benchmark_overhead.js [options]
+//
+// Options:
+//   --lib <path>         Libreria ctypes_bench (default: build/bench/ctypes_bench.*)
+//   --json <file>        Scrive i risultati come JSON su file ("-" = stdout)
+//   --baseline <file>    Baseline da confrontare
+//                        (default: benchmarks/baselines/<platform>-<arch>.json)
+//   --update-baseline    Salva i risultati come nuova baseline
+//   --tolerance <ratio>  Regressione ammessa rispetto alla baseline (default: 0.25)
+//   --filter <substr>    Esegue solo i casi il cui nome contiene substr
+//   --rounds <n>         Ripetizioni per caso, si tiene la mediana (default: 5)
+//
+// Exit code 1 se almeno un caso è più lento della baseline oltre la tolleranza.
+
+import * as ctypes from "node-ctypes";
+import fs from "node:fs";
+import os from "node:os";
+import path from "node:path";
+import { fileURLToPath } from "node:url";
+
+const here = path.dirname(fileURLToPath(import.meta.url));
+const root = path.resolve(here, "..", "..");
+
+// ============================================================================
+// Opzioni
+// ============================================================================
+
+function parseArgs(argv) {
+  const opts = { tolerance: 0.25, rounds: 5, updateBaseline: false };
+  for (let i = 0; i < argv.length; i++) {
+    const arg = argv[i];
+    const value = () => {
+      if (i + 1 >= argv.length) throw new Error(`Missing value for ${arg}`);
+      return argv[++i];
+    };
+    switch (arg) {
+      case "--lib":
+        opts.lib = value();
+        break;
+      case "--json":
+        opts.json = value();
+        break;
+      case "--baseline":
+        opts.baseline = value();
+        break;
+      case "--update-baseline":
+        opts.updateBaseline = true;
+        break;
+      case "--tolerance":
+        opts.tolerance = Number(value());
+        break;
+      case "--filter":
+        opts.filter = value();
+        break;
+      case "--rounds":
+        opts.rounds = Math.max(1, Number(value()) | 0);
+        break;
+      default:
+        throw new Error(`Unknown option: ${arg}`);
+    }
+  }
+  opts.baseline ??= path.join(here, "baselines", `${os.platform()}-${os.arch()}.json`);
+  return opts;
+}
+
+function findBenchLib() {
+  const ext = process.platform === "win32" ? ".dll" : process.platform === "darwin" ? ".dylib" : ".so";
+  const candidates = [path.join(root, "build", "bench", `ctypes_bench${ext}`)];
+  const found = candidates.find((p) => fs.existsSync(p));
+  if (!found) {
+    throw new Error(`ctypes_bench${ext} not found (looked in ${candidates.join(", ")}); run "npm run build:bench" or pass --lib`);
+  }
+  return found;
+}
+
+const opts = parseArgs(process.argv.slice(2));
+const log = opts.json === "-" ? (...a) => console.error(...a) : (...a) => console.log(...a);
+
+// ============================================================================
+// Misura
+// ============================================================================
+
+const cases = [];
+
+/**
+ * Registra un caso. `setup` ritorna `run(n)`, che esegue n operazioni
+ * (sincrone o async) così il loop di misura non aggiunge una closure per
+ * operazione, oppure `{ run, teardown }`, oppure null se il caso non si
+ * applica alla piattaforma.
+ */
+function bench(name, { ops, setup }) {
+  cases.push({ name, ops, setup });
+}
+
+function median(values) {
+  const sorted = [...values].sort((a, b) => a - b);
+  const mid = sorted.length >> 1;
+  return sorted.length % 2 ? sorted[mid] : (sorted[mid - 1] + sorted[mid]) / 2;
+}
+
+async function measure({ ops, run }) {
+  // Warmup: porta il call site in JIT e riempie le cache native (CIF, plan)
+  await run(Math.max(1, ops >> 3));
+  const samples = [];
+  for (let r = 0; r < opts.rounds; r++) {
+    const start = process.hrtime.bigint();
+    await run(ops);
+    samples.push(Number(process.hrtime.bigint() - start) / ops);
+  }
+  return { nsPerOp: median(samples), minNsPerOp: Math.min(...samples), ops, rounds: opts.rounds };
+}
+
+// ============================================================================
+// Casi
+// ============================================================================
+
+const lib = new ctypes.CDLL(opts.lib ?? findBenchLib());
+const { c_void, c_int32, c_int64, c_double, c_size_t, c_char_p, c_wchar_p, c_void_p } = ctypes;
+
+class Point extends ctypes.Structure {
+  static _fields_ = [
+    ["x", c_double],
+    ["y", c_double],
+  ];
+}
+
+class Record extends ctypes.Structure {
+  static _fields_ = [
+    ["a", c_int32],
+    ["b", c_int32],
+    ["c", c_int64],
+    ["d", c_double],
+  ];
+}
+
+bench("sync.noop", {
+  ops: 2_000_000,
+  setup: () => {
+    const f = lib.func("bench_noop", c_void, []);
+    return (n) => {
+      for (let i = 0; i < n; i++) f();
+    };
+  },
+});
+
+bench("sync.int_args", {
+  ops: 2_000_000,
+  setup: () => {
+    const f = lib.func("bench_add_i32", c_int32, [c_int32, c_int32]);
+    return (n) => {
+      for (let i = 0; i < n; i++) f(i, 1);
+    };
+  },
+});
+
+bench("sync.int_args6", {
+  ops: 1_000_000,
+  setup: () => {
+    const f = lib.func("bench_sum6_i32", c_int32, [c_int32, c_int32, c_int32, c_int32, c_int32, c_int32]);
+    return (n) => {
+      for (let i = 0; i < n; i++) f(i, 1, 2, 3, 4, 5);
+    };
+  },
+});
+
+bench("sync.int64_args", {
+  ops: 1_000_000,
+  setup: () => {
+    const f = lib.func("bench_add_i64", c_int64, [c_int64, c_int64]);
+    return (n) => {
+      for (let i = 0; i < n; i++) f(BigInt(i), 1n);
+    };
+  },
+});
+
+bench("sync.double_args", {
+  ops: 2_000_000,
+  setup: () => {
+    const f = lib.func("bench_add_f64", c_double, [c_double, c_double]);
+    return (n) => {
+      for (let i = 0; i < n; i++) f(i, 0.5);
+    };
+  },
+});
+
+bench("sync.pointer_args", {
+  ops: 1_000_000,
+  setup: () => {
+    const f = lib.func("bench_identity_ptr", c_void_p, [c_void_p]);
+    const buf = Buffer.alloc(16);
+    return (n) => {
+      for (let i = 0; i < n; i++) f(buf);
+    };
+  },
+});
+
+bench("string.ascii_arg", {
+  ops: 1_000_000,
+  setup: () => {
+    const f = lib.func("bench_strlen", c_size_t, [c_char_p]);
+    return (n) => {
+      for (let i = 0; i < n; i++) f("hello, node-ctypes");
+    };
+  },
+});
+
+bench("string.long_arg", {
+  ops: 200_000,
+  setup: () => {
+    const f = lib.func("bench_strlen", c_size_t, [c_char_p]);
+    const s = "x".repeat(4096);
+    return (n) => {
+      for (let i = 0; i < n; i++) f(s);
+    };
+  },
+});
+
+bench("string.wide_arg", {
+  ops: 500_000,
+  setup: () => {
+    const f = lib.func("bench_wcslen", c_size_t, [c_wchar_p]);
+    return (n) => {
+      for (let i = 0; i < n; i++) f("hello, node-ctypes");
+    };
+  },
+});
+
+bench("string.return", {
+  ops: 1_000_000,
+  setup: () => {
+    const f = lib.func("bench_const_string", c_char_p, []);
+    return (n) => {
+      for (let i = 0; i < n; i++) f();
+    };
+  },
+});
+
+bench("struct.by_value_arg", {
+  ops: 500_000,
+  setup: () => {
+    const f = lib.func("bench_point_dot", c_double, [Point]);
+    const p = new Point({ x: 3, y: 4 });
+    return (n) => {
+      for (let i = 0; i < n; i++) f(p);
+    };
+  },
+});
+
+bench("struct.by_value_return", {
+  ops: 500_000,
+  setup: () => {
+    const f = lib.func("bench_point_scale", Point, [Point, c_double]);
+    const p = new Point({ x: 3, y: 4 });
+    return (n) => {
+      for (let i = 0; i < n; i++) f(p, 2);
+    };
+  },
+});
+
+bench("struct.mixed_fields_arg", {
+  ops: 500_000,
+  setup: () => {
+    const f = lib.func("bench_record_sum", c_int64, [Record]);
+    const r = new Record({ a: 1, b: 2, c: 3n, d: 4.5 });
+    return (n) => {
+      for (let i = 0; i < n; i++) f(r);
+    };
+  },
+});
+
+bench("struct.out_pointer", {
+  ops: 1_000_000,
+  setup: () => {
+    const f = lib.func("bench_point_fill", c_void, [c_void_p, c_double, c_double]);
+    const p = new Point();
+    return (n) => {
+      for (let i = 0; i < n; i++) f(p, i, 1);
+    };
+  },
+});
+
+bench("array.int32_64", {
+  ops: 500_000,
+  setup: () => {
+    const f = lib.func("bench_sum_i32_array", c_int64, [c_void_p, c_size_t]);
+    const arr = ctypes.array(c_int32, 64).create(Array.from({ length: 64 }, (_, i) => i));
+    return (n) => {
+      for (let i = 0; i < n; i++) f(arr, 64);
+    };
+  },
+});
+
+bench("array.typed_array", {
+  ops: 1_000_000,
+  setup: () => {
+    const f = lib.func("bench_sum_i32_array", c_int64, [c_void_p, c_size_t]);
+    const values = new Int32Array(64).map((_, i) => i);
+    return (n) => {
+      for (let i = 0; i < n; i++) f(values, 64);
+    };
+  },
+});
+
+bench("array.call_batch", {
+  // Un'operazione = un elemento del batch
+  ops: 1_000_000,
+  setup: () => {
+    const f = lib.func("bench_add_i32", c_int32, [c_int32, c_int32]);
+    const chunk = 4096;
+    const a = new Int32Array(chunk).map((_, i) => i);
+    const out = new Int32Array(chunk);
+    return (n) => {
+      for (let done = 0; done < n; done += chunk) {
+        f.callBatch([a, 1], Math.min(chunk, n - done), out);
+      }
+    };
+  },
+});
+
+bench("variadic.int_args", {
+  ops: 500_000,
+  setup: () => {
+    const f = lib.func("bench_sum_variadic", c_int32, [c_int32]);
+    return (n) => {
+      for (let i = 0; i < n; i++) f(3, 1, 2, i);
+    };
+  },
+});
+
+bench("callback.same_thread", {
+  // Un'operazione = un'invocazione del callback JS da codice nativo
+  ops: 1_000_000,
+  setup: () => {
+    const f = lib.func("bench_call_cb", c_int32, [c_void_p, c_int32]);
+    const cb = ctypes.callback((i) => i & 1, c_int32, [c_int32]);
+    const batch = 1000;
+    return {
+      run: (n) => {
+        for (let done = 0; done < n; done += batch) f(cb.pointer, Math.min(batch, n - done));
+      },
+      teardown: () => cb.release(),
+    };
+  },
+});
+
+bench("callback.foreign_thread", {
+  // bench_call_cb gira su un worker del CallPool: ogni invocazione è una
+  // chiamata bloccante cross-thread verso il main thread
+  ops: 50_000,
+  setup: () => {
+    const f = lib.func("bench_call_cb", c_int32, [c_void_p, c_int32]);
+    const cb = ctypes.threadSafeCallback((i) => i & 1, c_int32, [c_int32]);
+    const batch = 1000;
+    return {
+      run: async (n) => {
+        for (let done = 0; done < n; done += batch) await f.callAsync(cb.pointer, Math.min(batch, n - done));
+      },
+      teardown: () => cb.release(),
+    };
+  },
+});
+
+bench("async.sequential", {
+  ops: 50_000,
+  setup: () => {
+    const f = lib.func("bench_add_i32", c_int32, [c_int32, c_int32]);
+    return async (n) => {
+      for (let i = 0; i < n; i++) await f.callAsync(i, 1);
+    };
+  },
+});
+
+bench("async.concurrent64", {
+  // 64 chiamate in volo alla volta; un'operazione = una chiamata
+  ops: 200_000,
+  setup: () => {
+    const f = lib.func("bench_add_i32", c_int32, [c_int32, c_int32]);
+    const inflight = 64;
+    return async (n) => {
+      for (let done = 0; done < n; done += inflight) {
+        const k = Math.min(inflight, n - done);
+        const pending = new Array(k);
+        for (let j = 0; j < k; j++) pending[j] = f.callAsync(j, 1);
+        await Promise.all(pending);
+      }
+    };
+  },
+});
+
+// ============================================================================
+// Esecuzione
+// ============================================================================
+
+const results = {};
+for (const c of cases) {
+  if (opts.filter && !c.name.includes(opts.filter)) continue;
+  const prepared = c.setup();
+  if (!prepared) {
+    log(`  ${c.name.padEnd(28)} skipped (not supported on this platform)`);
+    continue;
+  }
+  const { run, teardown } = typeof prepared === "function" ? { run: prepared } : prepared;
+  try {
+    results[c.name] = await measure({ ops: c.ops, run });
+  } finally {
+    teardown?.();
+  }
+  log(`  ${c.name.padEnd(28)} ${results[c.name].nsPerOp.toFixed(1).padStart(10)} ns/op`);
+}
+lib.close();
+
+const report = {
+  version: 1,
+  nodeCtypes: JSON.parse(fs.readFileSync(path.join(root, "package.json"), "utf8")).version,
+  node: process.version,
+  platform: os.platform(),
+  arch: os.arch(),
+  cpu: os.cpus()[0]?.model ?? "unknown",
+  date: new Date().toISOString(),
+  rounds: opts.rounds,
+  results,
+};
+
+// ============================================================================
+// Baseline
+// ============================================================================
+
+const regressions = [];
+if (opts.updateBaseline) {
+  fs.mkdirSync(path.dirname(opts.baseline), { recursive: true });
+  fs.writeFileSync(opts.baseline, JSON.stringify(report, null, 2) + "\n");
+  log(`\nBaseline written to ${opts.baseline}`);
+} else if (fs.existsSync(opts.baseline)) {
+  const baseline = JSON.parse(fs.readFileSync(opts.baseline, "utf8"));
+  const comparison = {};
+  log(`\nBaseline: ${opts.baseline} (node-ctypes ${baseline.nodeCtypes}, node ${baseline.node})`);
+  for (const [name, current] of Object.entries(results)) {
+    const base = baseline.results?.[name];
+    if (!base) continue;
+    const ratio = current.nsPerOp / base.nsPerOp;
+    const regressed = ratio > 1 + opts.tolerance;
+    comparison[name] = { baselineNsPerOp: base.nsPerOp, ratio, regressed };
+    if (regressed) regressions.push(name);
+    log(`  ${name.padEnd(28)} ${ratio.toFixed(2).padStart(6)}x${regressed ? "  REGRESSION" : ""}`);
+  }
+  report.baseline = { file: opts.baseline, tolerance: opts.tolerance, comparison, regressions };
+} else {
+  log(`\nNo baseline at ${opts.baseline} (create one with --update-baseline)`);
+}
+
+if (opts.json === "-") {
+  process.stdout.write(JSON.stringify(report, null, 2) + "\n");
+} else if (opts.json) {
+  fs.writeFileSync(opts.json, JSON.stringify(report, null, 2) + "\n");
+}
+
+if (regressions.length > 0) {
+  log(`\n${regressions.length} regression(s) over ${(opts.tolerance * 100).toFixed(0)}%: ${regressions.join(", ")}`);
+  process.exitCode = 1;
+}
@@ -0,0 +1,131 @@
+/*
+ * ctypes_bench - libreria nativa per i microbenchmark di node-ctypes.
+ *
+ * Funzioni a costo noto (quasi nullo) per misurare l'overhead della
+ * chiamata FFI e non il lavoro della funzione chiamata: ogni categoria
+ * (argomenti interi, struct by value, stringhe, array, callback, variadic)
+ * ha la sua funzione. Nessuna dipendenza da libc oltre <stdarg.h>.
+ *
+ * Build: npm run build:bench  (target CMake ctypes_bench)
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#define BENCH_API __declspec(dllexport)
+#else
+#define BENCH_API __attribute__((visibility("default")))
+#endif
+
+typedef struct {
+    double x;
+    double y;
+} bench_point;
+
+typedef struct {
+    int32_t a;
+    int32_t b;
+    int64_t c;
+    double d;
+} bench_record;
+
+typedef int32_t (*bench_int_cb)(int32_t);
+
+/* ========================================================================== */
+/* Chiamate sincrone                                                          */
+/* ========================================================================== */
+
+BENCH_API void bench_noop(void) {}
+
+BENCH_API int32_t bench_add_i32(int32_t a, int32_t b) { return a + b; }
+
+BENCH_API int64_t bench_add_i64(int64_t a, int64_t b) { return a + b; }
+
+BENCH_API double bench_add_f64(double a, double b) { return a + b; }
+
+BENCH_API int32_t bench_sum6_i32(int32_t a, int32_t b, int32_t c, int32_t d, int32_t e, int32_t f) {
+    return a + b + c + d + e + f;
+}
+
+BENCH_API void *bench_identity_ptr(void *p) { return p; }
+
+/* ========================================================================== */
+/* Struct by value                                                            */
+/* ========================================================================== */
+
+BENCH_API double bench_point_dot(bench_point p) { return p.x * p.x + p.y * p.y; }
+
+BENCH_API bench_point bench_point_scale(bench_point p, double k) {
+    bench_point r = {p.x * k, p.y * k};
+    return r;
+}
+
+BENCH_API int64_t bench_record_sum(bench_record r) { return (int64_t)r.a + r.b + r.c + (int64_t)r.d; }
+
+BENCH_API void bench_point_fill(bench_point *out, double x, double y) {
+    out->x = x;
+    out->y = y;
+}
+
+/* ========================================================================== */
+/* Stringhe e array                                                           */
+/* ========================================================================== */
+
+BENCH_API size_t bench_strlen(const char *s) {
+    const char *p = s;
+    while (*p) {
+        p++;
+    }
+    return (size_t)(p - s);
+}
+
+BENCH_API size_t bench_wcslen(const wchar_t *s) {
+    const wchar_t *p = s;
+    while (*p) {
+        p++;
+    }
+    return (size_t)(p - s);
+}
+
+static const char bench_message[] = "node-ctypes benchmark string";
+
+BENCH_API const char *bench_const_string(void) { return bench_message; }
+
+BENCH_API int64_t bench_sum_i32_array(const int32_t *values, size_t count) {
+    int64_t sum = 0;
+    for (size_t i = 0; i < count; i++) {
+        sum += values[i];
+    }
+    return sum;
+}
+
+/* ========================================================================== */
+/* Callback                                                                   */
+/* ========================================================================== */
+
+/* Invoca cb(i) per i in [0, count): chiamata sincrona, il callback gira sul
+ * thread del chiamante (main thread, o worker del CallPool con callAsync). */
+BENCH_API int32_t bench_call_cb(bench_int_cb cb, int32_t count) {
+    int32_t sum = 0;
+    for (int32_t i = 0; i < count; i++) {
+        sum += cb(i);
+    }
+    return sum;
+}
+
+/* ========================================================================== */
+/* Variadic                                                                   */
+/* ========================================================================== */
+
+BENCH_API int32_t bench_sum_variadic(int32_t count, ...) {
+    va_list ap;
+    int32_t sum = 0;
+    va_start(ap, count);
+    for (int32_t i = 0; i < count; i++) {
+        sum += (int32_t)va_arg(ap, int);
+    }
+    va_end(ap);
+    return sum;
+}
@@ -201,6 +201,113 @@ describe("Arrays", function () {
     });
   });
 
+  describe("TypedArray Arrays", function () {
+    it("should expose typed arrays as TypedArray views", function () {
+      const Samples = ctypes.array(ctypes.c_double, 4, { typed: true });
+      const arr = Samples.create([1.5, 2.5]);
+
+      assert.ok(arr instanceof Float64Array);
+      assert.strictEqual(arr.length, 4);
+      assert.deepStrictEqual([...arr], [1.5, 2.5, 0, 0]);
+
+      const fromTyped = Samples.create(new Float64Array([4, 3, 2, 1]));
+      assert.deepStrictEqual([...fromTyped], [4, 3, 2, 1]);
+    });
+
+    it("should reject typed arrays of non-numeric elements", function () {
+      throws(() => ctypes.array(ctypes.c_char_p, 4, { typed: true }), TypeError);
+    });
+
+    it("should return live views for typed array struct fields", function () {
+      const Frame = ctypes.struct({
+        id: ctypes.c_int32,
+        samples: ctypes.array(ctypes.c_float, 8, { typed: true }),
+      });
+      const frame = Frame.create({ id: 1, samples: new Float32Array([0.5, 0.25]) });
+
+      const samples = Frame.get(frame, "samples");
+      assert.ok(samples instanceof Float32Array);
+      assert.strictEqual(samples[1], 0.25);
+
+      samples[7] = 8;
+      assert.strictEqual(Frame.get(frame, "samples")[7], 8);
+    });
+
+    it("should memcpy matching TypedArrays into native arrays", function () {
+      const IntArray4 = ctypes.array(ctypes.c_int32, 4);
+      const buf = IntArray4._native.create(new Int32Array([1, -2, 3, -4]));
+      assert.deepStrictEqual([...new Int32Array(buf.buffer, buf.byteOffset, 4)], [1, -2, 3, -4]);
+
+      // Elementi di tipo diverso: conversione per elemento
+      const DoubleArray2 = ctypes.array(ctypes.c_double, 2);
+      const dbuf = DoubleArray2._native.create(new Float32Array([1.5, -0.25]));
+      assert.strictEqual(dbuf.readDoubleLE(0), 1.5);
+      assert.strictEqual(dbuf.readDoubleLE(8), -0.25);
+    });
+  });
+
+  describe("Bulk Memory Access", function () {
+    it("should read and write contiguous elements in one call", function () {
+      const buf = Buffer.alloc(4 * 8);
+      strictEqual(ctypes.writeArray(buf, ctypes.c_int32, [1, -2, 3, -4, 5, -6, 7, -8]), 8);
+
+      const values = ctypes.readArray(buf, ctypes.c_int32, 8);
+      assert.ok(values instanceof Int32Array);
+      assert.deepStrictEqual([...values], [1, -2, 3, -4, 5, -6, 7, -8]);
+
+      // Round trip da TypedArray (memcpy) e lettura in un TypedArray esistente
+      ctypes.writeArray(buf, ctypes.c_double, new Float64Array([0.5, 1.5, 2.5, 3.5]));
+      const out = new Float64Array(4);
+      strictEqual(ctypes.readArray(buf, ctypes.c_double, 4, undefined, out), out);
+      assert.deepStrictEqual([...out], [0.5, 1.5, 2.5, 3.5]);
+    });
+
+    it("should gather and scatter with a stride", function () {
+      const buf = Buffer.alloc(12 * 3);
+      ctypes.writeArray(buf, ctypes.c_uint16, new Uint16Array([10, 20, 30]), 12);
+      strictEqual(buf.readUInt16LE(0), 10);
+      strictEqual(buf.readUInt16LE(12), 20);
+      strictEqual(buf.readUInt16LE(24), 30);
+      strictEqual(buf.readUInt16LE(2), 0);
+
+      assert.deepStrictEqual([...ctypes.readArray(buf, ctypes.c_uint16, 3, 12)], [10, 20, 30]);
+    });
+
+    it("should reject out of bounds and invalid strides", function () {
+      const buf = Buffer.alloc(16);
+      throws(() => ctypes.readArray(buf, ctypes.c_int32, 5), RangeError);
+      throws(() => ctypes.readArray(buf, ctypes.c_int32, 2, 2), RangeError);
+      throws(() => ctypes.writeArray(buf, ctypes.c_int32, [1, 2], 12), RangeError);
+      throws(() => ctypes.readArray(buf, ctypes.c_char_p, 1), TypeError);
+    });
+
+    it("should read struct fields as columns", function () {
+      const Sample = ctypes.struct({
+        id: ctypes.c_int32,
+        x: ctypes.c_double,
+        flag: ctypes.c_uint8,
+      });
+      const n = 5;
+      const size = ctypes.sizeof(Sample);
+      const buf = Buffer.alloc(size * n);
+      for (let i = 0; i < n; i++) {
+        const item = Sample.create({ id: i, x: i * 0.5, flag: i % 2 });
+        item.copy(buf, i * size);
+      }
+
+      const { id, x, flag } = ctypes.readColumns(Sample, buf, n, ["id", "x", "flag"]);
+      assert.ok(id instanceof Int32Array);
+      assert.ok(x instanceof Float64Array);
+      assert.ok(flag instanceof Uint8Array);
+      assert.deepStrictEqual([...id], [0, 1, 2, 3, 4]);
+      assert.deepStrictEqual([...x], [0, 0.5, 1, 1.5, 2]);
+      assert.deepStrictEqual([...flag], [0, 1, 0, 1, 0]);
+
+      throws(() => ctypes.readColumns(Sample, buf, n, ["missing"]), /Unknown field/);
+      throws(() => ctypes.readColumns(Sample, buf, n + 1, ["id"]), RangeError);
+    });
+  });
+
   describe("String as Byte Arrays", function () {
     it("should create arrays from strings", function () {
       const CharArray = ctypes.array(ctypes.c_int8, 100);
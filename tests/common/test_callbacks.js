@@ -156,6 +156,32 @@ describe("Callbacks", function () {
     });
   });
 
+  describe("Struct arguments by value", function () {
+    class Point extends ctypes.Structure {
+      static _fields_ = [
+        ["x", ctypes.c_int32],
+        ["y", ctypes.c_int32],
+      ];
+    }
+
+    it("callback should receive a by-value struct as an object", function () {
+      const seen = [];
+      const cb = ctypes.CFUNCTYPE(ctypes.c_int32, Point, ctypes.c_double)((p, scale) => {
+        seen.push([p.x, p.y, scale]);
+        return (p.x + p.y) * scale;
+      });
+      const call = ctypes.CFUNCTYPE(ctypes.c_int32, Point, ctypes.c_double)(cb.pointer);
+
+      const pt = new Point();
+      pt.x = 3;
+      pt.y = -7;
+      strictEqual(call(pt, 2), -8);
+      assert.deepStrictEqual(seen, [[3, -7, 2]]);
+
+      cb.release();
+    });
+  });
+
   describe("Callback Properties", function () {
     it("should have pointer property", function () {
       const callback = libc.callback(() => 42, ctypes.c_int32, []);
@@ -233,4 +259,129 @@ describe("Callbacks", function () {
       assert.strictEqual(released, true, "release runs even when the block throws");
     });
   });
+
+  describe("Blocking threadSafeCallback from worker threads", function () {
+    it("should return each caller its own result under concurrency", async function () {
+      const qsort = libc.func("qsort", ctypes.c_void, [ctypes.c_void_p, ctypes.c_size_t, ctypes.c_size_t, ctypes.c_void_p]);
+      const compare = ctypes.threadSafeCallback(
+        (a, b) => ctypes.readValue(a, ctypes.c_int32) - ctypes.readValue(b, ctypes.c_int32),
+        ctypes.c_int32,
+        [ctypes.c_void_p, ctypes.c_void_p],
+      );
+      try {
+        // qsort gira sui worker del CallPool: ogni confronto è una chiamata
+        // bloccante da thread esterno, più sort in parallelo condividono il callback
+        const arrays = Array.from({ length: 4 }, (_, k) => {
+          const buf = Buffer.alloc(4 * 32);
+          for (let i = 0; i < 32; i++) buf.writeInt32LE(((i * 7919 + k * 31) % 101) - 50, i * 4);
+          return buf;
+        });
+        await Promise.all(arrays.map((buf) => qsort.callAsync(buf, 32, 4, compare.pointer)));
+
+        for (const buf of arrays) {
+          const values = Array.from({ length: 32 }, (_, i) => buf.readInt32LE(i * 4));
+          assert.deepStrictEqual(values, [...values].sort((x, y) => x - y));
+        }
+      } finally {
+        compare.release();
+      }
+    });
+  });
+
+  describe("Non-blocking threadSafeCallback", { skip: platform !== "linux" }, function () {
+    function pthreadFuncs() {
+      let lib = libc;
+      try {
+        lib.symbol("pthread_create");
+      } catch {
+        lib = new ctypes.CDLL("libpthread.so.0"); // glibc < 2.34
+      }
+      return {
+        create: lib.func("pthread_create", ctypes.c_int, [ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p]),
+        join: lib.func("pthread_join", ctypes.c_int, [ctypes.c_uint64, ctypes.c_void_p]),
+      };
+    }
+
+    // Avvia `count` thread che invocano cb.pointer con arg = indice, poi li
+    // joina dal main thread: in modalità bloccante sarebbe un deadlock.
+    function runThreads(cb, count) {
+      const { create, join } = pthreadFuncs();
+      const tids = Buffer.alloc(8 * count);
+      for (let i = 0; i < count; i++) {
+        strictEqual(create(tids.subarray(i * 8), null, cb.pointer, BigInt(i + 1)), 0);
+      }
+      for (let i = 0; i < count; i++) {
+        strictEqual(join(tids.readBigUInt64LE(i * 8), null), 0);
+      }
+    }
+
+    async function waitFor(predicate) {
+      for (let i = 0; i < 200 && !predicate(); i++) {
+        await new Promise((resolve) => setTimeout(resolve, 5));
+      }
+    }
+
+    it("should deliver every record once per call", async function () {
+      const seen = [];
+      const cb = ctypes.threadSafeCallback((arg) => seen.push(Number(arg)), ctypes.c_void, [ctypes.c_void_p], {
+        nonBlocking: true,
+      });
+      try {
+        runThreads(cb, 8);
+        await waitFor(() => seen.length === 8);
+        assert.deepStrictEqual(seen.sort((a, b) => a - b), [1, 2, 3, 4, 5, 6, 7, 8]);
+      } finally {
+        cb.release();
+      }
+    });
+
+    it("should deliver batches of argument arrays", async function () {
+      const seen = [];
+      let calls = 0;
+      const cb = ctypes.threadSafeCallback(
+        (records) => {
+          calls++;
+          assert.ok(Array.isArray(records));
+          for (const [arg] of records) seen.push(Number(arg));
+        },
+        ctypes.c_void,
+        [ctypes.c_void_p],
+        { nonBlocking: true, batch: true, capacity: 16 },
+      );
+      try {
+        runThreads(cb, 16);
+        await waitFor(() => seen.length === 16);
+        strictEqual(seen.length, 16);
+        strictEqual(cb.dropped, 0);
+        assert.ok(calls <= 16);
+      } finally {
+        cb.release();
+      }
+    });
+
+    it("should drop and count events when the ring is full", async function () {
+      const seen = [];
+      const cb = ctypes.threadSafeCallback((arg) => seen.push(Number(arg)), ctypes.c_void, [ctypes.c_void_p], {
+        nonBlocking: true,
+        capacity: 2,
+      });
+      try {
+        // Il main thread è bloccato nel join: nessun drain finché i thread
+        // non terminano, quindi solo 2 eventi entrano nel ring
+        runThreads(cb, 8);
+        await waitFor(() => seen.length === 2);
+        await new Promise((resolve) => setTimeout(resolve, 20));
+        strictEqual(seen.length, 2);
+        strictEqual(cb.dropped, 6);
+      } finally {
+        cb.release();
+      }
+    });
+
+    it("should reject non-void return types and string arguments", function () {
+      throws(() => ctypes.threadSafeCallback(() => 0, ctypes.c_int32, [], { nonBlocking: true }), TypeError);
+      throws(() => ctypes.threadSafeCallback(() => {}, ctypes.c_void, [ctypes.c_char_p], { nonBlocking: true }), TypeError);
+      throws(() => ctypes.threadSafeCallback(() => {}, ctypes.c_void, [], { batch: true }), TypeError);
+    });
+  });
 });
@@ -322,6 +322,108 @@ describe("errcheck (Python ctypes compatible)", function () {
       );
     });
   });
+
+  describe("Declarative errcheck policies", function () {
+    it("throws only when the predicate matches", function () {
+      const abs = libc.func("abs", ctypes.c_int32, [ctypes.c_int32]);
+      const calls = [];
+      abs.errcheck = {
+        fail: "zero",
+        error: (code, result, func, args) => {
+          calls.push([code, result, args]);
+          return new Error("abs returned zero");
+        },
+      };
+
+      for (let i = 1; i <= 100; i++) assert.strictEqual(abs(-i), i);
+      assert.strictEqual(calls.length, 0, "the factory must not run on success");
+
+      assert.throws(() => abs(0), /abs returned zero/);
+      assert.deepStrictEqual(calls, [[0, 0, [0]]]);
+    });
+
+    it("uses a default error carrying the result", function () {
+      const abs = libc.func("abs", ctypes.c_int32, [ctypes.c_int32]);
+      abs.errcheck = { fail: "nonzero" };
+      assert.strictEqual(abs(0), 0);
+      assert.throws(
+        () => abs(-3),
+        (err) => err.result === 3 && /abs/.test(err.message),
+      );
+    });
+
+    it("rejects callAsync when the policy fails", async function () {
+      const strcmp = libc.func("strcmp", ctypes.c_int32, [ctypes.c_char_p, ctypes.c_char_p]);
+      strcmp.errcheck = { fail: "negative", error: (code) => Object.assign(new Error("negative"), { code }) };
+      assert.strictEqual(await strcmp.callAsync("a", "a"), 0);
+      await assert.rejects(strcmp.callAsync("a", "b"), (err) => err.code < 0);
+    });
+
+    it("passes the same func and args on the sync and async paths", async function () {
+      const abs = libc.func("abs", ctypes.c_int32, [ctypes.c_int32]);
+      const seen = [];
+      abs.errcheck = {
+        fail: "zero",
+        error: (code, result, func, args) => {
+          seen.push([func, args]);
+          return new Error("zero");
+        },
+      };
+      assert.throws(() => abs(0), /zero/);
+      await assert.rejects(abs.callAsync(0), /zero/);
+      assert.deepStrictEqual(seen, [
+        [abs, [0]],
+        [abs, [0]],
+      ]);
+
+      seen.length = 0;
+      abs.errcheck = (result, func, args) => {
+        seen.push([func, args]);
+        return result;
+      };
+      assert.strictEqual(abs(-4), 4);
+      assert.strictEqual(await abs.callAsync(-5), 5);
+      assert.deepStrictEqual(seen, [
+        [abs, [-4]],
+        [abs, [-5]],
+      ]);
+    });
+
+    it("is replaced by a JS errcheck and cleared by null", function () {
+      const abs = libc.func("abs", ctypes.c_int32, [ctypes.c_int32]);
+      abs.errcheck = { fail: "zero" };
+      assert.throws(() => abs(0));
+      abs.errcheck = (result) => result + 1;
+      assert.strictEqual(abs(0), 1);
+      abs.errcheck = { fail: "zero" };
+      abs.errcheck = null;
+      assert.strictEqual(abs(0), 0);
+    });
+
+    it("validates the policy", function () {
+      const abs = libc.func("abs", ctypes.c_int32, [ctypes.c_int32]);
+      assert.throws(() => (abs.errcheck = { fail: "sometimes" }), TypeError);
+      assert.throws(() => (abs.errcheck = { fail: "zero", code: "errno" }), /use_errno/);
+      assert.throws(() => (abs.errcheck = { fail: "zero", code: "lastError" }), /use_last_error/);
+      const srand = libc.func("srand", ctypes.c_void, [ctypes.c_uint32]);
+      assert.throws(() => (srand.errcheck = { fail: "zero" }), /no status/);
+    });
+
+    it("reports the captured errno", { skip: process.platform === "win32" }, function () {
+      const LIBC = platform === "darwin" ? "libc.dylib" : "libc.so.6";
+      const lib = new ctypes.CDLL(LIBC, { use_errno: true });
+      try {
+        const open = lib.func("open", ctypes.c_int32, [ctypes.c_char_p, ctypes.c_int32]);
+        open.errcheck = { fail: "minusOne", code: "errno" };
+        assert.throws(
+          () => open("/path/that/does/not/exist/test.txt", 0),
+          (err) => err.errno === os.constants.errno.ENOENT && err.code === "ENOENT",
+        );
+      } finally {
+        lib.close();
+      }
+    });
+  });
 });
 
 // ────────────────────────────────────────────────────────────────────
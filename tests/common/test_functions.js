@@ -248,6 +248,27 @@ describe("Functions and Callbacks", function () {
       const str4 = buf.toString("utf8", 0, buf.indexOf(0));
       assert.strictEqual(str4, "Pi is approximately 3.14");
     });
+
+    it("should share cached variadic CIFs between sync and async calls", async function () {
+      const lib = new ctypes.CDLL("msvcrt.dll");
+      try {
+        const sprintf = lib.func("sprintf", ctypes.c_int32, [ctypes.c_void_p, ctypes.c_char_p]);
+        const buf = ctypes.create_string_buffer(64);
+
+        sprintf(buf, "%d", 1);
+        sprintf(buf, "%d", 2);
+        sprintf(buf, "%s", "x");
+        await sprintf.callAsync(buf, "%d", 3);
+        assert.strictEqual(buf.toString("utf8", 0, buf.indexOf(0)), "3");
+
+        const stats = sprintf._ffi.getVariadicCacheStats();
+        assert.strictEqual(stats.misses, 2);
+        assert.strictEqual(stats.hits, 2);
+        assert.strictEqual(stats.size, 2);
+      } finally {
+        lib.close();
+      }
+    });
   });
 
   describe("Pointer Returns", function () {
@@ -262,6 +283,379 @@ describe("Functions and Callbacks", function () {
     });
   });
 
+  // Le signature tutte primitive passano dal trampolino specializzato;
+  // use_errno forza il path libffi, quindi i due risultati devono coincidere.
+  describe("Specialized call trampolines", function () {
+    let fast, slow;
+
+    before(function () {
+      const LIBC = process.platform === "win32" ? "msvcrt.dll" : platform === "darwin" ? "libc.dylib" : "libc.so.6";
+      fast = new ctypes.CDLL(LIBC);
+      slow = new ctypes.CDLL(LIBC, { use_errno: true });
+    });
+
+    after(function () {
+      fast.close();
+      slow.close();
+    });
+
+    const both = (name, restype, argtypes) => [fast.func(name, restype, argtypes), slow.func(name, restype, argtypes)];
+
+    it("int(int) and long(long) match the libffi path", function () {
+      const [abs, absFfi] = both("abs", ctypes.c_int32, [ctypes.c_int32]);
+      for (const v of [-42, 0, 42, -2147483647]) {
+        assert.strictEqual(abs(v), absFfi(v));
+      }
+      const [labs, labsFfi] = both("labs", ctypes.c_long, [ctypes.c_long]);
+      assert.strictEqual(labs(-1234567), labsFfi(-1234567));
+    });
+
+    it("double(double, int) and double(double, double) match the libffi path", function () {
+      const [ldexp, ldexpFfi] = both("ldexp", ctypes.c_double, [ctypes.c_double, ctypes.c_int32]);
+      assert.strictEqual(ldexp(1.5, 4), 24);
+      assert.strictEqual(ldexp(-0.75, -2), ldexpFfi(-0.75, -2));
+      const [pow, powFfi] = both("pow", ctypes.c_double, [ctypes.c_double, ctypes.c_double]);
+      assert.strictEqual(pow(2, 10), 1024);
+      assert.strictEqual(pow(1.1, 3.3), powFfi(1.1, 3.3));
+    });
+
+    it("float(float)", { skip: process.platform === "win32" }, function () {
+      const [fabsf, fabsfFfi] = both("fabsf", ctypes.c_float, [ctypes.c_float]);
+      assert.strictEqual(fabsf(-2.5), 2.5);
+      assert.strictEqual(fabsf(-1.1), fabsfFfi(-1.1));
+    });
+
+    it("void*(void*, int, size_t) with Buffer and pointer return", function () {
+      const [memset, memsetFfi] = both("memset", ctypes.c_void_p, [ctypes.c_void_p, ctypes.c_int32, ctypes.c_size_t]);
+      const buf = Buffer.alloc(8);
+      const ret = memset(buf, 0x5a, 8);
+      assert.strictEqual(ret, memsetFfi(buf, 0x5a, 8));
+      assert.ok(buf.every((b) => b === 0x5a));
+      assert.strictEqual(memset(null, 0, 0), null);
+    });
+
+    it("void(uint) and int() keep call order", function () {
+      const [srand, srandFfi] = both("srand", ctypes.c_void, [ctypes.c_uint32]);
+      const rand = fast.func("rand", ctypes.c_int32, []);
+      assert.strictEqual(srand(1234), undefined);
+      const a = rand();
+      srandFfi(1234);
+      assert.strictEqual(rand(), a);
+    });
+
+    it("getFastCall() entry matches ffi.call() on both paths", function () {
+      const [abs, absFfi] = both("abs", ctypes.c_int32, [ctypes.c_int32]);
+      const entry = abs._ffi.getFastCall();
+      const entryFfi = absFfi._ffi.getFastCall();
+      assert.strictEqual(entry(-7), abs._ffi.call(-7));
+      assert.strictEqual(entryFfi(-7), 7);
+      const strlen = fast.func("strlen", ctypes.c_size_t, [ctypes.c_char_p]);
+      assert.strictEqual(strlen._ffi.getFastCall()("hello"), 5n);
+      assert.throws(() => entry(), /Expected 1 arguments, got 0/);
+    });
+
+    it("errcheck still applies on the fast path", function () {
+      const [abs] = both("abs", ctypes.c_int32, [ctypes.c_int32]);
+      abs.errcheck = (result) => result * 2;
+      assert.strictEqual(abs(-21), 42);
+    });
+  });
+
+  describe("callBatch", function () {
+    it("runs one call per column element", function () {
+      const abs = libc.func("abs", ctypes.c_int32, [ctypes.c_int32]);
+      const out = abs.callBatch([Int32Array.of(-1, 2, -3, 4)], 4);
+      assert.ok(out instanceof Int32Array);
+      assert.deepStrictEqual(Array.from(out), [1, 2, 3, 4]);
+    });
+
+    it("broadcasts scalar columns and fills a caller-supplied out", function () {
+      const ldexp = libc.func("ldexp", ctypes.c_double, [ctypes.c_double, ctypes.c_int32]);
+      const out = new Float64Array(3);
+      const ret = ldexp.callBatch([Float64Array.of(1, 1.5, -2), 3], 3, out);
+      assert.strictEqual(ret, out);
+      assert.deepStrictEqual(Array.from(out), [8, 12, -16]);
+    });
+
+    it("supports pointer columns and void returns", function () {
+      const memset = libc.func("memset", ctypes.c_void_p, [ctypes.c_void_p, ctypes.c_int32, ctypes.c_size_t]);
+      const buf = Buffer.alloc(4);
+      const ptrs = memset.callBatch([buf, Int32Array.of(1, 2, 3), 4], 3);
+      assert.ok(ptrs instanceof BigUint64Array);
+      assert.strictEqual(ptrs[0], ptrs[2]);
+      assert.deepStrictEqual([...buf], [3, 3, 3, 3]);
+
+      // Uint8Array come scalare puntatore; BigUint64Array come colonna di indirizzi
+      const bytes = new Uint8Array(buf.buffer, buf.byteOffset, 4);
+      memset.callBatch([bytes, 7, 2], 1);
+      assert.deepStrictEqual([...buf], [7, 7, 3, 3]);
+      const a = Buffer.alloc(2);
+      const b = Buffer.alloc(2);
+      memset.callBatch([BigUint64Array.of(ctypes.addressof(a), ctypes.addressof(b)), Int32Array.of(1, 2), 2], 2);
+      assert.deepStrictEqual([...a, ...b], [1, 1, 2, 2]);
+
+      const srand = libc.func("srand", ctypes.c_void, [ctypes.c_uint32]);
+      assert.strictEqual(srand.callBatch([Uint32Array.of(1, 2)], 2), undefined);
+    });
+
+    it("validates columns", function () {
+      const abs = libc.func("abs", ctypes.c_int32, [ctypes.c_int32]);
+      assert.throws(() => abs.callBatch([Int32Array.of(1)], 2), RangeError);
+      assert.throws(() => abs.callBatch([Float64Array.of(1)], 1), /compatible with int32/);
+      assert.throws(() => abs.callBatch([], 1), /Expected 1 argument columns/);
+      const strlen = libc.func("strlen", ctypes.c_size_t, [ctypes.c_char_p]);
+      assert.throws(() => strlen.callBatch(["abc"], 1), /only primitive arguments/);
+    });
+
+    it("maps a batch in parallel chunks with mapAsync", async function () {
+      const abs = libc.func("abs", ctypes.c_int32, [ctypes.c_int32]);
+      const count = 10007;
+      const input = Int32Array.from({ length: count }, (_, i) => (i % 2 ? -i : i));
+
+      const before = ctypes.callPoolStats();
+      const out = await abs.mapAsync([input], count, { concurrency: 4 });
+      assert.ok(out instanceof Int32Array);
+      assert.deepStrictEqual(Array.from(out), Array.from({ length: count }, (_, i) => i));
+      assert.strictEqual(ctypes.callPoolStats().submitted - before.submitted, 4);
+
+      const given = new Int32Array(3);
+      assert.strictEqual(await abs.mapAsync([Int32Array.of(-7, 8, -9)], 3, { out: given }), given);
+      assert.deepStrictEqual(Array.from(given), [7, 8, 9]);
+
+      const ldexp = libc.func("ldexp", ctypes.c_double, [ctypes.c_double, ctypes.c_int32]);
+      assert.deepStrictEqual(Array.from(await ldexp.mapAsync([Float64Array.of(1, 2), 2], 2)), [4, 8]);
+      assert.strictEqual((await abs.mapAsync([new Int32Array(0)], 0)).length, 0);
+    });
+
+    it("passes Buffer pointer arguments to mapAsync as scalars", async function () {
+      const strlen = libc.func("strlen", ctypes.c_size_t, [ctypes.c_void_p]);
+      const text = Buffer.from("hello\0");
+      const lengths = await strlen.mapAsync([text], 8, { concurrency: 2 });
+      assert.ok(lengths instanceof BigUint64Array);
+      assert.deepStrictEqual(Array.from(lengths), Array(8).fill(5n));
+
+      const memset = libc.func("memset", ctypes.c_void_p, [ctypes.c_void_p, ctypes.c_int32, ctypes.c_size_t]);
+      const buf = Buffer.alloc(4);
+      await memset.mapAsync([buf, Int32Array.of(1, 2, 9), 3], 3, { concurrency: 1 });
+      assert.deepStrictEqual([...buf], [9, 9, 9, 0]);
+    });
+
+    it("validates mapAsync arguments", async function () {
+      const abs = libc.func("abs", ctypes.c_int32, [ctypes.c_int32]);
+      assert.throws(() => abs.mapAsync([Int32Array.of(1)], 2), RangeError);
+      assert.throws(() => abs.mapAsync([Int32Array.of(1)], 1, { concurrency: 0 }), /concurrency/);
+      const strlen = libc.func("strlen", ctypes.c_size_t, [ctypes.c_char_p]);
+      assert.throws(() => strlen.mapAsync(["abc"], 1), /mapAsync supports only primitive arguments/);
+    });
+  });
+
+  describe("bindAll", function () {
+    it("should bind a manifest in one call", function () {
+      const { abs, strlen } = libc.bindAll([
+        { name: "abs", restype: ctypes.c_int32, argtypes: [ctypes.c_int32] },
+        { name: "strlen", restype: ctypes.c_size_t, argtypes: [ctypes.c_char_p] },
+      ]);
+
+      assert.strictEqual(abs(-7), 7);
+      assert.strictEqual(strlen("hello"), 5n);
+    });
+
+    it("should share the function cache with func()", function () {
+      const abs = libc.func("abs", ctypes.c_int32, [ctypes.c_int32]);
+      const bound = libc.bindAll([{ name: "abs", restype: ctypes.c_int32, argtypes: [ctypes.c_int32] }]);
+      assert.strictEqual(bound.abs, abs);
+    });
+
+    it("should report the missing symbol", function () {
+      throws(
+        () =>
+          libc.bindAll([
+            { name: "abs", restype: ctypes.c_int32, argtypes: [ctypes.c_int32] },
+            { name: "no_such_function_xyz", restype: ctypes.c_int32 },
+          ]),
+        /no_such_function_xyz/,
+      );
+    });
+
+    it("should reject malformed entries", function () {
+      throws(() => libc.bindAll({}), TypeError);
+      throws(() => libc.bindAll([{ restype: ctypes.c_int32 }]), TypeError);
+      throws(() => libc.bindAll([{ name: "abs" }]), TypeError);
+    });
+  });
+
+  describe("Call statistics", function () {
+    const LIBC = process.platform === "win32" ? "msvcrt.dll" : platform === "darwin" ? "libc.dylib" : "libc.so.6";
+    const sum = (histogram) => histogram.reduce((a, b) => a + b, 0);
+
+    it("should be off by default", function () {
+      const abs = libc.func("abs", ctypes.c_int32, [ctypes.c_int32]);
+      abs(-1);
+      const stats = abs.getStats();
+      assert.strictEqual(stats.enabled, false);
+      assert.strictEqual(stats.calls, 0);
+    });
+
+    it("should record phases for a library opened with stats: true", function () {
+      const lib = new ctypes.CDLL(LIBC, { stats: true });
+      try {
+        const abs = lib.func("abs", ctypes.c_int32, [ctypes.c_int32]);
+        const strlen = lib.func("strlen", ctypes.c_size_t, [ctypes.c_char_p]);
+        for (let i = 0; i < 5; i++) abs(-i);
+        strlen("x".repeat(4096));
+
+        const a = abs.getStats();
+        assert.strictEqual(a.enabled, true);
+        assert.strictEqual(a.calls, 5);
+        assert.strictEqual(sum(a.total.histogram), 5);
+        assert.strictEqual(sum(a.marshal.histogram), 5);
+        assert.strictEqual(sum(a.ffiCall.histogram), 5);
+        assert.strictEqual(sum(a.finalize.histogram), 5);
+        assert.strictEqual(a.total.histogram.length, 32);
+
+        const s = strlen.getStats();
+        assert.strictEqual(s.calls, 1);
+        assert.strictEqual(sum(s.marshal.histogram), 1);
+        assert.strictEqual(s.stringBufferGrowths, 1);
+        assert.ok(s.total.totalNs >= s.ffiCall.totalNs);
+
+        // 300 byte ASCII: oltre il caso peggiore (3 byte per unit) del buffer
+        // inline da 512, ma la lunghezza esatta ci sta
+        const strnlen = lib.func("strnlen", ctypes.c_size_t, [ctypes.c_char_p, ctypes.c_size_t]);
+        assert.strictEqual(strnlen("y".repeat(300), 1000), 300n);
+        assert.strictEqual(strnlen.getStats().stringBufferGrowths, 0);
+
+        const names = ctypes.statsSnapshot().functions.map((f) => f.name);
+        assert.ok(names.includes("abs"));
+        assert.ok(names.includes("strlen"));
+
+        abs.resetStats();
+        assert.strictEqual(abs.getStats().calls, 0);
+      } finally {
+        lib.close();
+      }
+    });
+
+    it("should be switchable globally", function () {
+      const labs = libc.func("labs", ctypes.c_long, [ctypes.c_long]);
+      assert.strictEqual(ctypes.setStatsEnabled(true), true);
+      try {
+        labs(-3);
+        labs(-4);
+      } finally {
+        assert.strictEqual(ctypes.setStatsEnabled(false), false);
+      }
+      labs(-5);
+      assert.strictEqual(labs.getStats().calls, 2);
+      assert.strictEqual(ctypes.statsSnapshot().enabled, false);
+    });
+  });
+
+  describe("pointerMode", function () {
+    it("should return BigInt pointers and sizes by default", function () {
+      const strlen = libc.func("strlen", ctypes.c_size_t, [ctypes.c_char_p]);
+      assert.strictEqual(strlen("abc"), 3n);
+    });
+
+    it("should return exact Numbers with pointerMode: 'number'", function () {
+      const opts = { pointerMode: "number" };
+      const strlen = libc.func("strlen", ctypes.c_size_t, [ctypes.c_char_p], opts);
+      const malloc = libc.func("malloc", ctypes.c_void_p, [ctypes.c_size_t], opts);
+      const free = libc.func("free", ctypes.c_void, [ctypes.c_void_p]);
+
+      assert.strictEqual(strlen("hello"), 5);
+      const p = malloc(16);
+      try {
+        assert.strictEqual(typeof p, "number");
+        ctypes.ptrToBuffer(p, 4).writeInt32LE(42, 0);
+        assert.strictEqual(ctypes.readValue(p, ctypes.c_int32), 42);
+        assert.strictEqual(ctypes.addressof(p), BigInt(p));
+      } finally {
+        free(p);
+      }
+    });
+
+    it("should apply the library-level pointerMode", async function () {
+      const LIBC = process.platform === "win32" ? "msvcrt.dll" : platform === "darwin" ? "libc.dylib" : "libc.so.6";
+      const lib = new ctypes.CDLL(LIBC, { pointerMode: "number" });
+      try {
+        const strlen = lib.func("strlen", ctypes.c_size_t, [ctypes.c_char_p]);
+        assert.strictEqual(strlen("abcd"), 4);
+        assert.strictEqual(await strlen.callAsync("abcdef"), 6);
+        // L'opzione per-funzione vince su quella della library
+        const strlenBig = lib.func("strlen", ctypes.c_size_t, [ctypes.c_char_p], { pointerMode: "bigint" });
+        assert.strictEqual(strlenBig("abcd"), 4n);
+      } finally {
+        lib.close();
+      }
+    });
+
+    it("should wrap pointers beyond 2^53 in a handle", { skip: process.platform === "win32" }, function () {
+      // llabs come identità su un intero > 2^53, dichiarato con ritorno / argomento puntatore
+      const toPointer = libc.func("llabs", ctypes.c_void_p, [ctypes.c_int64], { pointerMode: "number" });
+      const fromPointer = libc.func("llabs", ctypes.c_int64, [ctypes.c_void_p], { pointerMode: "number" });
+      const big = 2n ** 60n + 8n;
+
+      const handle = toPointer(big);
+      assert.strictEqual(typeof handle, "object");
+      assert.notStrictEqual(handle, null);
+      assert.strictEqual(ctypes.addressof(handle), big);
+      // I marshaller scartano l'handle; un intero oltre 2^53 resta BigInt
+      assert.strictEqual(fromPointer(handle), big);
+      assert.strictEqual(fromPointer(4096), 4096);
+
+      // Anche come argomento intero (size_t / int64): il valore è l'indirizzo
+      const fromSize = libc.func("llabs", ctypes.c_size_t, [ctypes.c_size_t], { pointerMode: "number" });
+      assert.strictEqual(fromSize(handle), big);
+      const fromInt64 = libc.func("llabs", ctypes.c_int64, [ctypes.c_int64]);
+      assert.strictEqual(fromInt64(handle), big);
+    });
+
+    it("should reject an unknown pointerMode", function () {
+      assert.throws(() => libc.func("strlen", ctypes.c_size_t, [ctypes.c_char_p], { pointerMode: "auto" }), TypeError);
+    });
+  });
+
+  describe("Native out parameters", function () {
+    const { c_long, c_char_p, c_int32, POINTER } = ctypes;
+
+    it("should fill outValues for lib.func with outParams", function () {
+      const strtol = libc.func("strtol", c_long, [c_char_p, POINTER(c_char_p), c_int32], {
+        outParams: [{ index: 1, type: c_char_p }],
+      });
+      const outs = strtol.outValues;
+      assert.ok(Array.isArray(outs));
+
+      assert.strictEqual(Number(strtol("77 rest", undefined, 10)), 77);
+      assert.strictEqual(outs[0], " rest");
+      assert.strictEqual(Number(strtol("ff!", undefined, 16)), 255);
+      assert.strictEqual(strtol.outValues, outs);
+      assert.strictEqual(outs[0], "!");
+    });
+
+    it("should be used by paramflags out params", function () {
+      const proto = ctypes.CFUNCTYPE(c_long, c_char_p, POINTER(c_char_p), c_int32);
+      const strtol = proto.bind(libc, "strtol", [
+        { dir: "in", name: "s" },
+        { dir: "out", name: "end" },
+        { dir: "in", name: "base", default: 10 },
+      ]);
+      assert.strictEqual(strtol("123abc"), "abc");
+      assert.strictEqual(strtol({ s: "42" }), "");
+    });
+
+    it("should reject callAsync and invalid declarations", async function () {
+      const strtol = libc.func("strtol", c_long, [c_char_p, POINTER(c_char_p), c_int32], {
+        outParams: [{ index: 1, type: c_char_p }],
+      });
+      await assert.rejects(async () => strtol.callAsync("1", undefined, 10), TypeError);
+      assert.throws(
+        () => libc.func("strtol", c_long, [c_char_p, POINTER(c_char_p), c_int32], { outParams: [{ index: 0, type: c_int32 }] }),
+        TypeError,
+      );
+    });
+  });
+
   describe("Function Address", function () {
     it("should expose function address", function () {
       const strlen = libc.func("strlen", ctypes.c_size_t, [ctypes.c_char_p]);
@@ -272,11 +666,153 @@ describe("Functions and Callbacks", function () {
   });
 
   describe("Function async", function () {
+    const LIBC = process.platform === "win32" ? "msvcrt.dll" : platform === "darwin" ? "libc.dylib" : "libc.so.6";
+
     it("should call function asynchronously", async function () {
       const strlen = libc.func("strlen", ctypes.c_size_t, [ctypes.c_char_p]);
       const result = await strlen.callAsync("hello");
       assert.strictEqual(result, 5n);
     });
+
+    it("reuses async call frames across calls with different payloads", async function () {
+      const strlen = libc.func("strlen", ctypes.c_size_t, [ctypes.c_char_p]);
+      for (let round = 0; round < 3; round++) {
+        const inputs = Array.from({ length: 16 }, (_, i) => "x".repeat((i * 37 + round * 11) % 300));
+        const lengths = await Promise.all(inputs.map((s) => strlen.callAsync(s)));
+        assert.deepStrictEqual(lengths, inputs.map((s) => BigInt(s.length)));
+      }
+    });
+
+    it("runs async calls on the native call pool", async function () {
+      const labs = libc.func("labs", ctypes.c_long, [ctypes.c_long]);
+      const before = ctypes.callPoolStats();
+      const results = await Promise.all(Array.from({ length: 32 }, (_, i) => labs.callAsync(-i)));
+      assert.deepStrictEqual(results.map(Number), Array.from({ length: 32 }, (_, i) => i));
+
+      const after = ctypes.callPoolStats();
+      assert.ok(after.threads >= 1);
+      assert.strictEqual(after.submitted - before.submitted, 32);
+      assert.strictEqual(after.pending, 0);
+    });
+
+    it("settles calls of a serial library in call order", async function () {
+      const serial = new ctypes.CDLL(LIBC, { serial: true });
+      try {
+        const abs = serial.func("abs", ctypes.c_int32, [ctypes.c_int32]);
+        const order = [];
+        await Promise.all(Array.from({ length: 64 }, (_, i) => abs.callAsync(-i).then((v) => order.push(v))));
+        assert.deepStrictEqual(order, Array.from({ length: 64 }, (_, i) => i));
+      } finally {
+        serial.close();
+      }
+    });
+
+    it("does not reuse a cached function across serial options", async function () {
+      const lib = new ctypes.CDLL(LIBC);
+      try {
+        const abs = lib.func("abs", ctypes.c_int32, [ctypes.c_int32]);
+        const serialAbs = lib.func("abs", ctypes.c_int32, [ctypes.c_int32], { serial: true });
+        assert.notStrictEqual(serialAbs, abs);
+        assert.notStrictEqual(lib.func("abs", ctypes.c_int32, [ctypes.c_int32], { serial: false }), abs);
+        assert.strictEqual(lib.func("abs", ctypes.c_int32, [ctypes.c_int32], { serial: true }), serialAbs);
+
+        const order = [];
+        await Promise.all(Array.from({ length: 32 }, (_, i) => serialAbs.callAsync(-i).then((v) => order.push(v))));
+        assert.deepStrictEqual(order, Array.from({ length: 32 }, (_, i) => i));
+      } finally {
+        lib.close();
+      }
+    });
+
+    it("validates pool configuration and queue handles", function () {
+      assert.throws(() => ctypes.configureCallPool({ threads: 0 }), RangeError);
+      assert.ok(ctypes.configureCallPool({}).threads >= 1);
+      assert.throws(() => libc.func("toupper", ctypes.c_int32, [ctypes.c_int32], { queue: {} }), /createSerialQueue/);
+    });
+
+    it("accepts an explicit serial queue per function", async function () {
+      const lib = new ctypes.CDLL(LIBC);
+      try {
+        const abs = lib.func("abs", ctypes.c_int32, [ctypes.c_int32], { queue: ctypes.createSerialQueue() });
+        assert.strictEqual(await abs.callAsync(-7), 7);
+      } finally {
+        lib.close();
+      }
+    });
+
+    it("publishes submitted calls to a completion ring", async function () {
+      const abs = libc.func("abs", ctypes.c_int32, [ctypes.c_int32]);
+      const labs = libc.func("labs", ctypes.c_long, [ctypes.c_long]);
+      const ring = ctypes.completionRing({ capacity: 64 });
+      assert.strictEqual(ring.capacity, 64);
+      assert.ok(ring.buffer instanceof SharedArrayBuffer);
+
+      for (let i = 0; i < 20; i++) abs.submit(ring, i, -i);
+      for (let i = 20; i < 30; i++) labs.submit(ring, i, -i);
+
+      const results = new Map();
+      while (results.size < 30) {
+        await ring.wait();
+        ring.drain((tag, value, error) => {
+          assert.strictEqual(error, undefined);
+          results.set(tag, value);
+        });
+      }
+      for (let i = 0; i < 20; i++) assert.strictEqual(results.get(i), i);
+      for (let i = 20; i < 30; i++) assert.strictEqual(results.get(i), BigInt(i));
+      assert.strictEqual(ring.inflight, 0);
+      assert.strictEqual(ring.pending, 0);
+    });
+
+    it("calls onBatch and rejects submissions to a full ring", async function () {
+      const abs = libc.func("abs", ctypes.c_int32, [ctypes.c_int32]);
+      let batches = 0;
+      let sum = 0;
+      let resolve;
+      const done = new Promise((r) => (resolve = r));
+      const ring = ctypes.completionRing({
+        capacity: 4,
+        onBatch: (r) => {
+          batches++;
+          r.drain((tag, value) => (sum += value));
+          if (r.inflight === 0 && r.pending === 0) resolve();
+        },
+      });
+
+      for (let i = 1; i <= 4; i++) abs.submit(ring, i, -i);
+      assert.throws(() => abs.submit(ring, 5, -5), RangeError);
+      await done;
+      assert.ok(batches >= 1);
+      assert.strictEqual(sum, 10);
+
+      assert.throws(() => abs.submit({}, 0, 1), /CompletionRing/);
+      const div = libc.func("div", ctypes.c_int32, [ctypes.c_int32, ctypes.c_int32]);
+      assert.throws(() => div.submit(ring, "tag", 1, 2), /numeric tag/);
+    });
+
+    it("still notifies later rings when an onBatch callback throws", async function () {
+      const abs = libc.func("abs", ctypes.c_int32, [ctypes.c_int32]);
+      const listeners = process.rawListeners("uncaughtException");
+      process.removeAllListeners("uncaughtException");
+      const uncaught = new Promise((resolve) => process.once("uncaughtException", resolve));
+      try {
+        const failing = ctypes.completionRing({
+          onBatch: () => {
+            throw new Error("onBatch failed");
+          },
+        });
+        const ring = ctypes.completionRing();
+        abs.submit(failing, 1, -1);
+        abs.submit(ring, 2, -2);
+        // wait() starts before the drain, so only the Atomics.notify can resolve it
+        assert.strictEqual(await ring.wait(5000), 1);
+        ring.drain((tag, value) => assert.strictEqual(value, 2));
+        assert.match((await uncaught).message, /onBatch failed/);
+      } finally {
+        process.removeAllListeners("uncaughtException");
+        for (const listener of listeners) process.on("uncaughtException", listener);
+      }
+    });
   });
 
   describe("CFUNCTYPE", function () {
@@ -347,6 +883,50 @@ describe("Functions and Callbacks", function () {
       assert.strictEqual(strlen(buf), 5n);
     });
   });
+
+  describe("C string marshalling", function () {
+    it("encodes multi-byte and long c_char_p arguments", function () {
+      const strlen = libc.func("strlen", ctypes.c_size_t, [ctypes.c_char_p]);
+      assert.strictEqual(strlen("àèì€"), 9n);
+      assert.strictEqual(strlen("x".repeat(5000)), 5000n);
+
+      // Più stringhe nel buffer heap: la seconda può riallocarlo, i
+      // puntatori devono restare validi
+      const strcmp = libc.func("strcmp", ctypes.c_int32, [ctypes.c_char_p, ctypes.c_char_p]);
+      const long = "é".repeat(3000);
+      assert.strictEqual(strcmp(long, long), 0);
+      assert.ok(strcmp("short", long) < 0);
+      assert.ok(strcmp(long + "b", "a".repeat(200) + long) > 0);
+    });
+
+    it("encodes long c_wchar_p arguments", async function () {
+      let wcslen;
+      try {
+        wcslen = libc.func("wcslen", ctypes.c_size_t, [ctypes.c_wchar_p]);
+      } catch {
+        return;
+      }
+      assert.strictEqual(wcslen("Hello"), 5n);
+      assert.strictEqual(wcslen("ß".repeat(4000)), 4000n);
+      assert.strictEqual(await wcslen.callAsync("ß".repeat(4000)), 4000n);
+    });
+
+    it("intern_string returns a shared pre-encoded buffer", async function () {
+      const a = ctypes.intern_string("table.users");
+      assert.ok(Buffer.isBuffer(a));
+      assert.strictEqual(ctypes.intern_string("table.users"), a);
+      assert.strictEqual(a.length, "table.users".length + 1);
+      assert.strictEqual(a[a.length - 1], 0);
+
+      const strlen = libc.func("strlen", ctypes.c_size_t, [ctypes.c_char_p]);
+      assert.strictEqual(strlen(a), 11n);
+      assert.strictEqual(await strlen.callAsync(a), 11n);
+
+      const w = ctypes.intern_wstring("table.users");
+      assert.strictEqual(ctypes.intern_wstring("table.users"), w);
+      assert.strictEqual(w.length, ("table.users".length + 1) * ctypes.WCHAR_SIZE);
+    });
+  });
 });
 
 // ────────────────────────────────────────────────────────────────────
@@ -5,6 +5,10 @@
 
 import test from "node:test";
 import assert from "node:assert";
+import fs from "node:fs";
+import os from "node:os";
+import path from "node:path";
+import { pathToFileURL } from "node:url";
 import {
   POINTER,
   pointer,
@@ -14,6 +18,15 @@ import {
   c_char,
   struct,
   Structure,
+  pool,
+  addressof,
+  string_at,
+  wstring_at,
+  create_string_buffer,
+  create_unicode_buffer,
+  mmap,
+  madvise,
+  readValue,
 } from "../../lib/index.js";
 
 test("POINTER type creation", async (t) => {
@@ -378,3 +391,174 @@ test("POINTER arithmetic", async (t) => {
     assert.deepStrictEqual(p.slice(1, 4), [20, 30, 40]);
   });
 });
+
+test("Slab pool", async (t) => {
+  await t.test("alloc returns zeroed Buffer views sharing a slab", () => {
+    const p = pool();
+    const a = p.alloc(12);
+    const b = p.alloc(16);
+    assert.ok(Buffer.isBuffer(a));
+    assert.strictEqual(a.length, 12);
+    assert.ok(a.every((v) => v === 0));
+    // Stessa size class (16): blocchi consecutivi dello stesso slab
+    assert.strictEqual(a.buffer, b.buffer);
+    assert.strictEqual(b.byteOffset - a.byteOffset, 16);
+
+    const stats = p.stats();
+    assert.strictEqual(stats.slabs, 1);
+    assert.strictEqual(stats.liveBlocks, 2);
+    assert.strictEqual(stats.classes.find((c) => c.blockSize === 16).live, 2);
+  });
+
+  await t.test("release recycles blocks and rejects double release", () => {
+    const p = pool();
+    const a = p.alloc(32);
+    a.fill(0xff);
+    assert.strictEqual(p.release(a), true);
+    assert.throws(() => p.release(a), /already released/);
+
+    const b = p.alloc(32);
+    assert.strictEqual(b.byteOffset, a.byteOffset);
+    assert.ok(b.every((v) => v === 0), "recycled blocks are zero-filled");
+    assert.strictEqual(p.release(Buffer.alloc(8)), false);
+  });
+
+  await t.test("large requests fall back to ordinary Buffers", () => {
+    const p = pool({ maxBlockSize: 64 });
+    const big = p.alloc(65);
+    assert.strictEqual(big.length, 65);
+    assert.strictEqual(p.release(big), false);
+    assert.strictEqual(p.stats().fallbacks, 1);
+    assert.strictEqual(p.stats().slabs, 0);
+  });
+
+  await t.test("scope releases the blocks allocated inside it", () => {
+    const p = pool();
+    const outer = p.alloc(8);
+    const len = p.scope(() => {
+      p.alloc(24);
+      const s = p.cstring("hello");
+      assert.strictEqual(string_at(addressof(s)), "hello");
+      return s.length;
+    });
+    assert.strictEqual(len, 6);
+    assert.strictEqual(p.stats().liveBlocks, 1);
+    assert.strictEqual(p.release(outer), true);
+
+    const scope = p.scope();
+    p.create_string_buffer(Buffer.from("abc"));
+    scope.close();
+    scope.close();
+    assert.strictEqual(p.stats().liveBlocks, 0);
+    assert.strictEqual(p.stats().scopes, 0);
+  });
+
+  await t.test("reset and trim give memory back", () => {
+    const p = pool({ slabSize: 4096 });
+    for (let i = 0; i < 600; i++) p.alloc(8);
+    assert.strictEqual(p.stats().slabs, 2);
+    p.reset();
+    assert.strictEqual(p.stats().liveBlocks, 0);
+    assert.strictEqual(p.trim(), 2);
+    assert.strictEqual(p.stats().reservedBytes, 0);
+    assert.strictEqual(p.alloc(8).length, 8);
+  });
+
+  await t.test("invalid options are rejected", () => {
+    assert.throws(() => pool({ slabSize: 1000 }), RangeError);
+    assert.throws(() => pool({ maxBlockSize: 8192 }), RangeError);
+    assert.throws(() => pool(42), TypeError);
+  });
+});
+
+test("String reads", async (t) => {
+  await t.test("string_at handles long ASCII and UTF-8 text", () => {
+    const ascii = "x".repeat(70000) + "end";
+    assert.strictEqual(string_at(create_string_buffer(ascii)), ascii);
+    const utf8 = "caffè ".repeat(1000) + "😀";
+    assert.strictEqual(string_at(create_string_buffer(utf8)), utf8);
+  });
+
+  await t.test("string_at stops at the size limit and the Buffer end", () => {
+    assert.strictEqual(string_at(Buffer.from("Hello, World!\0"), 5), "Hello");
+    assert.strictEqual(string_at(Buffer.from("no terminator")), "no terminator");
+  });
+
+  await t.test("string_at and wstring_at read exactly size units", () => {
+    assert.strictEqual(string_at(Buffer.from("ab\0cd\0"), 5), "ab\0cd");
+    assert.strictEqual(string_at(Buffer.from("abc"), 10), "abc");
+    const wide = create_unicode_buffer("ab\0cd");
+    assert.strictEqual(wstring_at(wide, 5), "ab\0cd");
+    const shifted = Buffer.alloc(wide.length + 1);
+    wide.copy(shifted, 1);
+    assert.strictEqual(wstring_at(shifted.subarray(1), 5), "ab\0cd");
+    assert.strictEqual(wstring_at(shifted.subarray(1)), "ab");
+  });
+
+  await t.test("wstring_at round-trips BMP and astral text", () => {
+    for (const text of ["", "Hello", "é".repeat(33), "日本語テキスト".repeat(10), "a😀b🎉c".repeat(9)]) {
+      const buf = create_unicode_buffer(text);
+      assert.strictEqual(wstring_at(buf), text);
+      assert.strictEqual(wstring_at(addressof(buf)), text);
+    }
+  });
+
+  await t.test("wstring_at honours size and unaligned views", () => {
+    const buf = create_unicode_buffer("Hello, World!");
+    assert.strictEqual(wstring_at(buf, 5), "Hello");
+    const shifted = Buffer.alloc(buf.length + 1);
+    buf.copy(shifted, 1);
+    assert.strictEqual(wstring_at(shifted.subarray(1)), "Hello, World!");
+    assert.strictEqual(wstring_at(null), null);
+  });
+});
+
+test("Memory-mapped files", async (t) => {
+  const dir = fs.mkdtempSync(path.join(os.tmpdir(), "ctypes-mmap-"));
+  const file = path.join(dir, "data.bin");
+  const content = Buffer.alloc(3 * 65536 + 123);
+  for (let i = 0; i < content.length; i++) content[i] = i % 251;
+  content.write("hello mapped\0", 70000, "latin1");
+  fs.writeFileSync(file, content);
+  t.after(() => {
+    // Windows: the file stays locked until the GC unmaps the Buffers
+    try {
+      fs.rmSync(dir, { recursive: true, force: true });
+    } catch {}
+  });
+
+  await t.test("maps the whole file read-only", () => {
+    const buf = mmap(file);
+    assert.strictEqual(buf.length, content.length);
+    assert.ok(buf.equals(content));
+    assert.strictEqual(string_at(buf.subarray(70000)), "hello mapped");
+    assert.strictEqual(readValue(buf, c_int32, 4), content.readInt32LE(4));
+  });
+
+  await t.test("maps an unaligned window", () => {
+    const buf = mmap(pathToFileURL(file), { offset: 70000, length: 12 });
+    assert.strictEqual(buf.toString("latin1"), "hello mapped");
+    assert.throws(() => mmap(file, { offset: content.length - 1, length: 2 }), RangeError);
+    assert.throws(() => mmap(file, { offset: content.length }), RangeError);
+  });
+
+  await t.test("writable mappings reach the file", () => {
+    const buf = mmap(file, { readonly: false, offset: 10, length: 4 });
+    buf.write("ABCD", "latin1");
+    assert.strictEqual(fs.readFileSync(file).toString("latin1", 10, 14), "ABCD");
+  });
+
+  await t.test("madvise accepts mapped Buffers only", () => {
+    const buf = mmap(file, { advise: "sequential" });
+    assert.strictEqual(typeof madvise(buf, "willneed"), "boolean");
+    assert.strictEqual(typeof madvise(buf.subarray(5000), "normal", 10, 100), "boolean");
+    assert.throws(() => madvise(buf, "willneed", 0, buf.length + 1), RangeError);
+    assert.throws(() => madvise(Buffer.alloc(16), "willneed"), TypeError);
+    assert.throws(() => madvise(buf, "often"), TypeError);
+  });
+
+  await t.test("reports open errors", () => {
+    assert.throws(() => mmap(path.join(dir, "missing.bin")), /cannot open/);
+    assert.throws(() => mmap(file, { advise: "often" }), TypeError);
+  });
+});
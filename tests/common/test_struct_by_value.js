@@ -14,6 +14,7 @@
 
 import assert from "node:assert";
 import { describe, it, before } from "node:test";
+import { Worker } from "node:worker_threads";
 import * as ctypes from "node-ctypes";
 
 describe("struct-by-value (Python ctypes parity, CORR-4)", function () {
@@ -26,7 +27,7 @@ describe("struct-by-value (Python ctypes parity, CORR-4)", function () {
     ];
   }
 
-  let libc;
+  let libc, libcPath;
   before(() => {
     // Su Windows (CI) `div` è esportato da msvcrt.
     const path = process.platform === "darwin"
@@ -34,6 +35,7 @@ describe("struct-by-value (Python ctypes parity, CORR-4)", function () {
       : process.platform === "win32"
         ? "msvcrt.dll"
         : null; // Linux: path=null → Library(NULL) cerca il processo corrente (libc già linkata)
+    libcPath = path;
     libc = new CDLL(path);
   });
 
@@ -71,6 +73,138 @@ describe("struct-by-value (Python ctypes parity, CORR-4)", function () {
     assert.strictEqual(DivTDef.get(r, "quot"), 6);
     assert.strictEqual(DivTDef.get(r, "rem"), 1);
   });
+
+  it("typed array field in a struct returned by value", function () {
+    const { array } = ctypes;
+    class DivArr extends Structure {
+      static _fields_ = [["qr", array(c_int, 2, { typed: true })]];
+    }
+    const div = libc.func("div", DivArr, [c_int, c_int]);
+    const r = div(17, 5);
+    assert.ok(r.qr instanceof Int32Array);
+    assert.deepStrictEqual([...r.qr], [3, 2]);
+  });
+
+  it("lazy_struct returns a buffer-backed Structure view", async function () {
+    const div = libc.func("div", DivT, [c_int, c_int], { lazy_struct: true });
+    const r = div(17, 5);
+    assert.ok(r instanceof DivT);
+    assert.strictEqual(r.quot, 3);
+    assert.strictEqual(r.rem, 2);
+    // Il buffer è una copia: le call successive non lo toccano
+    const b = div(42, 6);
+    assert.strictEqual(r.quot, 3);
+    assert.strictEqual(b.quot, 7);
+
+    const a = await div.callAsync(-17, 5);
+    assert.ok(a instanceof DivT);
+    assert.strictEqual(a.quot, -3);
+    assert.strictEqual(a.rem, -2);
+  });
+
+  it("lazy_struct with a struct() def and errcheck", function () {
+    const { struct } = ctypes;
+    const DivTDef = struct({ quot: c_int, rem: c_int });
+    // CDLL dedicata: errcheck resta sulla funzione in cache
+    const div = new CDLL(libcPath).func("div", DivTDef, [c_int, c_int], { lazy_struct: true });
+    let seen;
+    div.errcheck = (result) => {
+      seen = result;
+      return result;
+    };
+    const r = div(25, 4);
+    assert.strictEqual(seen, r);
+    assert.ok(Buffer.isBuffer(r._buffer));
+    assert.strictEqual(r.quot, 6);
+    assert.strictEqual(r.rem, 1);
+  });
+
+  it("lldiv() returns a 16-byte struct without per-call buffers", { skip: process.platform === "win32" }, function () {
+    const { c_int64 } = ctypes;
+    class LLDivT extends Structure {
+      static _fields_ = [
+        ["quot", c_int64],
+        ["rem", c_int64],
+      ];
+    }
+    const lldiv = new CDLL(libcPath, { stats: true }).func("lldiv", LLDivT, [c_int64, c_int64]);
+    for (let i = 1n; i <= 50n; i++) {
+      const r = lldiv(1000n * i + 7n, 1000n);
+      assert.strictEqual(r.quot, i);
+      assert.strictEqual(r.rem, 7n);
+    }
+    const stats = lldiv.getStats();
+    assert.strictEqual(stats.calls, 50);
+    assert.strictEqual(stats.largeArgOverflows, 0);
+  });
+
+  describe("aggregate arena", function () {
+    const { c_int64, CFUNCTYPE } = ctypes;
+    const bigFields = [
+      ["a", c_int64],
+      ["b", c_int64],
+      ["c", c_int64],
+      ["d", c_int64],
+    ];
+    class Big extends Structure {
+      static _fields_ = bigFields;
+    }
+
+    // Callback C che riceve Big per valore (32 byte > ARG_SLOT_SIZE)
+    let callee;
+    before(() => {
+      callee = CFUNCTYPE(c_int64, Big)((s) => s.a + s.d);
+    });
+
+    const withStats = (fn) => {
+      ctypes.setStatsEnabled(true);
+      try {
+        return fn();
+      } finally {
+        ctypes.setStatsEnabled(false);
+      }
+    };
+
+    it("passes a struct larger than a slot without heap fallbacks", function () {
+      const call = CFUNCTYPE(c_int64, Big)(callee.pointer);
+      const big = new Big();
+      withStats(() => {
+        for (let i = 1n; i <= 20n; i++) {
+          big.a = i;
+          big.d = 100n;
+          assert.strictEqual(call(big), i + 100n);
+        }
+      });
+      const stats = call._ffi.getStats();
+      assert.strictEqual(stats.calls, 20);
+      assert.strictEqual(stats.largeArgOverflows, 0);
+    });
+
+    it("falls back once when a layout grows after binding", function () {
+      class Grown extends Structure {
+        static _fields_ = bigFields;
+      }
+      const call = CFUNCTYPE(c_int64, Grown)(callee.pointer);
+      // Il chiamante ora copia 40 byte: l'arena dimensionata a 32 non basta
+      Grown._structDef._nativeStructType.addField("e", ctypes.CType.INT64);
+      const buf = Buffer.alloc(40);
+      buf.writeBigInt64LE(5n, 0);
+      buf.writeBigInt64LE(7n, 24);
+
+      withStats(() => {
+        for (let i = 0; i < 5; i++) {
+          assert.strictEqual(call(buf), 12n);
+        }
+      });
+      const stats = call._ffi.getStats();
+      assert.strictEqual(stats.calls, 5);
+      assert.strictEqual(stats.largeArgOverflows, 1);
+    });
+  });
+
+  it("lazy_struct rejects non-struct return types", function () {
+    assert.throws(() => libc.func("abs", c_int, [c_int], { lazy_struct: true }), TypeError);
+  });
 });
 
 describe("struct-by-value — composite fields (layout / signature only)", function () {
@@ -148,3 +282,198 @@ describe("struct-by-value — composite fields (layout / signature only)", funct
     }
   });
 });
+
+describe("binding manifests", function () {
+  const { Structure, c_int, c_int32, c_double, c_uint8, CDLL } = ctypes;
+
+  const divFields = [
+    ["quot", c_int],
+    ["rem", c_int],
+  ];
+
+  let libc;
+  before(() => {
+    const path = process.platform === "darwin" ? "/usr/lib/libSystem.dylib" : process.platform === "win32" ? "msvcrt.dll" : null;
+    libc = new CDLL(path);
+  });
+
+  it("round-trips through JSON and binds the manifest functions", function () {
+    class DivT extends Structure {
+      static _fields_ = divFields;
+    }
+    const manifest = ctypes.createManifest({
+      types: { DivT },
+      functions: [{ name: "div", restype: DivT, argtypes: [c_int, c_int] }],
+    });
+
+    // Classe "fresca": il suo tipo nativo arriva dal manifest, non da addField
+    class DivT2 extends Structure {
+      static _fields_ = divFields;
+    }
+    const loaded = ctypes.loadManifest(JSON.parse(JSON.stringify(manifest)), { DivT: DivT2 });
+    assert.strictEqual(DivT2._structDef._nativeStructType, loaded.types.DivT);
+
+    const { div } = loaded.bind(libc);
+    const r = div(17, 5);
+    assert.strictEqual(r.quot, 3);
+    assert.strictEqual(r.rem, 2);
+  });
+
+  it("preserves nested struct and array layouts", function () {
+    class Inner extends Structure {
+      static _fields_ = [
+        ["tag", c_uint8],
+        ["value", c_double],
+      ];
+    }
+    class Outer extends Structure {
+      static _fields_ = [
+        ["id", c_int32],
+        ["inner", Inner],
+        ["samples", ctypes.array(c_int32, 3)],
+      ];
+    }
+
+    const manifest = ctypes.createManifest({ types: { Outer } });
+    const { types } = ctypes.loadManifest(JSON.parse(JSON.stringify(manifest)));
+    assert.strictEqual(types.Outer.getSize(), ctypes.sizeof(Outer));
+    assert.strictEqual(types.Outer.getAlignment(), ctypes.alignment(Outer));
+    const buf = types.Outer.create({ id: 7, inner: { tag: 2, value: 1.5 }, samples: [1, 2, 3] });
+    const obj = types.Outer.read(buf);
+    assert.strictEqual(obj.id, 7);
+    assert.strictEqual(obj.inner.tag, 2);
+    assert.strictEqual(obj.inner.value, 1.5);
+    assert.deepStrictEqual(Array.from(obj.samples), [1, 2, 3]);
+  });
+
+  it("rejects manifests from another platform or with bad references", function () {
+    class P extends Structure {
+      static _fields_ = [["x", c_int32]];
+    }
+    const manifest = ctypes.createManifest({ types: { P } });
+
+    assert.throws(() => ctypes.loadManifest({ ...manifest, pointerSize: manifest.pointerSize === 8 ? 4 : 8 }), /different platform/);
+    assert.throws(() => ctypes.loadManifest({ ...manifest, version: 99 }), /unsupported version/);
+    const badRef = { ...manifest, types: [{ kind: "struct", size: 4, alignment: 4, fields: [{ name: "x", type: { ref: 0 }, offset: 0 }] }] };
+    assert.throws(() => ctypes.loadManifest(badRef), /earlier type/);
+    const badOffset = { ...manifest, types: [{ kind: "struct", size: 4, alignment: 4, fields: [{ name: "x", type: ctypes.CType.INT32, offset: 2 }] }] };
+    assert.throws(() => ctypes.loadManifest(badOffset), /layout does not match/);
+  });
+
+  it("rejects bindings whose layout differs from the manifest", function () {
+    class P extends Structure {
+      static _fields_ = [["x", c_int32]];
+    }
+    class Q extends Structure {
+      static _fields_ = [
+        ["x", c_int32],
+        ["y", c_int32],
+      ];
+    }
+    const manifest = ctypes.createManifest({ types: { P } });
+    assert.throws(() => ctypes.loadManifest(manifest, { P: Q }), /does not match/);
+
+    // Stessa dimensione, layout diverso: nomi, tipi e offset dei campi
+    class Pair extends Structure {
+      static _fields_ = [
+        ["a", c_int32],
+        ["b", c_int32],
+      ];
+    }
+    const pairManifest = ctypes.createManifest({ types: { Pair } });
+    const renamed = class extends Structure {
+      static _fields_ = [
+        ["a", c_int32],
+        ["c", c_int32],
+      ];
+    };
+    const retyped = class extends Structure {
+      static _fields_ = [
+        ["a", c_int32],
+        ["b", ctypes.c_float],
+      ];
+    };
+    const moved = class extends Structure {
+      static _fields_ = [
+        ["a", ctypes.c_int16],
+        ["b", ctypes.c_int16],
+        ["pad", c_int32],
+      ];
+    };
+    for (const Pair of [renamed, retyped, moved]) {
+      assert.throws(() => ctypes.loadManifest(pairManifest, { Pair }), /does not match/);
+    }
+  });
+});
+
+describe("shared bindings across worker threads", function () {
+  const { Structure, c_int, CDLL } = ctypes;
+  const libcPath = process.platform === "darwin" ? "/usr/lib/libSystem.dylib" : process.platform === "win32" ? "msvcrt.dll" : null;
+
+  // Il Worker ridefinisce DivT (come farebbe il suo modulo) e la lega al
+  // layout condiviso dal main thread
+  const runWorker = (token) =>
+    new Promise((resolve, reject) => {
+      const code = `
+        const { parentPort, workerData } = require("node:worker_threads");
+        import(workerData.entry).then((ctypes) => {
+          class DivT extends ctypes.Structure {
+            static _fields_ = [["quot", ctypes.c_int], ["rem", ctypes.c_int]];
+          }
+          const { types, bind } = ctypes.attachBindings(workerData.token, { DivT });
+          const { div } = bind(new ctypes.CDLL(workerData.libcPath));
+          const r = div(23, 4);
+          parentPort.postMessage({
+            shared: DivT._structDef._nativeStructType === types.DivT,
+            size: types.DivT.getSize(),
+            quot: r.quot,
+            rem: r.rem,
+          });
+        });
+      `;
+      const worker = new Worker(code, {
+        eval: true,
+        workerData: { entry: import.meta.resolve("node-ctypes"), token, libcPath },
+      });
+      worker.once("message", resolve);
+      worker.once("error", reject);
+    });
+
+  it("lets a worker attach layouts and signatures built by the main thread", async function () {
+    class DivT extends Structure {
+      static _fields_ = [
+        ["quot", c_int],
+        ["rem", c_int],
+      ];
+    }
+    const token = ctypes.shareBindings({
+      types: { DivT },
+      functions: [{ name: "div", restype: DivT, argtypes: [c_int, c_int] }],
+    });
+    assert.strictEqual(typeof token.id, "number");
+    assert.ok(ctypes.sharedRegistryStats().bindingSets >= 1);
+
+    const result = await runWorker(token);
+    assert.deepStrictEqual(result, { shared: true, size: ctypes.sizeof(DivT), quot: 5, rem: 3 });
+
+    // Il layout condiviso è immutabile
+    assert.throws(() => DivT._structDef._nativeStructType.addField("extra", ctypes.CType.INT32), /shared/);
+
+    assert.strictEqual(ctypes.releaseBindings(token), true);
+    assert.strictEqual(ctypes.releaseBindings(token), false);
+    assert.throws(() => ctypes.attachBindings(token), /does not exist or was released/);
+  });
+
+  it("opens each library path once per process", function () {
+    const path = libcPath ?? "libc.so.6";
+    const before = ctypes.sharedRegistryStats();
+    const a = new CDLL(path);
+    const b = new CDLL(path);
+    const during = ctypes.sharedRegistryStats();
+    assert.strictEqual(during.libraryRefs - before.libraryRefs, 2);
+    assert.ok(during.libraries - before.libraries <= 1);
+    a.close();
+    b.close();
+    assert.strictEqual(ctypes.sharedRegistryStats().libraryRefs, before.libraryRefs);
+  });
+});
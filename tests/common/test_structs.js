@@ -5,6 +5,7 @@
 
 import assert, { strictEqual, throws } from "node:assert";
 import { describe, it, before, after } from "node:test";
+import { types } from "node:util";
 import * as ctypes from "node-ctypes";
 
 describe("Structs and Unions", function () {
@@ -60,6 +61,46 @@ describe("Structs and Unions", function () {
     });
   });
 
+  describe("struct() instances", function () {
+    const Point = ctypes.struct({ x: ctypes.c_int32, y: ctypes.c_int32 });
+    const Rect = ctypes.struct({ origin: Point, w: ctypes.c_double, length: ctypes.c_uint16 });
+
+    it("are Buffers with prototype accessors, not Proxies", function () {
+      const r = Rect.create({ origin: { x: 1, y: 2 }, w: 2.5 });
+      assert.ok(Buffer.isBuffer(r));
+      assert.ok(!types.isProxy(r));
+      assert.strictEqual(r._buffer, r);
+      assert.strictEqual(Object.getPrototypeOf(r), Object.getPrototypeOf(Rect.create()));
+      assert.strictEqual(r.w, 2.5);
+      assert.strictEqual(Object.prototype.toString.call(r), "[object StructInstance]");
+    });
+
+    it("nested fields are views on the same memory", function () {
+      const r = Rect.create({ origin: { x: 1, y: 2 } });
+      const o = r.origin;
+      // subarray() torna un Buffer senza accessor
+      assert.strictEqual(o.subarray(0, 4).x, undefined);
+      o.y = 42;
+      assert.strictEqual(r.origin.y, 42);
+      assert.strictEqual(Rect.get(r, "origin.y"), 42);
+      assert.strictEqual(r.readInt32LE(4), 42);
+    });
+
+    it("fields shadowing Buffer properties stay reachable via get/set", function () {
+      const r = Rect.create({ length: 7 });
+      assert.strictEqual(r.length, Rect.size);
+      assert.strictEqual(Rect.get(r, "length"), 7);
+      assert.strictEqual(r.toObject().length, 7);
+    });
+
+    it("wrap() shares memory with the source buffer", function () {
+      const buf = Buffer.alloc(Point.size);
+      const p = Point.wrap(buf);
+      p.x = -5;
+      assert.strictEqual(buf.readInt32LE(0), -5);
+    });
+  });
+
   describe("Unions", function () {
     it("should create and use unions with Python-style syntax", function () {
       // Python: class IntOrFloat(Union): _fields_ = [("i", c_int32), ("f", c_float)]
@@ -1056,3 +1097,56 @@ describe("BigEndianUnion / LittleEndianUnion", function () {
     assert.strictEqual(v._buffer[0], 0x78);
   });
 });
+
+describe("Native StructType marshalling", function () {
+  const { StructType, CType } = ctypes;
+
+  function makePoint() {
+    const inner = new StructType();
+    inner.addField("x", CType.INT16);
+    inner.addField("y", CType.DOUBLE);
+    return inner;
+  }
+
+  it("round-trips nested and anonymous fields through create/toObject", function () {
+    const outer = new StructType();
+    outer.addField("tag", CType.UINT8);
+    outer.addField("pos", makePoint(), { anonymous: true });
+    outer.addField("origin", makePoint());
+    outer.addField("id", CType.INT64);
+
+    const s = outer.create({ tag: 7, x: -3, y: 1.5, origin: { x: 9, y: -2.25 }, id: 42n });
+    const obj = outer.toObject(s);
+    assert.deepStrictEqual(Object.keys(obj), ["tag", "x", "y", "origin", "id"]);
+    assert.strictEqual(obj.tag, 7);
+    assert.strictEqual(obj.x, -3);
+    assert.strictEqual(obj.y, 1.5);
+    assert.deepStrictEqual(obj.origin, { x: 9, y: -2.25 });
+    assert.strictEqual(obj.id, 42n);
+  });
+
+  it("zeroes padding and omitted fields", function () {
+    const st = new StructType();
+    st.addField("a", CType.UINT8);
+    st.addField("b", CType.INT32);
+    st.addField("c", CType.DOUBLE);
+
+    // create() alloca con napi_create_buffer (memoria non inizializzata)
+    const partial = st.create({ b: 5 });
+    const obj = st.toObject(partial);
+    assert.strictEqual(obj.a, 0);
+    assert.strictEqual(obj.b, 5);
+    assert.strictEqual(obj.c, 0);
+    // padding tra a e b
+    assert.deepStrictEqual([...partial._buffer.subarray(1, 4)], [0, 0, 0]);
+  });
+
+  it("keeps last-written member in unions", function () {
+    const u = new StructType({ union: true });
+    u.addField("i", CType.UINT32);
+    u.addField("f", CType.FLOAT);
+    const obj = u.toObject(u.create({ i: 0x3f800000 }));
+    assert.strictEqual(obj.i, 0x3f800000);
+    assert.strictEqual(obj.f, 1);
+  });
+});